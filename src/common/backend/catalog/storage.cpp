@@ -23,6 +23,7 @@
 
 #include "access/cstore_am.h"
 #include "access/dfs/dfs_insert.h"
+#include "access/hio.h"
 #include "access/visibilitymap.h"
 #include "access/xact.h"
 #include "access/xlog.h"
@@ -685,6 +686,7 @@ void RelationTruncate(Relation rel, BlockNumber nblocks)
      * Make sure smgr_targblock etc aren't pointing somewhere past new end
      */
     rel->rd_smgr->smgr_targblock = InvalidBlockNumber;
+    RelationReleaseBulkExtendBlocks(rel, nblocks);
     rel->rd_smgr->smgr_fsm_nblocks = InvalidBlockNumber;
     rel->rd_smgr->smgr_vm_nblocks = InvalidBlockNumber;
 
@@ -776,6 +778,7 @@ void PartitionTruncate(Relation parent, Partition part, BlockNumber nblocks)
      * Make sure smgr_targblock etc aren't pointing somewhere past new end
      */
     rel->rd_smgr->smgr_targblock = InvalidBlockNumber;
+    RelationReleaseBulkExtendBlocks(rel, nblocks);
     rel->rd_smgr->smgr_fsm_nblocks = InvalidBlockNumber;
     rel->rd_smgr->smgr_vm_nblocks = InvalidBlockNumber;
 
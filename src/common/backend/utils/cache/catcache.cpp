@@ -23,6 +23,7 @@
 #include "access/transam.h"
 #include "access/tuptoaster.h"
 #include "access/valid.h"
+#include "access/xact.h"
 #include "catalog/pg_operator.h"
 #include "catalog/pg_proc.h"
 #include "catalog/pg_type.h"
@@ -37,7 +38,9 @@
 #include "storage/ipc.h" /* for on_proc_exit */
 #endif
 #include "storage/lmgr.h"
+#include "threadpool/threadpool.h"
 #include "utils/acl.h"
+#include "utils/atomic.h"
 #include "utils/datum.h"
 #include "utils/builtins.h"
 #include "utils/elog.h"
@@ -105,6 +108,7 @@ static CatCTup* CatalogCacheCreateEntry(CatCache* cache, HeapTuple ntp, Datum* a
     Index hashIndex, bool negative, bool isnailed = false);
 static void CatCacheFreeKeys(TupleDesc tupdesc, int nkeys, const int* attnos, Datum* keys);
 static void CatCacheCopyKeys(TupleDesc tupdesc, int nkeys, const int* attnos, Datum* srckeys, Datum* dstkeys);
+static void GlobalCatCacheRelease(struct GlobalCatCTup* gct);
 
 /*
  *					internal support functions
@@ -509,6 +513,8 @@ static void CatCacheRemoveCTup(CatCache* cache, CatCTup* ct)
      */
     if (ct->negative)
         CatCacheFreeKeys(cache->cc_tupdesc, cache->cc_nkeys, cache->cc_keyno, ct->keys);
+    if (ct->global_ct != NULL)
+        GlobalCatCacheRelease(ct->global_ct);
     pfree_ext(ct);
 
     --cache->cc_ntup;
@@ -553,6 +559,303 @@ static void CatCacheRemoveCList(CatCache* cache, CatCList* cl)
     pfree_ext(cl);
 }
 
+/*
+ * Global catalog cache
+ *
+ * With the thread pool every session builds its own catcache, so catalog cache
+ * memory grows with the number of sessions and a newly attached session pays
+ * the whole cold-cache cost again.  When enable_global_syscache is on, positive
+ * tuples fetched by SearchCatCacheMiss are also published in an instance-wide
+ * table, and a session CatCTup built from a global entry shares its tuple body
+ * instead of copying it.  Sessions keep their own CatCTup headers, lists and
+ * negative entries, so a session cache hit still takes no lock at all; the
+ * global table is only consulted on a session miss.
+ *
+ * Global entries are invalidated by SendSharedInvalidMessages before the
+ * messages reach the sinval queue, so a session that has just processed a
+ * message cannot pick the stale tuple up again.  A tuple read by a catalog scan
+ * that overlapped an invalidation must not be published either: every partition
+ * counts the invalidations it has seen, and the count sampled before the scan
+ * must be unchanged when the tuple is inserted.
+ */
+#define GLOBAL_CATCACHE_BUCKETS 1024
+
+typedef struct GlobalCatCTup {
+    Dlelem cache_elem;       /* list member of per-bucket list */
+    int cache_id;            /* id of the catcache the tuple belongs to */
+    Oid reloid;              /* catalog the tuple comes from */
+    Oid dbid;                /* database of the tuple, InvalidOid for shared catalogs */
+    uint32 hash_value;       /* hash value for this tuple's keys */
+    volatile int32 refcount; /* number of session CatCTups pointing at the tuple */
+    bool dead;               /* unlinked by invalidation, freed on last release */
+    int64 size;              /* memory charged to global_syscache_threshold */
+    Datum keys[CATCACHE_MAXKEYS];
+    HeapTupleData tuple;
+} GlobalCatCTup;
+
+typedef struct GlobalCatCachePartition {
+    MemoryContext context; /* entries of this partition live here */
+    uint64 inval_count;    /* # of invalidations applied to this partition */
+    Dllist buckets[GLOBAL_CATCACHE_BUCKETS];
+} GlobalCatCachePartition;
+
+typedef struct GlobalCatCacheHeader {
+    int64 total_size; /* bytes held by all the global entries */
+    GlobalCatCachePartition partitions[NUM_GLOBAL_CATCACHE_PARTITIONS];
+} GlobalCatCacheHeader;
+
+#define GlobalCatCachePartitionId(hashValue) ((hashValue) % NUM_GLOBAL_CATCACHE_PARTITIONS)
+#define GlobalCatCacheBucketId(hashValue) \
+    (((hashValue) / NUM_GLOBAL_CATCACHE_PARTITIONS) % GLOBAL_CATCACHE_BUCKETS)
+#define GlobalCatCachePartitionLock(partId) GetMainLWLockByIndex(FirstGlobalCatCacheLock + (partId))
+
+/*
+ * Only thread pool sessions use the global cache: their catcache is torn down
+ * by free_session_context, which hands the global references back.  A
+ * transaction that has an xid may see its own uncommitted catalog changes, so
+ * it neither reads nor publishes global entries.
+ */
+static inline bool GlobalCatCacheUsable(void)
+{
+    return ENABLE_GLOBAL_SYSCACHE && IS_THREAD_POOL_WORKER && IS_THREAD_POOL_SESSION && IsNormalProcessingMode() &&
+           !u_sess->attr.attr_common.IsInplaceUpgrade && !TransactionIdIsValid(GetTopTransactionIdIfAny());
+}
+
+static inline Oid GlobalCatCacheDatabaseId(const CatCache* cache)
+{
+    return cache->cc_relisshared ? InvalidOid : u_sess->proc_cxt.MyDatabaseId;
+}
+
+static void GlobalCatCacheFreeEntry(GlobalCatCTup* gct)
+{
+    (void)gs_atomic_add_64(&g_instance.cache_cxt.global_catcache->total_size, -gct->size);
+    pfree(gct);
+}
+
+/*
+ * GlobalCatCacheSearch
+ *
+ * Look for a live global entry matching the search keys.  On success the entry
+ * is returned with one more reference; otherwise NULL is returned and
+ * *invalCount is set for a following GlobalCatCacheInsert.
+ */
+static GlobalCatCTup* GlobalCatCacheSearch(
+    CatCache* cache, int nkeys, uint32 hashValue, const Datum* arguments, uint64* invalCount)
+{
+    GlobalCatCachePartition* part =
+        &g_instance.cache_cxt.global_catcache->partitions[GlobalCatCachePartitionId(hashValue)];
+    Oid dbid = GlobalCatCacheDatabaseId(cache);
+    Dlelem* elt = NULL;
+
+    (void)LWLockAcquire(GlobalCatCachePartitionLock(GlobalCatCachePartitionId(hashValue)), LW_SHARED);
+    for (elt = DLGetHead(&part->buckets[GlobalCatCacheBucketId(hashValue)]); elt; elt = DLGetSucc(elt)) {
+        GlobalCatCTup* gct = (GlobalCatCTup*)DLE_VAL(elt);
+
+        if (gct->hash_value != hashValue || gct->cache_id != cache->id || gct->dbid != dbid)
+            continue;
+        if (!CatalogCacheCompareTuple(cache, nkeys, gct->keys, arguments))
+            continue;
+
+        /* the entry cannot be freed while we hold the partition lock */
+        (void)gs_atomic_add_32(&gct->refcount, 1);
+        LWLockRelease(GlobalCatCachePartitionLock(GlobalCatCachePartitionId(hashValue)));
+        return gct;
+    }
+    *invalCount = part->inval_count;
+    LWLockRelease(GlobalCatCachePartitionLock(GlobalCatCachePartitionId(hashValue)));
+
+    return NULL;
+}
+
+/*
+ * GlobalCatCacheInsert
+ *
+ * Publish a tuple fetched from the catalog and return the global entry holding
+ * it, with one reference for the caller.  NULL is returned when the partition
+ * was invalidated since invalCount was sampled, or when the cache is full; the
+ * caller then keeps a private copy as usual.
+ */
+static GlobalCatCTup* GlobalCatCacheInsert(CatCache* cache, HeapTuple ntp, uint32 hashValue, uint64 invalCount)
+{
+    GlobalCatCacheHeader* header = g_instance.cache_cxt.global_catcache;
+    uint32 partId = GlobalCatCachePartitionId(hashValue);
+    GlobalCatCachePartition* part = &header->partitions[partId];
+    Dllist* bucket = &part->buckets[GlobalCatCacheBucketId(hashValue)];
+    int64 limit = (int64)g_instance.attr.attr_memory.global_syscache_threshold * 1024L;
+    GlobalCatCTup* gct = NULL;
+    HeapTuple dtp;
+    Dlelem* elt = NULL;
+    errno_t rc;
+
+    /* cheap check first, the charge below is what really enforces the limit */
+    if (header->total_size >= limit)
+        return NULL;
+
+    if (HeapTupleHasExternal(ntp))
+        dtp = toast_flatten_tuple(ntp, cache->cc_tupdesc);
+    else
+        dtp = ntp;
+
+    /* build the entry before taking the lock, the shared context does its own locking */
+    gct = (GlobalCatCTup*)MemoryContextAlloc(part->context, sizeof(GlobalCatCTup) + MAXIMUM_ALIGNOF + dtp->t_len);
+    gct->size = (int64)(sizeof(GlobalCatCTup) + MAXIMUM_ALIGNOF + dtp->t_len);
+    gct->cache_id = cache->id;
+    gct->reloid = cache->cc_reloid;
+    gct->dbid = GlobalCatCacheDatabaseId(cache);
+    gct->hash_value = hashValue;
+    gct->refcount = 1;
+    gct->dead = false;
+    gct->tuple = *dtp;
+    gct->tuple.t_data = (HeapTupleHeader)MAXALIGN(((char*)gct) + sizeof(GlobalCatCTup));
+    rc = memcpy_s((char*)gct->tuple.t_data, dtp->t_len, (const char*)dtp->t_data, dtp->t_len);
+    securec_check(rc, "", "");
+    if (dtp != ntp)
+        heap_freetuple_ext(dtp);
+
+    for (int i = 0; i < cache->cc_nkeys; i++) {
+        bool isnull = false;
+
+        gct->keys[i] = heap_getattr(&gct->tuple, cache->cc_keyno[i], cache->cc_tupdesc, &isnull);
+        Assert(!isnull);
+    }
+    DLInitElem(&gct->cache_elem, (void*)gct);
+
+    (void)LWLockAcquire(GlobalCatCachePartitionLock(partId), LW_EXCLUSIVE);
+    if (part->inval_count != invalCount) {
+        LWLockRelease(GlobalCatCachePartitionLock(partId));
+        pfree(gct);
+        return NULL;
+    }
+
+    /* another session may have published the same tuple meanwhile */
+    for (elt = DLGetHead(bucket); elt; elt = DLGetSucc(elt)) {
+        GlobalCatCTup* other = (GlobalCatCTup*)DLE_VAL(elt);
+
+        if (other->hash_value != hashValue || other->cache_id != gct->cache_id || other->dbid != gct->dbid)
+            continue;
+        if (!CatalogCacheCompareTuple(cache, cache->cc_nkeys, other->keys, gct->keys))
+            continue;
+
+        (void)gs_atomic_add_32(&other->refcount, 1);
+        LWLockRelease(GlobalCatCachePartitionLock(partId));
+        pfree(gct);
+        return other;
+    }
+
+    if (gs_atomic_add_64(&header->total_size, gct->size) > limit) {
+        (void)gs_atomic_add_64(&header->total_size, -gct->size);
+        LWLockRelease(GlobalCatCachePartitionLock(partId));
+        pfree(gct);
+        return NULL;
+    }
+    DLAddHead(bucket, &gct->cache_elem);
+    LWLockRelease(GlobalCatCachePartitionLock(partId));
+
+    return gct;
+}
+
+/*
+ * GlobalCatCacheRelease
+ *
+ * Drop a session reference to a global entry, freeing it if it was already
+ * invalidated and this was the last reference.
+ */
+static void GlobalCatCacheRelease(GlobalCatCTup* gct)
+{
+    uint32 partId = GlobalCatCachePartitionId(gct->hash_value);
+
+    (void)LWLockAcquire(GlobalCatCachePartitionLock(partId), LW_EXCLUSIVE);
+    Assert(gct->refcount > 0);
+    if (gs_atomic_add_32(&gct->refcount, -1) == 0 && gct->dead) {
+        LWLockRelease(GlobalCatCachePartitionLock(partId));
+        GlobalCatCacheFreeEntry(gct);
+        return;
+    }
+    LWLockRelease(GlobalCatCachePartitionLock(partId));
+}
+
+/*
+ * Unlink the entry from its bucket; it is freed now if no session uses it,
+ * otherwise by the last GlobalCatCacheRelease.  Caller holds the partition
+ * lock exclusively.
+ */
+static void GlobalCatCacheRemoveEntry(GlobalCatCTup* gct)
+{
+    DLRemove(&gct->cache_elem);
+    gct->dead = true;
+    if (gct->refcount == 0)
+        GlobalCatCacheFreeEntry(gct);
+}
+
+/*
+ * Invalidate the global entries of one partition matching the given cache id
+ * and hash value, or all the entries of the given catalog when reloid is valid.
+ */
+static void GlobalCatCacheInvalidatePartition(uint32 partId, int cacheId, uint32 hashValue, Oid reloid)
+{
+    GlobalCatCachePartition* part = &g_instance.cache_cxt.global_catcache->partitions[partId];
+
+    (void)LWLockAcquire(GlobalCatCachePartitionLock(partId), LW_EXCLUSIVE);
+    part->inval_count++;
+    if (OidIsValid(reloid)) {
+        for (int i = 0; i < GLOBAL_CATCACHE_BUCKETS; i++) {
+            Dlelem* nextelt = NULL;
+
+            for (Dlelem* elt = DLGetHead(&part->buckets[i]); elt; elt = nextelt) {
+                GlobalCatCTup* gct = (GlobalCatCTup*)DLE_VAL(elt);
+
+                nextelt = DLGetSucc(elt);
+                if (gct->reloid == reloid)
+                    GlobalCatCacheRemoveEntry(gct);
+            }
+        }
+    } else {
+        Dlelem* nextelt = NULL;
+
+        /* the database of the message is ignored, a spurious drop is harmless */
+        for (Dlelem* elt = DLGetHead(&part->buckets[GlobalCatCacheBucketId(hashValue)]); elt; elt = nextelt) {
+            GlobalCatCTup* gct = (GlobalCatCTup*)DLE_VAL(elt);
+
+            nextelt = DLGetSucc(elt);
+            if (gct->hash_value == hashValue && gct->cache_id == cacheId)
+                GlobalCatCacheRemoveEntry(gct);
+        }
+    }
+    LWLockRelease(GlobalCatCachePartitionLock(partId));
+}
+
+/*
+ * Build a session CatCTup on top of a global entry; the caller's reference to
+ * the global entry is transferred to the new CatCTup.
+ */
+static CatCTup* CatalogCacheCreateEntryFromGlobal(CatCache* cache, GlobalCatCTup* gct, Index hashIndex)
+{
+    CatCTup* ct = NULL;
+
+    ct = (CatCTup*)MemoryContextAlloc(u_sess->cache_mem_cxt, sizeof(CatCTup));
+    ct->tuple = gct->tuple;
+    errno_t rc = memcpy_s(ct->keys, sizeof(ct->keys), gct->keys, sizeof(gct->keys));
+    securec_check(rc, "", "");
+
+    ct->ct_magic = CT_MAGIC;
+    ct->my_cache = cache;
+    DLInitElem(&ct->cache_elem, (void*)ct);
+    ct->c_list = NULL;
+    ct->refcount = 0;
+    ct->dead = false;
+    ct->isnailed = false;
+    ct->negative = false;
+    ct->hash_value = gct->hash_value;
+    ct->global_ct = gct;
+
+    DLAddHead(&cache->cc_bucket[hashIndex], &ct->cache_elem);
+
+    cache->cc_ntup++;
+    u_sess->cache_cxt.cache_header->ch_ntup++;
+
+    return ct;
+}
+
 /*
  *	CatalogCacheIdInvalidate
  *
@@ -800,6 +1103,114 @@ void CatalogCacheFlushCatalog(Oid catId)
     CACHE1_elog(DEBUG2, "end of CatalogCacheFlushCatalog call");
 }
 
+/*
+ *		GlobalCatCacheInit
+ *
+ *	Create the global catalog cache, called once by the postmaster when
+ *	enable_global_syscache and the thread pool are both on.
+ */
+void GlobalCatCacheInit(void)
+{
+    GlobalCatCacheHeader* header = NULL;
+
+    header = (GlobalCatCacheHeader*)MemoryContextAllocZero(
+        g_instance.cache_cxt.global_cache_mem, sizeof(GlobalCatCacheHeader));
+    for (int i = 0; i < NUM_GLOBAL_CATCACHE_PARTITIONS; i++) {
+        /*
+         * One context per partition, so that sessions filling different
+         * partitions do not all serialize on the same shared allocator.
+         */
+        header->partitions[i].context = AllocSetContextCreate(g_instance.cache_cxt.global_cache_mem,
+            "GlobalCatCachePartition",
+            ALLOCSET_DEFAULT_MINSIZE,
+            ALLOCSET_DEFAULT_INITSIZE,
+            ALLOCSET_DEFAULT_MAXSIZE,
+            SHARED_CONTEXT);
+    }
+
+    g_instance.cache_cxt.global_catcache = header;
+}
+
+/*
+ *		GlobalCatCacheInvalidateMessages
+ *
+ *	Apply the catcache and catalog invalidation messages to the global
+ *	catalog cache.  Called by SendSharedInvalidMessages before the messages
+ *	are queued for the sessions.
+ */
+void GlobalCatCacheInvalidateMessages(const SharedInvalidationMessage* msgs, int n)
+{
+    if (!ENABLE_GLOBAL_SYSCACHE)
+        return;
+
+    for (int i = 0; i < n; i++) {
+        const SharedInvalidationMessage* msg = &msgs[i];
+
+        if (msg->id >= 0) {
+            GlobalCatCacheInvalidatePartition(
+                GlobalCatCachePartitionId(msg->cc.hashValue), msg->cc.id, msg->cc.hashValue, InvalidOid);
+        } else if (msg->id == SHAREDINVALCATALOG_ID) {
+            for (uint32 partId = 0; partId < NUM_GLOBAL_CATCACHE_PARTITIONS; partId++)
+                GlobalCatCacheInvalidatePartition(partId, 0, 0, msg->cat.catId);
+        }
+    }
+}
+
+/*
+ *		GlobalCatCacheResetAll
+ *
+ *	Drop every global entry.  Used when the postmaster reinitializes after a
+ *	crash or a demotion: invalidations of transactions that committed just
+ *	before may never have been sent, and no session survives to release its
+ *	references.  The postmaster calls it before resetting shared memory.
+ */
+void GlobalCatCacheResetAll(void)
+{
+    GlobalCatCacheHeader* header = g_instance.cache_cxt.global_catcache;
+
+    if (header == NULL)
+        return;
+
+    for (uint32 partId = 0; partId < NUM_GLOBAL_CATCACHE_PARTITIONS; partId++) {
+        GlobalCatCachePartition* part = &header->partitions[partId];
+
+        /* no other thread is running, so the partition locks are not needed */
+        part->inval_count++;
+        for (int i = 0; i < GLOBAL_CATCACHE_BUCKETS; i++)
+            DLInitList(&part->buckets[i]);
+        MemoryContextReset(part->context);
+    }
+    header->total_size = 0;
+}
+
+/*
+ *		ReleaseCatCacheGlobalRefs
+ *
+ *	Give back the global entries used by the session catcache.  Called when a
+ *	thread pool session is freed, since its catcache memory goes away without
+ *	the entries being removed one by one.
+ */
+void ReleaseCatCacheGlobalRefs(void)
+{
+    CatCache* cache = NULL;
+
+    if (!ENABLE_GLOBAL_SYSCACHE || u_sess->cache_cxt.cache_header == NULL)
+        return;
+
+    for (cache = u_sess->cache_cxt.cache_header->ch_caches; cache; cache = cache->cc_next) {
+        for (int i = 0; i < cache->cc_nbuckets; i++) {
+            for (Dlelem* elt = DLGetHead(&cache->cc_bucket[i]); elt; elt = DLGetSucc(elt)) {
+                CatCTup* ct = (CatCTup*)DLE_VAL(elt);
+
+                if (ct->global_ct != NULL) {
+                    GlobalCatCacheRelease(ct->global_ct);
+                    ct->global_ct = NULL;
+                }
+            }
+        }
+    }
+}
+
 /*
  *		InitCatCache
  *
@@ -1507,6 +1918,8 @@ static HeapTuple SearchCatCacheMiss(
     CatCTup* ct = NULL;
     Datum arguments[CATCACHE_MAXKEYS];
     errno_t rc = EOK;
+    bool useGlobal = false;
+    uint64 invalCount = 0;
 
     /* Initialize local parameter array */
     arguments[0] = v1;
@@ -1569,6 +1982,19 @@ static HeapTuple SearchCatCacheMiss(
      * This case is rare enough that it's not worth expending extra cycles to
      * detect.
      */
+    useGlobal = (ct == NULL && GlobalCatCacheUsable());
+    if (useGlobal) {
+        GlobalCatCTup* gct = GlobalCatCacheSearch(cache, nkeys, hashValue, arguments, &invalCount);
+
+        if (gct != NULL) {
+            CACHE2_elog(DEBUG2, "SearchCatCacheMiss(%d): found in global catcache", cache->id);
+            ct = CatalogCacheCreateEntryFromGlobal(cache, gct, hashIndex);
+            ResourceOwnerEnlargeCatCacheRefs(t_thrd.utils_cxt.CurrentResourceOwner);
+            ct->refcount++;
+            ResourceOwnerRememberCatCacheRef(t_thrd.utils_cxt.CurrentResourceOwner, &ct->tuple);
+        }
+    }
+
     if (ct == NULL) {
         relation = heap_open(cache->cc_reloid, AccessShareLock);
 
@@ -1578,7 +2004,12 @@ static HeapTuple SearchCatCacheMiss(
             relation, cache->cc_indexoid, IndexScanOK(cache, cur_skey), SnapshotNow, nkeys, cur_skey);
 
         while (HeapTupleIsValid(ntp = systable_getnext(scandesc))) {
-            ct = CatalogCacheCreateEntry(cache, ntp, arguments, hashValue, hashIndex, false);
+            GlobalCatCTup* gct = useGlobal ? GlobalCatCacheInsert(cache, ntp, hashValue, invalCount) : NULL;
+
+            if (gct != NULL)
+                ct = CatalogCacheCreateEntryFromGlobal(cache, gct, hashIndex);
+            else
+                ct = CatalogCacheCreateEntry(cache, ntp, arguments, hashValue, hashIndex, false);
             /* immediately set the refcount to 1 */
             ResourceOwnerEnlargeCatCacheRefs(t_thrd.utils_cxt.CurrentResourceOwner);
             ct->refcount++;
@@ -2735,6 +3166,7 @@ static CatCTup* CatalogCacheCreateEntry(
     ct->isnailed = isnailed;
     ct->negative = negative;
     ct->hash_value = hashValue;
+    ct->global_ct = NULL;
 
     DLAddHead(&cache->cc_bucket[hashIndex], &ct->cache_elem);
 
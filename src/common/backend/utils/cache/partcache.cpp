@@ -23,6 +23,7 @@
 #include "postgres.h"
 #include "knl/knl_variable.h"
 #include <sys/file.h>
+#include "access/hio.h"
 #include "access/reloptions.h"
 #include "access/sysattr.h"
 #include "access/transam.h"
@@ -1287,6 +1288,11 @@ void releaseDummyRelation(Relation* relation)
         ResourceOwnerForgetFakerelRef(t_thrd.utils_cxt.CurrentResourceOwner, *relation);
     }
 
+    /* the SmgrRelation outlives us, give its run of pre-extended blocks to the FSM first */
+    if (RelationHasBulkExtendBlock(*relation) && IsTransactionState()) {
+        RelationReleaseBulkExtendBlocks(*relation, InvalidBlockNumber);
+    }
+
     /*detach the binding between Relation and SmgrRelation*/
     if ((*relation)->rd_smgr != NULL) {
         /* put SmgrRelation object into unowned list */
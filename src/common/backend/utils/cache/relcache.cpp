@@ -173,6 +173,7 @@
 #include "utils/snapmgr.h"
 #include "utils/syscache.h"
 #include "access/heapam.h"
+#include "access/hio.h"
 #include "utils/partitionmap.h"
 #include "utils/partitionmap_gs.h"
 #include "utils/resowner.h"
@@ -2975,7 +2976,9 @@ void RelationDecrementReferenceCount(Oid relationId)
 /*
  * RelationClose - close an open relation
  *
- *	Actually, we just decrement the refcount.
+ *	Actually, we just decrement the refcount.  When the last reference goes
+ *	away, the pages left in this backend's run of pre-extended heap blocks
+ *	are handed to the FSM, so they aren't lost until the next vacuum.
  *
  *	NOTE: if compiled with -DRELCACHE_FORCE_RELEASE then relcache entries
  *	will be freed as soon as their refcount goes to zero.  In combination
@@ -2988,6 +2991,11 @@ void RelationClose(Relation relation)
     /* Note: no locking manipulations needed */
     RelationDecrementReferenceCount(relation);
 
+    /* FSM I/O is not safe while aborting, such runs are left to vacuum */
+    if (RelationHasReferenceCountZero(relation) && RelationHasBulkExtendBlock(relation) && IsTransactionState()) {
+        RelationReleaseBulkExtendBlocks(relation, InvalidBlockNumber);
+    }
+
 #ifdef RELCACHE_FORCE_RELEASE
     if (RelationHasReferenceCountZero(relation) && relation->rd_createSubid == InvalidSubTransactionId &&
         relation->rd_newRelfilenodeSubid == InvalidSubTransactionId)
@@ -98,6 +98,7 @@
 #include "libpq/sha2.h"
 #include "optimizer/planner.h"
 #include "optimizer/streamplan.h"
+#include "postmaster/aiocompleter.h"
 #include "postmaster/alarmchecker.h"
 #include "postmaster/autovacuum.h"
 #include "postmaster/bgwriter.h"
@@ -943,6 +944,29 @@ static const struct config_enum_entry plan_cache_mode_options[] = {
 static const struct config_enum_entry cstore_insert_mode_options[] = {
     {"auto", TO_AUTO, true}, {"main", TO_MAIN, true}, {"delta", TO_DELTA, true}, {NULL, 0, false}};
 
+/*
+ * eviction policy of the column store data cache
+ */
+static const struct config_enum_entry cstore_cache_policy_options[] = {
+    {"clock", CACHE_POLICY_CLOCK, false}, {"2q", CACHE_POLICY_2Q, false}, {NULL, 0, false}};
+
+/*
+ * kernel interface of the adio requests
+ */
+static const struct config_enum_entry adio_io_engine_options[] = {
+    {"libaio", AioEngineLibaio, false},
+    {"io_uring", AioEngineIoUring, false},
+    {"io_uring_sqpoll", AioEngineIoUringSqpoll, false},
+    {NULL, 0, false}};
+
+/*
+ * torn page protection under incremental checkpoint
+ */
+static const struct config_enum_entry torn_page_protection_options[] = {
+    {"double_write", TORN_PAGE_DOUBLE_WRITE, false},
+    {"full_page_write", TORN_PAGE_FULL_PAGE_WRITE, false},
+    {NULL, 0, false}};
+
 static const struct config_enum_entry rewrite_options[] = {
     {"none", NO_REWRITE, false},
     {"lazyagg", LAZY_AGG, false},
@@ -2831,6 +2855,17 @@ static void InitConfigureNamesBool()
             NULL,
             NULL},
 
+        {{"enable_global_syscache",
+             PGC_POSTMASTER,
+             CLIENT_CONN,
+             gettext_noop("Share catalog cache tuples among thread pool sessions."),
+             NULL},
+            &g_instance.attr.attr_common.enable_global_syscache,
+            false,
+            NULL,
+            NULL,
+            NULL},
+
         {{"enable_router", PGC_SIGHUP, CLIENT_CONN, gettext_noop("enable to use router."),
              NULL},
             &u_sess->attr.attr_common.enable_router,
@@ -3998,6 +4033,20 @@ static void InitConfigureNamesInt()
             NULL,
             NULL},
 
+        {{"global_syscache_threshold",
+             PGC_POSTMASTER,
+             RESOURCES_MEM,
+             gettext_noop("Sets the maximum memory used by the global catalog cache."),
+             NULL,
+             GUC_UNIT_KB},
+            &g_instance.attr.attr_memory.global_syscache_threshold,
+            512 * 1024,
+            16 * 1024,
+            1024 * 1024 * 1024,
+            NULL,
+            NULL,
+            NULL},
+
         {{"session_statistics_memory",
              PGC_SIGHUP,
              RESOURCES_MEM,
@@ -4740,6 +4789,32 @@ static void InitConfigureNamesInt()
             NULL,
             NULL},
 
+        {{"relsize_cache_entries",
+             PGC_POSTMASTER,
+             RESOURCES_KERNEL,
+             gettext_noop("Sets the number of relation forks whose size is cached in shared memory."),
+             gettext_noop("Zero disables the cache, then every size check seeks to the end of the files.")},
+            &g_instance.attr.attr_storage.relsize_cache_entries,
+            65536,
+            0,
+            INT_MAX / 2,
+            NULL,
+            NULL,
+            NULL},
+
+        {{"fsm_target_cache_entries",
+             PGC_POSTMASTER,
+             RESOURCES_KERNEL,
+             gettext_noop("Sets the number of relations whose insert target pages are cached in shared memory."),
+             gettext_noop("Zero disables the cache, then every inserter searches the free space map itself.")},
+            &g_instance.attr.attr_storage.fsm_target_cache_entries,
+            4096,
+            0,
+            1048576,
+            NULL,
+            NULL,
+            NULL},
+
         {{"max_pred_locks_per_transaction",
              PGC_POSTMASTER,
              LOCK_MANAGEMENT,
@@ -8624,6 +8699,47 @@ static void InitConfigureNamesEnum()
             NULL},
 
 #endif
+        {{"cstore_cache_policy",
+             PGC_POSTMASTER,
+             RESOURCES_MEM,
+             gettext_noop("Sets the eviction policy of the CStore buffers."),
+             gettext_noop("2q keeps blocks referenced more than once in a protected segment, "
+                          "so that large sequential scans do not flush them.")},
+            &g_instance.attr.attr_storage.cstore_cache_policy,
+            CACHE_POLICY_CLOCK,
+            cstore_cache_policy_options,
+            NULL,
+            NULL,
+            NULL},
+
+        {{"adio_io_engine",
+             PGC_POSTMASTER,
+             DEVELOPER_OPTIONS,
+             gettext_noop("Sets the kernel interface used by the adio function."),
+             gettext_noop("The adio function stays off with libaio. io_uring and io_uring_sqpoll turn it on "
+                          "when the kernel supports io_uring.")},
+            &g_instance.attr.attr_storage.adio_io_engine,
+            AioEngineLibaio,
+            adio_io_engine_options,
+            NULL,
+            NULL,
+            NULL},
+
+        {{"torn_page_protection",
+             PGC_POSTMASTER,
+             WAL_CHECKPOINTS,
+             gettext_noop("Sets how incremental checkpoint protects data pages against partial writes."),
+             gettext_noop("full_page_write writes full page images to WAL instead of going "
+                          "through the double write files. It needs full_page_writes on, otherwise "
+                          "double_write is used, and it makes every checkpoint a full checkpoint, "
+                          "so incremental checkpoints are not taken.")},
+            &g_instance.attr.attr_storage.torn_page_protection,
+            TORN_PAGE_DOUBLE_WRITE,
+            torn_page_protection_options,
+            NULL,
+            NULL,
+            NULL},
+
         {{"backslash_quote",
              PGC_USERSET,
              COMPAT_OPTIONS_PREVIOUS,
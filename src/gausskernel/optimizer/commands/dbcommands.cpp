@@ -1000,6 +1000,9 @@ void dropdb(const char* dbname, bool missing_ok)
      */
     ForgetDatabaseFsyncRequests(db_id);
 
+    /* Drop any cached relation sizes for the database */
+    RelSizeCacheForgetDatabase(db_id);
+
     /*
      * Force a checkpoint to make sure the checkpointer has received the
      * message sent by ForgetDatabaseFsyncRequests. On Windows, this also
@@ -1463,6 +1466,7 @@ static void movedb_success_callback(Oid db_id, Oid src_tblspcoid)
     if (!rmtree(src_dbpath, true))
         ereport(
             WARNING, (errmsg("some useless files may be left behind in old database directory \"%s\"", src_dbpath)));
+    RelSizeCacheForgetDatabase(db_id);
 
     /*
      * Record the filesystem change in XLOG
@@ -2216,6 +2220,9 @@ void xlog_db_drop(Oid dbId, Oid tbSpcId)
     /* Also, clean out any fsync requests that might be pending in md.c */
     ForgetDatabaseFsyncRequests(dbId);
 
+    /* And any cached relation sizes */
+    RelSizeCacheForgetDatabase(dbId);
+
     /* Clean out the xlog relcache too */
     XLogDropDatabase(dbId);
 
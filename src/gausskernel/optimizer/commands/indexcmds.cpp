@@ -720,12 +720,22 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
     }
     accessMethodId = HeapTupleGetOid(tuple);
     accessMethodForm = (Form_pg_am)GETSTRUCT(tuple);
+#ifdef ENABLE_MOT
+    /* MOT builds its own hash index, which supports unique and multicolumn keys */
+    bool isMOTHashIndex = (accessMethodId == HASH_AM_OID && isMOTFromTblOid(RelationGetRelid(rel)));
+    if (stmt->unique && !accessMethodForm->amcanunique && !isMOTHashIndex)
+#else
     if (stmt->unique && !accessMethodForm->amcanunique)
+#endif
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support unique indexes", accessMethodName)));
 
+#ifdef ENABLE_MOT
+    if (numberOfAttributes > 1 && !accessMethodForm->amcanmulticol && !isMOTHashIndex)
+#else
     if (numberOfAttributes > 1 && !accessMethodForm->amcanmulticol)
+#endif
         ereport(ERROR,
             (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
                 errmsg("access method \"%s\" does not support multicolumn indexes", accessMethodName)));
@@ -464,15 +464,14 @@ char* get_nsp_relname(Oid relid)
     char* relname = get_rel_name(relid);
 
     if (relname != NULL) {
+        char* nspname = get_namespace_name(get_rel_namespace(relid));
+
         nsp_relname = (char*)palloc(NAMEDATALEN * 2);
-        errno_t rc = snprintf_s(nsp_relname,
-            NAMEDATALEN * 2,
-            NAMEDATALEN * 2 - 1,
-            "%s.%s",
-            get_namespace_name(get_rel_namespace(relid)),
-            relname);
+        errno_t rc = snprintf_s(nsp_relname, NAMEDATALEN * 2, NAMEDATALEN * 2 - 1, "%s.%s", nspname, relname);
         securec_check_ss(rc, "\0", "\0");
 
+        if (nspname != NULL)
+            pfree(nspname);
         pfree(relname);
         relname = NULL;
     }
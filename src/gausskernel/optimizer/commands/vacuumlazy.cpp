@@ -4,24 +4,25 @@
  *	  Concurrent ("lazy") vacuuming.
  *
  *
- * The major space usage for LAZY VACUUM is storage for the array of dead
- * tuple TIDs, with the next biggest need being storage for per-disk-page
- * free space info.  We want to ensure we can vacuum even the very largest
- * relations with finite memory space usage.  To do that, we set upper bounds
- * on the number of tuples and pages we will keep track of at once.
+ * The major space usage for LAZY VACUUM is storage for the dead tuple TIDs,
+ * with the next biggest need being storage for per-disk-page free space info.
+ * We want to ensure we can vacuum even the very largest relations with finite
+ * memory space usage.  To do that, we set upper bounds on the number of tuples
+ * and pages we will keep track of at once.
  *
  * We are willing to use at most maintenance_work_mem memory space to keep
- * track of dead tuples.  We initially allocate an array of TIDs of that size,
- * with an upper limit that depends on table size (this limit ensures we don't
- * allocate a huge area uselessly for vacuuming small tables).	If the array
- * threatens to overflow, we suspend the heap scan phase and perform a pass of
- * index cleanup and page compaction, then resume the heap scan with an empty
- * TID array.
+ * track of dead tuples.  They are stored per heap page, as a bitmap of the
+ * dead offsets, and a two-level radix tree maps a block number to its page;
+ * the arrays grow on demand, so small tables don't allocate a huge area
+ * uselessly.  Everything allocated, spare array slots and the radix tree
+ * included, counts against the limit.  If the store threatens to overflow,
+ * we suspend the heap scan phase and perform a pass of index cleanup and page
+ * compaction, then resume the heap scan with an empty store.
  *
  * If we're processing a table with no indexes, we can just vacuum each page
  * as we go; there's no need to save up multiple tuples to minimize the number
  * of index scans performed.  So we don't use maintenance_work_mem memory for
- * the TID array, just enough to hold as many heap tuples as fit on one page.
+ * the store, just enough to hold the dead tuples of one page.
  *
  *
  * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
@@ -75,11 +76,21 @@
 #endif
 
 /*
- * Guesstimation of number of dead tuples per page.  This is used to
- * provide an upper limit to memory allocated when vacuuming small
- * tables.
+ * Dead tuple store: the offsets of a page are kept in 32-bit words, either as
+ * a bitmap or, when that takes fewer words, as a sorted array of offset
+ * numbers packed two to a word.  Each leaf of the radix tree maps
+ * LAZY_DEAD_MAP_LEAF_BLOCKS consecutive blocks to their dead page (index + 1,
+ * zero meaning no dead tuple on the block).
  */
-#define LAZY_ALLOC_TUPLES MaxHeapTuplesPerPage
+#define LAZY_DEAD_WORD_BITS 32
+#define LAZY_DEAD_OFFSETS_PER_WORD ((int)(sizeof(uint32) / sizeof(OffsetNumber)))
+#define LAZY_DEAD_WORDS_PER_PAGE ((MaxHeapTuplesPerPage + LAZY_DEAD_WORD_BITS - 1) / LAZY_DEAD_WORD_BITS)
+#define LAZY_DEAD_MAP_LEAF_SHIFT 10
+#define LAZY_DEAD_MAP_LEAF_BLOCKS (1 << LAZY_DEAD_MAP_LEAF_SHIFT)
+#define LAZY_DEAD_MAP_LEAF_SIZE (LAZY_DEAD_MAP_LEAF_BLOCKS * sizeof(uint32))
+/* the most the store can grow by while one heap page is scanned */
+#define LAZY_DEAD_PAGE_MAX_SPACE \
+    (sizeof(LVDeadPage) + LAZY_DEAD_WORDS_PER_PAGE * sizeof(uint32) + LAZY_DEAD_MAP_LEAF_SIZE)
 
 /*
  * Before we consider skipping a page that's marked as clean in
@@ -88,6 +99,15 @@
 #define SKIP_PAGES_THRESHOLD ((BlockNumber)32)
 
 #define CHANGE_XID_BASE (MaxShortTransactionId * 0.1)
+
+/* heap page with dead tuples, its offsets are kept in dead_words */
+typedef struct LVDeadPage {
+    BlockNumber blkno;
+    int firstword; /* first word of the page in dead_words */
+    uint16 ndead;  /* # of dead offsets on the page */
+    bool bitmap;   /* offsets are bits rather than an OffsetNumber array */
+} LVDeadPage;
+
 typedef struct LVRelStats {
     /* hasindex = true means two-pass strategy; false means one-pass */
     bool hasindex;
@@ -101,11 +121,21 @@ typedef struct LVRelStats {
     BlockNumber pages_removed;
     double tuples_deleted;
     BlockNumber nonempty_pages; /* actually, last nonempty page + 1 */
-    /* List of TIDs of tuples we intend to delete */
-    /* NB: this list is ordered by TID address */
-    int num_dead_tuples;     /* current # of entries */
-    int max_dead_tuples;     /* # slots allocated in array */
-    ItemPointer dead_tuples; /* array of ItemPointerData */
+    /* TIDs of tuples we intend to delete, see lazy_record_dead_tuple */
+    /* NB: dead_pages is ordered by block number */
+    int num_dead_tuples;       /* current # of TIDs */
+    LVDeadPage* dead_pages;    /* pages having dead tuples */
+    int num_dead_pages;        /* current # of entries */
+    int max_dead_pages;        /* # slots allocated in dead_pages */
+    uint32* dead_words;        /* offsets of all the dead pages */
+    int num_dead_words;        /* current # of words */
+    int max_dead_words;        /* # words allocated in dead_words */
+    uint32** dead_page_map;    /* radix tree leaves mapping blocks to dead_pages */
+    int dead_map_leaves;       /* # of leaf slots in dead_page_map */
+    int dead_map_used;         /* # of leaves allocated */
+    Size dead_space_limit;     /* bytes the store may use */
+    int prefetch_pageindex;    /* first dead page not prefetched yet */
+    char** progress_relnames;  /* names of the indexes and then the heap, see lazy_report_progress */
     int num_index_scans;
     TransactionId latestRemovedXid;
     bool lock_waiter_detected;
@@ -141,15 +171,22 @@ static void lazy_scan_bucket(Relation onerel, LVRelStats* vacrelstats, VacuumStm
 static void lazy_scan_rel(Relation onerel, LVRelStats* vacrelstats, VacuumStmt* vacstmt, Relation* Irel, int nindexes,
     bool scan_all, double* deleteTupleNum);
 static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats);
+static void lazy_vacuum_all_indexes(
+    Relation onerel, Relation* Irel, int nindexes, IndexBulkDeleteResult** indstats, LVRelStats* vacrelstats);
+static void lazy_prefetch_heap_pass(Relation onerel, LVRelStats* vacrelstats, int visited_pages);
+static void lazy_report_progress(LVRelStats* vacrelstats, int relindex);
 static bool lazy_check_needs_freeze(Buffer buf);
 static void lazy_vacuum_index(Relation indrel, IndexBulkDeleteResult** stats, LVRelStats* vacrelstats);
 static IndexBulkDeleteResult* lazy_cleanup_index(
     Relation indrel, IndexBulkDeleteResult* stats, LVRelStats* vacrelstats);
-static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, int tupindex, LVRelStats* vacrelstats);
+static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, int pageindex, LVRelStats* vacrelstats);
 static void lazy_space_alloc(LVRelStats* vacrelstats, BlockNumber relblocks);
+static void lazy_space_free(LVRelStats* vacrelstats);
+static bool lazy_space_full(const LVRelStats* vacrelstats);
+static void lazy_reset_dead_tuples(LVRelStats* vacrelstats);
 static void lazy_record_dead_tuple(LVRelStats* vacrelstats, ItemPointer itemptr);
+static int lazy_dead_page_offsets(const LVRelStats* vacrelstats, int pageindex, OffsetNumber* offsets);
 static bool lazy_tid_reaped(ItemPointer itemptr, void* state, Oid partOid = InvalidOid);
-static int vac_cmp_itemptr(const void* left, const void* right);
 
 /*
  *	lazy_vacuum_rel() -- perform LAZY VACUUM for one heap relation
@@ -772,7 +809,7 @@ static void lazy_scan_bucket(Relation onerel, LVRelStats* vacrelstats, VacuumStm
             vacrelstats->lock_waiter_detected = true;
         }
         *deleteTupleNum += deleteTupletemp;
-		pfree_ext(vacbucketstats->dead_tuples);
+        lazy_space_free(vacbucketstats);
     }
 
     pfree_ext(ibuckRel);
@@ -824,6 +861,12 @@ static IndexBulkDeleteResult** lazy_scan_heap(
 
     indstats = (IndexBulkDeleteResult**)palloc0(nindexes * sizeof(IndexBulkDeleteResult*));
 
+    /* build the names reported while vacuum works on each relation once */
+    vacrelstats->progress_relnames = (char**)palloc0((nindexes + 1) * sizeof(char*));
+    for (i = 0; i < nindexes; i++)
+        vacrelstats->progress_relnames[i] = get_nsp_relname(RelationGetRelid(Irel[i]));
+    vacrelstats->progress_relnames[nindexes] = get_nsp_relname(RelationGetRelid(onerel));
+
     nblocks = RelationGetNumberOfBlocks(onerel);
     vacrelstats->rel_pages = nblocks;
     vacrelstats->scanned_pages = 0;
@@ -948,8 +991,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
          * If we are close to overrunning the available space for dead-tuple
          * TIDs, pause and do a cycle of vacuuming before we tackle this page.
          */
-        if ((vacrelstats->max_dead_tuples - vacrelstats->num_dead_tuples) < MaxHeapTuplesPerPage &&
-            vacrelstats->num_dead_tuples > 0) {
+        if (lazy_space_full(vacrelstats) && vacrelstats->num_dead_tuples > 0) {
             /*
              * Before beginning index vacuuming, we release any pin we may
              * hold on the visibility map page.  This isn't necessary for
@@ -961,12 +1003,8 @@ static IndexBulkDeleteResult** lazy_scan_heap(
                 vmbuffer = InvalidBuffer;
             }
 
-            /* Log cleanup info before we touch indexes */
-            vacuum_log_cleanup_info(onerel, vacrelstats);
-
             /* Remove index entries */
-            for (i = 0; i < nindexes; i++)
-                lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats);
+            lazy_vacuum_all_indexes(onerel, Irel, nindexes, indstats, vacrelstats);
             /* Remove tuples from heap */
             lazy_vacuum_heap(onerel, vacrelstats);
 
@@ -975,7 +1013,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
              * not to reset latestRemovedXid since we want that value to be
              * valid.
              */
-            vacrelstats->num_dead_tuples = 0;
+            lazy_reset_dead_tuples(vacrelstats);
             vacrelstats->num_index_scans++;
         }
 
@@ -1316,7 +1354,7 @@ static IndexBulkDeleteResult** lazy_scan_heap(
              * not to reset latestRemovedXid since we want that value to be
              * valid.
              */
-            vacrelstats->num_dead_tuples = 0;
+            lazy_reset_dead_tuples(vacrelstats);
             vacuumed_pages++;
         }
 
@@ -1414,12 +1452,8 @@ static IndexBulkDeleteResult** lazy_scan_heap(
     /* If any tuples need to be deleted, perform final vacuum cycle */
     /* XXX put a threshold on min number of tuples here? */
     if (vacrelstats->num_dead_tuples > 0) {
-        /* Log cleanup info before we touch indexes */
-        vacuum_log_cleanup_info(onerel, vacrelstats);
-
         /* Remove index entries */
-        for (i = 0; i < nindexes; i++)
-            lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats);
+        lazy_vacuum_all_indexes(onerel, Irel, nindexes, indstats, vacrelstats);
         /* Remove tuples from heap */
         lazy_vacuum_heap(onerel, vacrelstats);
         vacrelstats->num_index_scans++;
@@ -1431,8 +1465,11 @@ static IndexBulkDeleteResult** lazy_scan_heap(
         if (ENABLE_WORKLOAD_CONTROL)
             IOSchedulerAndUpdate(IO_TYPE_WRITE, 1, IO_TYPE_ROW);
 
+        lazy_report_progress(vacrelstats, i);
         indstats[i] = lazy_cleanup_index(Irel[i], indstats[i], vacrelstats);
     }
+    if (nindexes > 0)
+        lazy_report_progress(vacrelstats, nindexes);
 
     /* record vacuumed tuple for reporting to PgStatCollector */
     *ptrDeleteTupleNum = tups_vacuumed;
@@ -1460,10 +1497,69 @@ static IndexBulkDeleteResult** lazy_scan_heap(
                 nunused,
                 empty_pages,
                 pg_rusage_show(&ru0))));
+
+    for (i = 0; i <= nindexes; i++) {
+        if (vacrelstats->progress_relnames[i] != NULL)
+            pfree(vacrelstats->progress_relnames[i]);
+    }
+    pfree(vacrelstats->progress_relnames);
+    vacrelstats->progress_relnames = NULL;
+
     gstrace_exit(GS_TRC_ID_lazy_scan_heap);
     return indstats;
 }
 
+/*
+ *	lazy_vacuum_all_indexes() -- remove the index entries of the dead tuples
+ *
+ *		The indexes are scanned one after another, each reporting its name.
+ */
+static void lazy_vacuum_all_indexes(
+    Relation onerel, Relation* Irel, int nindexes, IndexBulkDeleteResult** indstats, LVRelStats* vacrelstats)
+{
+    /* Log cleanup info before we touch indexes */
+    vacuum_log_cleanup_info(onerel, vacrelstats);
+
+    for (int i = 0; i < nindexes; i++) {
+        lazy_report_progress(vacrelstats, i);
+        lazy_vacuum_index(Irel[i], &indstats[i], vacrelstats);
+    }
+    lazy_report_progress(vacrelstats, nindexes);
+}
+
+/*
+ *	lazy_prefetch_heap_pass() -- prefetch the heap pages of lazy_vacuum_heap
+ *
+ *		Keep target_prefetch_pages (effective_io_concurrency) pages with dead
+ *		tuples requested ahead of the visited_pages the heap pass has reached.
+ */
+static void lazy_prefetch_heap_pass(Relation onerel, LVRelStats* vacrelstats, int visited_pages)
+{
+#ifdef USE_PREFETCH
+    while (vacrelstats->prefetch_pageindex - visited_pages < u_sess->storage_cxt.target_prefetch_pages &&
+           vacrelstats->prefetch_pageindex < vacrelstats->num_dead_pages) {
+        PrefetchBuffer(onerel, MAIN_FORKNUM, vacrelstats->dead_pages[vacrelstats->prefetch_pageindex].blkno);
+        vacrelstats->prefetch_pageindex++;
+    }
+#endif
+}
+
+/*
+ *	lazy_report_progress() -- show which relation vacuum is working on
+ *
+ *		Reported through pg_thread_wait_status, so that a long index pass
+ *		can be told apart from the heap passes of the same table.  relindex
+ *		is the index number in Irel, or nindexes for the heap itself.
+ */
+static void lazy_report_progress(LVRelStats* vacrelstats, int relindex)
+{
+    char* relname = vacrelstats->progress_relnames[relindex];
+
+    /* the reported copy is freed by pgstat_report_waitstatus_relname */
+    if (relname != NULL && !IS_PGSTATE_TRACK_UNDEFINE)
+        (void)pgstat_report_waitstatus_relname(STATE_VACUUM, pstrdup(relname));
+}
+
 /*
  *	lazy_vacuum_heap() -- second pass over the heap
  *
@@ -1477,7 +1573,8 @@ static IndexBulkDeleteResult** lazy_scan_heap(
  */
 static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats)
 {
-    int tupindex;
+    int pageindex;
+    int ntuples;
     int npages;
     PGRUsage ru0;
 
@@ -1485,9 +1582,10 @@ static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats)
 
     pg_rusage_init(&ru0);
     npages = 0;
+    ntuples = 0;
+    vacrelstats->prefetch_pageindex = 0;
 
-    tupindex = 0;
-    while (tupindex < vacrelstats->num_dead_tuples) {
+    for (pageindex = 0; pageindex < vacrelstats->num_dead_pages; pageindex++) {
         BlockNumber tblk;
         Buffer buf;
         Page page;
@@ -1495,14 +1593,14 @@ static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats)
 
         vacuum_delay_point();
 
-        tblk = ItemPointerGetBlockNumber(&vacrelstats->dead_tuples[tupindex]);
+        tblk = vacrelstats->dead_pages[pageindex].blkno;
+        lazy_prefetch_heap_pass(onerel, vacrelstats, pageindex + 1);
         buf = ReadBufferExtended(onerel, MAIN_FORKNUM, tblk, RBM_NORMAL, vac_strategy);
         if (!ConditionalLockBufferForCleanup(buf)) {
             ReleaseBuffer(buf);
-            ++tupindex;
             continue;
         }
-        tupindex = lazy_vacuum_page(onerel, tblk, buf, tupindex, vacrelstats);
+        ntuples += lazy_vacuum_page(onerel, tblk, buf, pageindex, vacrelstats);
 
         /* Now that we've compacted the page, record its available space */
         page = BufferGetPage(buf);
@@ -1516,7 +1614,7 @@ static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats)
     ereport(LOG,
         (errmsg("vacuum %u/%u/%u, \"%s\": removed %d row versions in %d pages",
             onerel->rd_node.spcNode, onerel->rd_node.dbNode, onerel->rd_node.relNode,
-            RelationGetRelationName(onerel), tupindex, npages),
+            RelationGetRelationName(onerel), ntuples, npages),
             errdetail("%s.", pg_rusage_show(&ru0))));
     gstrace_exit(GS_TRC_ID_lazy_vacuum_heap);
 }
@@ -1527,30 +1625,25 @@ static void lazy_vacuum_heap(Relation onerel, LVRelStats* vacrelstats)
  *
  * Caller must hold pin and buffer cleanup lock on the buffer.
  *
- * tupindex is the index in vacrelstats->dead_tuples of the first dead
- * tuple for this page.  We assume the rest follow sequentially.
- * The return value is the first tupindex after the tuples of this page.
+ * pageindex is the index in vacrelstats->dead_pages of this page.
+ * The return value is the number of tuples freed.
  */
-static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, int tupindex, LVRelStats* vacrelstats)
+static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, int pageindex, LVRelStats* vacrelstats)
 {
     Page page = BufferGetPage(buffer);
     OffsetNumber unused[MaxOffsetNumber];
     int uncnt = 0;
 
+    Assert(vacrelstats->dead_pages[pageindex].blkno == blkno);
+
+    uncnt = lazy_dead_page_offsets(vacrelstats, pageindex, unused);
+
     START_CRIT_SECTION();
 
-    for (; tupindex < vacrelstats->num_dead_tuples; tupindex++) {
-        BlockNumber tblk;
-        OffsetNumber toff;
-        ItemId itemid;
+    for (int i = 0; i < uncnt; i++) {
+        ItemId itemid = PageGetItemId(page, unused[i]);
 
-        tblk = ItemPointerGetBlockNumber(&vacrelstats->dead_tuples[tupindex]);
-        if (tblk != blkno)
-            break; /* past end of tuples for this block */
-        toff = ItemPointerGetOffsetNumber(&vacrelstats->dead_tuples[tupindex]);
-        itemid = PageGetItemId(page, toff);
         ItemIdSetUnused(itemid);
-        unused[uncnt++] = toff;
     }
 
     PageRepairFragmentation(page);
@@ -1567,7 +1660,7 @@ static int lazy_vacuum_page(Relation onerel, BlockNumber blkno, Buffer buffer, i
 
     END_CRIT_SECTION();
 
-    return tupindex;
+    return uncnt;
 }
 
 /*
@@ -1608,8 +1701,8 @@ static bool lazy_check_needs_freeze(Buffer buf)
 /*
  *	lazy_vacuum_index() -- vacuum one index relation.
  *
- *		Delete all the index entries pointing to tuples listed in
- *		vacrelstats->dead_tuples, and update running statistics.
+ *		Delete all the index entries pointing to tuples recorded in
+ *		vacrelstats' dead tuple store, and update running statistics.
  */
 static void lazy_vacuum_index(Relation indrel, IndexBulkDeleteResult** stats, LVRelStats* vacrelstats)
 {
@@ -1681,86 +1774,350 @@ static IndexBulkDeleteResult* lazy_cleanup_index(Relation indrel, IndexBulkDelet
  */
 static void lazy_space_alloc(LVRelStats* vacrelstats, BlockNumber relblocks)
 {
-    unsigned long maxtuples;
+    Size limit;
+    Size map_size;
+
+    vacrelstats->dead_map_leaves = (int)(relblocks >> LAZY_DEAD_MAP_LEAF_SHIFT) + 1;
+    map_size = vacrelstats->dead_map_leaves * sizeof(uint32*);
 
     if (vacrelstats->hasindex) {
-        maxtuples = (u_sess->attr.attr_memory.maintenance_work_mem * 1024L) / sizeof(ItemPointerData);
-        maxtuples = Min(maxtuples, INT_MAX);
-        maxtuples = Min(maxtuples, (int)(MaxAllocSize / sizeof(ItemPointerData)));
-        /* curious coding here to ensure the multiplication can't overflow */
-        if ((BlockNumber)(maxtuples / LAZY_ALLOC_TUPLES) > relblocks)
-            maxtuples = relblocks * LAZY_ALLOC_TUPLES;
+        limit = (Size)u_sess->attr.attr_memory.maintenance_work_mem * 1024L;
+        limit = Min(limit, MaxAllocSize);
         /* stay sane if small maintenance_work_mem */
-        maxtuples = Max(maxtuples, MaxHeapTuplesPerPage);
+        limit = Max(limit, map_size + LAZY_DEAD_PAGE_MAX_SPACE);
     } else {
-        maxtuples = MaxHeapTuplesPerPage;
+        limit = map_size + LAZY_DEAD_PAGE_MAX_SPACE;
     }
 
+    vacrelstats->dead_space_limit = limit;
     vacrelstats->num_dead_tuples = 0;
-    vacrelstats->max_dead_tuples = (int)maxtuples;
-    vacrelstats->dead_tuples = (ItemPointer)palloc(maxtuples * sizeof(ItemPointerData));
+    vacrelstats->dead_pages = NULL;
+    vacrelstats->num_dead_pages = 0;
+    vacrelstats->max_dead_pages = 0;
+    vacrelstats->dead_words = NULL;
+    vacrelstats->num_dead_words = 0;
+    vacrelstats->max_dead_words = 0;
+    vacrelstats->dead_map_used = 0;
+    vacrelstats->dead_page_map = (uint32**)palloc0(map_size);
+    vacrelstats->prefetch_pageindex = 0;
+}
+
+/*
+ * lazy_space_free - release the dead tuple store
+ */
+static void lazy_space_free(LVRelStats* vacrelstats)
+{
+    lazy_reset_dead_tuples(vacrelstats);
+    pfree_ext(vacrelstats->dead_page_map);
+    pfree_ext(vacrelstats->dead_pages);
+    pfree_ext(vacrelstats->dead_words);
+    vacrelstats->max_dead_pages = 0;
+    vacrelstats->max_dead_words = 0;
+}
+
+/*
+ * lazy_space_allocated - bytes allocated by the store, spare slots included
+ */
+static Size lazy_space_allocated(const LVRelStats* vacrelstats)
+{
+    return vacrelstats->dead_map_leaves * sizeof(uint32*) + vacrelstats->dead_map_used * LAZY_DEAD_MAP_LEAF_SIZE +
+           vacrelstats->max_dead_pages * sizeof(LVDeadPage) + vacrelstats->max_dead_words * sizeof(uint32);
+}
+
+/*
+ * lazy_space_page_need - bytes the store must still allocate, beyond its
+ * spare slots, for the dead tuples of one more page at worst
+ */
+static Size lazy_space_page_need(const LVRelStats* vacrelstats)
+{
+    Size need = LAZY_DEAD_MAP_LEAF_SIZE;
+    int words = vacrelstats->num_dead_words + LAZY_DEAD_WORDS_PER_PAGE;
+
+    if (vacrelstats->num_dead_pages >= vacrelstats->max_dead_pages)
+        need += sizeof(LVDeadPage);
+    if (words > vacrelstats->max_dead_words)
+        need += (words - vacrelstats->max_dead_words) * sizeof(uint32);
+    return need;
+}
+
+/*
+ * lazy_space_full - could the dead tuples of one more page overflow the store?
+ */
+static bool lazy_space_full(const LVRelStats* vacrelstats)
+{
+    return lazy_space_allocated(vacrelstats) + lazy_space_page_need(vacrelstats) > vacrelstats->dead_space_limit;
+}
+
+/*
+ * lazy_space_grow - new size of a store array that must hold minslots
+ *
+ * The array doubles, but only as far as the limit allows once reserve bytes
+ * are set aside for the other arrays, so that the allocated size stays
+ * within the limit.
+ */
+static int lazy_space_grow(const LVRelStats* vacrelstats, int curslots, int minslots, int initslots, Size slotsize,
+    Size reserve)
+{
+    Size allocated = lazy_space_allocated(vacrelstats) + reserve;
+    Size spare = 0;
+    int newslots = Max(curslots * 2, initslots);
+
+    if (vacrelstats->dead_space_limit > allocated)
+        spare = (vacrelstats->dead_space_limit - allocated) / slotsize;
+    if ((Size)(newslots - curslots) > spare)
+        newslots = curslots + (int)spare;
+    return Max(newslots, minslots);
+}
+
+/*
+ * lazy_reset_dead_tuples - forget all the dead tuples, keeping the arrays
+ */
+static void lazy_reset_dead_tuples(LVRelStats* vacrelstats)
+{
+    if (vacrelstats->dead_map_used > 0) {
+        for (int i = 0; i < vacrelstats->dead_map_leaves; i++)
+            pfree_ext(vacrelstats->dead_page_map[i]);
+    }
+    vacrelstats->dead_map_used = 0;
+    vacrelstats->num_dead_tuples = 0;
+    vacrelstats->num_dead_pages = 0;
+    vacrelstats->num_dead_words = 0;
+    vacrelstats->prefetch_pageindex = 0;
+}
+
+/*
+ * lazy_dead_page_slot - radix tree slot of a block, NULL if not mapped
+ */
+static inline uint32* lazy_dead_page_slot(const LVRelStats* vacrelstats, BlockNumber blkno)
+{
+    uint32 leaf = blkno >> LAZY_DEAD_MAP_LEAF_SHIFT;
+
+    if (leaf >= (uint32)vacrelstats->dead_map_leaves || vacrelstats->dead_page_map[leaf] == NULL)
+        return NULL;
+    return &vacrelstats->dead_page_map[leaf][blkno & (LAZY_DEAD_MAP_LEAF_BLOCKS - 1)];
+}
+
+/*
+ * lazy_dead_words_extend - make the last dead page nwords words long,
+ * zeroing the words it gets
+ */
+static void lazy_dead_words_extend(LVRelStats* vacrelstats, int nwords)
+{
+    LVDeadPage* dpage = &vacrelstats->dead_pages[vacrelstats->num_dead_pages - 1];
+    int endword = dpage->firstword + nwords;
+
+    if (endword > vacrelstats->max_dead_words) {
+        int newmax = lazy_space_grow(vacrelstats, vacrelstats->max_dead_words, endword, 256, sizeof(uint32), 0);
+
+        if (vacrelstats->dead_words == NULL)
+            vacrelstats->dead_words = (uint32*)palloc(newmax * sizeof(uint32));
+        else
+            vacrelstats->dead_words = (uint32*)repalloc(vacrelstats->dead_words, newmax * sizeof(uint32));
+        vacrelstats->max_dead_words = newmax;
+    }
+    while (vacrelstats->num_dead_words < endword)
+        vacrelstats->dead_words[vacrelstats->num_dead_words++] = 0;
+}
+
+/*
+ * lazy_dead_page_offsets - fetch the dead offsets of a page in offset order
+ *
+ * Returns the number of offsets stored into offsets.
+ */
+static int lazy_dead_page_offsets(const LVRelStats* vacrelstats, int pageindex, OffsetNumber* offsets)
+{
+    const LVDeadPage* dpage = &vacrelstats->dead_pages[pageindex];
+    int endword;
+    int n = 0;
+
+    if (!dpage->bitmap) {
+        const OffsetNumber* array = (const OffsetNumber*)&vacrelstats->dead_words[dpage->firstword];
+
+        for (n = 0; n < dpage->ndead; n++)
+            offsets[n] = array[n];
+        return n;
+    }
+
+    endword = (pageindex + 1 < vacrelstats->num_dead_pages) ? dpage[1].firstword : vacrelstats->num_dead_words;
+    for (int word = dpage->firstword; word < endword; word++) {
+        uint32 bits = vacrelstats->dead_words[word];
+
+        while (bits != 0) {
+            offsets[n++] = (OffsetNumber)((word - dpage->firstword) * LAZY_DEAD_WORD_BITS + __builtin_ctz(bits) + 1);
+            bits &= bits - 1;
+        }
+    }
+    Assert(n == dpage->ndead);
+    return n;
 }
 
 /*
  * lazy_record_dead_tuple - remember one deletable tuple
+ *
+ * The heap is scanned in block order and each page in offset order, so a
+ * new page is appended whenever the block changes and its offsets only ever
+ * grow at the tail of dead_words.  The page is kept in whichever encoding
+ * takes fewer words for the offsets seen so far: a page with a few dead
+ * tuples needs a word for every two of them, while a bitmap needs a word for
+ * every 32 offsets up to the highest one.  Switching encodings rewrites the
+ * page's words.
  */
 static void lazy_record_dead_tuple(LVRelStats* vacrelstats, ItemPointer itemptr)
 {
-    /*
-     * The array shouldn't overflow under normal behavior, but perhaps it
-     * could if we are given a really small maintenance_work_mem. In that
-     * case, just forget the last few tuples (we'll get 'em next time).
-     */
-    if (vacrelstats->num_dead_tuples < vacrelstats->max_dead_tuples) {
-        vacrelstats->dead_tuples[vacrelstats->num_dead_tuples] = *itemptr;
-        vacrelstats->num_dead_tuples++;
+    BlockNumber blkno = ItemPointerGetBlockNumber(itemptr);
+    OffsetNumber offnum = ItemPointerGetOffsetNumber(itemptr);
+    int pageindex;
+    LVDeadPage* dpage = NULL;
+    int arraywords;
+    int bitmapwords;
+    bool bitmap = false;
+
+    if (vacrelstats->num_dead_pages > 0)
+        dpage = &vacrelstats->dead_pages[vacrelstats->num_dead_pages - 1];
+
+    if (dpage == NULL || dpage->blkno != blkno) {
+        uint32 leaf = blkno >> LAZY_DEAD_MAP_LEAF_SHIFT;
+
+        Assert(dpage == NULL || dpage->blkno < blkno);
+
+        /*
+         * The store shouldn't overflow since lazy_scan_heap checks it before
+         * each page, but the relation may have been extended meanwhile.  In
+         * that case, just forget the tuple (we'll get it next time).
+         */
+        if (leaf >= (uint32)vacrelstats->dead_map_leaves)
+            return;
+
+        if (vacrelstats->num_dead_pages >= vacrelstats->max_dead_pages) {
+            /* keep room for the offsets and the radix tree leaf of this page */
+            int words = vacrelstats->num_dead_words + LAZY_DEAD_WORDS_PER_PAGE - vacrelstats->max_dead_words;
+            Size reserve = (vacrelstats->dead_page_map[leaf] == NULL) ? LAZY_DEAD_MAP_LEAF_SIZE : 0;
+            int newmax;
+
+            if (words > 0)
+                reserve += words * sizeof(uint32);
+            newmax = lazy_space_grow(vacrelstats, vacrelstats->max_dead_pages, vacrelstats->num_dead_pages + 1,
+                64, sizeof(LVDeadPage), reserve);
+
+            if (vacrelstats->dead_pages == NULL)
+                vacrelstats->dead_pages = (LVDeadPage*)palloc(newmax * sizeof(LVDeadPage));
+            else
+                vacrelstats->dead_pages =
+                    (LVDeadPage*)repalloc(vacrelstats->dead_pages, newmax * sizeof(LVDeadPage));
+            vacrelstats->max_dead_pages = newmax;
+        }
+        if (vacrelstats->dead_page_map[leaf] == NULL) {
+            vacrelstats->dead_page_map[leaf] = (uint32*)palloc0(LAZY_DEAD_MAP_LEAF_SIZE);
+            vacrelstats->dead_map_used++;
+        }
+
+        dpage = &vacrelstats->dead_pages[vacrelstats->num_dead_pages++];
+        dpage->blkno = blkno;
+        dpage->firstword = vacrelstats->num_dead_words;
+        dpage->ndead = 0;
+        dpage->bitmap = false;
+        vacrelstats->dead_page_map[leaf][blkno & (LAZY_DEAD_MAP_LEAF_BLOCKS - 1)] = vacrelstats->num_dead_pages;
+    }
+    pageindex = vacrelstats->num_dead_pages - 1;
+
+    /* offsets come in increasing order, so offnum is the highest one */
+    arraywords = (dpage->ndead + LAZY_DEAD_OFFSETS_PER_WORD) / LAZY_DEAD_OFFSETS_PER_WORD;
+    bitmapwords = (offnum + LAZY_DEAD_WORD_BITS - 1) / LAZY_DEAD_WORD_BITS;
+    bitmap = bitmapwords < arraywords;
+
+    if (bitmap != dpage->bitmap) {
+        OffsetNumber offsets[MaxHeapTuplesPerPage];
+        int n = lazy_dead_page_offsets(vacrelstats, pageindex, offsets);
+
+        /* rewrite the page's words in the other encoding */
+        vacrelstats->num_dead_words = dpage->firstword;
+        dpage->bitmap = bitmap;
+        if (bitmap) {
+            lazy_dead_words_extend(vacrelstats, bitmapwords);
+            for (int i = 0; i < n; i++) {
+                int bit = offsets[i] - 1;
+
+                vacrelstats->dead_words[dpage->firstword + bit / LAZY_DEAD_WORD_BITS] |=
+                    (uint32)1 << (bit % LAZY_DEAD_WORD_BITS);
+            }
+        } else {
+            OffsetNumber* array = NULL;
+
+            lazy_dead_words_extend(vacrelstats, arraywords);
+            array = (OffsetNumber*)&vacrelstats->dead_words[dpage->firstword];
+            for (int i = 0; i < n; i++)
+                array[i] = offsets[i];
+        }
     }
+
+    if (dpage->bitmap) {
+        int bit = offnum - 1;
+
+        lazy_dead_words_extend(vacrelstats, bitmapwords);
+        vacrelstats->dead_words[dpage->firstword + bit / LAZY_DEAD_WORD_BITS] |=
+            (uint32)1 << (bit % LAZY_DEAD_WORD_BITS);
+    } else {
+        lazy_dead_words_extend(vacrelstats, arraywords);
+        ((OffsetNumber*)&vacrelstats->dead_words[dpage->firstword])[dpage->ndead] = offnum;
+    }
+    dpage->ndead++;
+    vacrelstats->num_dead_tuples++;
 }
 
 /*
  * lazy_tid_reaped() -- is a particular tid deletable?
  *      This has the right signature to be an IndexBulkDeleteCallback.
- *      Assumes dead_tuples array is in sorted order.
+ *      Looks the block up in the radix tree, then tests the offset bit or
+ *      searches the offset array of the page.
  *      inputparam partOid is valid only when index is global partition index
  */
 static bool lazy_tid_reaped(ItemPointer itemptr, void* state, Oid partOid)
 {
     LVRelStats* vacrelstats = (LVRelStats*)state;
-    ItemPointer res;
+    uint32* slot = NULL;
+    LVDeadPage* dpage = NULL;
+    OffsetNumber offnum;
+    int pageindex;
+    int bit;
+    int word;
+    int endword;
 
     // global partition index tuple need to check the tuple's partOid is same to current partition
     if (partOid != InvalidOid && vacrelstats->currVacuumPartOid != partOid) {
         return false;
     }
-    res = (ItemPointer)bsearch((void*)itemptr,
-        (void*)vacrelstats->dead_tuples,
-        vacrelstats->num_dead_tuples,
-        sizeof(ItemPointerData),
-        vac_cmp_itemptr);
 
-    return (res != NULL);
-}
+    slot = lazy_dead_page_slot(vacrelstats, ItemPointerGetBlockNumber(itemptr));
+    if (slot == NULL || *slot == 0)
+        return false;
 
-/*
- * Comparator routines for use with qsort() and bsearch().
- */
-static int vac_cmp_itemptr(const void* left, const void* right)
-{
-    BlockNumber lblk, rblk;
-    OffsetNumber loff, roff;
-    lblk = ItemPointerGetBlockNumber((ItemPointer)left);
-    rblk = ItemPointerGetBlockNumber((ItemPointer)right);
-    if (lblk < rblk)
-        return -1;
-    if (lblk > rblk)
-        return 1;
-    loff = ItemPointerGetOffsetNumber((ItemPointer)left);
-    roff = ItemPointerGetOffsetNumber((ItemPointer)right);
-    if (loff < roff)
-        return -1;
-    if (loff > roff)
-        return 1;
-    return 0;
+    pageindex = (int)*slot - 1;
+    dpage = &vacrelstats->dead_pages[pageindex];
+    offnum = ItemPointerGetOffsetNumber(itemptr);
+
+    if (!dpage->bitmap) {
+        const OffsetNumber* array = (const OffsetNumber*)&vacrelstats->dead_words[dpage->firstword];
+        int lo = 0;
+        int hi = dpage->ndead;
+
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+
+            if (array[mid] < offnum)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo < dpage->ndead && array[lo] == offnum;
+    }
+
+    endword = (pageindex + 1 < vacrelstats->num_dead_pages) ? dpage[1].firstword : vacrelstats->num_dead_words;
+    bit = offnum - 1;
+    word = dpage->firstword + bit / LAZY_DEAD_WORD_BITS;
+    if (bit < 0 || word >= endword)
+        return false;
+
+    return (vacrelstats->dead_words[word] & ((uint32)1 << (bit % LAZY_DEAD_WORD_BITS))) != 0;
 }
 
 void elogVacuumInfo(Relation rel, HeapTuple tuple, char* funcName, TransactionId oldestxmin)
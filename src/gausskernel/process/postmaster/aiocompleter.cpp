@@ -34,6 +34,19 @@
  * as a backend crash: shared memory may be corrupted, so remaining backends
  * should be killed by SIGQUIT and then a recovery cycle started.
  *
+ * When adio_io_engine selects io_uring, one ring per request type replaces
+ * the libaio contexts and a single completer thread serves all the rings.
+ * The dispatching threads queue their requests to the rings in batches and
+ * wake up the completer through an eventfd, which the rings also signal on
+ * every completion.  The completer submits the queued entries, so that the
+ * requests belong to a thread that lives as long as the rings, and calls
+ * the completion callbacks like the libaio completers do.  The shared buffer
+ * pool is registered with each ring so that page I/O uses the fixed-buffer
+ * opcodes.  The rings are created with shared memory, see AioCompltrReset(),
+ * and created again when the postmaster reinitializes it after a crash.
+ * Selecting io_uring is also what turns the adio function on, it stays off
+ * with libaio.
+ *
  * IDENTIFICATION
  *	  src/gausskernel/process/postmaster/aiocompleter.cpp
  *
@@ -50,7 +63,26 @@
 #include "storage/pmsignal.h"
 #include "utils/guc.h"
 #include "utils/memutils.h"
+#include "utils/atomic.h"
 #include <pthread.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/*
+ * io_uring is driven through the raw system calls so that no library beyond
+ * the kernel headers is needed.  IORING_FEAT_FAST_POLL (5.7) is used as the
+ * header version check, it implies IORING_OP_READ/WRITE and the opcode probe.
+ */
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#if defined(__NR_io_uring_setup) && defined(IORING_FEAT_FAST_POLL)
+#define HAVE_IO_URING
+#endif
+#endif
+#endif
 
 /*
  * Each AIO completer thread has a unique context, and potentially
@@ -179,6 +211,75 @@ AioCompltrThread_t compltrArray[MAX_AIOCOMPLTR_THREADS];
  */
 static bool volatile AioCompltrReady = false;
 
+#ifdef HAVE_IO_URING
+/* Submission queue entries per ring, the completion queue is twice as large */
+#define AIO_URING_ENTRIES 4096
+
+/* Completions copied out of the ring before calling back */
+#define AIO_URING_REAP_BATCH 256
+
+/* The kernel limits a single registered buffer to 1GB, and their number to 1024 */
+#define AIO_URING_FIXED_BUF_SIZE (1024L * 1024L * 1024L)
+#define AIO_URING_MAX_FIXED_BUFS 1024
+
+/* Milliseconds the SQPOLL kernel thread spins before going to sleep */
+#define AIO_URING_SQ_THREAD_IDLE 2000
+
+/*
+ * Milliseconds the completer sleeps on the eventfd, AIO_URING_BUSY_TIMEOUT
+ * when entries are left to submit because the completion queue was full.
+ */
+#define AIO_URING_WAIT_TIMEOUT 1000
+#define AIO_URING_BUSY_TIMEOUT 1
+
+/*
+ * One ring per AioCompltrType.  The ring memory is shared by all the threads
+ * of the instance.  sqLock serializes the threads queuing entries and the
+ * completer submitting them, the queuing threads wait on sqRoom while the
+ * submission queue is full.  The completion queue and retryList are only
+ * touched by the completer.  inflight counts the requests queued but not
+ * completed yet.
+ */
+typedef struct AioUring {
+    int ringFd;
+    bool sqpoll;
+    unsigned sqEntries;
+    volatile unsigned* sqHead;
+    volatile unsigned* sqTail;
+    volatile unsigned* sqFlags;
+    unsigned sqMask;
+    unsigned* sqArray;
+    struct io_uring_sqe* sqes;
+    volatile unsigned* cqHead;
+    volatile unsigned* cqTail;
+    unsigned cqMask;
+    struct io_uring_cqe* cqes;
+    void* sqRing;
+    size_t sqRingSize;
+    void* cqRing;
+    size_t cqRingSize;
+    size_t sqesSize;
+    char* fixedBase; /* shared buffer pool registered with the ring, or NULL */
+    size_t fixedSize;
+    volatile int32 inflight;
+    List* retryList; /* iocbs to queue again, short transfers and retries */
+    pthread_mutex_t sqLock;
+    pthread_cond_t sqRoom;
+    AioCallback_t callback;
+} AioUring_t;
+
+static AioUring_t uringArray[NUM_AIOCOMPLTR_TYPES];
+
+/*
+ * Wakes up the completer, written by the threads queuing entries and
+ * registered with every ring so that each completion signals it too.
+ */
+static int uringEventFd = -1;
+#endif
+
+/* Set when the io_uring rings serve the requests instead of the completers */
+static bool volatile AioCompltrUringReady = false;
+
 /* Associate a template with a thread index */
 #define AIOCOMPLTR_TEMPLATE(threadIdx) (&compltrDescArray[(threadIdx) % NUM_AIOCOMPLTR_TYPES])
 
@@ -233,6 +334,562 @@ io_context_t CompltrContext(AioCompltrType reqType, int h)
     return compltrArray[AIOCOMPLTR_THREAD_IDX(reqType, h)].context;
 }
 
+#ifdef HAVE_IO_URING
+static int UringSetup(unsigned entries, struct io_uring_params* params)
+{
+    return (int)syscall(__NR_io_uring_setup, entries, params);
+}
+
+static int UringEnter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags)
+{
+    return (int)syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, NULL, 0);
+}
+
+static int UringRegister(int ringFd, unsigned opcode, void* arg, unsigned nrArgs)
+{
+    return (int)syscall(__NR_io_uring_register, ringFd, opcode, arg, nrArgs);
+}
+
+/*
+ * @Description: check that the kernel knows the opcodes used by the ring
+ * @Param[IN] ring: io_uring ring
+ * @Return: true if IORING_OP_READ/WRITE and the fixed variants are supported
+ * @See also:
+ */
+static bool UringProbeOpcodes(AioUring_t* ring)
+{
+    const int probeOps = 256;
+    size_t probeSize = sizeof(struct io_uring_probe) + probeOps * sizeof(struct io_uring_probe_op);
+    struct io_uring_probe* probe = (struct io_uring_probe*)calloc(1, probeSize);
+    bool supported = false;
+
+    if (probe == NULL) {
+        return false;
+    }
+
+    if (UringRegister(ring->ringFd, IORING_REGISTER_PROBE, probe, probeOps) == 0) {
+        supported = true;
+        const int opcodes[] = {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED};
+        for (int op : opcodes) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+                supported = false;
+            }
+        }
+    }
+
+    free(probe);
+    return supported;
+}
+
+/*
+ * @Description: register the shared buffer pool as fixed buffers of the ring,
+ *  in AIO_URING_FIXED_BUF_SIZE pieces.  This is only an optimization, if the
+ *  pages cannot be pinned (RLIMIT_MEMLOCK) the plain opcodes are used.
+ * @Param[IN] ring: io_uring ring
+ * @See also:
+ */
+static void UringRegisterBuffers(AioUring_t* ring)
+{
+    char* base = t_thrd.storage_cxt.BufferBlocks;
+    size_t size = (size_t)g_instance.attr.attr_storage.NBuffers * BLCKSZ;
+    unsigned nrIovecs = (unsigned)((size + AIO_URING_FIXED_BUF_SIZE - 1) / AIO_URING_FIXED_BUF_SIZE);
+
+    if (base == NULL || size == 0 || nrIovecs > AIO_URING_MAX_FIXED_BUFS) {
+        return;
+    }
+
+    struct iovec* iovecs = (struct iovec*)malloc(nrIovecs * sizeof(struct iovec));
+    if (iovecs == NULL) {
+        return;
+    }
+
+    for (unsigned i = 0; i < nrIovecs; i++) {
+        size_t offset = (size_t)i * AIO_URING_FIXED_BUF_SIZE;
+        iovecs[i].iov_base = base + offset;
+        iovecs[i].iov_len = Min(size - offset, (size_t)AIO_URING_FIXED_BUF_SIZE);
+    }
+
+    if (UringRegister(ring->ringFd, IORING_REGISTER_BUFFERS, iovecs, nrIovecs) == 0) {
+        ring->fixedBase = base;
+        ring->fixedSize = size;
+    } else {
+        ereport(LOG, (errmsg("AIO Startup, io_uring cannot register shared buffers: %m")));
+    }
+
+    free(iovecs);
+}
+
+/*
+ * @Description: release the ring memory and descriptor
+ * @Param[IN] ring: io_uring ring
+ * @See also:
+ */
+static void UringDestroy(AioUring_t* ring)
+{
+    if (ring->sqes != NULL) {
+        (void)munmap(ring->sqes, ring->sqesSize);
+    }
+    if (ring->cqRing != NULL) {
+        (void)munmap(ring->cqRing, ring->cqRingSize);
+    }
+    if (ring->sqRing != NULL) {
+        (void)munmap(ring->sqRing, ring->sqRingSize);
+    }
+    if (ring->ringFd >= 0) {
+        (void)close(ring->ringFd);
+    }
+
+    errno_t rc = memset_s(ring, sizeof(AioUring_t), 0, sizeof(AioUring_t));
+    securec_check(rc, "\0", "\0");
+    ring->ringFd = -1;
+}
+
+/*
+ * @Description: create and map a ring, SQPOLL is dropped if the kernel refuses it
+ * @Param[IN] ring: io_uring ring to set up
+ * @Param[IN] sqpoll: let a kernel thread poll the submission queue
+ * @Return: 0 --success; errno --failed
+ * @See also:
+ */
+static int UringCreate(AioUring_t* ring, bool sqpoll)
+{
+    struct io_uring_params params;
+    errno_t rc = memset_s(&params, sizeof(params), 0, sizeof(params));
+    securec_check(rc, "\0", "\0");
+
+    if (sqpoll) {
+        params.flags |= IORING_SETUP_SQPOLL;
+        params.sq_thread_idle = AIO_URING_SQ_THREAD_IDLE;
+    }
+
+    ring->ringFd = UringSetup(AIO_URING_ENTRIES, &params);
+    if (ring->ringFd < 0 && sqpoll) {
+        /* Before 5.11 SQPOLL needs CAP_SYS_ADMIN */
+        ereport(LOG, (errmsg("AIO Startup, io_uring SQPOLL is not available: %m")));
+        return UringCreate(ring, false);
+    }
+    if (ring->ringFd < 0) {
+        return errno;
+    }
+
+    ring->sqpoll = sqpoll;
+    ring->sqEntries = params.sq_entries;
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ringFd,
+        IORING_OFF_SQ_RING);
+    ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring->ringFd,
+        IORING_OFF_CQ_RING);
+    ring->sqes = (struct io_uring_sqe*)mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+        ring->ringFd, IORING_OFF_SQES);
+    if (ring->sqRing == MAP_FAILED || ring->cqRing == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        int error = errno;
+        ring->sqRing = (ring->sqRing == MAP_FAILED) ? NULL : ring->sqRing;
+        ring->cqRing = (ring->cqRing == MAP_FAILED) ? NULL : ring->cqRing;
+        ring->sqes = (ring->sqes == MAP_FAILED) ? NULL : ring->sqes;
+        return error;
+    }
+
+    char* sqBase = (char*)ring->sqRing;
+    ring->sqHead = (volatile unsigned*)(sqBase + params.sq_off.head);
+    ring->sqTail = (volatile unsigned*)(sqBase + params.sq_off.tail);
+    ring->sqFlags = (volatile unsigned*)(sqBase + params.sq_off.flags);
+    ring->sqMask = *(unsigned*)(sqBase + params.sq_off.ring_mask);
+    ring->sqArray = (unsigned*)(sqBase + params.sq_off.array);
+
+    char* cqBase = (char*)ring->cqRing;
+    ring->cqHead = (volatile unsigned*)(cqBase + params.cq_off.head);
+    ring->cqTail = (volatile unsigned*)(cqBase + params.cq_off.tail);
+    ring->cqMask = *(unsigned*)(cqBase + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe*)(cqBase + params.cq_off.cqes);
+
+    /* Completions must not be dropped when nobody reaps for a while */
+    if (!(params.features & IORING_FEAT_NODROP) || !UringProbeOpcodes(ring)) {
+        return EOPNOTSUPP;
+    }
+
+    /* Before 5.11 SQPOLL only accepts registered files, retry without it */
+#ifdef IORING_FEAT_SQPOLL_NONFIXED
+    if (sqpoll && !(params.features & IORING_FEAT_SQPOLL_NONFIXED)) {
+#else
+    if (sqpoll) {
+#endif
+        ereport(LOG, (errmsg("AIO Startup, io_uring SQPOLL needs registered files on this kernel")));
+        UringDestroy(ring);
+        return UringCreate(ring, false);
+    }
+
+    UringRegisterBuffers(ring);
+    return 0;
+}
+
+/*
+ * @Description: start the io_uring rings, one per request type, and the
+ *  eventfd that wakes up their completer
+ * @Param[IN] sqpoll: let a kernel thread poll the submission queues
+ * @Return: 0 --success; errno --failed, nothing is left allocated
+ * @See also:
+ */
+static int CompltrUringStart(bool sqpoll)
+{
+    int error = 0;
+
+    for (int i = 0; i < NUM_AIOCOMPLTR_TYPES; i++) {
+        errno_t rc = memset_s(&uringArray[i], sizeof(AioUring_t), 0, sizeof(AioUring_t));
+        securec_check(rc, "\0", "\0");
+        uringArray[i].ringFd = -1;
+    }
+
+    uringEventFd = eventfd(0, EFD_CLOEXEC);
+    if (uringEventFd < 0) {
+        error = errno;
+        ereport(LOG, (errmsg("AIO Startup, io_uring eventfd failed: %m")));
+        return error;
+    }
+
+    for (int i = 0; i < NUM_AIOCOMPLTR_TYPES; i++) {
+        AioUring_t* ring = &uringArray[i];
+
+        error = UringCreate(ring, sqpoll);
+        if (error == 0 && UringRegister(ring->ringFd, IORING_REGISTER_EVENTFD, &uringEventFd, 1) != 0) {
+            error = errno;
+        }
+        if (error != 0) {
+            ereport(LOG, (errmsg("AIO Startup, io_uring ring %d setup failed, error=%d", i, error)));
+            for (int j = 0; j <= i; j++) {
+                UringDestroy(&uringArray[j]);
+            }
+            (void)close(uringEventFd);
+            uringEventFd = -1;
+            return error;
+        }
+
+        (void)pthread_mutex_init(&ring->sqLock, NULL);
+        (void)pthread_cond_init(&ring->sqRoom, NULL);
+        ring->callback = compltrDescArray[i].callback;
+    }
+
+    ereport(LOG,
+        (errmsg("AIO Startup, io_uring rings started, sqpoll=%d, fixed buffers=%d",
+            (int)uringArray[0].sqpoll,
+            (int)(uringArray[0].fixedBase != NULL))));
+    return 0;
+}
+
+/*
+ * @Description: tear down the rings, nothing may be in flight any more
+ * @See also:
+ */
+static void CompltrUringStop(void)
+{
+    AioCompltrUringReady = false;
+
+    for (int i = 0; i < NUM_AIOCOMPLTR_TYPES; i++) {
+        if (uringArray[i].ringFd < 0) {
+            continue;
+        }
+        list_free(uringArray[i].retryList);
+        (void)pthread_mutex_destroy(&uringArray[i].sqLock);
+        (void)pthread_cond_destroy(&uringArray[i].sqRoom);
+        UringDestroy(&uringArray[i]);
+    }
+
+    if (uringEventFd >= 0) {
+        (void)close(uringEventFd);
+        uringEventFd = -1;
+    }
+}
+
+/*
+ * @Description: fill a submission queue entry from a libaio iocb.  The iocb
+ *  address travels as user_data so that the completion callback receives the
+ *  same AioDispatchDesc_t/AioDispatchCUDesc_t as with io_getevents().
+ * @Param[IN] ring: io_uring ring
+ * @Param[IN] sqe: entry to fill
+ * @Param[IN] cb: prepared iocb, aio_fildes is the real fd
+ * @See also:
+ */
+static void UringPrepSqe(AioUring_t* ring, struct io_uring_sqe* sqe, struct iocb* cb)
+{
+    char* buf = (char*)cb->u.c.buf;
+    bool isWrite = (cb->aio_lio_opcode == IO_CMD_PWRITE);
+
+    errno_t rc = memset_s(sqe, sizeof(struct io_uring_sqe), 0, sizeof(struct io_uring_sqe));
+    securec_check(rc, "\0", "\0");
+
+    sqe->fd = cb->aio_fildes;
+    sqe->off = (uint64)cb->u.c.offset;
+    sqe->addr = (uint64)(uintptr_t)buf;
+    sqe->len = (uint32)cb->u.c.nbytes;
+    sqe->user_data = (uint64)(uintptr_t)cb;
+
+    if (ring->fixedBase != NULL && buf >= ring->fixedBase && buf + cb->u.c.nbytes <= ring->fixedBase + ring->fixedSize) {
+        /* pages never straddle two registered pieces, the piece size is a multiple of BLCKSZ */
+        sqe->opcode = isWrite ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe->buf_index = (uint16)((buf - ring->fixedBase) / AIO_URING_FIXED_BUF_SIZE);
+    } else {
+        sqe->opcode = isWrite ? IORING_OP_WRITE : IORING_OP_READ;
+    }
+}
+
+/*
+ * @Description: queue prepared iocbs at the tail of the submission queue
+ * @Param[IN] ring: io_uring ring, sqLock held
+ * @Param[IN] iocbList: iocbs with the real fd in aio_fildes
+ * @Param[IN] count: number of iocbs
+ * @Return: number of iocbs queued, limited by the room left in the queue
+ * @See also:
+ */
+static int UringQueue(AioUring_t* ring, struct iocb** iocbList, int count)
+{
+    unsigned tail = *ring->sqTail;
+    pg_read_barrier();
+    unsigned room = ring->sqEntries - (tail - *ring->sqHead);
+    unsigned batch = Min(room, (unsigned)count);
+
+    for (unsigned i = 0; i < batch; i++) {
+        unsigned idx = (tail + i) & ring->sqMask;
+        UringPrepSqe(ring, &ring->sqes[idx], iocbList[i]);
+        ring->sqArray[idx] = idx;
+    }
+
+    /* the entries must be visible before the kernel sees the new tail */
+    pg_write_barrier();
+    *ring->sqTail = tail + batch;
+
+    return (int)batch;
+}
+
+/*
+ * @Description: make the kernel consume the queued entries, only the
+ *  completer calls io_uring_enter() to submit so that the requests are never
+ *  cancelled by the exit of the thread that dispatched them
+ * @Param[IN] ring: io_uring ring, sqLock held
+ * @Return: 0 or -errno
+ * @See also:
+ */
+static int UringFlushSubmissions(AioUring_t* ring)
+{
+    if (ring->sqpoll) {
+        /* the kernel thread only needs a kick if it went to sleep */
+        pg_memory_barrier();
+        if (*ring->sqFlags & IORING_SQ_NEED_WAKEUP) {
+            if (UringEnter(ring->ringFd, 0, 0, IORING_ENTER_SQ_WAKEUP) < 0) {
+                return -errno;
+            }
+        }
+        return 0;
+    }
+
+    unsigned toSubmit = *ring->sqTail - *ring->sqHead;
+    while (toSubmit > 0) {
+        int ret = UringEnter(ring->ringFd, toSubmit, 0, 0);
+        if (ret < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -errno;
+        }
+        toSubmit -= (unsigned)ret;
+    }
+
+    return 0;
+}
+
+/*
+ * @Description: wake up the completer
+ * @See also:
+ */
+static void UringWakeCompleter(void)
+{
+    uint64 one = 1;
+
+    while (write(uringEventFd, &one, sizeof(one)) < 0 && errno == EINTR) {
+    }
+}
+
+/*
+ * @Description: pass a completion to the callback of the request type.
+ *  Short transfers are queued again for the remaining bytes, and requests
+ *  the kernel could not serve now are queued again as they are; the
+ *  callback only sees the final result, with the bytes of all the parts.
+ * @Param[IN] ring: io_uring ring
+ * @Param[IN] cb: completed iocb, data holds the bytes transferred before
+ * @Param[IN] res: bytes transferred, or -errno
+ * @See also:
+ */
+static void UringComplete(AioUring_t* ring, struct iocb* cb, long res)
+{
+    if (res == -EINTR || res == -EAGAIN || res == -ECANCELED) {
+        ring->retryList = lappend(ring->retryList, cb);
+        return;
+    }
+
+    if (res > 0 && (unsigned long)res < cb->u.c.nbytes) {
+        cb->data = (void*)((uintptr_t)cb->data + (uintptr_t)res);
+        cb->u.c.buf = (char*)cb->u.c.buf + res;
+        cb->u.c.offset += res;
+        cb->u.c.nbytes -= (unsigned long)res;
+        ring->retryList = lappend(ring->retryList, cb);
+        return;
+    }
+
+    if (res >= 0) {
+        res += (long)(uintptr_t)cb->data;
+    }
+
+    (void)gs_atomic_add_32(&ring->inflight, -1);
+    ring->callback((void*)cb, res);
+}
+
+/*
+ * @Description: complete every request found in the completion queue
+ * @Param[IN] ring: io_uring ring
+ * @See also:
+ */
+static void UringReap(AioUring_t* ring)
+{
+    struct io_uring_cqe cqes[AIO_URING_REAP_BATCH];
+    bool overflowFlushed = false;
+
+    for (;;) {
+        unsigned count = 0;
+        unsigned head = *ring->cqHead;
+        pg_read_barrier();
+        unsigned tail = *ring->cqTail;
+        pg_read_barrier();
+
+        while (head != tail && count < AIO_URING_REAP_BATCH) {
+            cqes[count++] = ring->cqes[head & ring->cqMask];
+            head++;
+        }
+        pg_memory_barrier();
+        *ring->cqHead = head;
+
+        if (count == 0) {
+#ifdef IORING_SQ_CQ_OVERFLOW
+            /* completions that did not fit in the queue are flushed by the kernel on demand */
+            if (!overflowFlushed && (*ring->sqFlags & IORING_SQ_CQ_OVERFLOW)) {
+                (void)UringEnter(ring->ringFd, 0, 0, IORING_ENTER_GETEVENTS);
+                overflowFlushed = true;
+                continue;
+            }
+#endif
+            break;
+        }
+
+        for (unsigned i = 0; i < count; i++) {
+            UringComplete(ring, (struct iocb*)(uintptr_t)cqes[i].user_data, (long)cqes[i].res);
+        }
+    }
+}
+
+/*
+ * @Description: submit the entries queued to the ring, after the requests
+ *  to retry, and wake up the threads waiting for room
+ * @Param[IN] ring: io_uring ring
+ * @Return: true if entries are left to submit
+ * @See also:
+ */
+static bool UringSubmit(AioUring_t* ring)
+{
+    bool pending = false;
+
+    (void)pthread_mutex_lock(&ring->sqLock);
+    while (ring->retryList != NIL) {
+        struct iocb* cb = (struct iocb*)linitial(ring->retryList);
+
+        if (UringQueue(ring, &cb, 1) == 0) {
+            break;
+        }
+        ring->retryList = list_delete_first(ring->retryList);
+    }
+
+    int error = UringFlushSubmissions(ring);
+    if (error < 0 && error != -EBUSY && error != -EAGAIN) {
+        /* the queued requests can no longer be completed */
+        ereport(PANIC, (errmsg("AIO Completer io_uring_enter() failed: error %d .", error)));
+    }
+
+    /* -EBUSY and -EAGAIN leave the entries queued until some completions are reaped */
+    pending = (ring->retryList != NIL || *ring->sqTail != *ring->sqHead);
+    (void)pthread_cond_broadcast(&ring->sqRoom);
+    (void)pthread_mutex_unlock(&ring->sqLock);
+
+    return pending;
+}
+
+/*
+ * @Description: Check whether some io_uring request has not completed yet
+ * @Return: true if requests are in flight
+ * @See also:
+ */
+static bool UringPending(void)
+{
+    for (int i = 0; i < NUM_AIOCOMPLTR_TYPES; i++) {
+        if (uringArray[i].inflight > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+#endif
+
+/*
+ * @Description: Check whether the requests are served by io_uring
+ * @Return: true if CompltrUringSubmit() must be used instead of io_submit()
+ * @See also:
+ */
+bool CompltrUringActive(void)
+{
+    return AioCompltrUringReady;
+}
+
+/*
+ * @Description: Queue a batch of prepared iocbs to the ring of the request
+ *  type and wake up the completer, which submits and completes them.  The
+ *  caller sleeps while the submission queue is full.
+ * @Param[IN] reqType: aio completer type
+ * @Param[IN] iocbList: iocbs with the real fd in aio_fildes
+ * @Param[IN] count: number of iocbs
+ * @Return: number of requests queued, or -errno
+ * @See also:
+ */
+int CompltrUringSubmit(AioCompltrType reqType, struct iocb** iocbList, int count)
+{
+#ifdef HAVE_IO_URING
+    AioUring_t* ring = &uringArray[reqType];
+    int queued = 0;
+
+    /* data counts the bytes transferred by the parts of a short transfer */
+    for (int i = 0; i < count; i++) {
+        iocbList[i]->data = NULL;
+    }
+
+    (void)pthread_mutex_lock(&ring->sqLock);
+    while (queued < count) {
+        int batch = UringQueue(ring, iocbList + queued, count - queued);
+
+        if (batch == 0) {
+            /* the submission queue is full, the completer makes room */
+            UringWakeCompleter();
+            (void)pthread_cond_wait(&ring->sqRoom, &ring->sqLock);
+            continue;
+        }
+        (void)gs_atomic_add_32(&ring->inflight, (int32)batch);
+        queued += batch;
+    }
+    (void)pthread_mutex_unlock(&ring->sqLock);
+
+    UringWakeCompleter();
+    return queued;
+#else
+    return -ENOSYS;
+#endif
+}
+
 /* Prototypes for private functions */
 /*
  * Signal handlers
@@ -298,6 +955,24 @@ int AioCompltrStart(void)
         return error;
     }
 
+#ifdef HAVE_IO_URING
+    /*
+     * The io_uring rings were set up with shared memory by AioCompltrReset(),
+     * they are served by a single completer thread.
+     */
+    if (AioCompltrUringReady) {
+        g_instance.pid_cxt.AioUringCompltrPID = initialize_util_thread(AIO_COMPLETER);
+        if (g_instance.pid_cxt.AioUringCompltrPID == 0) {
+            /* starting a thread failed */
+            error = 3;
+            ereport(LOG, (errmsg("Start AIO Completer thread failed: %d", error)));
+            return error;
+        }
+        AioCompltrReady = true;
+        return 0;
+    }
+#endif
+
     errno_t rc = memset_s(&compltrArray,
         sizeof(AioCompltrThread_t) * MAX_AIOCOMPLTR_THREADS,
         0,
@@ -370,6 +1045,57 @@ AioCompltrStartError:
     return error;
 }
 
+/*
+ * @Description: Set up the adio state for a new shared memory, called by the
+ *  postmaster each time it creates shared memory, before any thread that may
+ *  dispatch I/O is started.  The completer of a previous cycle is gone, and
+ *  its rings registered the old shared buffers, so new rings are created and
+ *  the completer is started again by the postmaster loop.
+ *
+ *  adio is a beta feature that stays off with the libaio engine, selecting an
+ *  io_uring engine turns it on when the kernel supports io_uring.
+ * @See also:
+ */
+void AioCompltrReset(void)
+{
+    AioCompltrReady = false;
+    g_instance.pid_cxt.AioCompleterStarted = 0;
+
+#ifdef HAVE_IO_URING
+    /*
+     * Close what a completer killed by SIGQUIT left open.  Its retry lists
+     * went away with its memory context, and no thread may hold the locks.
+     */
+    if (uringEventFd >= 0) {
+        for (int i = 0; i < NUM_AIOCOMPLTR_TYPES; i++) {
+            if (uringArray[i].ringFd >= 0) {
+                UringDestroy(&uringArray[i]);
+            }
+        }
+        (void)close(uringEventFd);
+        uringEventFd = -1;
+    }
+    AioCompltrUringReady = false;
+
+    if (g_instance.attr.attr_storage.adio_io_engine != AioEngineLibaio) {
+        if (CompltrUringStart(g_instance.attr.attr_storage.adio_io_engine == AioEngineIoUringSqpoll) == 0) {
+            AioCompltrUringReady = true;
+        } else {
+            ereport(LOG, (errmsg("AIO Startup, io_uring is not available, adio is disabled")));
+        }
+    }
+#else
+    if (g_instance.attr.attr_storage.adio_io_engine != AioEngineLibaio) {
+        ereport(LOG, (errmsg("AIO Startup, io_uring is not supported by this build, adio is disabled")));
+    }
+#endif
+
+    g_instance.attr.attr_storage.enable_adio_function = AioCompltrUringReady;
+    if (AioCompltrUringReady) {
+        AioResourceInitialize();
+    }
+}
+
 /*
  * @Description: Stop the Completer threads, cleanup any partially started ones.
  * Send SIGQUIT and forget about the threads.
@@ -382,6 +1108,17 @@ void AioCompltrStop(int signal)
     gs_thread_t thread;
     AioCompltrReady = false;
 
+#ifdef HAVE_IO_URING
+    if (AioCompltrUringReady) {
+        /* The completer tears the rings down on its way out */
+        if (g_instance.pid_cxt.AioUringCompltrPID != 0 &&
+            gs_signal_send(g_instance.pid_cxt.AioUringCompltrPID, signal) < 0) {
+            ereport(LOG, (errmsg("kill(%lu,%d) failed: %m", g_instance.pid_cxt.AioUringCompltrPID, signal)));
+        }
+        return;
+    }
+#endif
+
     /*
      * Stop the threads in the compltrArray.
      */
@@ -594,6 +1331,89 @@ void AioCompltrMain(int ac, char** av)
     exit(0);
 }
 
+/*
+ * @Description:  Main entry point for the io_uring completer thread.  It
+ *  submits what the dispatching threads queued to the rings and completes
+ *  the requests, sleeping on the eventfd in between.  On SIGTERM it exits
+ *  once the requests in flight are completed, tearing the rings down.
+ * @See also:
+ */
+void AioCompltrUringMain(void)
+{
+#ifdef HAVE_IO_URING
+    (void)gspqsignal(SIGHUP, CompltrConfig); /* retrieve config */
+    (void)gspqsignal(SIGINT, SIG_IGN);
+    (void)gspqsignal(SIGTERM, CompltrShutdown); /* shutdown */
+    (void)gspqsignal(SIGQUIT, CompltrQuickDie); /* hard crash time */
+    (void)gspqsignal(SIGALRM, SIG_IGN);
+    (void)gspqsignal(SIGPIPE, SIG_IGN);
+    (void)gspqsignal(SIGUSR1, SIG_IGN); /* reserved */
+    (void)gspqsignal(SIGUSR2, SIG_IGN);
+
+    (void)gspqsignal(SIGCHLD, SIG_DFL);
+    (void)gspqsignal(SIGTTIN, SIG_DFL);
+    (void)gspqsignal(SIGTTOU, SIG_DFL);
+    (void)gspqsignal(SIGCONT, SIG_DFL);
+    (void)gspqsignal(SIGWINCH, SIG_DFL);
+
+    /* We allow SIGQUIT (quickdie) at all times */
+    sigdelset(&t_thrd.libpq_cxt.BlockSig, SIGQUIT);
+
+    /* The retry lists live here */
+    MemoryContext compltrContext = AllocSetContextCreate(t_thrd.top_mem_cxt,
+        "AIO Completer",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE);
+    (void)MemoryContextSwitchTo(compltrContext);
+
+    gs_signal_setmask(&t_thrd.libpq_cxt.UnBlockSig, NULL);
+    (void)gs_signal_unblock_sigusr2();
+
+    ereport(LOG, (errmsg("AIO Completer io_uring STARTED.")));
+
+    for (;;) {
+        bool pending = false;
+        struct pollfd pfd;
+
+        if (t_thrd.aio_cxt.config_requested) {
+            t_thrd.aio_cxt.config_requested = false;
+        }
+
+        /* Reap first, the completions make room for the submissions */
+        for (int i = 0; i < NUM_AIOCOMPLTR_TYPES; i++) {
+            UringReap(&uringArray[i]);
+        }
+        for (int i = 0; i < NUM_AIOCOMPLTR_TYPES; i++) {
+            pending = UringSubmit(&uringArray[i]) || pending;
+        }
+
+        /*
+         * The postmaster requests shutdown once no thread is left to
+         * dispatch I/O, exit as soon as the last request completes.
+         */
+        if (t_thrd.aio_cxt.shutdown_requested && !UringPending()) {
+            CompltrUringStop();
+            ereport(LOG, (errmsg("AIO Completer io_uring EXITED.")));
+            proc_exit(0);
+        }
+
+        pfd.fd = uringEventFd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        int rc = poll(&pfd, 1, pending ? AIO_URING_BUSY_TIMEOUT : AIO_URING_WAIT_TIMEOUT);
+        if (rc < 0 && errno != EINTR) {
+            ereport(PANIC, (errmsg("AIO Completer poll() failed: %m")));
+        }
+        if (rc > 0) {
+            uint64 wakeups;
+            (void)read(uringEventFd, &wakeups, sizeof(wakeups));
+        }
+    }
+#endif
+    proc_exit(1);
+}
+
 /*
  * @Description: signal handler routines for config,not used now
  * @See also:
@@ -620,6 +1440,12 @@ static void CompltrQuickDie(SIGNAL_ARGS)
      */
     on_exit_reset();
 
+    /*
+     * The io_uring rings are left as they are, the threads still queuing to
+     * them are being killed too.  The postmaster closes them in
+     * AioCompltrReset() before it starts over.
+     */
+
     /*
      * Note we do exit(2) not exit(0)...
      * ...just like the other postmaster children.
@@ -643,6 +1469,11 @@ static void CompltrShutdown(SIGNAL_ARGS)
  */
 void AioResourceInitialize(void)
 {
+    /* it survives a reinitialization of shared memory */
+    if (AdioSharedContext != NULL) {
+        return;
+    }
+
     AdioSharedContext = AllocSetContextCreate((MemoryContext)g_instance.instance_context,
         "AdioSharedMemory",
         ALLOCSET_DEFAULT_MINSIZE,
@@ -164,6 +164,7 @@
 #include "storage/remote_read.h"
 #include "tcop/tcopprot.h"
 #include "utils/builtins.h"
+#include "utils/catcache.h"
 #include "utils/datetime.h"
 #include "utils/guc.h"
 #include "utils/inval.h"
@@ -2133,8 +2134,6 @@ int PostmasterMain(int argc, char* argv[]) {
                                    "listen port already in use")));
     }
 
-    if (g_instance.attr.attr_storage.enable_adio_function)
-        AioResourceInitialize();
     /* start alarm checker thread. */
     if (!dummyStandbyMode)
         g_instance.pid_cxt.AlarmCheckerPID = startAlarmChecker();
@@ -4293,6 +4292,12 @@ static void reset_shared(int port) {
      * objects if the postmaster crashes and is restarted.
      */
     CreateSharedMemoryAndSemaphores(false, port);
+
+    /*
+     * The adio rings register the shared buffers, set them up again for the
+     * new shared memory before any thread may dispatch I/O.
+     */
+    AioCompltrReset();
 }
 
 /*
@@ -6036,6 +6041,15 @@ static void reaper(SIGNAL_ARGS) {
             continue;
         }
 
+        if (pid == g_instance.pid_cxt.AioUringCompltrPID) {
+            g_instance.pid_cxt.AioUringCompltrPID = 0;
+            /* after a crash it exits on the SIGQUIT we sent, its rings are closed by reset_shared */
+            if (!EXIT_STATUS_0(exitstatus) && !g_instance.fatal_error)
+                HandleChildCrash(pid, exitstatus, _("aio completer process"));
+
+            continue;
+        }
+
         if (pid == g_instance.pid_cxt.CommPoolerCleanPID) {
             g_instance.pid_cxt.CommPoolerCleanPID = 0;
 
@@ -6147,7 +6161,8 @@ static const char* GetProcName(ThreadId pid) {
         return "fault monitor process";
     else if (g_instance.pid_cxt.AlarmCheckerPID == pid)
         return "alarm checker process";
-    else if (g_instance.pid_cxt.AioCompleterStarted == pid)
+    else if (g_instance.pid_cxt.AioCompleterStarted == pid ||
+             g_instance.pid_cxt.AioUringCompltrPID == pid)
         return "aio completer process";
     else if (pid == g_instance.pid_cxt.CBMWriterPID)
         return "CBM writer process";
@@ -6287,6 +6302,10 @@ void HandleChildCrash(ThreadId pid, int exitstatus, const char* procname) {
     //
     ereport(LOG, (errmsg("the server process exits")));
 
+    /* stop the aio completer from calling back into shared memory while we exit */
+    if (g_instance.pid_cxt.AioUringCompltrPID != 0 && g_instance.pid_cxt.AioUringCompltrPID != pid)
+        signal_child(g_instance.pid_cxt.AioUringCompltrPID, SIGQUIT);
+
     cancelIpcMemoryDetach();
 
     fflush(stdout);
@@ -6594,6 +6613,10 @@ static void PostmasterStateMachine(void) {
                         Assert(!dummyStandbyMode);
                         signal_child(g_instance.pid_cxt.PgAuditPID, SIGQUIT);
                     }
+
+                    /* and the aio completer, the I/O in flight is lost anyway */
+                    if (g_instance.pid_cxt.AioUringCompltrPID != 0)
+                        signal_child(g_instance.pid_cxt.AioUringCompltrPID, SIGQUIT);
                 }
             }
         }
@@ -6620,6 +6643,17 @@ static void PostmasterStateMachine(void) {
         }
     }
 
+    if (pmState == PM_WAIT_DEAD_END &&
+        g_instance.pid_cxt.AioUringCompltrPID != 0 &&
+        DLGetHead(g_instance.backend_list) == NULL &&
+        ckpt_all_flush_buffer_thread_exit()) {
+        /*
+         * Nobody is left to dispatch asynchronous I/O, the AIO completer
+         * exits once the requests in flight are completed.
+         */
+        signal_child(g_instance.pid_cxt.AioUringCompltrPID, SIGTERM);
+    }
+
     if (pmState == PM_WAIT_DEAD_END) {
         /*
          * PM_WAIT_DEAD_END state ends when the g_instance.backend_list is entirely empty
@@ -6638,6 +6672,7 @@ static void PostmasterStateMachine(void) {
             g_instance.pid_cxt.PgArchPID == 0 &&
             g_instance.pid_cxt.PgStatPID == 0 &&
             g_instance.pid_cxt.PgAuditPID == 0 &&
+            g_instance.pid_cxt.AioUringCompltrPID == 0 &&
             ckpt_all_flush_buffer_thread_exit()) {
             /* These other guys should be dead already */
             Assert(g_instance.pid_cxt.TwoPhaseCleanerPID == 0);
@@ -6738,6 +6773,7 @@ static void PostmasterStateMachine(void) {
                 g_threadPoolControler->GetScheduler()->HasShutDown() == false)
                 g_threadPoolControler->ShutDownScheduler(true);
         }
+        GlobalCatCacheResetAll();
         shmem_exit(1);
         reset_shared(g_instance.attr.attr_network.PostPortNumber);
 
@@ -6770,6 +6806,7 @@ static void PostmasterStateMachine(void) {
                 g_threadPoolControler->GetScheduler()->HasShutDown() == false)
                 g_threadPoolControler->ShutDownScheduler(true);
         }
+        GlobalCatCacheResetAll();
         shmem_exit(1);
         reset_shared(g_instance.attr.attr_network.PostPortNumber);
 
@@ -10225,6 +10262,9 @@ static void SetAuxType() {
         case HEARTBEAT:
             t_thrd.bootstrap_cxt.MyAuxProcType = HeartbeatProcess;
             break;
+        case AIO_COMPLETER:
+            t_thrd.bootstrap_cxt.MyAuxProcType = AsyncIOCompleterProcess;
+            break;
 #ifdef ENABLE_MULTIPLE_NODES
         case TS_COMPACTION:
             t_thrd.bootstrap_cxt.MyAuxProcType = TsCompactionProcess;
@@ -10491,6 +10531,11 @@ int GaussDbAuxiliaryThreadMain(knl_thread_arg* arg) {
             proc_exit(1);
             break;
 
+        case AIO_COMPLETER:
+            AioCompltrUringMain();
+            proc_exit(1); /* should never return */
+            break;
+
         case THREADPOOL_LISTENER:
             TpoolListenerMain(t_thrd.threadpool_cxt.listener);
             proc_exit(1);
@@ -10739,6 +10784,7 @@ int GaussDbThreadMain(knl_thread_arg* arg) {
         case STARTUP:
         case PAGEWRITER_THREAD:
         case HEARTBEAT:
+        case AIO_COMPLETER:
 #ifdef ENABLE_MULTIPLE_NODES
         case TS_COMPACTION:
         case TS_COMPACTION_CONSUMER:
@@ -11180,6 +11226,8 @@ static ThreadMetaData GaussdbThreadGate[] = {
     {GaussDbThreadMain<CSNMIN_SYNC>, CSNMIN_SYNC, "csnminsync", "csnmin sync"},
     {GaussDbThreadMain<BARRIER_CREATOR>, BARRIER_CREATOR, "barriercreator",
      "barrier creator"},
+    {GaussDbThreadMain<AIO_COMPLETER>, AIO_COMPLETER, "AIOcompleter",
+     "aio completer"},
 
 /* Keep the block in the end if it may be absent !!! */
 #ifdef ENABLE_MULTIPLE_NODES
@@ -62,6 +62,7 @@
 #include "distributelayer/streamMain.h"
 #include "distributelayer/streamProducer.h"
 #include "distributelayer/streamConsumer.h"
+#include "access/relscan.h"
 #include "storage/procsignal.h"
 
 /* Process-wise variables. */
@@ -351,6 +352,7 @@ StreamNodeGroup::StreamNodeGroup()
     m_streamConsumerList = NULL;
     m_streamProducerList = NULL;
     m_syncControllers = NIL;
+    m_parallelScans = NULL;
     m_streamRuntimeContext = NULL;
     m_streamArray = NULL;
     m_quitWaitCond = 0;
@@ -1039,6 +1041,8 @@ void StreamNodeGroup::deInit(StreamObjStatus status)
         m_syncControllers = NIL;
     }
 
+    /* Allocators are freed with the runtime context */
+    m_parallelScans = NULL;
     m_streamRuntimeContext = NULL;
 
     /*
@@ -1616,6 +1620,73 @@ SyncController* StreamNodeGroup::GetSyncController(int controller_plannodeid)
     return result;
 }
 
+/*
+ * @Function: AttachParallelScan()
+ *
+ * @Description: static function that used to join the block allocator shared
+ * by the smp workers of a parallel seqscan, creating it on first use
+ *
+ * @param[IN] planNodeId: plan node id of the SeqScan
+ * @param[IN] rnode: relation being scanned
+ * @param[IN] smpId: smp id of the calling worker
+ * @param[IN] nblocks: relation size seen by the calling worker
+ * @param[IN] startblock: syncscan start block seen by the calling worker
+ *
+ * @return: the allocator, or NULL if this worker already joined it once, which
+ * means the scan is being rescanned and has to fall back to static striping
+ */
+ParallelBlockAllocData* StreamNodeGroup::AttachParallelScan(
+    int planNodeId, const RelFileNode* rnode, int smpId, BlockNumber nblocks, BlockNumber startblock)
+{
+    StreamNodeGroup* group = u_sess->stream_cxt.global_obj;
+    ParallelBlockAllocData* result = NULL;
+    ParallelBlockAllocData* newpba = NULL;
+    ParallelBlockAllocData* pba = NULL;
+
+    if (group == NULL || group->m_streamRuntimeContext == NULL || smpId < 0 || smpId >= MAX_QUERY_DOP)
+        return NULL;
+
+    /* Allocate up front, nothing may error out while the mutex is held */
+    newpba = (ParallelBlockAllocData*)MemoryContextAllocZero(
+        group->m_streamRuntimeContext, sizeof(ParallelBlockAllocData));
+    newpba->plan_node_id = planNodeId;
+    newpba->rnode = *rnode;
+    newpba->nblocks = nblocks;
+    newpba->startblock = (startblock < nblocks) ? startblock : 0;
+    pg_atomic_init_u32(&newpba->nallocated, 0);
+
+    AutoMutexLock streamLock(&group->m_mutex);
+    streamLock.lock();
+
+    for (pba = group->m_parallelScans; pba != NULL; pba = pba->next) {
+        if (pba->plan_node_id == planNodeId && RelFileNodeEquals(pba->rnode, *rnode)) {
+            result = pba;
+            break;
+        }
+    }
+
+    if (result == NULL) {
+        newpba->next = group->m_parallelScans;
+        group->m_parallelScans = newpba;
+        result = newpba;
+        newpba = NULL;
+    }
+
+    if (result->attached & ((uint64)1 << smpId)) {
+        result = NULL;
+    } else {
+        result->attached |= ((uint64)1 << smpId);
+    }
+
+    streamLock.unLock();
+
+    if (newpba != NULL) {
+        pfree_ext(newpba);
+    }
+
+    return result;
+}
+
 /*
  * Mark executor stop flag for all sync controller
  */
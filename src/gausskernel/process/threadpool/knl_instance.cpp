@@ -38,6 +38,7 @@
 #include "optimizer/streamplan.h"
 #include "pgstat.h"
 #include "regex/regex.h"
+#include "utils/catcache.h"
 #include "utils/memutils.h"
 #include "utils/palloc.h"
 #include "workload/workload.h"
@@ -237,6 +238,7 @@ static void knl_g_cache_init(knl_g_cache_context* cache_cxt)
     cache_cxt->global_cache_mem = NULL;
     for (int i = 0; i < MAX_GLOBAL_CACHEMEM_NUM; ++i)
         cache_cxt->global_plancache_mem[i] = NULL;
+    cache_cxt->global_catcache = NULL;
 }
 
 void knl_g_cachemem_create()
@@ -261,6 +263,10 @@ void knl_g_cachemem_create()
                                                                              false);
     }
     g_instance.plan_cache = New(INSTANCE_GET_MEM_CXT_GROUP(MEMORY_CONTEXT_EXECUTOR)) GlobalPlanCache();
+
+    if (g_instance.attr.attr_common.enable_global_syscache && g_instance.attr.attr_common.enable_thread_pool) {
+        GlobalCatCacheInit();
+    }
 }
 static void knl_g_comm_init(knl_g_comm_context* comm_cxt)
 {
@@ -43,6 +43,7 @@
 #include "storage/procarray.h"
 #include "storage/sinval.h"
 #include "utils/anls_opt.h"
+#include "utils/catcache.h"
 #include "utils/elog.h"
 #include "utils/formatting.h"
 #include "utils/inval.h"
@@ -1360,6 +1361,9 @@ void free_session_context(knl_session_context* session)
         MemoryContextSwitchTo(t_thrd.mem_cxt.msg_mem_cxt);
     }
 
+    /* the catcache goes away with the session memory, give back its global entries */
+    ReleaseCatCacheGlobalRefs();
+
     MemoryContextDeleteChildren(session->top_mem_cxt);
     MemoryContextDelete(session->top_mem_cxt);
     (void)syscalllockFree(&session->utils_cxt.deleMemContextMutex);
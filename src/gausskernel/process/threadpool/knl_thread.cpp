@@ -218,6 +218,9 @@ static void knl_t_cbm_init(knl_t_cbm_context* cbm_cxt)
 static void knl_t_shemem_ptr_init(knl_t_shemem_ptr_context* shemem_ptr_cxt)
 {
     shemem_ptr_cxt->scan_locations = NULL;
+    shemem_ptr_cxt->relsize_cache = NULL;
+    shemem_ptr_cxt->relsize_hash = NULL;
+    shemem_ptr_cxt->fsm_target_cache = NULL;
     shemem_ptr_cxt->MultiXactOffsetCtl = (SlruCtlData*)palloc0(sizeof(SlruCtlData));
     shemem_ptr_cxt->MultiXactMemberCtl = (SlruCtlData*)palloc0(sizeof(SlruCtlData));
     shemem_ptr_cxt->MultiXactState = NULL;
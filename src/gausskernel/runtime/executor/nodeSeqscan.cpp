@@ -525,7 +525,7 @@ SeqScanState* ExecInitSeqScan(SeqScan* node, EState* estate, int eflags)
     InitSeqNextMtd(node, scanstate);
     if (IsValidScanDesc(scanstate->ss_currentScanDesc)) {
         scan_handler_tbl_init_parallel_seqscan(scanstate->ss_currentScanDesc, 
-            scanstate->ps.plan->dop, scanstate->partScanDirection);
+            scanstate->ps.plan->dop, scanstate->partScanDirection, scanstate->ps.plan->plan_node_id);
     } else {
         scanstate->ps.stubType = PST_Scan;
     }
@@ -636,7 +636,8 @@ void ExecReScanSeqScan(SeqScanState* node)
         scan_handler_tbl_rescan(scan, NULL, node->ss_currentRelation);
     }
 
-    scan_handler_tbl_init_parallel_seqscan(scan, node->ps.plan->dop, node->partScanDirection);
+    scan_handler_tbl_init_parallel_seqscan(scan, node->ps.plan->dop, node->partScanDirection,
+        node->ps.plan->plan_node_id);
     ExecScanReScan((ScanState*)node);
 }
 
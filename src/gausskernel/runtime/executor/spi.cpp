@@ -28,6 +28,7 @@
 #include "executor/executor.h"
 #include "executor/spi_priv.h"
 #include "miscadmin.h"
+#include "parser/analyze.h"
 #include "parser/parser.h"
 #include "pgxc/pgxc.h"
 #include "tcop/pquery.h"
@@ -44,6 +45,9 @@
 #include "utils/syscache.h"
 #include "utils/typcache.h"
 #include "utils/elog.h"
+#ifdef ENABLE_MOT
+#include "storage/mot/jit_exec.h"
+#endif
 
 THR_LOCAL uint32 SPI_processed = 0;
 THR_LOCAL SPITupleTable *SPI_tuptable = NULL;
@@ -72,6 +76,9 @@ static void _SPI_cursor_operation(Portal portal, FetchDirection direction, long
 
 static SPIPlanPtr _SPI_make_plan_non_temp(SPIPlanPtr plan);
 static SPIPlanPtr _SPI_save_plan(SPIPlanPtr plan);
+#ifdef ENABLE_MOT
+static void _SPI_try_mot_jit_codegen(CachedPlanSource *plansource, List *stmt_list);
+#endif
 
 static int _SPI_begin_call(bool execmem);
 static MemoryContext _SPI_procmem(void);
@@ -2023,6 +2030,10 @@ static void _SPI_pgxc_prepare_plan(const char *src, List *src_parsetree, SPIPlan
             plan->parserSetupArg, plan->cursor_options, false, /* not fixed result */
             "");
 
+#ifdef ENABLE_MOT
+        _SPI_try_mot_jit_codegen(plansource, stmt_list);
+#endif
+
         if (enable_spi_gpc && plansource->gpc.status.IsSharePlan()) {
             /* for needRecompilePlan, plansource need recreate each time, no need to global it.
              * for temp table, only one session can use it, no need to global it */
@@ -2080,6 +2091,59 @@ static void SPIParseOneShotPlan(CachedPlanSource* plansource, SPIPlanPtr plan)
                        plan->parserSetupArg, plan->cursor_options, false, ""); /* not fixed result */
 }
 
+#ifdef ENABLE_MOT
+/*
+ * _SPI_try_mot_jit_codegen: generate MOT jitted code for a plan source
+ *
+ * Statements issued through SPI (mostly from PL/pgSQL functions) are prepared
+ * once and executed many times, just like statements of the extended protocol,
+ * so MOT-only statements get a JIT context here, the same way exec_parse_message
+ * does it.  The context is owned by the plan source and destroyed with it.
+ *
+ * This is statement level JIT only.  A function is never compiled as a whole:
+ * its control flow, variables and exception handling stay in the PL/pgSQL
+ * interpreter, which runs each jitted statement like any other.  A statement
+ * that rewrite rules turn into several statements is not jitted either.
+ */
+static void _SPI_try_mot_jit_codegen(CachedPlanSource *plansource, List *stmt_list)
+{
+    if (IS_PGXC_COORDINATOR || !JitExec::IsMotCodegenEnabled()) {
+        return;
+    }
+
+    if (list_length(stmt_list) != 1) {
+        if (JitExec::IsMotCodegenPrintEnabled()) {
+            elog(LOG, "Skipping MOT jitted code for rewritten SPI query: %s\n", plansource->query_string);
+        }
+        return;
+    }
+
+    Query *query = (Query *)linitial(stmt_list);
+    if (!IsA(query, Query) || query->commandType == CMD_UTILITY) {
+        return;
+    }
+
+    StorageEngineType storageEngineType = SE_TYPE_UNSPECIFIED;
+    CheckTablesStorageEngine(query, &storageEngineType);
+    if (storageEngineType != SE_TYPE_MOT) {
+        return;
+    }
+    plansource->storageEngineType = storageEngineType;
+
+    if (JitExec::IsMotCodegenPrintEnabled()) {
+        elog(LOG, "Attempting to generate MOT jitted code for SPI query: %s\n", plansource->query_string);
+    }
+
+    JitExec::JitPlan *jitPlan = JitExec::IsJittable(query, plansource->query_string);
+    if (jitPlan != NULL) {
+        plansource->mot_jit_context = JitExec::JitCodegenQuery(query, plansource->query_string, jitPlan);
+        if ((plansource->mot_jit_context == NULL) && JitExec::IsMotCodegenPrintEnabled()) {
+            elog(LOG, "Failed to generate jitted MOT function for SPI query %s\n", plansource->query_string);
+        }
+    }
+}
+#endif
+
 /*
  * Parse, but don't analyze, a querystring.
  *
@@ -2333,8 +2397,15 @@ static int _SPI_execute_plan(SPIPlanPtr plan, ParamListInfo paramLI, Snapshot sn
                     snap = InvalidSnapshot;
                 }
 
+#ifdef ENABLE_MOT
+                /* the JIT context belongs to the single statement of its plan source */
+                JitExec::JitContext *mot_jit_context = (stmt_list->length == 1) ? cplan->mot_jit_context : NULL;
+                qdesc = CreateQueryDesc((PlannedStmt *)stmt, plansource->query_string, snap, crosscheck_snapshot, dest,
+                    paramLI, 0, mot_jit_context);
+#else
                 qdesc = CreateQueryDesc((PlannedStmt *)stmt, plansource->query_string, snap, crosscheck_snapshot, dest,
                     paramLI, 0);
+#endif
                 res = _SPI_pquery(qdesc, fire_triggers, canSetTag ? tcount : 0, from_lock);
                 FreeQueryDesc(qdesc);
             } else {
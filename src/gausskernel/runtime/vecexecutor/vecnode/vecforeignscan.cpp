@@ -96,7 +96,14 @@ VecForeignScanState* ExecInitVecForeignScan(VecForeignScan* node, EState* estate
         plan_state->ps_ExprContext,
         plan_state->ps_ResultTupleSlot,
         scan_state->ss.ss_ScanTupleSlot->tts_tupleDescriptor);
-    ExecAssignVectorForExprEval(plan_state->ps_ExprContext);
+#ifdef ENABLE_MOT
+    /* No expression context is created for MOT scans when the query is executed by MOT JIT. */
+    if (plan_state->ps_ExprContext != NULL) {
+#endif
+        ExecAssignVectorForExprEval(plan_state->ps_ExprContext);
+#ifdef ENABLE_MOT
+    }
+#endif
     return scan_state;
 }
 
@@ -105,6 +105,8 @@ static relopt_bool boolRelOpts[] = {
     {{ "hashbucket", "Enables hashbucket in this relation", RELOPT_KIND_HEAP }, false },
     {{ "primarynode", "Enables primarynode for replicatition relation", RELOPT_KIND_HEAP }, false },
     {{ "on_commit_delete_rows", "global temp table on commit options", RELOPT_KIND_HEAP}, true},
+    {{ "deduplicate_items", "Enables deduplication of equal leaf tuples for this btree index", RELOPT_KIND_BTREE },
+     true },
     /* list terminator */
     {{NULL}}
 };
@@ -1603,6 +1605,7 @@ bytea *default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
         { "hashbucket", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, hashbucket) },
         { "primarynode", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, primarynode) },
         { "on_commit_delete_rows", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, on_commit_delete_rows)},
+        { "deduplicate_items", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, deduplicate_items)},
         { "wait_clean_gpi", RELOPT_TYPE_STRING, offsetof(StdRdOptions, wait_clean_gpi)}
     };
 
@@ -338,6 +338,15 @@ private:
      */
     bool loadFile(int fileID);
 
+    /*
+     * @Description: check whether a file is large enough to be shared by the
+     *     SMP workers, each of them reading a part of its stripes.
+     * @IN split: the file to be checked
+     * @Return: true if the file is shared by all the SMP workers
+     * @See also: StripeOfOtherSmpWorker
+     */
+    bool isSharedSplit(const SplitInfo *split) const;
+
     /*
      * @Description: check whether the file is satisfied.
      * @IN itemPtr: the file id to be load
@@ -900,8 +909,8 @@ void ReaderImpl::dynamicAssignSplits()
 
         if (skip) {
             readerState->splitList = list_delete(readerState->splitList, sp);
-        } else if (u_sess->stream_cxt.producer_dop > 1) {
-            /* split again for SMP */
+        } else if (u_sess->stream_cxt.producer_dop > 1 && !isSharedSplit(sp)) {
+            /* split again for SMP, the large files are kept by all the workers and split by stripe */
             if ((count % u_sess->stream_cxt.producer_dop) != u_sess->stream_cxt.smp_id) {
                 readerState->splitList = list_delete(readerState->splitList, sp);
             }
@@ -1264,6 +1273,10 @@ bool ReaderImpl::loadFile(int fileID)
         return false;
     }
 
+    /* The tids to fetch are spread over the file, read it alone. */
+    readerState->stripeSplitDop = 1;
+    readerState->stripeSplitId = 0;
+
     currentFileName = readerState->currentSplit->filePath;
     setPartinfoAndDesc(currentFileName);
     reader->setBatchCapacity(1);
@@ -1282,6 +1295,16 @@ bool ReaderImpl::loadFile(int fileID)
     return true;
 }
 
+bool ReaderImpl::isSharedSplit(const SplitInfo *split) const
+{
+    /*
+     * Without any column to read the rows of the file are counted from the
+     * footer, which cannot be divided among the workers.
+     */
+    return u_sess->stream_cxt.producer_dop > 1 && !noRequireCol && split != NULL &&
+           split->ObjectSize >= DFS_SMP_SHARED_SPLIT_SIZE;
+}
+
 bool ReaderImpl::checkAndLoadFile(char *currentFileName)
 {
     bool satisfied = true;
@@ -1348,6 +1371,14 @@ bool ReaderImpl::loadNextFile()
         } else {
             readerState->currentFileID = -1;
         }
+
+        if (isSharedSplit(readerState->currentSplit)) {
+            readerState->stripeSplitDop = u_sess->stream_cxt.producer_dop;
+            readerState->stripeSplitId = u_sess->stream_cxt.smp_id;
+        } else {
+            readerState->stripeSplitDop = 1;
+            readerState->stripeSplitId = 0;
+        }
         setPartinfoAndDesc(currentFileName);
     } while (!checkAndLoadFile(currentFileName));
 
@@ -300,6 +300,9 @@ private:
 
     /* used in OBS foreign table */
     char *fileName;
+
+    /* Reuses the datums of the dictionary entries met in the batch being filled. */
+    DfsStringDatumCache stringCache;
 };
 
 /* do nothing */
@@ -1165,6 +1168,12 @@ bool OrcReaderImpl::tryStripeSkip(uint64_t &rowsSkip, uint64_t &rowsCross)
         numberOfStrides = (rowsInCurrentStripe + (rowsInStride - 1)) / rowsInStride;
         Assert(numberOfStrides > 0);
 
+        /* The stripe is read by another SMP worker sharing the file. */
+        if (StripeOfOtherSmpWorker(readerState, currentStripeIdx)) {
+            skipCurrentStripe(rowsSkip, rowsCross);
+            return true;
+        }
+
         if (hasRestriction() && !checkPredicateOnCurrentStripe()) {
             skipCurrentStripe(rowsSkip, rowsCross);
             return true;
@@ -2123,6 +2132,60 @@ void OrcColumnReaderImpl<fieldKind>::fillScalarVectorInternal(uint64_t numValues
     vec->m_rows = offset;
 }
 
+template <>
+template <bool hasNull, bool encoded>
+void OrcColumnReaderImpl<orc::STRING>::fillScalarVectorInternal(uint64_t numValues, bool *isSelected,
+                                                                ScalarVector *vec)
+{
+    char *notNull = primitiveBatch->notNull.data();
+    char **values = static_cast<orc::StringVectorBatch *>(primitiveBatch.get())->data.data();
+    int64_t *lengths = static_cast<orc::StringVectorBatch *>(primitiveBatch.get())->length.data();
+    int32_t encoding = readerState->fdwEncoding;
+    int32_t offset = vec->m_rows;
+    int32_t errorCount = 0;
+    bool meetError = false;
+    bool internalNull = false;
+    Datum cachedValue = 0;
+
+    stringCache.NextBatch();
+
+    for (uint64_t i = 0; i < numValues; i++) {
+        if (isSelected[i]) {
+            internalNull = false;
+            meetError = false;
+
+            Assert(offset < BatchMaxSize);
+            if (hasNull && !notNull[i]) {
+                vec->SetNull(offset);
+            } else if (stringCache.Lookup(values[i], lengths[i], cachedValue, meetError)) {
+                /* an earlier row of the batch holds the same dictionary entry, nulls are never cached */
+                vec->m_vals[static_cast<uint32_t>(offset)] = cachedValue;
+            } else {
+                Datum dValue = convertToDatumFunc(primitiveBatch.get(), i, var->vartypmod, scale, epochOffsetDiff,
+                                                  internalNull, encoding, checkEncodingLevel, meetError);
+                if (internalNull) {
+                    vec->SetNull(offset);
+                } else {
+                    if (encoded) {
+                        (void)vec->AddVar(dValue, offset);
+                    } else {
+                        vec->m_vals[static_cast<uint32_t>(offset)] = dValue;
+                    }
+                    stringCache.Remember(vec->m_vals[static_cast<uint32_t>(offset)], meetError);
+                }
+            }
+
+            offset++;
+            if (meetError) {
+                errorCount++;
+            }
+        }
+    }
+    readerState->dealWithCount += offset - vec->m_rows;
+    readerState->incompatibleCount += errorCount;
+    vec->m_rows = offset;
+}
+
 template <>
 template <bool hasNull, bool encoded>
 void OrcColumnReaderImpl<orc::DECIMAL>::fillScalarVectorInternal(uint64_t numValues, bool *isSelected,
@@ -2201,6 +2264,12 @@ void OrcColumnReaderImpl<orc::CHAR>::fillScalarVectorInternal(uint64_t numValues
     /* temp value to store whether the invalid string is found */
     bool meetError = false;
 
+    /* the datum and check result of a string already materialized in this batch */
+    Datum cachedValue = 0;
+    bool cachedError = false;
+
+    stringCache.NextBatch();
+
     for (uint64_t i = 0; i < numValues; i++) {
         if (isSelected[i]) {
             Assert(offset < BatchMaxSize);
@@ -2212,6 +2281,10 @@ void OrcColumnReaderImpl<orc::CHAR>::fillScalarVectorInternal(uint64_t numValues
                 /* Check compatibility and convert '' into null if the db is A_FORMAT. */
                 if (A_FORMAT == u_sess->attr.attr_sql.sql_compatibility && 0 == length) {
                     vec->SetNull(offset);
+                } else if (stringCache.Lookup(values[i], length, cachedValue, cachedError)) {
+                    /* an earlier row of the batch holds the same dictionary entry */
+                    vec->m_vals[offset] = cachedValue;
+                    errorCount += cachedError ? 1 : 0;
                 } else {
                     char *tmpValue = values[i];
 
@@ -2275,6 +2348,7 @@ void OrcColumnReaderImpl<orc::CHAR>::fillScalarVectorInternal(uint64_t numValues
                             break;
                         }
                     }
+                    stringCache.Remember(vec->m_vals[offset], meetError);
                 }
             }
             offset++;
@@ -2313,6 +2387,12 @@ void OrcColumnReaderImpl<orc::VARCHAR>::fillScalarVectorInternal(uint64_t numVal
     /* temp value to store whether the invalid string is found */
     bool meetError = false;
 
+    /* the datum and check result of a string already materialized in this batch */
+    Datum cachedValue = 0;
+    bool cachedError = false;
+
+    stringCache.NextBatch();
+
     for (uint64_t i = 0; i < numValues; i++) {
         if (isSelected[i]) {
             Assert(offset < BatchMaxSize);
@@ -2324,6 +2404,10 @@ void OrcColumnReaderImpl<orc::VARCHAR>::fillScalarVectorInternal(uint64_t numVal
                 /* Check compatibility and convert '' into null if the db is A_FORMAT. */
                 if (A_FORMAT == u_sess->attr.attr_sql.sql_compatibility && 0 == length) {
                     vec->SetNull(offset);
+                } else if (stringCache.Lookup(values[i], length, cachedValue, cachedError)) {
+                    /* an earlier row of the batch holds the same dictionary entry */
+                    vec->m_vals[offset] = cachedValue;
+                    errorCount += cachedError ? 1 : 0;
                 } else {
                     char *tmpValue = values[i];
 
@@ -2374,6 +2458,7 @@ void OrcColumnReaderImpl<orc::VARCHAR>::fillScalarVectorInternal(uint64_t numVal
                             break;
                         }
                     }
+                    stringCache.Remember(vec->m_vals[offset], meetError);
                 }
             }
 
@@ -689,6 +689,7 @@ private:
 private:
     void fillScalarVectorInternalForChar(uint64_t numRowsToRead, const bool *isSelected, ScalarVector *vec);
     void fillScalarVectorInternalForVarchar(uint64_t numRowsToRead, const bool *isSelected, ScalarVector *vec);
+    void fillScalarVectorInternalForText(uint64_t numRowsToRead, const bool *isSelected, ScalarVector *vec);
     void fillScalarVectorInternalForOthers(uint64_t numRowsToRead, const bool *isSelected, ScalarVector *vec);
 
     inline bool hasNullValues()
@@ -1048,6 +1049,10 @@ private:
     int16_t m_repLevels[BatchMaxSize];
 
     std::list<uint8_t *> m_dataBuffers;
+
+    /* reuses the datums of the dictionary entries met in the batch being filled */
+    DfsStringDatumCache m_stringCache;
+
     std::unique_ptr<parquet::ParquetFileReader> m_realParquetFileReader;
     std::shared_ptr<parquet::RowGroupReader> m_rowGroupReader;
     std::shared_ptr<parquet::ColumnReader> m_columnReader;
@@ -1075,7 +1080,7 @@ void ParquetColumnReaderImpl<parquet::ByteArrayReader>::fillScalarVectorInternal
             fillScalarVectorInternalForVarchar(numRowsToRead, isSelected, vec);
             break;
         case TEXTOID:
-            fillScalarVectorInternalForOthers(numRowsToRead, isSelected, vec);
+            fillScalarVectorInternalForText(numRowsToRead, isSelected, vec);
             break;
         default:
             ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED), errmodule(MOD_PARQUET),
@@ -1100,6 +1105,12 @@ void ParquetColumnReaderImpl<ReaderType>::fillScalarVectorInternalForChar(
     /* temp value to store whether the invalid string is found */
     bool meetError = false;
 
+    /* the datum and check result of a string already materialized in this batch */
+    Datum cachedValue = 0;
+    bool cachedError = false;
+
+    m_stringCache.NextBatch();
+
     /* the typemod of the current var */
     int32_t atttypmod = m_var->vartypmod;
 
@@ -1119,6 +1130,10 @@ void ParquetColumnReaderImpl<ReaderType>::fillScalarVectorInternalForChar(
                 /* Check compatibility and convert '' into null if the db is A_FORMAT. */
                 if (u_sess->attr.attr_sql.sql_compatibility == A_FORMAT && length == 0) {
                     vec->SetNull(offset);
+                } else if (m_stringCache.Lookup((const char *)value.ptr, length, cachedValue, cachedError)) {
+                    /* an earlier row of the batch holds the same dictionary entry */
+                    vec->m_vals[offset] = cachedValue;
+                    errorCount += cachedError ? 1 : 0;
                 } else {
                     char *tmpValue = (char *)value.ptr;
 
@@ -1181,6 +1196,7 @@ void ParquetColumnReaderImpl<ReaderType>::fillScalarVectorInternalForChar(
                         default: {
                         }
                     }
+                    m_stringCache.Remember(vec->m_vals[offset], meetError);
                 }
             }
             offset++;
@@ -1208,6 +1224,12 @@ void ParquetColumnReaderImpl<ReaderType>::fillScalarVectorInternalForVarchar(uin
     /* temp value to store whether the invalid string is found */
     bool meetError = false;
 
+    /* the datum and check result of a string already materialized in this batch */
+    Datum cachedValue = 0;
+    bool cachedError = false;
+
+    m_stringCache.NextBatch();
+
     /* the typemod of the current var */
     int32_t atttypmod = m_var->vartypmod;
 
@@ -1227,6 +1249,10 @@ void ParquetColumnReaderImpl<ReaderType>::fillScalarVectorInternalForVarchar(uin
                 /* Check compatibility and convert '' into null if the db is A_FORMAT. */
                 if (u_sess->attr.attr_sql.sql_compatibility == A_FORMAT && length == 0) {
                     vec->SetNull(offset);
+                } else if (m_stringCache.Lookup((const char *)value.ptr, length, cachedValue, cachedError)) {
+                    /* an earlier row of the batch holds the same dictionary entry */
+                    vec->m_vals[offset] = cachedValue;
+                    errorCount += cachedError ? 1 : 0;
                 } else {
                     char *tmpValue = (char *)value.ptr;
 
@@ -1274,9 +1300,61 @@ void ParquetColumnReaderImpl<ReaderType>::fillScalarVectorInternalForVarchar(uin
                         default: {
                         }
                     }
+                    m_stringCache.Remember(vec->m_vals[offset], meetError);
+                }
+            }
+            offset++;
+        }
+    }
+
+    m_readerState->dealWithCount += offset - vec->m_rows;
+    m_readerState->incompatibleCount += errorCount;
+    vec->m_rows = offset;
+}
+
+template <typename ReaderType>
+void ParquetColumnReaderImpl<ReaderType>::fillScalarVectorInternalForText(uint64_t numRowsToRead,
+    const bool *isSelected, ScalarVector *vec)
+{
+    int32_t encoding = m_readerState->fdwEncoding;
+    /* the offset in the current vector batch to be filled */
+    int32_t offset = vec->m_rows;
+    int32_t errorCount = 0;
+    bool meetError = false;
+    bool internalNull = false;
+    Datum cachedValue = 0;
+
+    m_stringCache.NextBatch();
+
+    for (uint64_t i = 0; i < numRowsToRead; ++i) {
+        if (isSelected[i]) {
+            Assert(offset < BatchMaxSize);
+
+            internalNull = false;
+            meetError = false;
+
+            if (hasNullValues() && isNullValue(i)) {
+                vec->SetNull(offset);
+            } else if (m_stringCache.Lookup((const char *)m_values[i].ptr, m_values[i].len, cachedValue, meetError)) {
+                /* an earlier row of the batch holds the same dictionary entry, nulls are never cached */
+                vec->m_vals[offset] = cachedValue;
+            } else {
+                Datum dValue = m_convertToDatumFunc(m_values, i, m_desc->physical_type(), m_desc->type_scale(),
+                                                    m_desc->type_length(), internalNull, encoding, m_checkEncodingLevel,
+                                                    meetError);
+
+                if (internalNull) {
+                    vec->SetNull(offset);
+                } else {
+                    vec->m_vals[offset] = dValue;
+                    m_stringCache.Remember(dValue, meetError);
                 }
             }
+
             offset++;
+            if (meetError) {
+                errorCount++;
+            }
         }
     }
 
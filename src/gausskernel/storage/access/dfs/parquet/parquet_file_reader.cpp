@@ -212,6 +212,12 @@ void ParquetFileReader::createRowGroupReaderWhenNecessary()
 bool ParquetFileReader::tryToSkipCurrentRowGroup(uint64_t &rowsSkip, uint64_t &rowsCross)
 {
     if (isStartOfCurrentRowGroup()) {
+        /* The row group is read by another SMP worker sharing the file. */
+        if (StripeOfOtherSmpWorker(m_readerState, m_currentRowGroupIndex)) {
+            skipCurrentRowGroup(rowsSkip, rowsCross);
+            return true;
+        }
+
         if (hasRestriction() && !checkPredicateOnCurrentRowGroup()) {
             skipCurrentRowGroup(rowsSkip, rowsCross);
             return true;
@@ -251,7 +251,8 @@ static void hbkt_tbl_rescan(TableScanDesc scan, ScanKey key)
 static void try_init_bucket_parallel(TableScanDesc nextBktScan, ScanState *sstate)
 {
     if (sstate != NULL && *(NodeTag *)sstate == T_SeqScanState) {
-        scan_handler_tbl_init_parallel_seqscan(nextBktScan, sstate->ps.plan->dop, sstate->partScanDirection);
+        scan_handler_tbl_init_parallel_seqscan(nextBktScan, sstate->ps.plan->dop, sstate->partScanDirection,
+            sstate->ps.plan->plan_node_id);
         nextBktScan->rs_ss_accessor = sstate->ss_scanaccessor;
     }
 }
@@ -676,12 +677,12 @@ void scan_handler_tbl_restrpos(TableScanDesc scan)
     }
 }
 
-void scan_handler_tbl_init_parallel_seqscan(TableScanDesc scan, int32 dop, ScanDirection dir)
+void scan_handler_tbl_init_parallel_seqscan(TableScanDesc scan, int32 dop, ScanDirection dir, int plan_node_id)
 {
     if (unlikely(RELATION_OWN_BUCKET(scan->rs_rd))) {
-        tableam_scan_init_parallel_seqscan(((HBktTblScanDesc)scan)->currBktScan, dop, dir);
+        tableam_scan_init_parallel_seqscan(((HBktTblScanDesc)scan)->currBktScan, dop, dir, plan_node_id);
     } else {
-        tableam_scan_init_parallel_seqscan(scan, dop, dir);
+        tableam_scan_init_parallel_seqscan(scan, dop, dir, plan_node_id);
     }
 }
 
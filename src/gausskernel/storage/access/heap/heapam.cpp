@@ -60,6 +60,7 @@
 #include "commands/dbcommands.h"
 #include "commands/verify.h"
 #include "commands/matview.h"
+#include "distributelayer/streamCore.h"
 #include "distributelayer/streamMain.h"
 #include "executor/nodeModifyTable.h"
 #include "miscadmin.h"
@@ -270,6 +271,8 @@ static void initscan(HeapScanDesc scan, ScanKey key, bool is_rescan) {
     scan->rs_base.rs_cblock = InvalidBlockNumber;
     scan->rs_base.rs_ss_accessor = NULL;
     scan->dop = 1;
+    scan->rs_parallel = NULL;
+    scan->rs_chunkend = InvalidBlockNumber;
 
     /* we don't have a marked position... */
     ItemPointerSetInvalid(&(scan->rs_mctid));
@@ -438,6 +441,51 @@ void heap_prefetch(HeapScanDesc scan, ScanDirection dir) {
     ADIO_END();
 }
 
+/*
+ * @Description: Claim the next chunk of blocks from the allocator shared by the
+ * smp workers. Chunks are PARALLEL_SCAN_GAP blocks at most and shrink as the
+ * scan nears its end, so that workers run out of work at about the same time.
+ * A chunk never wraps around the end of the relation.
+ *
+ * @param[IN] scan: heap scan describtion.
+ * @param[OUT] page: first page of the chunk.
+ * @return bool: false if all blocks have been handed out.
+ */
+static bool heap_parallel_next_chunk(HeapScanDesc scan, BlockNumber& page)
+{
+    ParallelBlockAlloc pba = scan->rs_parallel;
+    uint32 nallocated = pg_atomic_read_u32(&pba->nallocated);
+    BlockNumber start;
+    BlockNumber len;
+
+    do {
+        if (nallocated >= pba->nblocks) {
+            return false;
+        }
+
+        len = (pba->nblocks - nallocated) / ((BlockNumber)scan->dop * PARALLEL_SCAN_RAMPDOWN);
+        len = Max((BlockNumber)1, Min((BlockNumber)PARALLEL_SCAN_GAP, len));
+        start = (pba->startblock + nallocated) % pba->nblocks;
+        len = Min(len, pba->nblocks - start);
+    } while (!pg_atomic_compare_exchange_u32(&pba->nallocated, &nallocated, nallocated + len));
+
+    page = start;
+    scan->rs_chunkend = start + len;
+
+    ADIO_RUN()
+    {
+        /* the chunk is known in full, so prefetch it at once */
+        SeqScanAccessor* accessor = scan->rs_base.rs_ss_accessor;
+        if (accessor != NULL) {
+            PageRangePrefetch(scan->rs_base.rs_rd, MAIN_FORKNUM, start, len, 0, 0);
+            accessor->sa_last_prefbf = scan->rs_chunkend - 1;
+        }
+    }
+    ADIO_END();
+
+    return true;
+}
+
 /*
  * @Description: Calculate the next page number.
  *
@@ -449,7 +497,17 @@ void heap_prefetch(HeapScanDesc scan, ScanDirection dir) {
 FORCE_INLINE
 bool next_page(HeapScanDesc scan, ScanDirection dir, BlockNumber& page) {
     bool finished = false;
-    if (scan->dop > 1) {
+    if (scan->rs_parallel != NULL && ForwardScanDirection == dir) {
+        page++;
+        if (page >= scan->rs_chunkend) {
+            finished = !heap_parallel_next_chunk(scan, page);
+        }
+
+        /* workers cover the relation together, any of them may report */
+        if (!finished && scan->rs_base.rs_syncscan) {
+            ss_report_location(scan->rs_base.rs_rd, page);
+        }
+    } else if (scan->dop > 1) {
         if (BackwardScanDirection == dir) {
             finished = (page == 0);
             if (finished)
@@ -8328,7 +8386,7 @@ void PushHeapPageToDataQueue(Buffer buffer) {
 }
 
 void heap_init_parallel_seqscan(TableScanDesc sscan, int32 dop,
-                                ScanDirection dir) {
+                                ScanDirection dir, int plan_node_id) {
     HeapScanDesc scan = (HeapScanDesc)sscan;
 
     if (!scan || scan->rs_base.rs_nblocks == 0) {
@@ -8341,6 +8399,29 @@ void heap_init_parallel_seqscan(TableScanDesc sscan, int32 dop,
 
     scan->dop = dop;
 
+    /*
+     * Forward scans share a block allocator with the other workers, so a
+     * worker held up by expensive pages does not leave the others idle. The
+     * first worker to join fixes the relation size and the syncscan start
+     * point for everybody. Rescans, backward scans and range scans in
+     * redistribution keep the static PARALLEL_SCAN_GAP striping below.
+     */
+    if (ScanDirectionIsForward(dir) && !scan->rs_base.rs_rangeScanInRedis.isRangeScanInRedis &&
+        dop <= MAX_QUERY_DOP) {
+        scan->rs_parallel = StreamNodeGroup::AttachParallelScan(plan_node_id, &scan->rs_base.rs_rd->rd_node,
+            (int)u_sess->stream_cxt.smp_id, scan->rs_base.rs_nblocks,
+            scan->rs_base.rs_syncscan ? scan->rs_base.rs_startblock : 0);
+        if (scan->rs_parallel != NULL) {
+            scan->rs_base.rs_nblocks = scan->rs_parallel->nblocks;
+            if (!heap_parallel_next_chunk(scan, scan->rs_base.rs_startblock)) {
+                /* the other workers have taken every block already */
+                scan->rs_base.rs_startblock = 0;
+                scan->rs_base.rs_nblocks = 0;
+            }
+            return;
+        }
+    }
+
     uint32 paral_blocks = u_sess->stream_cxt.smp_id * PARALLEL_SCAN_GAP;
 
     /* If not enough pages to divide into every worker. */
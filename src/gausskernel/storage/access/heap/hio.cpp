@@ -100,18 +100,66 @@ static Buffer ReadBufferBI(Relation relation, BlockNumber target_block, BulkInse
     return buffer;
 }
 
+/*
+ * Hand the pages left in this backend's run of pre-extended blocks to the
+ * FSM when the run is abandoned, so they aren't lost until the next vacuum.
+ * Pages at or beyond nblocks are being truncated away and are skipped, pass
+ * InvalidBlockNumber to keep them all.  Besides a new bulk extension and a
+ * truncation, the run is released when the relation is closed for the last
+ * time in this backend (RelationClose, releaseDummyRelation).
+ * Nobody has used the pages since RelationAddExtraBlocks() set them up, so
+ * they are recorded as empty; the FSM is only a hint anyway.
+ */
+void RelationReleaseBulkExtendBlocks(Relation relation, BlockNumber nblocks)
+{
+    BlockNumber block_num;
+    BlockNumber first_block;
+    BlockNumber end_block;
+    Size freespace = BLCKSZ - SizeOfHeapPageHeaderData - sizeof(ItemIdData);
+
+    if (!RelationHasBulkExtendBlock(relation)) {
+        if (relation->rd_smgr != NULL) {
+            relation->rd_smgr->smgr_bulk_next = InvalidBlockNumber;
+            relation->rd_smgr->smgr_bulk_end = InvalidBlockNumber;
+        }
+        return;
+    }
+
+    first_block = relation->rd_smgr->smgr_bulk_next;
+    end_block = Min(relation->rd_smgr->smgr_bulk_end, nblocks);
+    relation->rd_smgr->smgr_bulk_next = InvalidBlockNumber;
+    relation->rd_smgr->smgr_bulk_end = InvalidBlockNumber;
+    if (first_block >= end_block) {
+        return;
+    }
+
+    for (block_num = first_block; block_num < end_block; block_num++) {
+        RecordPageWithFreeSpace(relation, block_num, freespace);
+    }
+    UpdateFreeSpaceMap(relation, first_block, end_block - 1, freespace);
+}
+
 /*
  * Extend a relation by multiple blocks to avoid future contention on the
  * relation extension lock.  Our goal is to pre-extend the relation by an
  * amount which ramps up as the degree of contention ramps up, but limiting
  * the result to some sane overall value.
+ *
+ * The file is extended by the whole chunk at once, and the new pages are
+ * then set up in shared buffers without reading them.  For heaps, our share
+ * of the chunk is kept out of the FSM as this backend's own run of target
+ * pages, so that the waiters, which get the rest through the FSM, don't
+ * pile up on the pages we are about to fill.
  */
 void RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
 {
     Page page;
     BlockNumber block_num = InvalidBlockNumber;
     BlockNumber first_block = InvalidBlockNumber;
+    BlockNumber fsm_block = InvalidBlockNumber;
+    BlockNumber end_block;
     int extra_blocks = 0;
+    int own_blocks = 0;
     int lock_waiters = 0;
     Size freespace = 0;
     Buffer buffer;
@@ -145,14 +193,18 @@ void RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
            } else {
                extra_blocks = Min(512, lock_waiters * 20);
            }
+        own_blocks = extra_blocks / (lock_waiters + 1);
     }
 
-    while (extra_blocks-- >= 0) {
-        /* Ouch - an unnecessary lseek() each time through the loop! */
-        buffer = ReadBufferBI(relation, P_NEW, bistate);
+    first_block = RelationGetNumberOfBlocks(relation);
+    end_block = first_block + (BlockNumber)extra_blocks + 1;
+    RelationOpenSmgr(relation);
+    smgrextendbatch(relation->rd_smgr, MAIN_FORKNUM, first_block, end_block - first_block, false);
 
-        /* Extend by one page. */
-        LockBuffer(buffer, BUFFER_LOCK_EXCLUSIVE);
+    for (block_num = first_block; block_num < end_block; block_num++) {
+        /* The block is already in the file, no need to read it */
+        buffer = ReadBufferExtended(relation, MAIN_FORKNUM, block_num, RBM_ZERO_AND_LOCK,
+                                    bistate ? bistate->strategy : NULL);
         page = BufferGetPage(buffer);
         if (!RelationIsIndex(relation)) {
             phdr = (HeapPageHeader)page;
@@ -162,7 +214,6 @@ void RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
             MarkBufferDirty(buffer);
         }
 
-        block_num = BufferGetBlockNumber(buffer);
         if (!RelationIsIndex(relation)) {
             freespace = PageGetHeapFreeSpace(page);
         } else {
@@ -170,9 +221,14 @@ void RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
         }
         UnlockReleaseBuffer(buffer);
 
-        /* Remember first block number thus added. */
-        if (first_block == InvalidBlockNumber) {
-            first_block = block_num;
+        /* Our own run is taken from the end of the chunk, keep it out of the FSM */
+        if (block_num >= end_block - (BlockNumber)own_blocks) {
+            continue;
+        }
+
+        /* Remember first block number thus added to the FSM. */
+        if (fsm_block == InvalidBlockNumber) {
+            fsm_block = block_num;
         }
 
         /*
@@ -183,6 +239,12 @@ void RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
         RecordPageWithFreeSpace(relation, block_num, freespace);
     }
 
+    if (own_blocks > 0) {
+        /* A run we still had is replaced, don't lose its pages */
+        RelationReleaseBulkExtendBlocks(relation, first_block);
+        RelationSetBulkExtendBlocks(relation, end_block - (BlockNumber)own_blocks, end_block);
+    }
+
     /*
      * Updating the upper levels of the free space map is too expensive
      * to do for every block, but it's worth doing once at the end to make
@@ -193,7 +255,7 @@ void RelationAddExtraBlocks(Relation relation, BulkInsertState bistate)
      * last block we added as if it were the freespace value for every block
      * we added.  That's actually true, because they're all equally empty.
      */
-    UpdateFreeSpaceMap(relation, first_block, block_num, freespace);
+    UpdateFreeSpaceMap(relation, fsm_block, end_block - (BlockNumber)own_blocks - 1, freespace);
 }
 
 /*
@@ -538,10 +600,17 @@ loop:
 
         /*
          * Update FSM as to condition of this page, and ask for another page
-         * to try.
+         * to try.  If we still have pages of our own from a bulk extension,
+         * take the next one instead; it is not in the FSM, so only the leaf
+         * of the page we leave is updated, not searched.
          */
-        target_block = RecordAndGetPageWithFreeSpace(relation, target_block, page_free_space,
-                                                     len + save_free_space + extralen);
+        if (RelationHasBulkExtendBlock(relation) && end_rel_block == InvalidBlockNumber) {
+            RecordPageWithFreeSpace(relation, target_block, page_free_space);
+            target_block = relation->rd_smgr->smgr_bulk_next++;
+        } else {
+            target_block = RecordAndGetPageWithFreeSpace(relation, target_block, page_free_space,
+                                                         len + save_free_space + extralen);
+        }
     }
 
     /*
@@ -18,6 +18,7 @@
 
 #include "access/heapam.h"
 #include "access/transam.h"
+#include "access/visibilitymap.h"
 #include "access/xlog.h"
 #include "miscadmin.h"
 #include "pgstat.h"
@@ -52,6 +53,7 @@ static void heap_prune_record_prunable(PruneState *prstate, TransactionId xid);
 static void heap_prune_record_redirect(PruneState *prstate, OffsetNumber offnum, OffsetNumber rdoffnum);
 static void heap_prune_record_dead(PruneState *prstate, OffsetNumber offnum);
 static void heap_prune_record_unused(PruneState *prstate, OffsetNumber offnum);
+static bool heap_page_freeze_opt(Relation relation, Buffer buffer, Buffer vmbuffer, TransactionId oldest_xmin);
 
 /*
  * Optionally prune and repair fragmentation in the specified page.
@@ -67,12 +69,17 @@ static void heap_prune_record_unused(PruneState *prstate, OffsetNumber offnum);
  *
  * OldestXmin is the cutoff XID used to distinguish whether tuples are DEAD
  * or RECENTLY_DEAD (see HeapTupleSatisfiesVacuum).
+ *
+ * If pruning changed the page and everything left on it is visible to all,
+ * the page is frozen and marked all-visible right away, see
+ * heap_page_freeze_opt.
  */
 void heap_page_prune_opt(Relation relation, Buffer buffer)
 {
     Page page = BufferGetPage(buffer);
     Size minfree;
     TransactionId oldest_xmin;
+    Buffer vmbuffer = InvalidBuffer;
     /*
      * We can't write WAL in recovery mode, so there's no point trying to
      * clean the page. The master will likely issue a cleaning WAL record soon
@@ -122,6 +129,8 @@ void heap_page_prune_opt(Relation relation, Buffer buffer)
     minfree = RelationGetTargetPageFreeSpace(relation, HEAP_DEFAULT_FILLFACTOR);
     minfree = Max(minfree, BLCKSZ / 10);
     if (PageIsFull(page) || PageGetHeapFreeSpace(page) < minfree) {
+        bool freeze = false;
+
         /* OK, try to get exclusive buffer lock */
         if (!ConditionalLockBufferForCleanup(buffer))
             return;
@@ -136,12 +145,139 @@ void heap_page_prune_opt(Relation relation, Buffer buffer)
             TransactionId ignore = InvalidTransactionId; /* return value not needed */
 
             /* OK to prune */
-            (void)heap_page_prune(relation, buffer, oldest_xmin, true, &ignore, true);
+            if (heap_page_prune(relation, buffer, oldest_xmin, true, &ignore, true) > 0)
+                freeze = heap_page_freeze_opt(relation, buffer, InvalidBuffer, oldest_xmin);
         }
 
         /* And release buffer lock */
         LockBuffer(buffer, BUFFER_LOCK_UNLOCK);
+
+        if (!freeze)
+            return;
+
+        /*
+         * The page can be marked all-visible.  Only now read the visibility
+         * map page, without the lock since that may do I/O, and never extend
+         * the map from here: if the page isn't there yet, VACUUM will do it.
+         * The page may change while it is unlocked, so it is checked again.
+         */
+        (void)visibilitymap_test(relation, BufferGetBlockNumber(buffer), &vmbuffer);
+        if (!BufferIsValid(vmbuffer))
+            return;
+
+        if (ConditionalLockBufferForCleanup(buffer)) {
+            (void)heap_page_freeze_opt(relation, buffer, vmbuffer, oldest_xmin);
+            LockBuffer(buffer, BUFFER_LOCK_UNLOCK);
+        }
+        ReleaseBuffer(vmbuffer);
+    }
+}
+
+/*
+ * Freeze the tuples of a just pruned page and mark it all-visible, if every
+ * tuple left on it is visible to all.
+ *
+ * Pruning has already dirtied and WAL-logged the page, so doing this now
+ * costs one small freeze record and a visibility map update, instead of
+ * another full read, write and likely full-page image when VACUUM comes by
+ * to freeze the page for wraparound. Pages holding LP_DEAD items still need
+ * VACUUM for their index entries and are left alone, and so are compressed
+ * pages.
+ *
+ * The freeze cutoff is just past the newest xmin on the page, which is also
+ * the cutoff for the visibility map, so a standby sees the same conflict as
+ * for setting the visibility map bit.
+ *
+ * Caller must hold buffer cleanup lock.  If vmbuffer is invalid, the page is
+ * only checked: true means it qualifies, and the caller should pin the map
+ * page and call again.  Otherwise vmbuffer must hold the map page of the
+ * page, and true means the page was marked all-visible.
+ */
+static bool heap_page_freeze_opt(Relation relation, Buffer buffer, Buffer vmbuffer, TransactionId oldest_xmin)
+{
+    Page page = BufferGetPage(buffer);
+    BlockNumber blkno = BufferGetBlockNumber(buffer);
+    OffsetNumber offnum, maxoff;
+    OffsetNumber frozen[MaxHeapTuplesPerPage];
+    int nfrozen = 0;
+    TransactionId visibility_cutoff_xid = InvalidTransactionId;
+    TransactionId freeze_xid;
+    HeapTupleData tuple;
+
+    if (PageIsAllVisible(page) || PageIsCompressed(page))
+        return false;
+
+    tuple.t_tableOid = RelationGetRelid(relation);
+    tuple.t_bucketId = RelationGetBktid(relation);
+
+    /* First make sure everything on the page is visible to all */
+    maxoff = PageGetMaxOffsetNumber(page);
+    for (offnum = FirstOffsetNumber; offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
+        ItemId itemid = PageGetItemId(page, offnum);
+        TransactionId xmin;
+
+        if (!ItemIdIsUsed(itemid) || ItemIdIsRedirected(itemid))
+            continue;
+        if (ItemIdIsDead(itemid))
+            return false;
+
+        ItemPointerSet(&(tuple.t_self), blkno, offnum);
+        tuple.t_data = (HeapTupleHeader)PageGetItem(page, itemid);
+        tuple.t_len = ItemIdGetLength(itemid);
+        HeapTupleCopyBaseFromPage(&tuple, page);
+
+        /* as in lazy_scan_heap, an asynchronously committed inserter isn't good enough */
+        if (HeapTupleSatisfiesVacuum(&tuple, oldest_xmin, buffer) != HEAPTUPLE_LIVE ||
+            !HeapTupleHeaderXminCommitted(tuple.t_data))
+            return false;
+
+        xmin = HeapTupleHeaderGetXmin(page, tuple.t_data);
+        if (!TransactionIdPrecedes(xmin, oldest_xmin))
+            return false;
+        if (TransactionIdFollows(xmin, visibility_cutoff_xid))
+            visibility_cutoff_xid = xmin;
     }
+
+    if (!BufferIsValid(vmbuffer))
+        return true;
+
+    /* Now freeze whatever still carries a normal xid */
+    if (TransactionIdIsNormal(visibility_cutoff_xid)) {
+        freeze_xid = visibility_cutoff_xid;
+        TransactionIdAdvance(freeze_xid);
+
+        for (offnum = FirstOffsetNumber; offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
+            ItemId itemid = PageGetItemId(page, offnum);
+
+            if (!ItemIdIsNormal(itemid))
+                continue;
+
+            ItemPointerSet(&(tuple.t_self), blkno, offnum);
+            tuple.t_data = (HeapTupleHeader)PageGetItem(page, itemid);
+            tuple.t_len = ItemIdGetLength(itemid);
+            HeapTupleCopyBaseFromPage(&tuple, page);
+
+            if (heap_freeze_tuple(&tuple, freeze_xid))
+                frozen[nfrozen++] = offnum;
+        }
+
+        if (nfrozen > 0) {
+            START_CRIT_SECTION();
+            MarkBufferDirty(buffer);
+            if (RelationNeedsWAL(relation)) {
+                XLogRecPtr recptr;
+
+                recptr = log_heap_freeze(relation, buffer, freeze_xid, frozen, nfrozen);
+                PageSetLSN(page, recptr);
+            }
+            END_CRIT_SECTION();
+        }
+    }
+
+    PageSetAllVisible(page);
+    MarkBufferDirty(buffer);
+    visibilitymap_set(relation, blkno, buffer, InvalidXLogRecPtr, vmbuffer, visibility_cutoff_xid, false);
+    return true;
 }
 
 /*
@@ -105,6 +105,7 @@ IndexScanDesc RelationGetIndexScan(Relation index_relation, int nkeys, int norde
         scan->orderByData = NULL;
 
     scan->xs_want_itup = false; /* may be set later */
+    scan->xs_heap_prefetch = false;
 
     /*
      * During recovery we ignore killed tuples and don't bother to kill them
@@ -241,6 +241,14 @@ IndexScanDesc index_beginscan(
     scan->heapRelation = heap_relation;
     scan->xs_snapshot = snapshot;
 
+    /*
+     * Plain index scans fetch every match from the heap, so let the AM
+     * prefetch the heap pages of each batch of matches it reads.  Index-only
+     * scans mostly don't visit the heap at all.
+     */
+    scan->xs_heap_prefetch = (scan_state != NULL && scan_state->ps.plan != NULL &&
+                              IsA(scan_state->ps.plan, IndexScan) && !scan->xs_want_ext_oid);
+
     if (scan->xs_want_ext_oid) {
         scan->xs_gpi_scan->parentRelation = heap_relation;
     }
@@ -0,0 +1,454 @@
+/* -------------------------------------------------------------------------
+ *
+ * nbtdedup.cpp
+ *	  Deduplicate equal leaf tuples of btree indexes into posting lists.
+ *
+ * Portions Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ * Portions Copyright (c) 1996-2012, PostgreSQL Global Development Group
+ * Portions Copyright (c) 1994, Regents of the University of California
+ *
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/storage/access/nbtree/nbtdedup.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/nbtree.h"
+#include "access/xlog.h"
+#include "access/xloginsert.h"
+#include "miscadmin.h"
+#include "storage/proc.h"
+#include "utils/rel.h"
+
+static int _bt_itemptr_cmp(const void *a, const void *b);
+
+/*
+ * _bt_dedup_enabled() -- may equal leaf tuples of rel be merged into
+ *						   posting list tuples?
+ *
+ * Unique indexes only get equal tuples from versions of the same row, which
+ * _bt_check_unique() has to visit one by one, so they are left alone.
+ * Binaries older than BTREE_DEDUP_VERSION can't read posting list tuples.
+ */
+bool _bt_dedup_enabled(Relation rel)
+{
+    if (t_thrd.proc->workingVersionNum < BTREE_DEDUP_VERSION) {
+        return false;
+    }
+    if (rel->rd_index->indisunique) {
+        return false;
+    }
+    return RelationGetDeduplicateItems(rel);
+}
+
+/*
+ * _bt_dedup_equal() -- do two leaf tuples hold the same attributes?
+ *
+ * The attributes, INCLUDE columns and the partition OID of global partition
+ * indexes alike, are compared byte by byte.  Tuples that the opclass finds
+ * equal but that are stored differently are not merged, so a posting list
+ * tuple returns exactly what each of its tuples would have returned to an
+ * index-only scan.  A posting list tuple's attributes end at its posting list.
+ */
+bool _bt_dedup_equal(IndexTuple itup1, IndexTuple itup2)
+{
+    Size keysize1 = BTreeTupleIsPosting(itup1) ? BTreeTupleGetPostingOffset(itup1) : IndexTupleSize(itup1);
+    Size keysize2 = BTreeTupleIsPosting(itup2) ? BTreeTupleGetPostingOffset(itup2) : IndexTupleSize(itup2);
+
+    if (keysize1 != keysize2) {
+        return false;
+    }
+    if ((itup1->t_info & (INDEX_NULL_MASK | INDEX_VAR_MASK)) != (itup2->t_info & (INDEX_NULL_MASK | INDEX_VAR_MASK))) {
+        return false;
+    }
+    return memcmp((char *)itup1 + sizeof(IndexTupleData), (char *)itup2 + sizeof(IndexTupleData),
+                  keysize1 - sizeof(IndexTupleData)) == 0;
+}
+
+/*
+ * _bt_dedup_start_pending() -- start a new run of equal tuples with base.
+ *
+ * state->htids must have room for state->maxpostingsize bytes.
+ */
+void _bt_dedup_start_pending(BTDedupState state, IndexTuple base, OffsetNumber baseoff)
+{
+    errno_t rc;
+
+    state->base = base;
+    state->baseoff = baseoff;
+    if (BTreeTupleIsPosting(base)) {
+        state->basetupsize = BTreeTupleGetPostingOffset(base);
+        state->nhtids = BTreeTupleGetNPosting(base);
+        rc = memcpy_s(state->htids, state->maxpostingsize, BTreeTupleGetPosting(base),
+                      state->nhtids * sizeof(ItemPointerData));
+        securec_check(rc, "", "");
+    } else {
+        state->basetupsize = IndexTupleSize(base);
+        state->htids[0] = base->t_tid;
+        state->nhtids = 1;
+    }
+    state->nitems = 1;
+}
+
+/*
+ * _bt_dedup_save_htid() -- add the heap TIDs of itup to the pending run.
+ *
+ * itup must be equal to the base tuple of the run.  Returns false, leaving
+ * the run alone, if the merged tuple would get bigger than maxpostingsize.
+ */
+bool _bt_dedup_save_htid(BTDedupState state, IndexTuple itup)
+{
+    int nhtids;
+    ItemPointer htids;
+    Size mergedtupsz;
+    errno_t rc;
+
+    if (BTreeTupleIsPosting(itup)) {
+        nhtids = BTreeTupleGetNPosting(itup);
+        htids = BTreeTupleGetPosting(itup);
+    } else {
+        nhtids = 1;
+        htids = &itup->t_tid;
+    }
+
+    mergedtupsz = MAXALIGN(state->basetupsize) + (state->nhtids + nhtids) * sizeof(ItemPointerData);
+    if (MAXALIGN(mergedtupsz) > state->maxpostingsize) {
+        return false;
+    }
+
+    rc = memcpy_s(state->htids + state->nhtids, state->maxpostingsize - state->nhtids * sizeof(ItemPointerData),
+                  htids, nhtids * sizeof(ItemPointerData));
+    securec_check(rc, "", "");
+    state->nhtids += nhtids;
+    state->nitems++;
+
+    return true;
+}
+
+/*
+ * _bt_dedup_page_has_duplicates() -- do two adjacent live tuples on the leaf
+ *									   page compare equal?
+ *
+ * A cheap test, stopping at the first equal pair, that keeps
+ * _bt_dedup_one_page() from running over full pages of distinct keys.
+ */
+bool _bt_dedup_page_has_duplicates(Page page)
+{
+    BTPageOpaqueInternal opaque = (BTPageOpaqueInternal)PageGetSpecialPointer(page);
+    OffsetNumber offnum;
+    OffsetNumber maxoff = PageGetMaxOffsetNumber(page);
+    IndexTuple prev = NULL;
+
+    for (offnum = P_FIRSTDATAKEY(opaque); offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
+        ItemId itemid = PageGetItemId(page, offnum);
+        IndexTuple itup;
+
+        if (ItemIdIsDead(itemid)) {
+            prev = NULL;
+            continue;
+        }
+        itup = (IndexTuple)PageGetItem(page, itemid);
+        if (prev != NULL && _bt_dedup_equal(prev, itup)) {
+            return true;
+        }
+        prev = itup;
+    }
+    return false;
+}
+
+/*
+ * _bt_dedup_one_page() -- merge runs of equal tuples on a leaf page.
+ *
+ * Called by _bt_findinsertloc() when a new tuple does not fit on the leaf
+ * page, after LP_DEAD tuples were removed, in the hope of avoiding a page
+ * split.  The caller must hold an exclusive lock on buf and must look up
+ * the insert location again afterwards, since tuples may have moved.
+ *
+ * Each run of equal tuples becomes one posting list tuple, as long as the
+ * result stays below half of the maximum tuple size.  The runs are WAL-logged
+ * as BTDedupIntervals, and replay merges them with the same code.
+ *
+ * Returns true if the page was changed.
+ */
+bool _bt_dedup_one_page(Relation rel, Buffer buf)
+{
+    Page page = BufferGetPage(buf);
+    BTPageOpaqueInternal opaque = (BTPageOpaqueInternal)PageGetSpecialPointer(page);
+    OffsetNumber offnum;
+    OffsetNumber minoff;
+    OffsetNumber maxoff;
+    BTDedupStateData state;
+    BTDedupInterval intervals[MaxIndexTuplesPerPage];
+    int nintervals = 0;
+    Page newpage;
+
+    Assert(P_ISLEAF(opaque));
+
+    state.maxpostingsize = Min(BTMaxItemSize(page) / 2, INDEX_SIZE_MASK);
+    state.htids = (ItemPointer)palloc(state.maxpostingsize);
+    state.base = NULL;
+    state.nitems = 0;
+
+    minoff = P_FIRSTDATAKEY(opaque);
+    maxoff = PageGetMaxOffsetNumber(page);
+    for (offnum = minoff; offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
+        ItemId itemid = PageGetItemId(page, offnum);
+        IndexTuple itup = (IndexTuple)PageGetItem(page, itemid);
+
+        if (state.base != NULL && !ItemIdIsDead(itemid) && _bt_dedup_equal(state.base, itup) &&
+            _bt_dedup_save_htid(&state, itup)) {
+            continue;
+        }
+
+        /* The pending run ends here */
+        if (state.base != NULL && state.nitems > 1) {
+            intervals[nintervals].baseoff = state.baseoff;
+            intervals[nintervals].nitems = (uint16)state.nitems;
+            nintervals++;
+        }
+
+        /* LP_DEAD tuples are going away, don't hide them in posting lists */
+        if (ItemIdIsDead(itemid)) {
+            state.base = NULL;
+            continue;
+        }
+        _bt_dedup_start_pending(&state, itup, offnum);
+    }
+    if (state.base != NULL && state.nitems > 1) {
+        intervals[nintervals].baseoff = state.baseoff;
+        intervals[nintervals].nitems = (uint16)state.nitems;
+        nintervals++;
+    }
+    pfree(state.htids);
+
+    if (nintervals == 0) {
+        return false;
+    }
+
+    newpage = _bt_dedup_build_page(page, intervals, nintervals);
+
+    /* No ereport(ERROR) until changes are logged */
+    START_CRIT_SECTION();
+
+    PageRestoreTempPage(newpage, page);
+    MarkBufferDirty(buf);
+
+    /* XLOG stuff */
+    if (RelationNeedsWAL(rel)) {
+        XLogRecPtr recptr;
+        xl_btree_dedup xlrec_dedup;
+
+        xlrec_dedup.nintervals = (uint16)nintervals;
+
+        XLogBeginInsert();
+        XLogRegisterBuffer(BTREE_DEDUP_ORIG_BLOCK_NUM, buf, REGBUF_STANDARD);
+        XLogRegisterData((char *)&xlrec_dedup, SizeOfBtreeDedup);
+
+        /*
+         * The intervals array is not in the buffer, but pretend that it is.
+         * When XLogInsert stores the whole buffer, the array need not be
+         * stored too.
+         */
+        XLogRegisterBufData(BTREE_DEDUP_ORIG_BLOCK_NUM, (char *)intervals, nintervals * sizeof(BTDedupInterval));
+
+        recptr = XLogInsert(RM_BTREE_ID, XLOG_BTREE_DEDUP);
+
+        PageSetLSN(page, recptr);
+    }
+
+    END_CRIT_SECTION();
+
+    return true;
+}
+
+/*
+ * _bt_dedup_build_page() -- build a copy of a leaf page with the given runs
+ *							 of tuples merged into posting list tuples.
+ *
+ * intervals must be in ascending baseoff order.  The caller installs the
+ * returned temp page with PageRestoreTempPage().  Used by both
+ * _bt_dedup_one_page() and WAL replay, so the two produce the same page.
+ */
+Page _bt_dedup_build_page(Page page, const BTDedupInterval *intervals, int nintervals)
+{
+    BTPageOpaqueInternal opaque = (BTPageOpaqueInternal)PageGetSpecialPointer(page);
+    Page newpage;
+    OffsetNumber offnum;
+    OffsetNumber minoff;
+    OffsetNumber maxoff;
+    OffsetNumber newoff;
+    ItemPointer htids;
+    int curinterval = 0;
+
+    newpage = PageGetTempPageCopySpecial(page, true);
+    PageSetLSN(newpage, PageGetLSN(page));
+    htids = (ItemPointer)palloc(MaxBTreeTIDsPerPage * sizeof(ItemPointerData));
+
+    minoff = P_FIRSTDATAKEY(opaque);
+    maxoff = PageGetMaxOffsetNumber(page);
+    newoff = P_HIKEY;
+
+    /* The high key is copied as it is */
+    if (!P_RIGHTMOST(opaque)) {
+        ItemId hitemid = PageGetItemId(page, P_HIKEY);
+
+        if (PageAddItem(newpage, PageGetItem(page, hitemid), ItemIdGetLength(hitemid), newoff, false, false) ==
+            InvalidOffsetNumber) {
+            ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED), errmsg("deduplication failed to add high key")));
+        }
+        newoff = OffsetNumberNext(newoff);
+    }
+
+    offnum = minoff;
+    while (offnum <= maxoff) {
+        ItemId itemid = PageGetItemId(page, offnum);
+        IndexTuple itup = (IndexTuple)PageGetItem(page, itemid);
+
+        if (curinterval < nintervals && intervals[curinterval].baseoff == offnum) {
+            const BTDedupInterval *interval = &intervals[curinterval];
+            IndexTuple posting;
+            int nhtids = 0;
+
+            for (int i = 0; i < interval->nitems; i++) {
+                IndexTuple dup = (IndexTuple)PageGetItem(page, PageGetItemId(page, offnum + i));
+
+                if (BTreeTupleIsPosting(dup)) {
+                    for (int j = 0; j < BTreeTupleGetNPosting(dup); j++) {
+                        htids[nhtids++] = *BTreeTupleGetPostingN(dup, j);
+                    }
+                } else {
+                    htids[nhtids++] = dup->t_tid;
+                }
+            }
+
+            /* Equal tuples are in no particular heap TID order on the page */
+            qsort(htids, nhtids, sizeof(ItemPointerData), _bt_itemptr_cmp);
+            posting = _bt_form_posting(itup, htids, nhtids);
+            if (PageAddItem(newpage, (Item)posting, MAXALIGN(IndexTupleSize(posting)), newoff, false, false) ==
+                InvalidOffsetNumber) {
+                ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                                errmsg("deduplication failed to add posting list tuple")));
+            }
+            pfree(posting);
+
+            offnum += interval->nitems;
+            curinterval++;
+        } else {
+            if (PageAddItem(newpage, (Item)itup, ItemIdGetLength(itemid), newoff, false, false) ==
+                InvalidOffsetNumber) {
+                ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED), errmsg("deduplication failed to add tuple")));
+            }
+            /* Keep the LP_DEAD hint, _bt_vacuum_one_page() relies on it */
+            if (ItemIdIsDead(itemid)) {
+                ItemIdMarkDead(PageGetItemId(newpage, newoff));
+            }
+            offnum = OffsetNumberNext(offnum);
+        }
+        newoff = OffsetNumberNext(newoff);
+    }
+
+    if (curinterval != nintervals) {
+        ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED),
+                        errmsg("deduplication interval %d of %d is out of page range", curinterval, nintervals)));
+    }
+
+    pfree(htids);
+    return newpage;
+}
+
+/*
+ * _bt_form_posting() -- build a tuple with the attributes of base and the
+ *						 heap TIDs htids, which must be in ascending order.
+ *
+ * base may be a plain or a posting list tuple.  When there is only one heap
+ * TID, a plain tuple is built instead.
+ */
+IndexTuple _bt_form_posting(IndexTuple base, const ItemPointerData *htids, int nhtids)
+{
+    Size keysize;
+    Size newsize;
+    Size postingoffset = 0;
+    IndexTuple itup;
+    errno_t rc;
+
+    Assert(nhtids > 0);
+
+    keysize = BTreeTupleIsPosting(base) ? BTreeTupleGetPostingOffset(base) : IndexTupleSize(base);
+    if (nhtids > 1) {
+        postingoffset = MAXALIGN(keysize);
+        newsize = MAXALIGN(postingoffset + nhtids * sizeof(ItemPointerData));
+    } else {
+        newsize = keysize;
+    }
+    Assert(newsize <= INDEX_SIZE_MASK);
+
+    itup = (IndexTuple)palloc0(newsize);
+    rc = memcpy_s(itup, newsize, base, keysize);
+    securec_check(rc, "", "");
+    itup->t_info &= ~(INDEX_SIZE_MASK | INDEX_ALT_TID_MASK);
+    itup->t_info |= newsize;
+
+    if (nhtids > 1) {
+        BTreeTupleSetPosting(itup, nhtids, postingoffset);
+        rc = memcpy_s(BTreeTupleGetPosting(itup), newsize - postingoffset, htids, nhtids * sizeof(ItemPointerData));
+        securec_check(rc, "", "");
+    } else {
+        itup->t_tid = htids[0];
+    }
+
+    return itup;
+}
+
+/*
+ * _bt_update_posting() -- build the replacement for a posting list tuple that
+ *						   VACUUM removes some heap TIDs from.
+ *
+ * deletetids holds the posting list indexes of the removed heap TIDs, in
+ * ascending order.  At least one heap TID must remain.
+ */
+IndexTuple _bt_update_posting(IndexTuple origtuple, const uint16 *deletetids, int ndeletedtids)
+{
+    int nposting = BTreeTupleGetNPosting(origtuple);
+    ItemPointer htids;
+    int nhtids = 0;
+    int d = 0;
+    IndexTuple itup;
+
+    Assert(ndeletedtids > 0 && ndeletedtids < nposting);
+
+    htids = (ItemPointer)palloc(nposting * sizeof(ItemPointerData));
+    for (int i = 0; i < nposting; i++) {
+        if (d < ndeletedtids && deletetids[d] == i) {
+            d++;
+            continue;
+        }
+        htids[nhtids++] = *BTreeTupleGetPostingN(origtuple, i);
+    }
+    Assert(d == ndeletedtids);
+
+    itup = _bt_form_posting(origtuple, htids, nhtids);
+    pfree(htids);
+    return itup;
+}
+
+/*
+ * _bt_replace_item() -- replace the tuple at offnum with the smaller itup.
+ */
+void _bt_replace_item(Page page, OffsetNumber offnum, IndexTuple itup)
+{
+    PageIndexTupleDelete(page, offnum);
+    if (PageAddItem(page, (Item)itup, MAXALIGN(IndexTupleSize(itup)), offnum, false, false) == InvalidOffsetNumber) {
+        ereport(ERROR, (errcode(ERRCODE_INDEX_CORRUPTED), errmsg("failed to replace posting list tuple")));
+    }
+}
+
+/*
+ * Comparator for sorting heap TIDs with qsort().
+ */
+static int _bt_itemptr_cmp(const void *a, const void *b)
+{
+    return ItemPointerCompare((ItemPointer)a, (ItemPointer)b);
+}
@@ -484,7 +484,8 @@ next:
  *		any existing equal keys because of the way _bt_binsrch() works.
  *
  *		If there's not enough room in the space, we try to make room by
- *		removing any LP_DEAD tuples.
+ *		removing any LP_DEAD tuples, and then by merging equal tuples into
+ *		posting list tuples (see nbtdedup.cpp).
  *
  *		On entry, *buf and *offsetptr point to the first legal position
  *		where the new tuple could be inserted.	The caller should hold an
@@ -569,6 +570,19 @@ static void _bt_findinsertloc(Relation rel, Buffer *bufptr, OffsetNumber *offset
                 break; /* OK, now we have enough space */
         }
 
+        /*
+         * merging runs of equal tuples into posting list tuples may free
+         * enough space as well.  This also moves tuples around.  Pages
+         * without a single pair of equal neighbours are not worth a try.
+         */
+        if (P_ISLEAF(lpageop) && _bt_dedup_enabled(rel) && _bt_dedup_page_has_duplicates(page) &&
+            _bt_dedup_one_page(rel, buf)) {
+            vacuumed = true;
+
+            if (PageGetFreeSpace(page) >= itemsz)
+                break; /* OK, now we have enough space */
+        }
+
         /*
          * nope, so check conditions (b) and (c) enumerated above
          */
@@ -900,8 +914,7 @@ static Buffer _bt_split(Relation rel, Buffer buf, Buffer cbuf, OffsetNumber firs
     bool isleaf = false;
     errno_t rc;
     IndexTuple lefthikey;
-    int indnatts = IndexRelationGetNumberOfAttributes(rel);
-    int indnkeyatts = IndexRelationGetNumberOfKeyAttributes(rel);
+    int indnkeyatts PG_USED_FOR_ASSERTS_ONLY = IndexRelationGetNumberOfKeyAttributes(rel);
 
     /* Acquire a new page to split into */
     rbuf = _bt_getbuf(rel, P_NEW, BT_WRITE);
@@ -971,7 +984,7 @@ static Buffer _bt_split(Relation rel, Buffer buf, Buffer cbuf, OffsetNumber firs
         itemid = PageGetItemId(origpage, P_HIKEY);
         itemsz = ItemIdGetLength(itemid);
         item = (IndexTuple)PageGetItem(origpage, itemid);
-        Assert(BTreeTupleGetNAtts(item, rel) == indnkeyatts);
+        Assert(BTreeTupleGetNAtts(item, rel) <= indnkeyatts);
         if (PageAddItem(rightpage, (Item)item, itemsz, rightoff, false, false) == InvalidOffsetNumber) {
             rc = memset_s(rightpage, BLCKSZ, 0, BufferGetPageSize(rbuf));
             securec_check(rc, "", "");
@@ -1000,15 +1013,29 @@ static Buffer _bt_split(Relation rel, Buffer buf, Buffer cbuf, OffsetNumber firs
     }
 
     /*
-     * We must truncate included attributes of the "high key" item, before
-     * insert it onto the leaf page.  It's the only point in insertion
-     * process, where we perform truncation.  All other functions work with
-     * this high key and do not change it.
+     * We must truncate included attributes of the "high key" item, and the
+     * key attributes not needed to separate it from the last item on the
+     * left, before insert it onto the leaf page.  It's the only point in
+     * insertion process, where we perform truncation.  All other functions
+     * work with this high key and do not change it.
      */
-    if (indnatts != indnkeyatts && isleaf) {
-        lefthikey = _bt_nonkey_truncate(rel, item);
-        itemsz = IndexTupleSize(lefthikey);
-        itemsz = MAXALIGN(itemsz);
+    if (isleaf) {
+        IndexTuple lastleft;
+
+        if (newitemonleft && newitemoff == firstright) {
+            /* incoming tuple will become last on left page */
+            lastleft = newitem;
+        } else {
+            OffsetNumber lastleftoff = OffsetNumberPrev(firstright);
+
+            Assert(lastleftoff >= P_FIRSTDATAKEY(oopaque));
+            lastleft = (IndexTuple)PageGetItem(origpage, PageGetItemId(origpage, lastleftoff));
+        }
+        lefthikey = _bt_truncate(rel, lastleft, item);
+        if (lefthikey != item) {
+            itemsz = IndexTupleSize(lefthikey);
+            itemsz = MAXALIGN(itemsz);
+        }
     } else {
         lefthikey = item;
     }
@@ -2070,12 +2097,16 @@ static bool _bt_isequal(Relation idxrel, Page page, OffsetNumber offnum, int key
     Assert(P_ISLEAF((BTPageOpaqueInternal)PageGetSpecialPointer(page)));
 
     itup = (IndexTuple)PageGetItem(page, PageGetItemId(page, offnum));
+
     /*
-     * Index tuple shouldn't be truncated.	Despite we technically could
-     * compare truncated tuple as well, this function should be only called
-     * for regular non-truncated leaf tuples and P_HIKEY tuple on
-     * rightmost leaf page.
+     * A leaf high key may have been suffix truncated.  Then the last tuple
+     * on this page and the first one on the right sibling differ in one of
+     * the attributes that were kept, so no tuple equal to scankey in all
+     * keysz attributes can continue onto the right sibling.
      */
+    if (BTreeTupleGetNAtts(itup, idxrel) < keysz)
+        return false;
+
     for (i = 1; i <= keysz; i++) {
         AttrNumber attno;
         Datum datum;
@@ -673,6 +673,10 @@ bool _bt_page_recyclable(Page page)
  * This routine assumes that the caller has pinned and locked the buffer.
  * Also, the given itemnos *must* appear in increasing order in the array.
  *
+ * updatable describes the posting list tuples that lose some but not all of
+ * their heap TIDs.  Those are replaced by smaller tuples at the same offsets
+ * before the itemnos tuples are deleted.
+ *
  * We record VACUUMs and b-tree deletes differently in WAL. InHotStandby
  * we need to be able to pin all of the blocks in the btree in physical
  * order when replaying the effects of a VACUUM, just as we do for the
@@ -684,15 +688,52 @@ bool _bt_page_recyclable(Page page)
  * ensure correct locking.
  */
 void _bt_delitems_vacuum(const Relation rel, Buffer buf, OffsetNumber *itemnos, int nitems,
-                         BlockNumber lastBlockVacuumed)
+                         BTVacuumPosting *updatable, int nupdatable, BlockNumber lastBlockVacuumed)
 {
     Page page = BufferGetPage(buf);
     BTPageOpaqueInternal opaque;
+    IndexTuple *updatedtuples = NULL;
+    OffsetNumber *updatedoffsets = NULL;
+    char *updatedbuf = NULL;
+    Size updatedbuflen = 0;
+
+    /* Form the shrunk posting list tuples, and their WAL data, up front */
+    if (nupdatable > 0) {
+        Size offset = 0;
+
+        updatedtuples = (IndexTuple *)palloc(nupdatable * sizeof(IndexTuple));
+        updatedoffsets = (OffsetNumber *)palloc(nupdatable * sizeof(OffsetNumber));
+        for (int i = 0; i < nupdatable; i++) {
+            BTVacuumPosting vacposting = updatable[i];
+
+            updatedtuples[i] = _bt_update_posting(vacposting->itup, vacposting->deletetids, vacposting->ndeletedtids);
+            updatedoffsets[i] = vacposting->updatedoffset;
+            updatedbuflen += SizeOfBtreeUpdate + vacposting->ndeletedtids * sizeof(uint16);
+        }
+
+        updatedbuf = (char *)palloc(updatedbuflen);
+        for (int i = 0; i < nupdatable; i++) {
+            BTVacuumPosting vacposting = updatable[i];
+            xl_btree_update update;
+            Size itemsz = vacposting->ndeletedtids * sizeof(uint16);
+            errno_t rc;
+
+            update.ndeletedtids = vacposting->ndeletedtids;
+            rc = memcpy_s(updatedbuf + offset, updatedbuflen - offset, &update, SizeOfBtreeUpdate);
+            securec_check(rc, "", "");
+            offset += SizeOfBtreeUpdate;
+            rc = memcpy_s(updatedbuf + offset, updatedbuflen - offset, vacposting->deletetids, itemsz);
+            securec_check(rc, "", "");
+            offset += itemsz;
+        }
+    }
 
     /* No ereport(ERROR) until changes are logged */
     START_CRIT_SECTION();
 
-    /* Fix the page */
+    /* Fix the page, updates first since deletes move the items */
+    for (int i = 0; i < nupdatable; i++)
+        _bt_replace_item(page, updatedoffsets[i], updatedtuples[i]);
     if (nitems > 0)
         PageIndexMultiDelete(page, itemnos, nitems);
 
@@ -720,10 +761,13 @@ void _bt_delitems_vacuum(const Relation rel, Buffer buf, OffsetNumber *itemnos,
         xl_btree_vacuum xlrec_vacuum;
 
         xlrec_vacuum.lastBlockVacuumed = lastBlockVacuumed;
+        xlrec_vacuum.ndeleted = (uint16)nitems;
+        xlrec_vacuum.nupdated = (uint16)nupdatable;
 
         XLogBeginInsert();
         XLogRegisterBuffer(0, buf, REGBUF_STANDARD);
-        XLogRegisterData((char *)&xlrec_vacuum, SizeOfBtreeVacuum);
+        /* records without posting list updates keep the old layout */
+        XLogRegisterData((char *)&xlrec_vacuum, nupdatable > 0 ? SizeOfBtreeVacuumPosting : SizeOfBtreeVacuum);
 
         /*
          * The target-offsets array is not in the buffer, but pretend that it
@@ -732,6 +776,10 @@ void _bt_delitems_vacuum(const Relation rel, Buffer buf, OffsetNumber *itemnos,
          */
         if (nitems > 0)
             XLogRegisterBufData(0, (char *)itemnos, nitems * sizeof(OffsetNumber));
+        if (nupdatable > 0) {
+            XLogRegisterBufData(0, (char *)updatedoffsets, nupdatable * sizeof(OffsetNumber));
+            XLogRegisterBufData(0, updatedbuf, updatedbuflen);
+        }
 
         recptr = XLogInsert(RM_BTREE_ID, XLOG_BTREE_VACUUM);
 
@@ -739,6 +787,14 @@ void _bt_delitems_vacuum(const Relation rel, Buffer buf, OffsetNumber *itemnos,
     }
 
     END_CRIT_SECTION();
+
+    if (nupdatable > 0) {
+        for (int i = 0; i < nupdatable; i++)
+            pfree(updatedtuples[i]);
+        pfree(updatedtuples);
+        pfree(updatedoffsets);
+        pfree(updatedbuf);
+    }
 }
 
 /*
@@ -1132,7 +1188,7 @@ int _bt_pagedel_old(Relation rel, Buffer buf, BTStack stack)
             /* we need an insertion scan key to do our search, so build one */
             itup_scankey = _bt_mkscankey(rel, targetkey);
             /* find the leftmost leaf page containing this key */
-            stack = _bt_search(rel, IndexRelationGetNumberOfKeyAttributes(rel), itup_scankey, false, &lbuf, BT_READ);
+            stack = _bt_search(rel, BTreeTupleGetNKeyAtts(targetkey, rel), itup_scankey, false, &lbuf, BT_READ);
             /* don't need a pin on that either */
             _bt_relbuf(rel, lbuf);
 
@@ -1699,8 +1755,7 @@ int _bt_pagedel_new(Relation rel, Buffer buf)
                 /* we need an insertion scan key for the search, so build one */
                 itup_scankey = _bt_mkscankey(rel, targetkey);
                 /* find the leftmost leaf page with matching pivot/high key */
-                stack =
-                    _bt_search(rel, IndexRelationGetNumberOfKeyAttributes(rel), itup_scankey, false, &lbuf, BT_READ);
+                stack = _bt_search(rel, BTreeTupleGetNKeyAtts(targetkey, rel), itup_scankey, false, &lbuf, BT_READ);
                 /* don't need a lock or second pin on the page */
                 _bt_relbuf(rel, lbuf);
 
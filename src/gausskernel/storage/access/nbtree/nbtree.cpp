@@ -54,6 +54,8 @@ static void btbuildCallback(Relation index, HeapTuple htup, Datum *values, const
 static void btvacuumscan(IndexVacuumInfo *info, IndexBulkDeleteResult *stats, IndexBulkDeleteCallback callback,
                          void *callback_state, BTCycleId cycleid);
 static void btvacuumpage(BTVacState *vstate, BlockNumber blkno, BlockNumber orig_blkno);
+static BTVacuumPosting btreevacuumposting(BTVacState *vstate, IndexTuple posting, OffsetNumber updatedoffset,
+                                          Oid partOid, int *nremaining);
 
 static IndexTuple btgetindextuple(IndexScanDesc scan, ScanDirection dir, BlockNumber heapTupleBlkOffset);
 /*
@@ -424,6 +426,7 @@ Datum btbeginscan(PG_FUNCTION_ARGS)
     so->arrayContext = NULL;
     so->killedItems = NULL; /* until needed */
     so->numKilled = 0;
+    so->prefetchItem = -1;
 
     /*
      * We don't know yet whether the scan will be index-only, so we do not
@@ -624,6 +627,9 @@ Datum btrestrpos(PG_FUNCTION_ARGS)
         }
     }
 
+    /* don't prefetch heap blocks again until the scan steps to another page */
+    so->prefetchItem = -1;
+
     PG_RETURN_VOID();
 }
 
@@ -817,7 +823,7 @@ static void btvacuumscan(IndexVacuumInfo *info, IndexBulkDeleteResult *stats, In
         buf = ReadBufferExtended(rel, MAIN_FORKNUM, vstate.lastBlockLocked, RBM_NORMAL, info->strategy);
         LockBufferForCleanup(buf);
         _bt_checkpage(rel, buf);
-        _bt_delitems_vacuum(rel, buf, NULL, 0, vstate.lastBlockVacuumed);
+        _bt_delitems_vacuum(rel, buf, NULL, 0, NULL, 0, vstate.lastBlockVacuumed);
         _bt_relbuf(rel, buf);
     }
 
@@ -901,6 +907,9 @@ restart:
     } else if (P_ISLEAF(opaque)) {
         OffsetNumber deletable[MaxOffsetNumber];
         int ndeletable;
+        BTVacuumPosting updatable[MaxIndexTuplesPerPage];
+        int nupdatable;
+        int nhtidsdead;
         OffsetNumber offnum, minoff, maxoff;
 
         /*
@@ -937,6 +946,8 @@ restart:
          * callback function.
          */
         ndeletable = 0;
+        nupdatable = 0;
+        nhtidsdead = 0;
         minoff = P_FIRSTDATAKEY(opaque);
         maxoff = PageGetMaxOffsetNumber(page);
         if (callback) {
@@ -973,17 +984,33 @@ restart:
                     partOid = DatumGetUInt32(index_getattr(itup, partitionOidAttr, tupdesc, &isnull));
                     Assert(!isnull);
                 }
-                if (callback(htup, callback_state, partOid)) {
+                if (BTreeTupleIsPosting(itup)) {
+                    /* ask about each of its heap TIDs */
+                    int nremaining;
+                    BTVacuumPosting vacposting = btreevacuumposting(vstate, itup, offnum, partOid, &nremaining);
+
+                    if (vacposting != NULL) {
+                        /* some heap TIDs go, the posting list shrinks */
+                        updatable[nupdatable++] = vacposting;
+                        nhtidsdead += vacposting->ndeletedtids;
+                    } else if (nremaining == 0) {
+                        /* all of them go */
+                        deletable[ndeletable++] = offnum;
+                        nhtidsdead += BTreeTupleGetNPosting(itup);
+                    }
+                } else if (callback(htup, callback_state, partOid)) {
                     deletable[ndeletable++] = offnum;
+                    nhtidsdead++;
                 }
             }
         }
 
         /*
-         * Apply any needed deletes.  We issue just one _bt_delitems_vacuum()
-         * call per page, so as to minimize WAL traffic.
+         * Apply any needed deletes and posting list updates.  We issue just
+         * one _bt_delitems_vacuum() call per page, so as to minimize WAL
+         * traffic.
          */
-        if (ndeletable > 0) {
+        if (ndeletable > 0 || nupdatable > 0) {
             /*
              * Notice that the issued XLOG_BTREE_VACUUM WAL record includes an
              * instruction to the replay code to get cleanup lock on all pages
@@ -995,7 +1022,7 @@ restart:
              * doesn't seem worth the amount of bookkeeping it'd take to avoid
              * that.
              */
-            _bt_delitems_vacuum(rel, buf, deletable, ndeletable, vstate->lastBlockVacuumed);
+            _bt_delitems_vacuum(rel, buf, deletable, ndeletable, updatable, nupdatable, vstate->lastBlockVacuumed);
 
             /*
              * Remember highest leaf page number we've issued a
@@ -1005,7 +1032,10 @@ restart:
                 vstate->lastBlockVacuumed = blkno;
             }
 
-            stats->tuples_removed += ndeletable;
+            stats->tuples_removed += nhtidsdead;
+            for (int i = 0; i < nupdatable; i++) {
+                pfree(updatable[i]);
+            }
             /* must recompute maxoff */
             maxoff = PageGetMaxOffsetNumber(page);
         } else {
@@ -1032,7 +1062,11 @@ restart:
         if (minoff > maxoff) {
             delete_now = (blkno == orig_blkno);
         } else {
-            stats->num_index_tuples += maxoff - minoff + 1;
+            for (offnum = minoff; offnum <= maxoff; offnum = OffsetNumberNext(offnum)) {
+                IndexTuple itup = (IndexTuple)PageGetItem(page, PageGetItemId(page, offnum));
+
+                stats->num_index_tuples += BTreeTupleGetNHeapTIDs(itup);
+            }
         }
     }
 
@@ -1066,6 +1100,47 @@ restart:
     }
 }
 
+/*
+ * btreevacuumposting --- determine which heap TIDs of a posting list tuple
+ * the bulk delete callback wants removed.
+ *
+ * Returns a palloc'd description of the removed TIDs when some but not all of
+ * them go, for _bt_delitems_vacuum() to shrink the tuple with.  Returns NULL
+ * when none or all of them go; *nremaining tells these cases apart.
+ */
+static BTVacuumPosting btreevacuumposting(BTVacState *vstate, IndexTuple posting, OffsetNumber updatedoffset,
+                                          Oid partOid, int *nremaining)
+{
+    int nposting = BTreeTupleGetNPosting(posting);
+    int live = 0;
+    BTVacuumPosting vacposting = NULL;
+
+    for (int i = 0; i < nposting; i++) {
+        ItemPointer htid = BTreeTupleGetPostingN(posting, i);
+
+        if (!vstate->callback(htid, vstate->callback_state, partOid)) {
+            live++;
+            continue;
+        }
+
+        if (vacposting == NULL) {
+            vacposting = (BTVacuumPosting)palloc(offsetof(BTVacuumPostingData, deletetids) + nposting * sizeof(uint16));
+            vacposting->itup = posting;
+            vacposting->updatedoffset = updatedoffset;
+            vacposting->ndeletedtids = 0;
+        }
+        vacposting->deletetids[vacposting->ndeletedtids++] = (uint16)i;
+    }
+
+    *nremaining = live;
+    if (vacposting != NULL && live == 0) {
+        /* the whole tuple goes */
+        pfree(vacposting);
+        return NULL;
+    }
+    return vacposting;
+}
+
 /*
  *	btcanreturn() -- Check whether btree indexes support index-only scans.
  *
@@ -1215,7 +1290,11 @@ static IndexTuple btgetindextuple(IndexScanDesc scan, ScanDirection dir, BlockNu
         return NULL;
     }
 
-    /* Return the index tuple we found. */
+    /*
+     * Return the index tuple we found.  The heap TIDs of a posting list tuple
+     * all share one copy of its key, so point that at the current one.
+     */
+    scan->xs_itup->t_tid = scan->xs_ctup.t_self;
     if (heapTupleBlkOffset != 0) {
         IndexTuple itup = scan->xs_itup;
         BlockNumber dest_blkno = ItemPointerGetBlockNumber(&(itup->t_tid));
@@ -30,7 +30,10 @@
 #include "catalog/pg_proc.h"
 
 static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber offnum);
+static void _bt_prefetch_heap(IndexScanDesc scan, ScanDirection dir, bool newPage);
 static void _bt_saveitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, IndexTuple itup, Oid partOid);
+static int _bt_savepostingitems(BTScanOpaque so, int itemIndex, OffsetNumber offnum, IndexTuple itup, Oid partOid,
+                                ScanDirection dir);
 static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir);
 static Buffer _bt_walk_left(Relation rel, Buffer buf);
 static bool _bt_endpoint(IndexScanDesc scan, ScanDirection dir);
@@ -350,7 +353,9 @@ OffsetNumber _bt_binsrch(Relation rel, Buffer buf, int keysz, ScanKey scankey, b
  *
  * CRUCIAL NOTE: on a non-leaf page, the first data key is assumed to be
  * "minus infinity": this routine will always claim it is less than the
- * scankey.  The actual key value stored (if any, which there probably isn't)
+ * scankey.  Likewise, key attributes truncated away from a pivot tuple are
+ * "minus infinity", so the scankey is greater once the present ones are
+ * equal.  The actual key value stored (if any, which there probably isn't)
  * does not matter.  This convention allows us to implement the Lehman and
  * Yao convention that the first down-link pointer is before the first key.
  * See backend/access/nbtree/README for details.
@@ -374,6 +379,7 @@ int32 _bt_compare(Relation rel, int keysz, ScanKey scankey, Page page, OffsetNum
 
     TupleDesc itupdesc = RelationGetDescr(rel);
     itup = (IndexTuple)PageGetItem(page, PageGetItemId(page, offnum));
+    int ntupatts = BTreeTupleGetNAtts(itup, rel);
 
     /*
      * The scan key is set up with the attribute number associated with each
@@ -391,6 +397,10 @@ int32 _bt_compare(Relation rel, int keysz, ScanKey scankey, Page page, OffsetNum
         bool isNull = false;
         int32 result;
 
+        /* truncated attribute of a pivot tuple */
+        if (unlikely(scankey->sk_attno > ntupatts))
+            return 1;
+
         datum = index_getattr(itup, scankey->sk_attno, itupdesc, &isNull);
 
         if (likely((!(scankey->sk_flags & SK_ISNULL)) && !isNull)) {
@@ -967,6 +977,8 @@ bool _bt_next(IndexScanDesc scan, ScanDirection dir)
                 return false;
             /* Drop the lock, but not pin, on the new page */
             LockBuffer(so->currPos.buf, BUFFER_LOCK_UNLOCK);
+        } else if (so->prefetchItem >= 0) {
+            _bt_prefetch_heap(scan, dir, false);
         }
     } else {
         if (--so->currPos.itemIndex < so->currPos.firstItem) {
@@ -977,6 +989,8 @@ bool _bt_next(IndexScanDesc scan, ScanDirection dir)
                 return false;
             /* Drop the lock, but not pin, on the new page */
             LockBuffer(so->currPos.buf, BUFFER_LOCK_UNLOCK);
+        } else if (so->prefetchItem >= 0) {
+            _bt_prefetch_heap(scan, dir, false);
         }
     }
 
@@ -1047,6 +1061,9 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
     /* initialize tuple workspace to empty */
     so->currPos.nextTupleOffset = 0;
 
+    /* the caller starts heap prefetching for the new items, if it wants to */
+    so->prefetchItem = -1;
+
     if (ScanDirectionIsForward(dir)) {
         /* load items[] in ascending order */
         itemIndex = 0;
@@ -1063,8 +1080,12 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
                               : heapOid;
                 Assert(!isnull);
                 /* tuple passes all scan key conditions, so remember it */
-                _bt_saveitem(so, itemIndex, offnum, itup, partOid);
-                itemIndex++;
+                if (BTreeTupleIsPosting(itup)) {
+                    itemIndex = _bt_savepostingitems(so, itemIndex, offnum, itup, partOid, dir);
+                } else {
+                    _bt_saveitem(so, itemIndex, offnum, itup, partOid);
+                    itemIndex++;
+                }
             }
             if (!continuescan) {
                 /* there can't be any more matches, so stop */
@@ -1075,13 +1096,13 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
             offnum = OffsetNumberNext(offnum);
         }
 
-        Assert(itemIndex <= MaxIndexTuplesPerPage);
+        Assert(itemIndex <= MaxBTreeTIDsPerPage);
         so->currPos.firstItem = 0;
         so->currPos.lastItem = itemIndex - 1;
         so->currPos.itemIndex = 0;
     } else {
         /* load items[] in descending order */
-        itemIndex = MaxIndexTuplesPerPage;
+        itemIndex = MaxBTreeTIDsPerPage;
 
         offnum = Min(offnum, maxoff);
 
@@ -1094,8 +1115,12 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
                               : heapOid;
                 Assert(!isnull);
                 /* tuple passes all scan key conditions, so remember it */
-                itemIndex--;
-                _bt_saveitem(so, itemIndex, offnum, itup, partOid);
+                if (BTreeTupleIsPosting(itup)) {
+                    itemIndex = _bt_savepostingitems(so, itemIndex, offnum, itup, partOid, dir);
+                } else {
+                    itemIndex--;
+                    _bt_saveitem(so, itemIndex, offnum, itup, partOid);
+                }
             }
             if (!continuescan) {
                 /* there can't be any more matches, so stop */
@@ -1108,8 +1133,8 @@ static bool _bt_readpage(IndexScanDesc scan, ScanDirection dir, OffsetNumber off
 
         Assert(itemIndex >= 0);
         so->currPos.firstItem = itemIndex;
-        so->currPos.lastItem = MaxIndexTuplesPerPage - 1;
-        so->currPos.itemIndex = MaxIndexTuplesPerPage - 1;
+        so->currPos.lastItem = MaxBTreeTIDsPerPage - 1;
+        so->currPos.itemIndex = MaxBTreeTIDsPerPage - 1;
     }
 
     return (so->currPos.firstItem <= so->currPos.lastItem);
@@ -1133,6 +1158,48 @@ static void _bt_saveitem(BTScanOpaque so, int itemIndex, OffsetNumber offnum, co
     }
 }
 
+/*
+ * Save all heap TIDs of a posting list tuple into so->currPos.items, in the
+ * order the scan returns them, and return the next free itemIndex.
+ *
+ * The items all share one copy of the key, made without the posting list,
+ * for index-only scans.  Items are stored at increasing indexes for forward
+ * scans and at decreasing ones for backward scans, so in either case the
+ * posting list's TIDs end up in ascending order within items[].
+ */
+static int _bt_savepostingitems(BTScanOpaque so, int itemIndex, OffsetNumber offnum, IndexTuple itup, Oid partOid,
+                                ScanDirection dir)
+{
+    int nposting = BTreeTupleGetNPosting(itup);
+    int first = ScanDirectionIsForward(dir) ? itemIndex : itemIndex - nposting;
+    uint16 tupleOffset = 0;
+
+    if (so->currTuples) {
+        Size itupsz = BTreeTupleGetPostingOffset(itup);
+        IndexTuple base = (IndexTuple)(so->currTuples + so->currPos.nextTupleOffset);
+
+        tupleOffset = (uint16)so->currPos.nextTupleOffset;
+        errno_t rc = memcpy_s(base, itupsz, itup, itupsz);
+        securec_check(rc, "", "");
+        /* turn the copy into a plain tuple pointing at the first heap TID */
+        base->t_info &= ~(INDEX_SIZE_MASK | INDEX_ALT_TID_MASK);
+        base->t_info |= itupsz;
+        base->t_tid = *BTreeTupleGetPostingN(itup, 0);
+        so->currPos.nextTupleOffset += MAXALIGN(itupsz);
+    }
+
+    for (int i = 0; i < nposting; i++) {
+        BTScanPosItem *currItem = &so->currPos.items[first + i];
+
+        currItem->heapTid = *BTreeTupleGetPostingN(itup, i);
+        currItem->indexOffset = offnum;
+        currItem->partitionOid = partOid;
+        currItem->tupleOffset = tupleOffset;
+    }
+
+    return ScanDirectionIsForward(dir) ? itemIndex + nposting : first;
+}
+
 /*
  *	_bt_steppage() -- Step to next page containing valid data for scan
  *
@@ -1207,8 +1274,10 @@ static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir)
                 PredicateLockPage(rel, blkno, scan->xs_snapshot);
                 /* see if there are any matches on this page */
                 /* note that this will clear moreRight if we can stop */
-                if (_bt_readpage(scan, dir, P_FIRSTDATAKEY(opaque)))
+                if (_bt_readpage(scan, dir, P_FIRSTDATAKEY(opaque))) {
+                    _bt_prefetch_heap(scan, dir, true);
                     break;
+                }
             }
             /* nope, keep going */
             blkno = opaque->btpo_next;
@@ -1250,8 +1319,10 @@ static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir)
                 PredicateLockPage(rel, BufferGetBlockNumber(so->currPos.buf), scan->xs_snapshot);
                 /* see if there are any matches on this page */
                 /* note that this will clear moreLeft if we can stop */
-                if (_bt_readpage(scan, dir, PageGetMaxOffsetNumber(page)))
+                if (_bt_readpage(scan, dir, PageGetMaxOffsetNumber(page))) {
+                    _bt_prefetch_heap(scan, dir, true);
                     break;
+                }
             }
         }
     }
@@ -1259,6 +1330,77 @@ static bool _bt_steppage(IndexScanDesc scan, ScanDirection dir)
     return true;
 }
 
+/*
+ *	_bt_prefetch_heap() -- prefetch the heap pages of the coming matches
+ *
+ * so->currPos holds the matches of a whole leaf page, which the caller
+ * fetches from the heap one at a time, in index order.  Keep the heap blocks
+ * of the next matches requested ahead of the one being returned, up to
+ * target_prefetch_pages blocks, so that those fetches find the pages already
+ * read or in flight instead of waiting on one random read after another.
+ * Call with newPage once the scan steps to a leaf page, and then each time
+ * it advances to another item of that page, to refill the window.
+ *
+ * Prefetching starts only once the scan steps to a second leaf page, so that
+ * short scans don't read heap pages they never get to, and stops at the end
+ * of the leaf page.  Only a change of block from one match to the next
+ * counts as a new block, a block met again later is simply requested again.
+ */
+static void _bt_prefetch_heap(IndexScanDesc scan, ScanDirection dir, bool newPage)
+{
+#ifdef USE_PREFETCH
+    BTScanOpaque so = (BTScanOpaque)scan->opaque;
+    BTScanPos pos = &so->currPos;
+    int step = ScanDirectionIsForward(dir) ? 1 : -1;
+    int target = u_sess->storage_cxt.target_prefetch_pages;
+    BlockNumber blocks[MAX_PREFETCH_REQSIZ];
+    int nblocks = 0;
+
+    if (newPage) {
+        if (!scan->xs_heap_prefetch || scan->heapRelation == NULL || target <= 0)
+            return;
+        /* the block of the first item is read right away, start after it */
+        so->prefetchItem = pos->itemIndex + step;
+        so->prefetchBlock = ItemPointerGetBlockNumber(&pos->items[pos->itemIndex].heapTid);
+        so->prefetchDistance = 0;
+    } else if (so->prefetchDistance > 0 &&
+               ItemPointerGetBlockNumber(&pos->items[pos->itemIndex].heapTid) !=
+                   ItemPointerGetBlockNumber(&pos->items[pos->itemIndex - step].heapTid)) {
+        /* the scan moved on to a block that was requested before */
+        so->prefetchDistance--;
+    }
+
+    while (so->prefetchDistance < target && so->prefetchItem >= pos->firstItem &&
+           so->prefetchItem <= pos->lastItem) {
+        BlockNumber blkno = ItemPointerGetBlockNumber(&pos->items[so->prefetchItem].heapTid);
+
+        so->prefetchItem += step;
+        if (blkno == so->prefetchBlock)
+            continue;
+        so->prefetchBlock = blkno;
+        so->prefetchDistance++;
+
+        ADIO_RUN()
+        {
+            /* Async Direct I/O takes the blocks as one list */
+            blocks[nblocks++] = blkno;
+            if (nblocks == MAX_PREFETCH_REQSIZ) {
+                PageListPrefetch(scan->heapRelation, MAIN_FORKNUM, blocks, nblocks, 0, 0);
+                nblocks = 0;
+            }
+        }
+        ADIO_ELSE()
+        {
+            PrefetchBuffer(scan->heapRelation, MAIN_FORKNUM, blkno);
+        }
+        ADIO_END();
+    }
+
+    if (nblocks > 0)
+        PageListPrefetch(scan->heapRelation, MAIN_FORKNUM, blocks, nblocks, 0, 0);
+#endif
+}
+
 /*
  * _bt_walk_left() -- step left one page, if possible
  *
@@ -1585,8 +1727,8 @@ bool _bt_gettuple_internal(IndexScanDesc scan, ScanDirection dir)
                  * just forget any excess entries.
                  */
                 if (so->killedItems == NULL)
-                    so->killedItems = (int *)palloc(MaxIndexTuplesPerPage * sizeof(int));
-                if (so->numKilled < MaxIndexTuplesPerPage)
+                    so->killedItems = (int *)palloc(MaxBTreeTIDsPerPage * sizeof(int));
+                if (so->numKilled < MaxBTreeTIDsPerPage)
                     so->killedItems[so->numKilled++] = so->currPos.itemIndex;
             }
 
@@ -1637,9 +1779,13 @@ bool _bt_check_natts(const Relation index, Page page, OffsetNumber offnum)
 
     if (P_ISLEAF(opaque) && offnum >= P_FIRSTDATAKEY(opaque)) {
         /*
-         * Regular leaf tuples have as every index attributes
+         * Regular leaf tuples have as every index attributes, posting list
+         * tuples included
          */
         return (BTreeTupleGetNAtts(itup, index) == natts);
+    } else if (BTreeTupleIsPosting(itup)) {
+        /* Posting list tuples are only found among leaf data items */
+        return false;
     } else if (!P_ISLEAF(opaque) && offnum == P_FIRSTDATAKEY(opaque)) {
         /*
          * Leftmost tuples on non-leaf pages have no attributes, or haven't
@@ -1649,9 +1795,11 @@ bool _bt_check_natts(const Relation index, Page page, OffsetNumber offnum)
     } else {
         /*
          * Pivot tuples stored in non-leaf pages and hikeys of leaf pages
-         * contain only key attributes
+         * contain only key attributes, possibly suffix truncated
          */
-        return (BTreeTupleGetNAtts(itup, index) == nkeyatts);
+        int16 tupnatts = BTreeTupleGetNAtts(itup, index);
+
+        return (tupnatts > 0 && tupnatts <= nkeyatts);
     }
 }
 
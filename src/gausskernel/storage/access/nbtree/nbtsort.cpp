@@ -98,6 +98,7 @@ static Page _bt_blnewpage(uint32 level);
 static void _bt_slideleft(Page page);
 static void _bt_sortaddtup(Page page, Size itemsize, IndexTuple itup, OffsetNumber itup_off);
 static void _bt_load(BTWriteState *wstate, BTSpool *btspool, BTSpool *btspool2);
+static void _bt_load_pending(BTWriteState *wstate, BTPageState *state, BTDedupState dstate);
 
 /*
  * Interface routines
@@ -533,15 +534,23 @@ void _bt_buildadd(BTWriteState *wstate, BTPageState *state, IndexTuple itup)
         *hii = *ii;
         ItemIdSetUnused(ii); /* redundant */
         ((PageHeader)opage)->pd_lower -= sizeof(ItemIdData);
-        int indnatts = IndexRelationGetNumberOfAttributes(wstate->index);
-        int indnkeyatts = IndexRelationGetNumberOfKeyAttributes(wstate->index);
 
-        if (indnkeyatts != indnatts && P_ISLEAF(opageop)) {
+        if (P_ISLEAF(opageop)) {
+            IndexTuple lastleft = (IndexTuple)PageGetItem(opage, PageGetItemId(opage, OffsetNumberPrev(last_off)));
+
+            keytup = _bt_truncate(wstate->index, lastleft, oitup);
+        } else {
+            keytup = oitup;
+        }
+
+        if (keytup != oitup) {
             /*
-             * We truncate included attributes of high key here.  Subsequent
-             * insertions assume that hikey is already truncated, and so they
-             * need not worry about it, when copying the high key into the
-             * parent page as a downlink.
+             * We truncate included attributes of high key here, as well as
+             * the key attributes not needed to separate it from the last
+             * item left on the page.  Subsequent insertions assume that
+             * hikey is already truncated, and so they need not worry about
+             * it, when copying the high key into the parent page as a
+             * downlink.
              *
              * The code above have just rearranged item pointers, but it
              * didn't save any space.  In order to save the space on page we
@@ -550,7 +559,6 @@ void _bt_buildadd(BTWriteState *wstate, BTPageState *state, IndexTuple itup)
              * have to shift much of tuples memory.  Shift of ItemId's is
              * rather cheap, because they are small.
              */
-            keytup = _bt_nonkey_truncate(wstate->index, oitup);
             /* delete "wrong" high key, insert keytup as P_HIKEY. */
             PageIndexTupleDelete(opage, P_HIKEY);
             _bt_sortaddtup(opage, IndexTupleSize(keytup), keytup, P_HIKEY);
@@ -763,6 +771,39 @@ static void _bt_load(BTWriteState *wstate, BTSpool *btspool, BTSpool *btspool2)
             }
         }
         _bt_freeskey(indexScanKey);
+    } else if (_bt_dedup_enabled(wstate->index)) {
+        /*
+         * Merge runs of equal tuples into posting list tuples as they come.
+         * The tuplesort returns equal tuples in heap TID order, which is the
+         * order posting lists keep.
+         */
+        BTDedupStateData dstate;
+
+        dstate.base = NULL;
+        dstate.htids = NULL;
+        while ((itup = tuplesort_getindextuple(btspool->sortstate, true, &should_free)) != NULL) {
+            /* When we see first tuple, create first index page */
+            if (state == NULL) {
+                state = _bt_pagestate(wstate, 0);
+                dstate.maxpostingsize = Min(BTMaxItemSize(state->btps_page) / 2, INDEX_SIZE_MASK);
+                dstate.htids = (ItemPointer)palloc(dstate.maxpostingsize);
+            }
+
+            if (dstate.base == NULL || !_bt_dedup_equal(dstate.base, itup) || !_bt_dedup_save_htid(&dstate, itup)) {
+                /* itup starts a new run */
+                if (dstate.base != NULL)
+                    _bt_load_pending(wstate, state, &dstate);
+                _bt_dedup_start_pending(&dstate, CopyIndexTuple(itup), InvalidOffsetNumber);
+            }
+            if (should_free) {
+                pfree(itup);
+                itup = NULL;
+            }
+        }
+        if (dstate.base != NULL)
+            _bt_load_pending(wstate, state, &dstate);
+        if (dstate.htids != NULL)
+            pfree(dstate.htids);
     } else {
         /* merge is unnecessary */
         while ((itup = tuplesort_getindextuple(btspool->sortstate, true, &should_free)) != NULL) {
@@ -802,6 +843,20 @@ static void _bt_load(BTWriteState *wstate, BTSpool *btspool, BTSpool *btspool2)
     }
 }
 
+/*
+ * Add the pending run of equal tuples of a deduplicating build to the leaf
+ * level, as a posting list tuple unless the run is a single tuple.
+ */
+static void _bt_load_pending(BTWriteState *wstate, BTPageState *state, BTDedupState dstate)
+{
+    IndexTuple itup = _bt_form_posting(dstate->base, dstate->htids, dstate->nhtids);
+
+    _bt_buildadd(wstate, state, itup);
+    pfree(itup);
+    pfree(dstate->base);
+    dstate->base = NULL;
+}
+
 /*
  * if itup <= itup2, return true;
  * if itup > itup2, return false.
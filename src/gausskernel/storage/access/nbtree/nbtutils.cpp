@@ -40,6 +40,7 @@ static bool _bt_fix_scankey_strategy(ScanKey skey, const int16 *indoption);
 static void _bt_mark_scankey_required(ScanKey skey);
 static bool _bt_check_rowcompare(ScanKey skey, IndexTuple tuple, TupleDesc tupdesc, ScanDirection dir,
                                  bool *continuescan);
+static bool _bt_killitems_posting(BTScanOpaque so, bool *killedmap, int itemIndex, IndexTuple ituple);
 
 /*
  * _bt_mkscankey
@@ -54,6 +55,7 @@ ScanKey _bt_mkscankey(Relation rel, IndexTuple itup)
     TupleDesc itupdesc;
     int indnatts PG_USED_FOR_ASSERTS_ONLY;
     int indnkeyatts;
+    int tupnatts;
     int16* indoption = NULL;
     int i;
 
@@ -62,12 +64,16 @@ ScanKey _bt_mkscankey(Relation rel, IndexTuple itup)
     indnkeyatts = IndexRelationGetNumberOfKeyAttributes(rel);
     indoption = rel->rd_indoption;
 
+    tupnatts = BTreeTupleGetNAtts(itup, rel);
+
     Assert(indnkeyatts != 0);
     Assert(indnkeyatts <= indnatts);
-    Assert(BTreeTupleGetNAtts(itup, rel) == indnatts || BTreeTupleGetNAtts(itup, rel) == indnkeyatts);
+    Assert(tupnatts == indnatts || tupnatts <= indnkeyatts);
     /*
      * We'll execute search using ScanKey constructed on key columns. Non key
-     * (included) columns must be omitted.
+     * (included) columns must be omitted.  Key columns truncated away from a
+     * pivot tuple are left as NULL; callers must search with only the first
+     * BTreeTupleGetNKeyAtts() keys of such a tuple.
      */
     skey = (ScanKey)palloc(indnkeyatts * sizeof(ScanKeyData));
     for (i = 0; i < indnkeyatts; i++) {
@@ -81,7 +87,12 @@ ScanKey _bt_mkscankey(Relation rel, IndexTuple itup)
          * comparison can be needed.
          */
         procinfo = index_getprocinfo(rel, i + 1, (uint16)BTORDER_PROC);
-        arg = index_getattr(itup, i + 1, itupdesc, &null);
+        if (i < tupnatts) {
+            arg = index_getattr(itup, i + 1, itupdesc, &null);
+        } else {
+            arg = (Datum)0;
+            null = true;
+        }
         flags = (null ? SK_ISNULL : 0) | (((uint16)indoption[i]) << SK_BT_INDOPTION_SHIFT);
         ScanKeyEntryInitializeWithInfo(&skey[i], flags, (AttrNumber)(i + 1), InvalidStrategy, InvalidOid,
                                        rel->rd_indcollation[i], procinfo, arg);
@@ -1557,7 +1568,11 @@ static bool _bt_check_rowcompare(ScanKey skey, IndexTuple tuple, TupleDesc tupde
  * the page, and so there is no need to search left from the recorded offset.
  * (This observation also guarantees that the item is still the right one
  * to delete, which might otherwise be questionable since heap TIDs can get
- * recycled.)
+ * recycled.)  Deduplication may have merged items into posting list tuples
+ * meanwhile, which moves them left; we don't find those either.
+ *
+ * A posting list tuple is only marked when all of its heap TIDs were
+ * killed, and it still has exactly the heap TIDs that we read.
  */
 void _bt_killitems(IndexScanDesc scan, bool haveLock)
 {
@@ -1571,6 +1586,8 @@ void _bt_killitems(IndexScanDesc scan, bool haveLock)
     AttrNumber partitionOidAttr;
     TupleDesc tupdesc;
     Oid heapOid = IndexScanGetPartHeapOid(scan);
+    bool killedmap[MaxBTreeTIDsPerPage];
+    errno_t rc;
 
     Assert(BufferIsValid(so->currPos.buf));
 
@@ -1585,6 +1602,13 @@ void _bt_killitems(IndexScanDesc scan, bool haveLock)
     tupdesc = RelationGetDescr(scan->indexRelation);
     partitionOidAttr = IndexRelationGetNumberOfAttributes(scan->indexRelation);
 
+    /* killedmap tells which of the items were killed and not yet processed */
+    rc = memset_s(killedmap, sizeof(killedmap), 0, sizeof(killedmap));
+    securec_check(rc, "", "");
+    for (i = 0; i < so->numKilled; i++) {
+        killedmap[so->killedItems[i]] = true;
+    }
+
     for (i = 0; i < so->numKilled; i++) {
         int itemIndex = so->killedItems[i];
         BTScanPosItem *kitem = &so->currPos.items[itemIndex];
@@ -1592,6 +1616,9 @@ void _bt_killitems(IndexScanDesc scan, bool haveLock)
         Oid partOid = kitem->partitionOid;
 
         Assert(itemIndex >= so->currPos.firstItem && itemIndex <= so->currPos.lastItem);
+        if (!killedmap[itemIndex]) {
+            continue; /* done along with its posting list tuple */
+        }
         if (offnum < minoff) {
             continue; /* pure paranoia */
         }
@@ -1603,7 +1630,23 @@ void _bt_killitems(IndexScanDesc scan, bool haveLock)
                                   ? DatumGetUInt32(index_getattr(ituple, partitionOidAttr, tupdesc, &isNull))
                                   : heapOid;
             Assert(!isNull);
-            if (ItemPointerEquals(&ituple->t_tid, &kitem->heapTid) && currPartOid == partOid) {
+            if (BTreeTupleIsPosting(ituple)) {
+                int nposting = BTreeTupleGetNPosting(ituple);
+                int j;
+
+                for (j = 0; j < nposting; j++) {
+                    if (ItemPointerEquals(BTreeTupleGetPostingN(ituple, j), &kitem->heapTid))
+                        break;
+                }
+                if (j < nposting && currPartOid == partOid) {
+                    /* found the item */
+                    if (_bt_killitems_posting(so, killedmap, itemIndex, ituple)) {
+                        ItemIdMarkDead(iid);
+                        killedsomething = true;
+                    }
+                    break; /* out of inner search loop */
+                }
+            } else if (ItemPointerEquals(&ituple->t_tid, &kitem->heapTid) && currPartOid == partOid) {
                 /* found the item */
                 ItemIdMarkDead(iid);
                 killedsomething = true;
@@ -1637,6 +1680,40 @@ void _bt_killitems(IndexScanDesc scan, bool haveLock)
     so->numKilled = 0;
 }
 
+/*
+ * _bt_killitems_posting - were all heap TIDs of a posting list tuple killed?
+ *
+ * The items that were read from the tuple are the run of items around
+ * itemIndex that share its indexOffset.  They must match the posting list
+ * one for one, else the tuple changed after we read it.  The run is marked
+ * done in killedmap either way.
+ */
+static bool _bt_killitems_posting(BTScanOpaque so, bool *killedmap, int itemIndex, IndexTuple ituple)
+{
+    OffsetNumber indexOffset = so->currPos.items[itemIndex].indexOffset;
+    int first = itemIndex;
+    int last = itemIndex;
+    bool allkilled;
+
+    while (first > so->currPos.firstItem && so->currPos.items[first - 1].indexOffset == indexOffset) {
+        first--;
+    }
+    while (last < so->currPos.lastItem && so->currPos.items[last + 1].indexOffset == indexOffset) {
+        last++;
+    }
+
+    allkilled = (last - first + 1 == BTreeTupleGetNPosting(ituple));
+    for (int i = first; i <= last; i++) {
+        if (allkilled &&
+            (!killedmap[i] || !ItemPointerEquals(&so->currPos.items[i].heapTid, BTreeTupleGetPostingN(ituple, i - first)))) {
+            allkilled = false;
+        }
+        killedmap[i] = false;
+    }
+
+    return allkilled;
+}
+
 /*
  * The following routines manage a shared-memory area in which we track
  * assignment of "vacuum cycle IDs" to currently-active btree vacuuming
@@ -1838,25 +1915,80 @@ Datum btoptions(PG_FUNCTION_ARGS)
 }
 
 /*
- *	_bt_nonkey_truncate() -- remove non-key (INCLUDE) attributes from index
- *							tuple.
+ *	_bt_keep_natts() -- number of leading key attributes needed to tell
+ *						lastleft and firstright apart.
  *
- *	Transforms an ordinal B-tree leaf index tuple into pivot tuple to be used
- *	as hikey or non-leaf page tuple with downlink.  Note that t_tid offset
- *	will be overritten in order to represent number of present tuple attributes.
+ *	Returns the number of key attributes if they are equal in all of them.
  */
-IndexTuple _bt_nonkey_truncate(Relation idxrel, IndexTuple olditup)
+static int _bt_keep_natts(Relation idxrel, IndexTuple lastleft, IndexTuple firstright)
 {
-    IndexTuple truncated;
+    TupleDesc itupdesc = RelationGetDescr(idxrel);
     int nkeyattrs = IndexRelationGetNumberOfKeyAttributes(idxrel);
+    int attnum;
+
+    for (attnum = 1; attnum < nkeyattrs; attnum++) {
+        Datum datum1;
+        Datum datum2;
+        bool isNull1 = false;
+        bool isNull2 = false;
+
+        datum1 = index_getattr(lastleft, attnum, itupdesc, &isNull1);
+        datum2 = index_getattr(firstright, attnum, itupdesc, &isNull2);
+        if (isNull1 != isNull2) {
+            break;
+        }
+        if (!isNull1) {
+            FmgrInfo* procinfo = index_getprocinfo(idxrel, attnum, (uint16)BTORDER_PROC);
+
+            if (DatumGetInt32(FunctionCall2Coll(procinfo, idxrel->rd_indcollation[attnum - 1], datum1, datum2)) != 0) {
+                break;
+            }
+        }
+    }
+
+    return attnum;
+}
+
+/*
+ *	_bt_truncate() -- build the high key of a leaf page being split.
+ *
+ *	Transforms firstright, the first tuple of the right half, into a pivot
+ *	tuple to be used as the left half's hikey and, later, as the downlink to
+ *	the right half.  Non-key (INCLUDE) attributes are always removed, and so
+ *	are the trailing key attributes that are not needed to distinguish
+ *	lastleft, the last tuple of the left half, from firstright.  Note that
+ *	t_tid offset will be overritten in order to represent number of present
+ *	tuple attributes.
+ *
+ *	Returns firstright itself if there is nothing to truncate.  A posting list
+ *	tuple is never returned as it is, since a high key must not have one.
+ */
+IndexTuple _bt_truncate(Relation idxrel, IndexTuple lastleft, IndexTuple firstright)
+{
+    IndexTuple truncated;
+    int natts = IndexRelationGetNumberOfAttributes(idxrel);
+    int keepnatts = IndexRelationGetNumberOfKeyAttributes(idxrel);
 
     /*
      * We're assuming to truncate only regular leaf index tuples which have
      * both key and non-key attributes.
      */
-    Assert(BTreeTupleGetNAtts(olditup, idxrel) == IndexRelationGetNumberOfAttributes(idxrel));
-    truncated = index_truncate_tuple(RelationGetDescr(idxrel), olditup, nkeyattrs);
-    BTreeTupleSetNAtts(truncated, nkeyattrs);
+    Assert(BTreeTupleGetNAtts(lastleft, idxrel) == natts);
+    Assert(BTreeTupleGetNAtts(firstright, idxrel) == natts);
+
+    /* Older binaries can't read truncated key attributes */
+    if (t_thrd.proc->workingVersionNum >= BTREE_SUFFIX_TRUNCATION_VERSION) {
+        keepnatts = _bt_keep_natts(idxrel, lastleft, firstright);
+    }
+    if (keepnatts == natts) {
+        if (BTreeTupleIsPosting(firstright)) {
+            return _bt_form_posting(firstright, BTreeTupleGetPosting(firstright), 1);
+        }
+        return firstright;
+    }
+
+    truncated = index_truncate_tuple(RelationGetDescr(idxrel), firstright, keepnatts);
+    BTreeTupleSetNAtts(truncated, keepnatts);
 
     return truncated;
 }
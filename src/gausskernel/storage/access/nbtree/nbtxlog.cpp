@@ -596,13 +596,29 @@ static void btree_xlog_vacuum(XLogReaderState *record)
         Size len;
 
         ptr = XLogRecGetBlockData(record, BTREE_VACUUM_ORIG_BLOCK_NUM, &len);
-        BtreeXlogVacuumOperatorPage(&redobuf, (void *)xlrec, (void *)ptr, len);
+        BtreeXlogVacuumOperatorPage(&redobuf, (void *)xlrec, XLogRecGetDataLen(record), (void *)ptr, len);
         MarkBufferDirty(redobuf.buf);
     }
     if (BufferIsValid(redobuf.buf))
         UnlockReleaseBuffer(redobuf.buf);
 }
 
+static void btree_xlog_dedup(XLogReaderState *record)
+{
+    RedoBufferInfo buffer;
+
+    if (XLogReadBufferForRedo(record, BTREE_DEDUP_ORIG_BLOCK_NUM, &buffer) == BLK_NEEDS_REDO) {
+        Size len;
+        char *ptr = XLogRecGetBlockData(record, BTREE_DEDUP_ORIG_BLOCK_NUM, &len);
+
+        BtreeXlogDedupOperatorPage(&buffer, (void *)XLogRecGetData(record), (void *)ptr, len);
+        MarkBufferDirty(buffer.buf);
+    }
+    if (BufferIsValid(buffer.buf)) {
+        UnlockReleaseBuffer(buffer.buf);
+    }
+}
+
 static void btree_xlog_delete(XLogReaderState *record)
 {
     RedoBufferInfo buffer;
@@ -1024,6 +1040,9 @@ void btree_redo(XLogReaderState *record)
         case XLOG_BTREE_REUSE_PAGE:
             btree_xlog_reuse_page(record);
             break;
+        case XLOG_BTREE_DEDUP:
+            btree_xlog_dedup(record);
+            break;
         default:
             ereport(PANIC, (errmsg("btree_redo: unknown op code %hhu", info)));
     }
@@ -260,8 +260,30 @@ void BtreeXlogSplitOperatorLeftpage(RedoBufferInfo *lbuf, void *recorddata, Bloc
     PageSetLSN(lpage, lbuf->lsn);
 }
 
-void BtreeXlogVacuumOperatorPage(RedoBufferInfo *redobuffer, void *recorddata, void *blkdata, Size len)
+/*
+ * Shrink the posting list tuples of a vacuum record, before its deletes are
+ * applied.  The update metadata follows the updated offsets.
+ */
+static void BtreeXlogVacuumUpdatePostings(Page page, OffsetNumber *updatedoffsets, int nupdated)
 {
+    char *ptr = (char *)(updatedoffsets + nupdated);
+
+    for (int i = 0; i < nupdated; i++) {
+        xl_btree_update *update = (xl_btree_update *)ptr;
+        uint16 *deletetids = (uint16 *)(ptr + SizeOfBtreeUpdate);
+        IndexTuple origtuple = (IndexTuple)PageGetItem(page, PageGetItemId(page, updatedoffsets[i]));
+        IndexTuple itup = _bt_update_posting(origtuple, deletetids, update->ndeletedtids);
+
+        _bt_replace_item(page, updatedoffsets[i], itup);
+        pfree(itup);
+        ptr += SizeOfBtreeUpdate + update->ndeletedtids * sizeof(uint16);
+    }
+}
+
+void BtreeXlogVacuumOperatorPage(RedoBufferInfo *redobuffer, void *recorddata, Size recorddatalen, void *blkdata,
+                                 Size len)
+{
+    xl_btree_vacuum *xlrec = (xl_btree_vacuum *)recorddata;
     Page page = redobuffer->pageinfo.page;
     char *ptr = (char *)blkdata;
     BTPageOpaqueInternal opaque;
@@ -273,6 +295,12 @@ void BtreeXlogVacuumOperatorPage(RedoBufferInfo *redobuffer, void *recorddata, v
         unused = (OffsetNumber *)ptr;
         unend = (OffsetNumber *)((char *)ptr + len);
 
+        /* records that update posting list tuples carry the counts */
+        if (recorddatalen >= SizeOfBtreeVacuumPosting && xlrec->nupdated > 0) {
+            unend = unused + xlrec->ndeleted;
+            BtreeXlogVacuumUpdatePostings(page, unend, xlrec->nupdated);
+        }
+
         if (module_logging_is_on(MOD_REDO)) {
             DumpBtreeDeleteInfo(redobuffer->lsn, unused, unend - unused);
             DumpPageInfo(page, redobuffer->lsn);
@@ -295,6 +323,23 @@ void BtreeXlogVacuumOperatorPage(RedoBufferInfo *redobuffer, void *recorddata, v
     }
 }
 
+void BtreeXlogDedupOperatorPage(RedoBufferInfo *buffer, void *recorddata, void *blkdata, Size len)
+{
+    xl_btree_dedup *xlrec = (xl_btree_dedup *)recorddata;
+    Page page = buffer->pageinfo.page;
+    Page newpage;
+
+    Assert(len == xlrec->nintervals * sizeof(BTDedupInterval));
+
+    newpage = _bt_dedup_build_page(page, (BTDedupInterval *)blkdata, xlrec->nintervals);
+    PageRestoreTempPage(newpage, page);
+
+    PageSetLSN(page, buffer->lsn);
+    if (module_logging_is_on(MOD_REDO)) {
+        DumpPageInfo(page, buffer->lsn);
+    }
+}
+
 void BtreeXlogDeleteOperatorPage(RedoBufferInfo *buffer, void *recorddata, Size recorddatalen)
 {
     xl_btree_delete *xlrec = (xl_btree_delete *)recorddata;
@@ -667,6 +712,20 @@ static XLogRecParseState *BtreeXlogDeleteParseBlock(XLogReaderState *record, uin
     return recordstatehead;
 }
 
+static XLogRecParseState *BtreeXlogDedupParseBlock(XLogReaderState *record, uint32 *blocknum)
+{
+    XLogRecParseState *recordstatehead = NULL;
+
+    *blocknum = 1;
+    XLogParseBufferAllocListFunc(record, &recordstatehead, NULL);
+    if (recordstatehead == NULL) {
+        return NULL;
+    }
+
+    XLogRecSetBlockDataState(record, BTREE_DEDUP_ORIG_BLOCK_NUM, recordstatehead);
+    return recordstatehead;
+}
+
 static XLogRecParseState *BtreeXlogMarkHalfdeadParseBlock(XLogReaderState *record, uint32 *blocknum)
 {
     XLogRecParseState *recordstatehead = NULL;
@@ -834,6 +893,9 @@ XLogRecParseState *BtreeRedoParseToBlock(XLogReaderState *record, uint32 *blockn
         case XLOG_BTREE_REUSE_PAGE:
             recordblockstate = BtreeXlogReusePageParseBlock(record, blocknum);
             break;
+        case XLOG_BTREE_DEDUP:
+            recordblockstate = BtreeXlogDedupParseBlock(record, blocknum);
+            break;
         default:
             ereport(PANIC, (errmsg("BtreeRedoParseToBlock: unknown op code %u", info)));
     }
@@ -927,13 +989,30 @@ static void BtreeXlogVacuumBlock(XLogBlockHead *blockhead, XLogBlockDataParse *b
     XLogRedoAction action;
     action = XLogCheckBlockDataRedoAction(datadecode, bufferinfo);
     if (action == BLK_NEEDS_REDO) {
-        char *maindata = XLogBlockDataGetMainData(datadecode, NULL);
+        Size maindatalen = 0;
+        char *maindata = XLogBlockDataGetMainData(datadecode, &maindatalen);
         Size blkdatalen = 0;
         char *blkdata = NULL;
 
         blkdata = XLogBlockDataGetBlockData(datadecode, &blkdatalen);
 
-        BtreeXlogVacuumOperatorPage(bufferinfo, (void *)maindata, (void *)blkdata, blkdatalen);
+        BtreeXlogVacuumOperatorPage(bufferinfo, (void *)maindata, maindatalen, (void *)blkdata, blkdatalen);
+
+        MakeRedoBufferDirty(bufferinfo);
+    }
+}
+
+static void BtreeXlogDedupBlock(XLogBlockHead *blockhead, XLogBlockDataParse *blockdatarec, RedoBufferInfo *bufferinfo)
+{
+    XLogBlockDataParse *datadecode = blockdatarec;
+    XLogRedoAction action;
+    action = XLogCheckBlockDataRedoAction(datadecode, bufferinfo);
+    if (action == BLK_NEEDS_REDO) {
+        char *maindata = XLogBlockDataGetMainData(datadecode, NULL);
+        Size blkdatalen = 0;
+        char *blkdata = XLogBlockDataGetBlockData(datadecode, &blkdatalen);
+
+        BtreeXlogDedupOperatorPage(bufferinfo, (void *)maindata, (void *)blkdata, blkdatalen);
 
         MakeRedoBufferDirty(bufferinfo);
     }
@@ -1067,6 +1146,9 @@ void BtreeRedoDataBlock(XLogBlockHead *blockhead, XLogBlockDataParse *blockdatar
         case XLOG_BTREE_NEWROOT:
             BtreeXlogNewrootBlock(blockhead, blockdatarec, bufferinfo);
             break;
+        case XLOG_BTREE_DEDUP:
+            BtreeXlogDedupBlock(blockhead, blockdatarec, bufferinfo);
+            break;
         default:
             ereport(PANIC, (errmsg("btree_redo_block: unknown op code %u", info)));
     }
@@ -80,6 +80,9 @@ void btree_desc(StringInfo buf, XLogReaderState *record)
             xl_btree_vacuum *xlrec = (xl_btree_vacuum *)rec;
 
             appendStringInfo(buf, "vacuum: lastBlockVacuumed %u ", xlrec->lastBlockVacuumed);
+            if (XLogRecGetDataLen(record) >= SizeOfBtreeVacuumPosting) {
+                appendStringInfo(buf, "ndeleted %u; nupdated %u", (uint32)xlrec->ndeleted, (uint32)xlrec->nupdated);
+            }
             break;
         }
         case XLOG_BTREE_DELETE: {
@@ -135,6 +138,12 @@ void btree_desc(StringInfo buf, XLogReaderState *record)
             }
             break;
         }
+        case XLOG_BTREE_DEDUP: {
+            xl_btree_dedup *xlrec = (xl_btree_dedup *)rec;
+
+            appendStringInfo(buf, "dedup: nintervals %u", (uint32)xlrec->nintervals);
+            break;
+        }
         default:
             appendStringInfo(buf, "UNKNOWN");
             break;
@@ -334,9 +334,9 @@ void heapam_scan_markpos(TableScanDesc sscan)
     return heap_markpos(sscan);
 }
 
-void heapam_scan_init_parallel_seqscan(TableScanDesc sscan, int32 dop, ScanDirection dir)
+void heapam_scan_init_parallel_seqscan(TableScanDesc sscan, int32 dop, ScanDirection dir, int plan_node_id)
 {
-    return heap_init_parallel_seqscan(sscan, dop, dir);
+    return heap_init_parallel_seqscan(sscan, dop, dir, plan_node_id);
 }
 
 
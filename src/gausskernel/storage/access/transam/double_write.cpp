@@ -995,6 +995,32 @@ void dw_cxt_init_single()
 }
 
 
+/*
+ * Decide the torn page protection of this run. Double write stays the default, full page images in WAL
+ * protect the pages instead when asked to.
+ */
+static void dw_resolve_torn_page_mode()
+{
+    int mode = g_instance.attr.attr_storage.torn_page_protection;
+
+    if (!g_instance.attr.attr_storage.enableIncrementalCheckpoint) {
+        /* full checkpoint keeps full_page_writes as it is */
+        g_instance.dw_batch_cxt.torn_page_mode = TORN_PAGE_DOUBLE_WRITE;
+        return;
+    }
+
+    if (mode == TORN_PAGE_FULL_PAGE_WRITE && !u_sess->attr.attr_storage.fullPageWrites) {
+        /* without full page images nothing would protect the pages, keep the double write files */
+        ereport(WARNING, (errmodule(MOD_DW), errmsg("full_page_writes is off, using double write for torn page "
+                                                    "protection instead of full_page_write")));
+        mode = TORN_PAGE_DOUBLE_WRITE;
+    }
+
+    g_instance.dw_batch_cxt.torn_page_mode = mode;
+    ereport(LOG, (errmodule(MOD_DW), errmsg("torn page protection: %s",
+                                            (mode == TORN_PAGE_DOUBLE_WRITE) ? "double write" : "full page write")));
+}
+
 void dw_init(bool shut_down)
 {
     MemoryContext old_mem_cxt;
@@ -1015,6 +1041,7 @@ void dw_init(bool shut_down)
     old_mem_cxt = MemoryContextSwitchTo(mem_cxt);
 
     dw_file_check_and_rebuild();
+    dw_resolve_torn_page_mode();
     ereport(LOG, (errmodule(MOD_DW), errmsg("Double Write init")));
 
     dw_cxt_init_batch();
@@ -1039,6 +1066,8 @@ void dw_init(bool shut_down)
 
     /*
      * After recovering partially written pages (if any), we will un-initialize, if the double write is disabled.
+     * Pages left in the files by a run that used double write are recovered above whatever the torn page
+     * protection of this run is.
      */
     if (!dw_enabled()) {
         dw_free_resource(batch_cxt);
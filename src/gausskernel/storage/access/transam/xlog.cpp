@@ -148,6 +148,8 @@
 #define MAX_PATH_LEN 1024
 #define MAX(A, B) ((B) > (A) ? (B) : (A))
 #define ENABLE_INCRE_CKPT g_instance.attr.attr_storage.enableIncrementalCheckpoint
+/* incremental checkpoint without full page writes, torn pages are handled by double write */
+#define INCRE_CKPT_SKIP_FPW (ENABLE_INCRE_CKPT && !dw_full_page_writes())
 
 #define RecoveryFromDummyStandby() (t_thrd.postmaster_cxt.ReplConnArray[2] != NULL && IS_DN_DUMMY_STANDYS_MODE())
 
@@ -6865,7 +6867,7 @@ void BootStrapXLOG(void)
      * segment with logid=0 logseg=1. The very first WAL segment, 0/0, is not
      * used, so that we can use 0/0 to mean "before any valid WAL segment".
      */
-    if (ENABLE_INCRE_CKPT) {
+    if (INCRE_CKPT_SKIP_FPW) {
         u_sess->attr.attr_storage.fullPageWrites = false;
     }
     checkPoint.redo = XLogSegSize + SizeOfXLogLongPHD;
@@ -8894,7 +8896,7 @@ void StartupXLOG(void)
     t_thrd.xlog_cxt.RedoRecPtr = t_thrd.shemem_ptr_cxt.XLogCtl->RedoRecPtr =
         t_thrd.shemem_ptr_cxt.XLogCtl->Insert.RedoRecPtr = checkPoint.redo;
 
-    if (ENABLE_INCRE_CKPT) {
+    if (INCRE_CKPT_SKIP_FPW) {
         t_thrd.xlog_cxt.doPageWrites = false;
     } else {
         t_thrd.xlog_cxt.doPageWrites = t_thrd.xlog_cxt.lastFullPageWrites;
@@ -9625,7 +9627,7 @@ void StartupXLOG(void)
      * record before resource manager writes cleanup WAL records or checkpoint
      * record is written.
      */
-    if (ENABLE_INCRE_CKPT) {
+    if (INCRE_CKPT_SKIP_FPW) {
         Insert->fullPageWrites = false;
     } else {
         Insert->fullPageWrites = t_thrd.xlog_cxt.lastFullPageWrites;
@@ -10371,7 +10373,7 @@ void InitXLOGAccess(void)
     (void)GetRedoRecPtr();
 
     /* Also update our copy of doPageWrites. */
-    if (ENABLE_INCRE_CKPT) {
+    if (INCRE_CKPT_SKIP_FPW) {
         t_thrd.xlog_cxt.doPageWrites = false;
     } else {
         t_thrd.xlog_cxt.doPageWrites = (Insert->fullPageWrites || Insert->forcePageWrites);
@@ -10419,9 +10421,9 @@ XLogRecPtr GetRedoRecPtr(void)
 void GetFullPageWriteInfo(XLogFPWInfo *fpwInfo_p)
 {
     fpwInfo_p->redoRecPtr = t_thrd.xlog_cxt.RedoRecPtr;
-    fpwInfo_p->doPageWrites = t_thrd.xlog_cxt.doPageWrites && !ENABLE_INCRE_CKPT;
+    fpwInfo_p->doPageWrites = t_thrd.xlog_cxt.doPageWrites && !INCRE_CKPT_SKIP_FPW;
 
-    fpwInfo_p->forcePageWrites = t_thrd.shemem_ptr_cxt.XLogCtl->FpwBeforeFirstCkpt && !IsInitdb && !ENABLE_INCRE_CKPT;
+    fpwInfo_p->forcePageWrites = t_thrd.shemem_ptr_cxt.XLogCtl->FpwBeforeFirstCkpt && !IsInitdb && !INCRE_CKPT_SKIP_FPW;
 }
 
 /*
@@ -10690,7 +10692,11 @@ void CreateCheckPoint(int flags)
     int32 lastlrc = 0;
     errno_t errorno = EOK;
     XLogRecPtr curMinRecLSN = InvalidXLogRecPtr;
-    bool doFullCheckpoint = !ENABLE_INCRE_CKPT;
+    /*
+     * Full page images are only enough when the redo point is the insert position at checkpoint start,
+     * so full page write protection makes every checkpoint a full one.
+     */
+    bool doFullCheckpoint = !ENABLE_INCRE_CKPT || dw_full_page_writes();
     TransactionId oldest_active_xid = InvalidTransactionId;
     TransactionId globalXmin = InvalidTransactionId;
 
@@ -12142,9 +12148,15 @@ void UpdateFullPageWrites(void)
      * because we assume that there is no concurrently running process which
      * can update it.
      */
-    if (ENABLE_INCRE_CKPT) {
+    if (INCRE_CKPT_SKIP_FPW) {
         u_sess->attr.attr_storage.fullPageWrites = false;
     }
+    if (dw_full_page_writes() && !u_sess->attr.attr_storage.fullPageWrites) {
+        /* full page images are the only torn page protection of this run */
+        ereport(WARNING, (errmsg("full_page_writes cannot be turned off while torn_page_protection is "
+                                 "full_page_write")));
+        u_sess->attr.attr_storage.fullPageWrites = true;
+    }
     if (u_sess->attr.attr_storage.fullPageWrites == Insert->fullPageWrites) {
         return;
     }
@@ -12984,7 +12996,7 @@ char** tblspcmapfile, List** tablespaces, bool infotbssize, bool needtblspcmapfi
     } else {
         t_thrd.shemem_ptr_cxt.XLogCtl->Insert.nonExclusiveBackups++;
     }
-    if (ENABLE_INCRE_CKPT) {
+    if (INCRE_CKPT_SKIP_FPW) {
         t_thrd.shemem_ptr_cxt.XLogCtl->Insert.forcePageWrites = false;
     } else {
         t_thrd.shemem_ptr_cxt.XLogCtl->Insert.forcePageWrites = true;
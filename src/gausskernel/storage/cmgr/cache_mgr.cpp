@@ -31,6 +31,7 @@
 #include "utils/resowner.h"
 #include "storage/ipc.h"
 #include "miscadmin.h"
+#include "utils/atomic.h"
 
 const int MAX_LOOPS = 16;
 
@@ -126,6 +127,10 @@ void CacheMgr::Init(int64 cache_size, uint32 each_block_size, MgrCacheType type,
     m_cstoreCurrentSize = 0;
     m_cstoreMaxSize = cache_size;
 
+    m_policy = (CachePolicy)g_instance.attr.attr_storage.cstore_cache_policy;
+    m_protectedSize = 0;
+    m_protectedMaxSize = cache_size / 100 * CACHE_PROTECTED_PERCENT;
+
     total_slots = Min(cache_size / each_block_size, MAX_CACHE_SLOT_COUNT);
     m_CacheSlots = (char *)palloc0(total_slots * each_slot_length);
     m_CacheDesc = (CacheDesc *)palloc0(total_slots * sizeof(CacheDesc));
@@ -139,6 +144,7 @@ void CacheMgr::Init(int64 cache_size, uint32 each_block_size, MgrCacheType type,
         m_CacheDesc[i].m_freeNext = i + 1;
         m_CacheDesc[i].m_cache_tag.type = CACHE_TYPE_NONE;
         m_CacheDesc[i].m_flag = CACHE_BLOCK_FREE;
+        m_CacheDesc[i].m_segment = CACHE_SEGMENT_PROBATION;
         if (type == MGR_CACHE_TYPE_DATA) {
             trancheId = (int)LWTRANCHE_DATA_CACHE;
         } else if (type == MGR_CACHE_TYPE_INDEX) {
@@ -156,6 +162,7 @@ void CacheMgr::Init(int64 cache_size, uint32 each_block_size, MgrCacheType type,
     m_CacheDesc[total_slots - 1].m_freeNext = CACHE_BLOCK_INVALID_IDX;
     m_freeListHead = 0;
     m_freeListTail = total_slots - 1;
+    m_freeListCount = total_slots;
     SpinLockInit(&m_freeList_lock);
     SpinLockInit(&m_memsize_lock);
 
@@ -235,10 +242,11 @@ void CacheMgr::InitCacheBlockTag(CacheTag *cacheTag, int32 type, const void *key
  * @IN cacheTag: block unique identification
  * @IN first_enter_block: flag to check whether need to increase usage count,  when block first used,it's usage count
  * may need increase
+ * @IN bulkRead: the block is referenced by a large sequential scan, see TouchCacheBlock_Locked
  * @Return: the block desc and pinned if found, null not found
  * @See also:
  */
-CacheSlotId_t CacheMgr::FindCacheBlock(CacheTag *cacheTag, bool first_enter_block)
+CacheSlotId_t CacheMgr::FindCacheBlock(CacheTag *cacheTag, bool first_enter_block, bool bulkRead)
 {
     CacheLookupEnt *result = NULL;
     CacheSlotId_t slotId = CACHE_BLOCK_INVALID_IDX;
@@ -265,8 +273,8 @@ CacheSlotId_t CacheMgr::FindCacheBlock(CacheTag *cacheTag, bool first_enter_bloc
                  m_CacheDesc[slotId].m_cache_tag.type == CACHE_CARBONDATA_METADATA)));
 
         LockCacheDescHeader(slotId);
-        if (first_enter_block && (m_CacheDesc[slotId].m_usage_count < CACHE_BLOCK_MAX_USAGE)) {
-            m_CacheDesc[slotId].m_usage_count += 1;
+        if (first_enter_block) {
+            TouchCacheBlock_Locked(slotId, bulkRead);
         }
         UnLockCacheDescHeader(slotId);
 
@@ -327,6 +335,7 @@ void CacheMgr::InvalidateCacheBlock(CacheTag *cacheTag)
                                                       m_CacheDesc[slotId].m_flag, CACHE_BLOCK_FREE)));
         /* update slot flag */
         LockCacheDescHeader(slotId);
+        ResetCacheBlockSegment_Locked(slotId);
         blockSize = m_CacheDesc[slotId].m_datablock_size;
         m_CacheDesc[slotId].m_flag = CACHE_BLOCK_FREE;
         m_CacheDesc[slotId].m_datablock_size = 0;
@@ -362,7 +371,98 @@ void CacheMgr::DeleteCacheBlock(CacheTag *cacheTag)
 }
 
 /*
- * @Description: use clock-swap algorithm to evict a block
+ * @Description: record one more reference of a block for the eviction policy.
+ * Under CACHE_POLICY_2Q a block enters the probationary segment on its first reference and is
+ * promoted to the protected segment on its next one. A block reserved by prefetch has not been
+ * referenced yet, so its first read only moves it to the probationary segment. References from
+ * large sequential scans never promote a block, so that one full scan cannot flush the hot set
+ * out of the cache.
+ * @IN slotId: cache block index, the header lock must be held
+ * @IN bulkRead: the block is referenced by a large sequential scan
+ * @See also:
+ */
+void CacheMgr::TouchCacheBlock_Locked(CacheSlotId_t slotId, bool bulkRead)
+{
+    CacheDesc *desc = m_CacheDesc + slotId;
+
+    if (m_policy == CACHE_POLICY_2Q) {
+        if (bulkRead) {
+            return;
+        }
+
+        if (desc->m_segment == CACHE_SEGMENT_PREFETCH) {
+            desc->m_segment = CACHE_SEGMENT_PROBATION;
+        } else if (desc->m_segment == CACHE_SEGMENT_PROBATION) {
+            /*
+             * Size aware promotion: a block larger than the average cached block costs more memory
+             * to keep, so it starts with a lower usage count and ages out of the protected segment
+             * earlier than a small block referenced as often. The average is taken over the slots
+             * holding a block now and computed without the memory and free list locks, a stale
+             * value only shifts the usage count by one or two.
+             */
+            int liveSlots = m_CacheSlotsNum - m_freeListCount;
+            int64 avgSize = m_cstoreCurrentSize / Max(liveSlots, 1);
+            uint16 usage = CACHE_BLOCK_MAX_USAGE;
+            if (desc->m_datablock_size > avgSize && desc->m_datablock_size > 0) {
+                usage = (uint16)Max(1, (CACHE_BLOCK_MAX_USAGE * avgSize) / desc->m_datablock_size);
+            }
+
+            desc->m_segment = CACHE_SEGMENT_PROTECTED;
+            desc->m_usage_count = usage;
+            (void)gs_atomic_add_64(&m_protectedSize, desc->m_datablock_size);
+            return;
+        }
+    }
+
+    if (desc->m_usage_count < CACHE_BLOCK_MAX_USAGE) {
+        desc->m_usage_count += 1;
+    }
+}
+
+/*
+ * @Description: move a block back to the probationary segment and give back its protected memory,
+ * called whenever the block is evicted, invalidated or refreshed.
+ * @IN slotId: cache block index, the header lock must be held
+ * @See also:
+ */
+void CacheMgr::ResetCacheBlockSegment_Locked(CacheSlotId_t slotId)
+{
+    CacheDesc *desc = m_CacheDesc + slotId;
+
+    if (desc->m_segment == CACHE_SEGMENT_PROTECTED) {
+        (void)gs_atomic_add_64(&m_protectedSize, -(int64)desc->m_datablock_size);
+    }
+    desc->m_segment = CACHE_SEGMENT_PROBATION;
+}
+
+/*
+ * @Description: decide whether the clock sweep may evict an unpinned block whose usage count
+ * dropped to zero. Probationary, prefetched and error blocks always may. A protected block is demoted to the
+ * probationary segment when the protected segment is over budget, otherwise it is only evicted
+ * after the sweep has looped once without finding a probationary victim.
+ * @IN slotId: cache block index, the header lock must be held
+ * @IN looped: times the sweep passed its starting point
+ * @Return: true if the block can be evicted now
+ * @See also:
+ */
+bool CacheMgr::SweepProtectedBlock_Locked(CacheSlotId_t slotId, int looped)
+{
+    if (m_policy == CACHE_POLICY_CLOCK || m_CacheDesc[slotId].m_segment != CACHE_SEGMENT_PROTECTED ||
+        (m_CacheDesc[slotId].m_flag & CACHE_BLOCK_ERROR)) {
+        return true;
+    }
+
+    if (m_protectedSize > m_protectedMaxSize) {
+        ResetCacheBlockSegment_Locked(slotId);
+        return false;
+    }
+
+    return (looped > 0);
+}
+
+/*
+ * @Description: use clock-swap algorithm to evict a block, blocks of the protected segment are
+ * skipped while the policy is CACHE_POLICY_2Q, see SweepProtectedBlock_Locked
  * @Return: slot id
  * @See also:
  */
@@ -416,8 +516,9 @@ CacheSlotId_t CacheMgr::EvictCacheBlock(int size, int retryNum)
                 unpinned++;
                 /* skip cache blocks with usage count > 0 */
                 if (m_CacheDesc[slotId].m_usage_count == 0) {
-                    /* skip cache blocks that are in another ring , 1 in my ring,  0 no ring */
-                    if (m_CacheDesc[slotId].m_ring_count == 0) {
+                    /* skip cache blocks that are in another ring , 1 in my ring,  0 no ring,
+                     * and protected blocks that still fit into the protected segment */
+                    if (m_CacheDesc[slotId].m_ring_count == 0 && SweepProtectedBlock_Locked(slotId, looped)) {
                         ereport(DEBUG2,
                                 (errmodule(MOD_CACHE), errmsg("evict cache block, solt(%d), flag(%d - %d)", slotId,
                                                               m_CacheDesc[slotId].m_flag, CACHE_BLOCK_INFREE)));
@@ -701,6 +802,9 @@ void CacheMgr::AdjustCacheMem(CacheSlotId_t slotId, int oldSize, int newSize)
 
     LockCacheDescHeader(slotId);
     Assert(m_CacheDesc[slotId].m_datablock_size == oldSize);
+    if (m_CacheDesc[slotId].m_segment == CACHE_SEGMENT_PROTECTED) {
+        (void)gs_atomic_add_64(&m_protectedSize, (int64)newSize - oldSize);
+    }
     m_CacheDesc[slotId].m_datablock_size = newSize;
     UnLockCacheDescHeader(slotId);
 }
@@ -732,6 +836,7 @@ int CacheMgr::GetFreeListCache()
         Assert(freeSlotIdx >= 0 && freeSlotIdx < m_CacheSlotsNum);
         m_freeListHead = m_CacheDesc[freeSlotIdx].m_freeNext;
         m_CacheDesc[freeSlotIdx].m_freeNext = CACHE_BLOCK_NO_LIST;
+        m_freeListCount--;
         if (m_freeListHead == CACHE_BLOCK_INVALID_IDX) {
             m_freeListTail = CACHE_BLOCK_INVALID_IDX;
         }
@@ -755,6 +860,7 @@ void CacheMgr::PutFreeListCache(CacheSlotId_t freeSlotIdx)
     SpinLockAcquire(&m_freeList_lock);
     m_CacheDesc[freeSlotIdx].m_freeNext = m_freeListHead;
     m_freeListHead = freeSlotIdx;
+    m_freeListCount++;
     if (m_freeListTail == CACHE_BLOCK_INVALID_IDX) {
         m_freeListTail = m_freeListHead;
     }
@@ -997,6 +1103,7 @@ CacheSlotId_t CacheMgr::AllocateBlockFromCache(CacheTag *cacheTag, uint32 hashCo
         DeleteCacheBlock(&m_CacheDesc[slot].m_cache_tag);
         /* mark the block free */
         LockCacheDescHeader(slot);
+        ResetCacheBlockSegment_Locked(slot);
         old_size = m_CacheDesc[slot].m_datablock_size;
         m_CacheDesc[slot].m_flag = CACHE_BLOCK_FREE;  // !Valid and Free
         m_CacheDesc[slot].m_datablock_size = 0;
@@ -1110,6 +1217,7 @@ bool CacheMgr::ReserveCacheBlockWithSlotId(CacheSlotId_t slotId)
 
     LockCacheDescHeader(slotId);
 
+    ResetCacheBlockSegment_Locked(slotId);
     m_CacheDesc[slotId].m_usage_count = 1;
     m_CacheDesc[slotId].m_ring_count = 0;
     m_CacheDesc[slotId].m_flag = CACHE_BLOCK_VALID | CACHE_BLOCK_IOBUSY;
@@ -1205,10 +1313,14 @@ bool CacheMgr::ReserveCstoreCacheBlockWithSlotId(CacheSlotId_t slotId)
  * @IN cacheTag: block unique identification
  * @OUT hasFound: found in cache
  * @IN size: cache block memory size
+ * @IN bulkRead: reserved by a large sequential scan, the block is admitted with usage count 0 so that
+ *     it is the first one to be evicted under CACHE_POLICY_2Q
+ * @IN prefetch: reserved ahead of the read, a found block is not referenced and a new block is not
+ *     counted as referenced until it is read, see TouchCacheBlock_Locked
  * @Return:
  * @See also:
  */
-CacheSlotId_t CacheMgr::ReserveCacheBlock(CacheTag *cacheTag, int size, bool &hasFound)
+CacheSlotId_t CacheMgr::ReserveCacheBlock(CacheTag *cacheTag, int size, bool &hasFound, bool bulkRead, bool prefetch)
 {
     int slot;
     uint32 hashCode = GetHashCode(cacheTag);
@@ -1217,11 +1329,11 @@ CacheSlotId_t CacheMgr::ReserveCacheBlock(CacheTag *cacheTag, int size, bool &ha
     Assert(slot >= 0 && slot <= m_CaccheSlotMax && slot < m_CacheSlotsNum);
     if (hasFound) {
         /* add m_usage_count here may not ok, so need think more about it */
-        LockCacheDescHeader(slot);
-        if (m_CacheDesc[slot].m_usage_count < CACHE_BLOCK_MAX_USAGE) {
-            m_CacheDesc[slot].m_usage_count += 1;
+        if (!prefetch) {
+            LockCacheDescHeader(slot);
+            TouchCacheBlock_Locked(slot, bulkRead);
+            UnLockCacheDescHeader(slot);
         }
-        UnLockCacheDescHeader(slot);
         ereport(DEBUG2, (errmodule(MOD_CACHE), errmsg("Reuse cache block, slot(%d), type(%d)", slot, cacheTag->type)));
         Assert(m_CacheDesc[slot].m_refcount > 0);  // pinned
         return slot;
@@ -1233,7 +1345,11 @@ CacheSlotId_t CacheMgr::ReserveCacheBlock(CacheTag *cacheTag, int size, bool &ha
     LockCacheDescHeader(slot);
 
     InitCacheBlockTag(&(m_CacheDesc[slot].m_cache_tag), cacheTag->type, cacheTag->key, MAX_CACHE_TAG_LEN);
-    m_CacheDesc[slot].m_usage_count = 1;
+    Assert(m_CacheDesc[slot].m_segment == CACHE_SEGMENT_PROBATION);
+    if (m_policy == CACHE_POLICY_2Q && prefetch) {
+        m_CacheDesc[slot].m_segment = CACHE_SEGMENT_PREFETCH;
+    }
+    m_CacheDesc[slot].m_usage_count = (m_policy == CACHE_POLICY_2Q && bulkRead) ? 0 : 1;
     m_CacheDesc[slot].m_flag = CACHE_BLOCK_VALID | CACHE_BLOCK_IOBUSY;
     m_CacheDesc[slot].m_datablock_size = size;
     UnLockCacheDescHeader(slot);
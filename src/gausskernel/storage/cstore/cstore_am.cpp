@@ -112,6 +112,7 @@ CStore::CStore()
       m_prefetch_quantity(0),
       m_prefetch_threshold(0),
       m_load_finish(false),
+      m_bulkRead(false),
       m_scanPosInCU(NULL),
       m_RCFuncs(NULL),
       m_fillVectorByTids(NULL),
@@ -377,6 +378,7 @@ void CStore::InitScan(CStoreScanState* state, Snapshot snapshot)
     m_prefetch_quantity = 0;
     m_prefetch_threshold =
         Min(CUCache->m_cstoreMaxSize / 4, u_sess->attr.attr_storage.cstore_prefetch_quantity * 1024LL);
+    m_bulkRead = IsBulkReadRelation(m_relation);
     m_snapshot = snapshot;
     m_rangeScanInRedis = state->rangeScanInRedis;
 
@@ -494,7 +496,7 @@ void CStore::CUPrefetch(CUDesc* cudesc, int col, AioDispatchCUDesc_t** dList, in
     // find whether already in CUCache, ReserveDataBlock can also find CU in cache,
     // but i still add FindDataBlock here for efficient
     // here we ignore the enter block times
-    slotId = CUCache->FindDataBlock(&dataSlotTag, false);
+    slotId = CUCache->FindDataBlock(&dataSlotTag, false, m_bulkRead);
     if (IsValidCacheSlotID(slotId)) {
         ereport(DEBUG1,
                 (errmodule(MOD_ADIO),
@@ -506,7 +508,7 @@ void CStore::CUPrefetch(CUDesc* cudesc, int col, AioDispatchCUDesc_t** dList, in
         return;
     }
 
-    slotId = CUCache->ReserveDataBlock(&dataSlotTag, cudesc->cu_size, found);
+    slotId = CUCache->ReserveDataBlock(&dataSlotTag, cudesc->cu_size, found, m_bulkRead, true);
     if (found) {
         CUCache->UnPinDataBlock(slotId);
         return;
@@ -1386,6 +1388,19 @@ void CStore::InitPartReScan(Relation rel)
         CFileNode cFileNode(m_relation->rd_node, m_relation->rd_att->attrs[i]->attnum, MAIN_FORKNUM);
         m_cuStorage[i] = New(CurrentMemoryContext) CUStorage(cFileNode);
     }
+
+    m_bulkRead = IsBulkReadRelation(m_relation);
+}
+
+/*
+ * @Description: like heap scans using BAS_BULKREAD, a sequential scan over a relation bigger
+ * than a quarter of the data cache is a bulk read, whose CUs must not displace the hot ones.
+ * @IN rel: the scanned relation or partition
+ * @Return: true if the scan is a bulk read
+ */
+bool CStore::IsBulkReadRelation(Relation rel)
+{
+    return ((int64)rel->rd_rel->relpages * BLCKSZ > CUCache->m_cstoreMaxSize / 4);
 }
 
 // FORCE_INLINE
@@ -1440,6 +1455,9 @@ void CStore::ScanByTids(_in_ CStoreIndexScanState* state, _in_ VectorBatch* idxO
     /* set if use btree index */
     m_useBtreeIndex = (state->m_indexScan == NULL) ? true : false;
 
+    /* fetching by tids is random access, not a bulk read */
+    m_bulkRead = false;
+
     /*
      * Pre-Step: For const-targetlist, set output rows.
      */
@@ -3540,7 +3558,7 @@ RETRY_LOAD_CU:
 
     // Look for the CU in the cache first, this is quick and
     // should succeed most of the time.
-    slotId = CUCache->FindDataBlock(&dataSlotTag, (m_rowCursorInCU == 0));
+    slotId = CUCache->FindDataBlock(&dataSlotTag, (m_rowCursorInCU == 0), m_bulkRead);
 
     // If the CU is not in the cache, reserve it.
     // Get a cache slot, reserve memory, and put it in the hashtable.
@@ -3549,7 +3567,7 @@ RETRY_LOAD_CU:
         hasFound = true;
     } else {
         hasFound = false;
-        slotId = CUCache->ReserveDataBlock(&dataSlotTag, cuDescPtr->cu_size, hasFound);
+        slotId = CUCache->ReserveDataBlock(&dataSlotTag, cuDescPtr->cu_size, hasFound, m_bulkRead);
     }
 
     // Use the cached CU
@@ -153,16 +153,17 @@ DataSlotTag DataCacheMgr::InitOBSSlotTag(uint32 hostNameHash, uint32 bucketNameH
  * @Description: find data block in cache
  * @IN dataSlotTag: data slot tag key
  * @IN first_enter_block: flag to check whether first use the block
+ * @IN bulkRead: looked up by a large sequential scan
  * @Return: slot id
  * @See also:
  */
-CacheSlotId_t DataCacheMgr::FindDataBlock(DataSlotTag* dataSlotTag, bool first_enter_block)
+CacheSlotId_t DataCacheMgr::FindDataBlock(DataSlotTag* dataSlotTag, bool first_enter_block, bool bulkRead)
 {
     CacheSlotId_t slot = CACHE_BLOCK_INVALID_IDX;
     CacheTag cacheTag = {0};
 
     m_cache_mgr->InitCacheBlockTag(&cacheTag, dataSlotTag->slotType, &dataSlotTag->slotTag, sizeof(DataSlotTagKey));
-    slot = m_cache_mgr->FindCacheBlock(&cacheTag, first_enter_block);
+    slot = m_cache_mgr->FindCacheBlock(&cacheTag, first_enter_block, bulkRead);
 
     return slot;
 }
@@ -267,16 +268,19 @@ bool DataCacheMgr::ReserveCstoreDataBlockWithSlotId(CacheSlotId_t slotId)
  * @IN dataSlotTag: data slot tag
  * @IN hasFound: whether found or not
  * @IN size: need block size
+ * @IN bulkRead: reserved by a large sequential scan
+ * @IN prefetch: reserved by prefetch ahead of the read
  * @Return: slot id
  * @See also:
  */
-CacheSlotId_t DataCacheMgr::ReserveDataBlock(DataSlotTag* dataSlotTag, int size, bool& hasFound)
+CacheSlotId_t DataCacheMgr::ReserveDataBlock(
+    DataSlotTag* dataSlotTag, int size, bool& hasFound, bool bulkRead, bool prefetch)
 {
     CacheSlotId_t slot = CACHE_BLOCK_INVALID_IDX;
     CacheTag cacheTag = {0};
 
     m_cache_mgr->InitCacheBlockTag(&cacheTag, dataSlotTag->slotType, &dataSlotTag->slotTag, sizeof(DataSlotTagKey));
-    slot = m_cache_mgr->ReserveCacheBlock(&cacheTag, size, hasFound);
+    slot = m_cache_mgr->ReserveCacheBlock(&cacheTag, size, hasFound, bulkRead, prefetch);
     if (!hasFound) {
         /* remember block slot in process */
         Assert(!IsValidCacheSlotID(t_thrd.storage_cxt.CacheBlockInProgressIO));
@@ -1981,6 +1981,29 @@ static int FileAsyncSubmitIO(io_context_t aio_context, dlistType dList, int dLis
     return submitCount;
 }
 
+/*
+ * @Description: dispatch the aio desc list to the io_uring ring or the libaio context of the request type
+ * @Param[IN] reqType: aio completer type
+ * @Param[IN] dList: aio desc list
+ * @Param[IN] dListCount: aio desc list count
+ * @Return: number of requests submitted, negative on error
+ * @See also:
+ */
+template <typename dlistType>
+static int FileAsyncDispatchIO(AioCompltrType reqType, dlistType dList, int dListCount)
+{
+    if (CompltrUringActive()) {
+        return CompltrUringSubmit(reqType, (struct iocb**)dList, dListCount);
+    }
+
+    /*
+     * Took a shortcut here and sent all the requests to a single context
+     * If the number of requests is too great, and there are more threads
+     * than request types it makes sense to spread them around.
+     */
+    return FileAsyncSubmitIO<dlistType>(CompltrContext(reqType, 0), dList, dListCount);
+}
+
 /*
  * @Description: row store async read api
  * @Param[IN] dList:aio desc list
@@ -2019,14 +2042,8 @@ int FileAsyncRead(AioDispatchDesc_t** dList, int32 dn)
      * If there are too many on the system queue then retry.
      * Alternatives- abort the requests, or have another thread do
      * the blocking...
-     *
-     * Took a shortcut here and sent all the requests to a single context
-     * If the number of requests is too great, and there are more threads
-     * than request types it makes sense to spread them around.
      */
-    io_context_t aio_context = CompltrContext(dList[0]->blockDesc.reqType, 0);
-
-    returnCode = FileAsyncSubmitIO<AioDispatchDesc_t**>(aio_context, dList, dn);
+    returnCode = FileAsyncDispatchIO<AioDispatchDesc_t**>(dList[0]->blockDesc.reqType, dList, dn);
     if (returnCode != dn) {
         ereport(ERROR,
                 (errcode_for_file_access(),
@@ -2067,9 +2084,7 @@ int FileAsyncWrite(AioDispatchDesc_t** dList, int32 dn)
         dList[i]->aiocb.aio_fildes = u_sess->storage_cxt.VfdCache[file].fd;
     }
 
-    io_context_t aio_context = CompltrContext(dList[0]->blockDesc.reqType, 0);
-
-    returnCode = FileAsyncSubmitIO<AioDispatchDesc_t**>(aio_context, dList, dn);
+    returnCode = FileAsyncDispatchIO<AioDispatchDesc_t**>(dList[0]->blockDesc.reqType, dList, dn);
     if (returnCode != dn) {
         ereport(PANIC, (errmsg("io_submit() async write failed %d, dispatch count(%d)", returnCode, dn)));
     }
@@ -2132,9 +2147,7 @@ int FileAsyncCURead(AioDispatchCUDesc_t** dList, int32 dn)
         dList[i]->aiocb.aio_fildes = u_sess->storage_cxt.VfdCache[file].fd;
     }
 
-    io_context_t aio_context = CompltrContext(dList[0]->cuDesc.reqType, 0);
-
-    returnCode = FileAsyncSubmitIO<AioDispatchCUDesc_t**>(aio_context, dList, dn);
+    returnCode = FileAsyncDispatchIO<AioDispatchCUDesc_t**>(dList[0]->cuDesc.reqType, dList, dn);
     if (returnCode != dn) {
         ereport(ERROR,
                 (errcode_for_file_access(),
@@ -2177,9 +2190,7 @@ int FileAsyncCUWrite(AioDispatchCUDesc_t** dList, int32 dn)
         dList[i]->aiocb.aio_fildes = u_sess->storage_cxt.VfdCache[file].fd;
     }
 
-    io_context_t aio_context = CompltrContext(dList[0]->cuDesc.reqType, 0);
-
-    returnCode = FileAsyncSubmitIO<AioDispatchCUDesc_t**>(aio_context, dList, dn);
+    returnCode = FileAsyncDispatchIO<AioDispatchCUDesc_t**>(dList[0]->cuDesc.reqType, dList, dn);
     if (returnCode != dn) {
         ereport(PANIC, (errmsg("io_submit() async cu write failed %d, dispatch count(%d)", returnCode, dn)));
     }
@@ -42,6 +42,9 @@
 /* Address of the root page. */
 static const FSMAddress g_fsm_root_address = {FSM_ROOT_LEVEL, 0};
 
+/* how many more pages fsm_search_spread asks for to avoid one another backend is filling */
+#define FSM_SPREAD_TRIES 3
+
 /* functions to navigate the tree */
 static FSMAddress fsm_get_child(const FSMAddress& parent, uint16 slot);
 static FSMAddress fsm_get_parent(const FSMAddress& child, uint16* slot);
@@ -57,6 +60,7 @@ static Size fsm_space_cat_to_avail(uint8 cat);
 /* workhorse functions for various operations */
 static int fsm_set_and_search(Relation rel, const FSMAddress& addr, uint16 slot, uint8 newValue, uint8 minValue);
 static BlockNumber fsm_search(Relation rel, uint8 min_cat);
+static BlockNumber fsm_search_spread(Relation rel, uint8 min_cat);
 static uint8 fsm_vacuum_page(Relation rel, const FSMAddress& addr, bool* eof);
 static BlockNumber fsm_get_lastblckno(Relation rel, const FSMAddress& addr);
 static void fsm_update_recursive(Relation rel, const FSMAddress& addr, uint8 new_cat);
@@ -74,12 +78,18 @@ static void fsm_update_recursive(Relation rel, const FSMAddress& addr, uint8 new
  * amount of free space available on that page and then try again (see
  * RecordAndGetPageWithFreeSpace).	If InvalidBlockNumber is returned,
  * extend the relation.
+ *
+ * The target page of this backend's slot in the shared target cache is
+ * tried first, see fsmcache.c.
  */
 BlockNumber GetPageWithFreeSpace(Relation rel, Size spaceNeeded)
 {
     uint8 min_cat = fsm_space_needed_to_cat(spaceNeeded);
+    BlockNumber blkno = fsm_target_get(rel, min_cat);
 
-    return fsm_search(rel, min_cat);
+    if (blkno != InvalidBlockNumber)
+        return blkno;
+    return fsm_search_spread(rel, min_cat);
 }
 
 /*
@@ -98,19 +108,35 @@ BlockNumber RecordAndGetPageWithFreeSpace(Relation rel, BlockNumber oldPage, Siz
     FSMAddress addr;
     uint16 slot;
     int search_slot;
+    BlockNumber blkno;
 
     /* Get the location of the FSM byte representing the heap block */
     addr = fsm_get_location(oldPage, &slot);
 
+    /*
+     * Another backend sharing our target slot may already have moved on to a
+     * new page; follow it instead of searching the FSM.
+     */
+    fsm_target_update(rel, oldPage, (uint8)old_cat);
+    blkno = fsm_target_get(rel, (uint8)search_cat);
+    if (blkno != InvalidBlockNumber && blkno != oldPage) {
+        (void)fsm_set_and_search(rel, addr, slot, (uint8)old_cat, 0);
+        return blkno;
+    }
+
     search_slot = fsm_set_and_search(rel, addr, slot, (uint8)old_cat, (uint8)search_cat);
     /*
-     * If fsm_set_and_search found a suitable new block, return that.
-     * Otherwise, search as usual.
+     * If fsm_set_and_search found a suitable new block that nobody else is
+     * filling, return that.  Otherwise, search as usual.
      */
-    if (search_slot != -1)
-        return fsm_get_heap_blk(addr, (uint16)search_slot);
-    else
-        return fsm_search(rel, (uint8)search_cat);
+    if (search_slot != -1) {
+        blkno = fsm_get_heap_blk(addr, (uint16)search_slot);
+        if (!fsm_target_taken(rel, blkno)) {
+            fsm_target_set(rel, blkno, (uint8)search_cat);
+            return blkno;
+        }
+    }
+    return fsm_search_spread(rel, (uint8)search_cat);
 }
 
 /*
@@ -130,6 +156,7 @@ void RecordPageWithFreeSpace(Relation rel, BlockNumber heapBlk, Size spaceAvail)
     addr = fsm_get_location(heapBlk, &slot);
 
     fsm_set_and_search(rel, addr, slot, (uint8)new_cat, 0);
+    fsm_target_update(rel, heapBlk, (uint8)new_cat);
 }
 
 /*
@@ -265,6 +292,9 @@ void FreeSpaceMapTruncateRel(Relation rel, BlockNumber nblocks)
     uint16 first_removed_slot;
     Buffer buf;
 
+    /* Targets past the new end must not be handed out any more */
+    fsm_target_forget(rel);
+
     RelationOpenSmgr(rel);
 
     /*
@@ -758,6 +788,33 @@ static BlockNumber fsm_search(Relation rel, uint8 min_cat)
     return InvalidBlockNumber; /* should not reached, avoid compile warning */
 }
 
+/*
+ * Search the tree like fsm_search, but skip over pages that are the target
+ * of another slot in the shared target cache, and make the result the target
+ * of our own slot.
+ *
+ * Each search moves fp_next_slot of the leaf page past the page returned, so
+ * asking again yields the next page with enough space, if there is one.
+ */
+static BlockNumber fsm_search_spread(Relation rel, uint8 min_cat)
+{
+    BlockNumber blkno = fsm_search(rel, min_cat);
+
+    for (int tries = 0; tries < FSM_SPREAD_TRIES; tries++) {
+        BlockNumber next;
+
+        if (blkno == InvalidBlockNumber || !fsm_target_taken(rel, blkno))
+            break;
+        next = fsm_search(rel, min_cat);
+        if (next == InvalidBlockNumber || next == blkno)
+            break;
+        blkno = next;
+    }
+
+    fsm_target_set(rel, blkno, min_cat);
+    return blkno;
+}
+
 /*
  * Recursive guts of FreeSpaceMapVacuum
  */
@@ -0,0 +1,339 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ *  fsmcache.cpp
+ *        Shared cache of insert target pages, in front of the free space map.
+ *
+ *        Searching the FSM walks the tree from the root under buffer content
+ *        locks, and every searcher is steered to the same first page with
+ *        enough space, so concurrent inserters end up queueing on the same FSM
+ *        pages and on the same heap page. This cache keeps, per relation, a
+ *        small array of target slots. A backend only uses the slots of its
+ *        NUMA node, picked by its PGPROC number, so inserters on different
+ *        nodes never share a heap page through the cache and inserters on one
+ *        node are spread over its slots. A hit is a couple of atomic reads.
+ *
+ *        The cache is direct mapped, fsm_target_cache_entries entries indexed
+ *        by a hash of the RelFileNode. Each entry has a version word, odd
+ *        while the entry is being taken over by another relation, and every
+ *        slot carries the version it was written under, so a takeover or a
+ *        truncation invalidates all slots at once without touching them.
+ *
+ *        The FSM stays the authority. Slots are only hints: a target is
+ *        checked against the relation size before it is handed out, the
+ *        caller checks the page itself, and pages reported full are written
+ *        to the FSM as before and dropped from the slots holding them.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/freespace/fsmcache.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/hash.h"
+#include "storage/barrier.h"
+#include "storage/buf/bufmgr.h"
+#include "storage/freespace.h"
+#include "storage/fsm_internals.h"
+#include "storage/proc.h"
+#include "storage/shmem.h"
+#include "utils/atomic.h"
+#include "utils/rel.h"
+#include "utils/rel_gs.h"
+
+/* target slots per relation, shared out among the NUMA nodes */
+#define FSM_TARGET_SLOTS 16
+
+typedef struct FsmTargetEntry {
+    pg_atomic_uint32 version; /* odd while tag is being changed */
+    RelFileNode tag;
+    pg_atomic_uint64 targets[FSM_TARGET_SLOTS]; /* version << 40 | category << 32 | block, see below */
+} FsmTargetEntry;
+
+typedef struct FsmTargetCacheCtl {
+    int nentries;
+    FsmTargetEntry entries[FLEXIBLE_ARRAY_MEMBER];
+} FsmTargetCacheCtl;
+
+/*
+ * A slot is valid only under the entry version it was written with. Only 24 bits of it are
+ * kept, an entry would have to change hands 2^24 times between reading the version and
+ * writing the slot to confuse it. Category 0 never satisfies a search, so a zero slot is empty.
+ */
+#define FSM_TARGET_VERSION_BITS(version) (((uint64)((version) >> 1)) & 0xFFFFFF)
+#define FSM_TARGET(version, cat, blkno) \
+    ((FSM_TARGET_VERSION_BITS(version) << 40) | ((uint64)(cat) << 32) | (uint64)(blkno))
+#define FSM_TARGET_VERSION(target) ((target) >> 40)
+#define FSM_TARGET_CAT(target) ((uint8)((target) >> 32))
+#define FSM_TARGET_BLOCK(target) ((BlockNumber)(target))
+
+Size FsmTargetCacheShmemSize(void)
+{
+    int nentries = g_instance.attr.attr_storage.fsm_target_cache_entries;
+
+    if (nentries <= 0) {
+        return 0;
+    }
+    return add_size(offsetof(FsmTargetCacheCtl, entries), mul_size(nentries, sizeof(FsmTargetEntry)));
+}
+
+void FsmTargetCacheShmemInit(void)
+{
+    int nentries = g_instance.attr.attr_storage.fsm_target_cache_entries;
+    FsmTargetCacheCtl *ctl = NULL;
+    bool found = false;
+
+    if (nentries <= 0) {
+        t_thrd.shemem_ptr_cxt.fsm_target_cache = NULL;
+        return;
+    }
+
+    ctl = (FsmTargetCacheCtl *)ShmemInitStruct("FSM Target Cache", FsmTargetCacheShmemSize(), &found);
+    if (!found) {
+        errno_t rc = memset_s(ctl, FsmTargetCacheShmemSize(), 0, FsmTargetCacheShmemSize());
+        securec_check(rc, "", "");
+        ctl->nentries = nentries;
+        for (int i = 0; i < nentries; i++) {
+            pg_atomic_init_u32(&ctl->entries[i].version, 0);
+            for (int j = 0; j < FSM_TARGET_SLOTS; j++) {
+                pg_atomic_init_u64(&ctl->entries[i].targets[j], 0);
+            }
+        }
+    }
+    t_thrd.shemem_ptr_cxt.fsm_target_cache = ctl;
+}
+
+static inline bool FsmTargetCacheable(Relation rel)
+{
+    /* index FSMs hand out whole pages, they must not be given to several backends */
+    return t_thrd.shemem_ptr_cxt.fsm_target_cache != NULL && !RelationIsIndex(rel) && !RELATION_IS_LOCAL(rel);
+}
+
+static inline FsmTargetEntry *FsmTargetEntryFor(const RelFileNode &rnode)
+{
+    FsmTargetCacheCtl *ctl = t_thrd.shemem_ptr_cxt.fsm_target_cache;
+    uint32 hashcode = DatumGetUInt32(hash_any((const unsigned char *)&rnode, sizeof(RelFileNode)));
+
+    return &ctl->entries[hashcode % (uint32)ctl->nentries];
+}
+
+/*
+ * The slot of this backend: the slots are split evenly among the NUMA nodes, and the
+ * backends of a node are spread over its share by PGPROC number.
+ */
+static int FsmTargetMySlot(void)
+{
+    int nodes = Max(g_instance.shmem_cxt.numaNodeNum, 1);
+    int per_node = Max(FSM_TARGET_SLOTS / nodes, 1);
+    int node = 0;
+    int procno = 0;
+
+    if (t_thrd.proc != NULL) {
+        node = t_thrd.proc->nodeno;
+        procno = t_thrd.proc->pgprocno;
+    }
+    return ((node % nodes) * per_node + procno % per_node) % FSM_TARGET_SLOTS;
+}
+
+/*
+ * Return the version of entry if it currently belongs to rnode, or an odd number if not.
+ */
+static uint32 FsmTargetEntryVersion(FsmTargetEntry *entry, const RelFileNode &rnode)
+{
+    uint32 version = pg_atomic_read_u32(&entry->version);
+    bool match = false;
+
+    if (version & 1) {
+        return version;
+    }
+    pg_read_barrier();
+    match = RelFileNodeEquals(entry->tag, rnode);
+    pg_read_barrier();
+    if (!match || pg_atomic_read_u32(&entry->version) != version) {
+        return 1;
+    }
+    return version;
+}
+
+/*
+ * Move entry over to rnode, invalidating all of its slots. Returns the new version, or an odd
+ * number if someone else is doing the same right now.
+ */
+static uint32 FsmTargetEntryTake(FsmTargetEntry *entry, const RelFileNode &rnode)
+{
+    uint32 version = pg_atomic_read_u32(&entry->version);
+
+    if ((version & 1) || !pg_atomic_compare_exchange_u32(&entry->version, &version, version + 1)) {
+        return 1;
+    }
+    entry->tag = rnode;
+    pg_write_barrier();
+    pg_atomic_write_u32(&entry->version, version + 2);
+    return version + 2;
+}
+
+/*
+ *  fsm_target_get() -- The target page of this backend's slot in rel, if it is known to have
+ *      at least min_cat of free space, or InvalidBlockNumber.
+ */
+BlockNumber fsm_target_get(Relation rel, uint8 min_cat)
+{
+    FsmTargetEntry *entry = NULL;
+    uint32 version;
+    uint64 target;
+    BlockNumber blkno;
+
+    if (!FsmTargetCacheable(rel)) {
+        return InvalidBlockNumber;
+    }
+
+    entry = FsmTargetEntryFor(rel->rd_node);
+    version = FsmTargetEntryVersion(entry, rel->rd_node);
+    if (version & 1) {
+        return InvalidBlockNumber;
+    }
+
+    target = pg_atomic_read_u64(&entry->targets[FsmTargetMySlot()]);
+    if (FSM_TARGET_VERSION(target) != FSM_TARGET_VERSION_BITS(version) || FSM_TARGET_CAT(target) < min_cat) {
+        return InvalidBlockNumber;
+    }
+
+    /* a dropped and recreated relfilenode could leave blocks past the end behind */
+    blkno = FSM_TARGET_BLOCK(target);
+    if (blkno >= RelationGetNumberOfBlocks(rel)) {
+        return InvalidBlockNumber;
+    }
+    return blkno;
+}
+
+/*
+ *  fsm_target_set() -- Make blkno, known to have at least cat of free space, the target of
+ *      this backend's slot in rel. Takes the cache entry over from another relation if need be.
+ */
+void fsm_target_set(Relation rel, BlockNumber blkno, uint8 cat)
+{
+    FsmTargetEntry *entry = NULL;
+    uint32 version;
+
+    if (!FsmTargetCacheable(rel) || blkno == InvalidBlockNumber || cat == 0) {
+        return;
+    }
+
+    entry = FsmTargetEntryFor(rel->rd_node);
+    version = FsmTargetEntryVersion(entry, rel->rd_node);
+    if (version & 1) {
+        version = FsmTargetEntryTake(entry, rel->rd_node);
+        if (version & 1) {
+            return;
+        }
+    }
+
+    /* if the entry changed hands meanwhile, the version in the slot no longer matches */
+    pg_atomic_write_u64(&entry->targets[FsmTargetMySlot()], FSM_TARGET(version, cat, blkno));
+}
+
+/*
+ *  fsm_target_update() -- blkno of rel now has cat of free space, adjust every slot that holds it.
+ *
+ *      A slot whose page no longer satisfies any search is simply cleared.
+ */
+void fsm_target_update(Relation rel, BlockNumber blkno, uint8 cat)
+{
+    FsmTargetEntry *entry = NULL;
+    uint32 version;
+
+    if (!FsmTargetCacheable(rel)) {
+        return;
+    }
+
+    entry = FsmTargetEntryFor(rel->rd_node);
+    version = FsmTargetEntryVersion(entry, rel->rd_node);
+    if (version & 1) {
+        return;
+    }
+
+    for (int i = 0; i < FSM_TARGET_SLOTS; i++) {
+        uint64 target = pg_atomic_read_u64(&entry->targets[i]);
+
+        if (FSM_TARGET_VERSION(target) != FSM_TARGET_VERSION_BITS(version) || FSM_TARGET_BLOCK(target) != blkno ||
+            FSM_TARGET_CAT(target) == cat) {
+            continue;
+        }
+        /* losing the race against a backend setting its own slot is fine */
+        (void)pg_atomic_compare_exchange_u64(&entry->targets[i], &target,
+                                             (cat == 0) ? 0 : FSM_TARGET(version, cat, blkno));
+    }
+}
+
+/*
+ *  fsm_target_taken() -- Is blkno the target of some other slot of rel?
+ *
+ *      Used to pick a different page from the FSM rather than pile onto one that other
+ *      inserters are already filling.
+ */
+bool fsm_target_taken(Relation rel, BlockNumber blkno)
+{
+    FsmTargetEntry *entry = NULL;
+    uint32 version;
+    int myslot;
+
+    if (!FsmTargetCacheable(rel)) {
+        return false;
+    }
+
+    entry = FsmTargetEntryFor(rel->rd_node);
+    version = FsmTargetEntryVersion(entry, rel->rd_node);
+    if (version & 1) {
+        return false;
+    }
+
+    myslot = FsmTargetMySlot();
+    for (int i = 0; i < FSM_TARGET_SLOTS; i++) {
+        uint64 target = pg_atomic_read_u64(&entry->targets[i]);
+
+        if (i != myslot && FSM_TARGET_VERSION(target) == FSM_TARGET_VERSION_BITS(version) &&
+            FSM_TARGET_BLOCK(target) == blkno && FSM_TARGET_CAT(target) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ *  fsm_target_forget() -- Drop all targets of rel, after it was truncated.
+ */
+void fsm_target_forget(Relation rel)
+{
+    FsmTargetEntry *entry = NULL;
+    uint32 version;
+
+    if (!FsmTargetCacheable(rel)) {
+        return;
+    }
+
+    entry = FsmTargetEntryFor(rel->rd_node);
+    for (;;) {
+        version = FsmTargetEntryVersion(entry, rel->rd_node);
+        if (version & 1) {
+            /* not ours, or being taken over, either way no slot of ours survives */
+            return;
+        }
+        if (!(FsmTargetEntryTake(entry, rel->rd_node) & 1)) {
+            return;
+        }
+    }
+}
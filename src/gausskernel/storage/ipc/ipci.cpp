@@ -51,6 +51,7 @@
 #include "replication/dataqueue.h"
 #include "storage/buf/bufmgr.h"
 #include "storage/fd.h"
+#include "storage/freespace.h"
 #include "storage/ipc.h"
 #include "storage/pg_shmem.h"
 #include "storage/pmsignal.h"
@@ -58,6 +59,7 @@
 #include "storage/procarray.h"
 #include "storage/procsignal.h"
 #include "storage/sinvaladt.h"
+#include "storage/smgr.h"
 #include "storage/spin.h"
 #include "storage/cstore/cstorealloc.h"
 #include "storage/cucache_mgr.h"
@@ -167,6 +169,8 @@ void CreateSharedMemoryAndSemaphores(bool makePrivate, int port)
         size = add_size(size, JobInfoShmemSize());
         size = add_size(size, BTreeShmemSize());
         size = add_size(size, SyncScanShmemSize());
+        size = add_size(size, RelSizeCacheShmemSize());
+        size = add_size(size, FsmTargetCacheShmemSize());
         size = add_size(size, AsyncShmemSize());
         size = add_size(size, active_gtt_shared_hash_size());
 #ifdef PGXC
@@ -326,6 +330,8 @@ void CreateSharedMemoryAndSemaphores(bool makePrivate, int port)
          */
         BTreeShmemInit();
         SyncScanShmemInit();
+        RelSizeCacheShmemInit();
+        FsmTargetCacheShmemInit();
         AsyncShmemInit();
 
 #ifdef PGXC
@@ -21,6 +21,7 @@
 #include "miscadmin.h"
 #include "storage/ipc.h"
 #include "storage/sinvaladt.h"
+#include "utils/catcache.h"
 #include "utils/globalplancache.h"
 #include "utils/inval.h"
 #include "utils/plancache.h"
@@ -46,6 +47,12 @@ THR_LOCAL volatile sig_atomic_t catchupInterruptPending = false;
  */
 void SendSharedInvalidMessages(const SharedInvalidationMessage* msgs, int n)
 {
+    /*
+     * Drop the global catcache entries first, a session that reads the
+     * messages must not find the old tuples there any more.
+     */
+    GlobalCatCacheInvalidateMessages(msgs, n);
+
     SIInsertDataEntries(msgs, n);
 
     if (ENABLE_GPC && g_instance.plan_cache != NULL) {
@@ -169,7 +169,9 @@ static const char *BuiltinTrancheNames[] = {
     "IOStatLock",
     "WALFlushWait",
     "WALBufferInitWait",
-    "WALInitSegment"
+    "WALInitSegment",
+    "GlobalCatCacheLock",
+    "RelSizeCacheLock"
 };
 
 static void RegisterLWLockTranches(void);
@@ -567,6 +569,14 @@ static void InitializeLWLocks(int numLocks)
         LWLockInitialize(&lock->lock, LWTRANCHE_IO_STAT);
     }
 
+    for (id = 0; id < NUM_GLOBAL_CATCACHE_PARTITIONS; id++, lock++) {
+        LWLockInitialize(&lock->lock, LWTRANCHE_GLOBAL_CATCACHE);
+    }
+
+    for (id = 0; id < NUM_RELSIZE_CACHE_PARTITIONS; id++, lock++) {
+        LWLockInitialize(&lock->lock, LWTRANCHE_RELSIZE_CACHE);
+    }
+
     Assert((lock - t_thrd.shemem_ptr_cxt.mainLWLockArray) == NumFixedLWLocks);
 
     for (id = NumFixedLWLocks; id < numLocks; id++, lock++) {
@@ -33,6 +33,7 @@
 #include "checkpoint_manager.h"
 #include "mm_session_api.h"
 #include "mot_error.h"
+#include "db_session_statistics.h"
 #include <pthread.h>
 
 namespace MOT {
@@ -47,6 +48,7 @@ OccTransactionManager::OccTransactionManager()
       m_insertSetSize(0),
       m_dynamicSleep(100),
       m_rowsLocked(false),
+      m_rowVersions(false),
       m_preAbort(true),
       m_validationNoWait(true)
 {}
@@ -269,6 +271,86 @@ bool OccTransactionManager::PreAllocStableRow(TxnManager* txMan)
     return true;
 }
 
+bool OccTransactionManager::PreAllocRowVersions(TxnManager* txMan)
+{
+    // Decided once, so a configuration reload cannot change how the deleted keys of this commit are removed
+    m_rowVersions = GetGlobalConfiguration().m_enableSnapshotRead;
+    if (m_rowVersions) {
+        TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+        for (const auto& raPair : orderedSet) {
+            Access* access = raPair.second;
+            if (!access->m_params.IsPrimarySentinel()) {
+                continue;
+            }
+            if (access->m_type == WR || access->m_type == DEL ||
+                (access->m_type == INS && access->m_params.IsUpgradeInsert())) {
+                access->m_versionRow = access->GetRowFromHeader()->GetTable()->CreateNewRow();
+                if (access->m_versionRow == nullptr) {
+                    MOT_REPORT_ERROR(MOT_ERROR_OOM, "Commit Transaction", "Failed to allocate previous row version");
+                    FreeRowVersions(txMan);
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void OccTransactionManager::FreeRowVersions(TxnManager* txMan)
+{
+    if (m_rowVersions) {
+        TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+        for (const auto& raPair : orderedSet) {
+            Access* access = raPair.second;
+            if (access->m_versionRow != nullptr) {
+                access->m_versionRow->GetTable()->DestroyRow(access->m_versionRow);
+                access->m_versionRow = nullptr;
+            }
+        }
+    }
+}
+
+void OccTransactionManager::WriteRowVersions(TxnManager* txMan)
+{
+    if (m_rowVersions) {
+        TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+        for (const auto& raPair : orderedSet) {
+            Access* access = raPair.second;
+            Row* version = access->m_versionRow;
+            if (version == nullptr) {
+                continue;
+            }
+
+            // The global row is locked, copy it as is including its CSN and deletion state
+            Row* row = access->GetRowFromHeader();
+            version->DeepCopy(row);
+            if (row->IsAbsentRow()) {
+                version->m_rowHeader.SetDeleted();
+            }
+            version->m_prevVersion = row->m_prevVersion;
+            row->m_prevVersion = version;
+            if (access->m_type == INS) {
+                // Upgrade: the deleted row is replaced by the auxiliary row, which continues its version chain
+                access->m_auxRow->m_prevVersion = version;
+            }
+
+            if (access->m_type != DEL) {
+                // Snapshots that need this version were taken before our CSN, and so before it is retired
+                access->m_versionRow = nullptr;
+                txMan->GetGcSession()->GcRecordObject(row->GetTable()->GetPrimaryIndex()->GetIndexId(),
+                    version,
+                    nullptr,
+                    Row::RowDtor,
+                    ROW_SIZE_FROM_POOL(row->GetTable()));
+            }
+            MOT::DbSessionStatisticsProvider::GetInstance().AddRowVersion();
+        }
+
+        // Readers that see the new CSN of a row must also see its previous version
+        COMPILER_BARRIER
+    }
+}
+
 bool OccTransactionManager::QuickVersionCheck(TxnManager* txMan, uint32_t& readSetSize)
 {
     int isolationLevel = txMan->GetTxnIsoLevel();
@@ -324,6 +406,7 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
     m_rowsSetSize = 0;
     m_deleteSetSize = 0;
     m_insertSetSize = 0;
+    m_rowVersions = false;
     m_txnCounter++;
 
     if (rowCount == 0) {
@@ -360,8 +443,15 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
         goto final;
     }
 
+    // Pre-allocate previous row versions, so snapshot readers can still see them after we write.
+    if (!PreAllocRowVersions(txMan)) {
+        rc = RC_MEMORY_ALLOCATION_ERROR;
+        goto final;
+    }
+
     // Pre-allocate stable row according to the checkpoint state.
     if (!PreAllocStableRow(txMan)) {
+        FreeRowVersions(txMan);
         rc = RC_MEMORY_ALLOCATION_ERROR;
         goto final;
     }
@@ -414,6 +504,9 @@ void OccTransactionManager::WriteChanges(TxnManager* txMan)
     // Stable rows for checkpoint needs to be created (copied from original row) before modifying the global rows.
     ApplyWrite(txMan);
 
+    // Previous versions for snapshot readers need to be linked before modifying the global rows as well.
+    WriteRowVersions(txMan);
+
     TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
 
     // Update CSN with all relevant information on global rows
@@ -497,20 +590,51 @@ void OccTransactionManager::CleanRowsFromIndexes(TxnManager* txMan)
     TxnAccess* tx = txMan->m_accessMgr.Get();
     TxnOrderedSet_t& orderedSet = tx->GetOrderedRowSet();
     uint32_t numOfDeletes = m_deleteSetSize;
+    Table* lastTable = nullptr;
     // use local counter to optimize
     for (const auto& raPair : orderedSet) {
         const Access* access = raPair.second;
         if (access->m_type == DEL) {
             numOfDeletes--;
-            access->GetTxnRow()->GetTable()->UpdateRowCount(-1);
+            Table* table = access->GetTxnRow()->GetTable();
+            table->UpdateRowCount(-1);
             MOT_ASSERT(access->m_params.IsUpgradeInsert() == false);
-            // Use Txn Row as row may change INSERT after DELETE leaves residue
-            txMan->RemoveKeyFromIndex(access->GetTxnRow(), access->m_origSentinel);
+            if (!m_rowVersions) {
+                // Use Txn Row as row may change INSERT after DELETE leaves residue
+                txMan->RemoveKeyFromIndex(access->GetTxnRow(), access->m_origSentinel);
+            } else if (!access->m_params.IsPrimarySentinel()) {
+                // Snapshot readers may still find the row through the key, keep it until they are done
+                table->DeferKeyRemoval(access->m_origSentinel,
+                    access->GetRowFromHeader()->GetPrevVersion(),
+                    GetGlobalEpoch(),
+                    txMan->GetCommitSequenceNumber());
+            }
+            if (table != lastTable) {
+                lastTable = table;
+                table->RemoveDeferredKeys(txMan->GetGcSession(), txMan->GetThdId(), false);
+            }
         }
         if (!numOfDeletes) {
             break;
         }
     }
+
+    if (m_rowVersions) {
+        // The previous version of a deleted row builds its keys, so the primary key that releases it goes last
+        for (const auto& raPair : orderedSet) {
+            Access* access = raPair.second;
+            if (access->m_type == DEL && access->m_params.IsPrimarySentinel()) {
+                Sentinel* sentinel = access->m_origSentinel;
+                if (sentinel->GetStable() != nullptr) {
+                    // Checkpoint works on primary-sentinel only!
+                    sentinel = nullptr;
+                }
+                access->GetTxnRow()->GetTable()->DeferKeyRemoval(
+                    sentinel, access->m_versionRow, GetGlobalEpoch(), txMan->GetCommitSequenceNumber());
+                access->m_versionRow = nullptr;
+            }
+        }
+    }
 }
 
 void OccTransactionManager::ReleaseHeaderLocks(TxnManager* txMan, uint32_t numOfLocks)
@@ -572,5 +696,6 @@ void OccTransactionManager::CleanUp()
     m_writeSetSize = 0;
     m_insertSetSize = 0;
     m_rowsSetSize = 0;
+    m_rowVersions = false;
 }
 }  // namespace MOT
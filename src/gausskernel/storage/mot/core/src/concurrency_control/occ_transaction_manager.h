@@ -92,12 +92,15 @@ public:
      */
     void WriteChanges(TxnManager* txMan);
 
-    /** @brief remove all deleted keys from the global indices   */
+    /** @brief remove all deleted keys from the global indices, or defer it while snapshot readers need them */
     void CleanRowsFromIndexes(TxnManager* txMan);
 
     /** @brief Rollack insert-set due to an abort   */
     void RollbackInserts(TxnManager* txMan);
 
+    /** @brief Releases row versions pre-allocated for snapshot reads that were not used. */
+    void FreeRowVersions(TxnManager* txMan);
+
     void ReleaseLocks(TxnManager* txMan)
     {
         if (m_rowsLocked) {
@@ -175,6 +178,12 @@ private:
     /** @brief Sets stable row according to the checkpoint state. */
     void ApplyWrite(TxnManager* txMan);
 
+    /** @brief Pre-allocates the previous versions of the rows in the write set for snapshot reads. */
+    bool PreAllocRowVersions(TxnManager* txMan);
+
+    /** @brief Links the previous versions of the rows in the write set before they are modified. */
+    void WriteRowVersions(TxnManager* txMan);
+
     /** @var transaction counter   */
     uint32_t m_txnCounter;
 
@@ -198,6 +207,9 @@ private:
     /** @var flag indicating whether we locked the rows   */
     bool m_rowsLocked;
 
+    /** @var Whether the commit keeps previous row versions and deleted keys for snapshot readers. */
+    bool m_rowVersions;
+
     /** @var Pre-abort configuration. */
     bool m_preAbort;
 
@@ -85,6 +85,40 @@ RC RowHeader::GetLocalCopy(
     return RC_OK;
 }
 
+uint64_t RowHeader::GetSnapshotCopy(uint64_t snapshotCsn, Row* localRow, const Row* origRow, Row*& prevVersion) const
+{
+    uint64_t sleepTime = 1;
+    uint64_t v = 0;
+    uint64_t v2 = 1;
+
+    while (v2 != v) {
+        // A locked row that already carries a newer CSN has its previous version published, so wait only for a
+        // writer that did not reach that point yet
+        v = m_csnWord;
+        while ((v & LOCK_BIT) && (v & CSN_BITS) <= snapshotCsn) {
+            if (sleepTime > LOCK_TIME_OUT) {
+                sleepTime = LOCK_TIME_OUT;
+                struct timespec ts = {0, 5000};
+                (void)nanosleep(&ts, NULL);
+            } else {
+                CpuCyclesLevelTime::Sleep(1);
+                sleepTime = sleepTime << 1;
+            }
+
+            v = m_csnWord;
+        }
+        COMPILER_BARRIER
+        prevVersion = origRow->GetPrevVersion();
+        if ((v & CSN_BITS) <= snapshotCsn && (v & ABSENT_BIT) == 0) {
+            localRow->Copy(origRow);
+        }
+        COMPILER_BARRIER
+        v2 = m_csnWord;
+    }
+
+    return v;
+}
+
 bool RowHeader::ValidateWrite(TransactionId tid) const
 {
     return (tid == GetCSN());
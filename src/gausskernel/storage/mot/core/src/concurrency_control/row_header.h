@@ -99,6 +99,17 @@ private:
      */
     RC GetLocalCopy(TxnAccess* txn, AccessType type, Row* localRow, const Row* origRow, TransactionId& lastTid) const;
 
+    /**
+     * @brief Gets a consistent copy of a managed row if it is visible to a snapshot.
+     * @param snapshotCsn The commit sequence number of the snapshot.
+     * @param[out] localRow Receives the row contents if the row is visible to the snapshot.
+     * @param origRow The managed row.
+     * @param[out] prevVersion Receives the previous version of the row, which must be used when the row itself is
+     * newer than the snapshot.
+     * @return The CSN word of the row as it was when the copy was made.
+     */
+    uint64_t GetSnapshotCopy(uint64_t snapshotCsn, Row* localRow, const Row* origRow, Row*& prevVersion) const;
+
     /**
      * @brief Validates the row was not changed by a concurrent transaction
      * @param tid The transaction identifier.
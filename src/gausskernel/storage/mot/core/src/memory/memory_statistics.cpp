@@ -141,7 +141,11 @@ MemoryThreadStatistics::MemoryThreadStatistics(uint64_t threadId, void* inplaceB
       m_freeTime(MakeName("free-time", threadId).c_str(), 1, "nanos"),
       m_gcRetiredBytes(MakeName("gc-retired-bytes", threadId).c_str(), MEGA_BYTE, "MB"),
       m_gcReclaimedBytes(MakeName("gc-reclaimed-bytes", threadId).c_str(), MEGA_BYTE, "MB"),
-      m_masstreeBytesUsed(MakeName("masstree-bytes-used", threadId).c_str(), MEGA_BYTE, "MB")
+      m_masstreeBytesUsed(MakeName("masstree-bytes-used", threadId).c_str(), MEGA_BYTE, "MB"),
+      m_objRemoteFrees(MakeName("object-remote-frees", threadId).c_str()),
+      m_objMagazineFlushes(MakeName("object-magazine-flushes", threadId).c_str()),
+      m_compactionRelocatedRows(MakeName("compaction-relocated-rows", threadId).c_str()),
+      m_compactionReleasedBytes(MakeName("compaction-released-bytes", threadId).c_str(), MEGA_BYTE, "MB")
 {
     // register all statistic variables
     RegisterStatistics(&m_globalChunksUsed);
@@ -155,6 +159,10 @@ MemoryThreadStatistics::MemoryThreadStatistics(uint64_t threadId, void* inplaceB
     RegisterStatistics(&m_gcRetiredBytes);
     RegisterStatistics(&m_gcReclaimedBytes);
     RegisterStatistics(&m_masstreeBytesUsed);
+    RegisterStatistics(&m_objRemoteFrees);
+    RegisterStatistics(&m_objMagazineFlushes);
+    RegisterStatistics(&m_compactionRelocatedRows);
+    RegisterStatistics(&m_compactionReleasedBytes);
 }
 
 MemoryGlobalStatistics::MemoryGlobalStatistics(GlobalStatistics::NamingScheme namingScheme)
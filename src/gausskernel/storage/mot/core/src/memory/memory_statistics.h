@@ -223,6 +223,30 @@ public:
         m_masstreeBytesUsed.AddSample(bytes);
     }
 
+    /** @brief Updates the statistics for objects released into a sub-pool reserved by another thread. */
+    inline void AddObjRemoteFree()
+    {
+        m_objRemoteFrees.AddSample();
+    }
+
+    /** @brief Updates the statistics for batches of cached objects returned to their sub-pools. */
+    inline void AddObjMagazineFlush()
+    {
+        m_objMagazineFlushes.AddSample();
+    }
+
+    /** @brief Updates the statistics for rows moved by online compaction. */
+    inline void AddCompactionRelocatedRow()
+    {
+        m_compactionRelocatedRows.AddSample();
+    }
+
+    /** @brief Updates the statistics for row memory given back by online compaction. */
+    inline void AddCompactionReleasedBytes(uint64_t bytes)
+    {
+        m_compactionReleasedBytes.AddSample(bytes);
+    }
+
 private:
     // global/local chunks
     MemoryStatisticVariable m_globalChunksUsed;
@@ -248,6 +272,14 @@ private:
 
     // masstree statistics
     MemoryStatisticVariable m_masstreeBytesUsed;
+
+    // object pool statistics
+    FrequencyStatisticVariable m_objRemoteFrees;
+    FrequencyStatisticVariable m_objMagazineFlushes;
+
+    // online compaction statistics
+    FrequencyStatisticVariable m_compactionRelocatedRows;
+    MemoryStatisticVariable m_compactionReleasedBytes;
 };
 
 class MemoryGlobalStatistics : public GlobalStatistics {
@@ -600,6 +632,42 @@ public:
         }
     }
 
+    /** @brief Updates the statistics for objects released into a sub-pool reserved by another thread. */
+    inline void AddObjRemoteFree()
+    {
+        MemoryThreadStatistics* mts = GetCurrentThreadStatistics<MemoryThreadStatistics>();
+        if (mts) {
+            mts->AddObjRemoteFree();
+        }
+    }
+
+    /** @brief Updates the statistics for batches of cached objects returned to their sub-pools. */
+    inline void AddObjMagazineFlush()
+    {
+        MemoryThreadStatistics* mts = GetCurrentThreadStatistics<MemoryThreadStatistics>();
+        if (mts) {
+            mts->AddObjMagazineFlush();
+        }
+    }
+
+    /** @brief Updates the statistics for rows moved by online compaction. */
+    inline void AddCompactionRelocatedRow()
+    {
+        MemoryThreadStatistics* mts = GetCurrentThreadStatistics<MemoryThreadStatistics>();
+        if (mts) {
+            mts->AddCompactionRelocatedRow();
+        }
+    }
+
+    /** @brief Updates the statistics for row memory given back by online compaction. */
+    inline void AddCompactionReleasedBytes(uint64_t bytes)
+    {
+        MemoryThreadStatistics* mts = GetCurrentThreadStatistics<MemoryThreadStatistics>();
+        if (mts) {
+            mts->AddCompactionReleasedBytes(bytes);
+        }
+    }
+
     /** @brief Updates the statistics for the amount of bytes retired into the garbage collector. */
     inline void AddGCRetiredBytes(uint64_t bytes)
     {
@@ -130,15 +130,30 @@ public:
     }
 };
 
+#define OBJ_MAGAZINE_SIZE 64
+
+/**
+ * @brief Per-thread cache of released objects. Objects are handed out again by the releasing thread without touching
+ * their sub-pool, and are returned to their sub-pools in batches when the magazine fills up, or all at once when the
+ * pool requests a flush (see GlobalObjPool::RequestMagazineFlush()).
+ */
+typedef struct __ObjMagazine {
+    uint32_t m_count;
+    uint32_t m_epoch;
+    uint8_t m_oix[OBJ_MAGAZINE_SIZE];
+    void* m_objs[OBJ_MAGAZINE_SIZE];
+} ObjMagazine;
+
 typedef struct PACKED __ThreadAOP {
     ObjPoolPtr m_nextFree;
+    ObjMagazine* m_magazine;
 } ThreadAOP;
 
 class GlobalObjPool : public ObjAllocInterface {
 public:
     ThreadAOP m_threadAOP[MAX_THREAD_COUNT];
 
-    GlobalObjPool(uint16_t sz, uint8_t align) : ObjAllocInterface(true)
+    GlobalObjPool(uint16_t sz, uint8_t align) : ObjAllocInterface(true), m_magazineEpoch(0)
     {
         m_objList = nullptr;
         m_nextFree = nullptr;
@@ -153,6 +168,12 @@ public:
     ~GlobalObjPool() override
     {
         Print("Global");
+        for (int i = 0; i < MAX_THREAD_COUNT; i++) {
+            if (m_threadAOP[i].m_magazine != nullptr) {
+                delete m_threadAOP[i].m_magazine;
+                m_threadAOP[i].m_magazine = nullptr;
+            }
+        }
     };
 
     bool Initialize() override
@@ -206,22 +227,32 @@ public:
 
     inline void Release(void* ptr) override
     {
-        PoolAllocStateT state = PAS_NONE;
         ThreadAOP* t = &m_threadAOP[G_THREAD_ID];
 
         OBJ_RELEASE_START(ptr, m_size);
-        op->Release(oix, &state);
+        if (op->m_owner >= 0 && op->m_owner != G_THREAD_ID) {
+            MemoryStatisticsProvider::m_provider->AddObjRemoteFree();
+        }
 
-        if (state == PAS_FIRST) {
-            if (t->m_nextFree.Get() == nullptr) {
-                op->m_owner = G_THREAD_ID;
-                t->m_nextFree = op;
-            } else {
-                op->m_owner = -1;
-                MEMORY_BARRIER;
-                PUSH(m_nextFree, op);
+        // objects from sub-pools of other NUMA nodes go straight back, so the magazine hands out only local memory,
+        // and so do objects of sub-pools being compacted, which must empty out
+        if (op->GetNode() == MOTCurrentNumaNodeId && !op->IsCompacting()) {
+            ObjMagazine* mag = GetMagazine(t);
+            if (likely(mag != nullptr)) {
+                if (unlikely(mag->m_epoch != m_magazineEpoch)) {
+                    SyncMagazine(t);
+                }
+                if (mag->m_count == OBJ_MAGAZINE_SIZE) {
+                    FlushMagazine(t, OBJ_MAGAZINE_SIZE / 2);
+                }
+                mag->m_objs[mag->m_count] = ptr;
+                mag->m_oix[mag->m_count] = oix;
+                ++mag->m_count;
+                return;
             }
         }
+
+        ReleaseToPool(t, op, oix);
     }
 
     inline void* Alloc() override
@@ -231,6 +262,24 @@ public:
 
         ThreadAOP* t = &m_threadAOP[G_THREAD_ID];
 
+        ObjMagazine* mag = t->m_magazine;
+        if (mag != nullptr && unlikely(mag->m_epoch != m_magazineEpoch)) {
+            SyncMagazine(t);
+        }
+        while (mag != nullptr && mag->m_count > 0) {
+            --mag->m_count;
+            uint8_t* obj = (uint8_t*)mag->m_objs[mag->m_count];
+            uint8_t oix = mag->m_oix[mag->m_count];
+            ObjPoolPtr op = (ObjPool*)(obj - sizeof(ObjPool) - oix * m_size);
+            if (unlikely(op->IsCompacting())) {
+                // cached before its sub-pool was picked for compaction, do not hand it out again
+                ReleaseToPool(t, op, oix);
+                continue;
+            }
+            obj[m_oixOffset] = oix;
+            return obj;
+        }
+
         if (t->m_nextFree.Get() == nullptr) {
             t->m_nextFree = Reserve();
             if (unlikely(t->m_nextFree.Get() == nullptr)) {  // out of memory
@@ -250,7 +299,12 @@ public:
 
     void ClearThreadCache() override
     {
-        ObjPoolPtr op = m_threadAOP[G_THREAD_ID].m_nextFree;
+        ThreadAOP* t = &m_threadAOP[G_THREAD_ID];
+        if (t->m_magazine != nullptr && t->m_magazine->m_count > 0) {
+            FlushMagazine(t, t->m_magazine->m_count);
+        }
+
+        ObjPoolPtr op = t->m_nextFree;
 
         while (op.Get() != nullptr) {
             ObjPoolPtr tmp = op->m_objNext;
@@ -261,8 +315,24 @@ public:
         m_threadAOP[G_THREAD_ID].m_nextFree = nullptr;
     }
 
+    /**
+     * @brief Asks all threads to return the objects cached in their magazines to their sub-pools. Each thread flushes
+     * its magazine on its next allocation or release from this pool, so sub-pools are not kept alive by the magazines
+     * of threads that stopped allocating.
+     */
+    inline void RequestMagazineFlush() override
+    {
+        (void)__sync_add_and_fetch(&m_magazineEpoch, 1);
+    }
+
     void ClearFreeCache() override
     {
+        RequestMagazineFlush();
+        ThreadAOP* t = &m_threadAOP[G_THREAD_ID];
+        if (t->m_magazine != nullptr) {
+            SyncMagazine(t);
+        }
+
         ObjPoolPtr orig = nullptr;
         ObjPoolPtr p = nullptr;
         do {
@@ -294,6 +364,71 @@ public:
             } while (!CAS(m_nextFree, prev->m_objNext, orig));
         }
     }
+
+private:
+    /** @var Bumped to make all threads flush their magazines. */
+    volatile uint32_t m_magazineEpoch;
+
+    inline ObjMagazine* GetMagazine(ThreadAOP* t)
+    {
+        if (unlikely(t->m_magazine == nullptr)) {
+            // on failure objects are just released directly to their sub-pools
+            t->m_magazine = new (std::nothrow) ObjMagazine();
+            if (t->m_magazine != nullptr) {
+                t->m_magazine->m_epoch = m_magazineEpoch;
+            }
+        }
+        return t->m_magazine;
+    }
+
+    /** @brief Flushes the whole magazine of a thread if a flush was requested since it was last synchronized. */
+    inline void SyncMagazine(ThreadAOP* t)
+    {
+        ObjMagazine* mag = t->m_magazine;
+        uint32_t epoch = m_magazineEpoch;
+        if (mag->m_count > 0) {
+            FlushMagazine(t, mag->m_count);
+        }
+        mag->m_epoch = epoch;
+    }
+
+    inline void ReleaseToPool(ThreadAOP* t, ObjPoolPtr& op, uint8_t oix)
+    {
+        PoolAllocStateT state = PAS_NONE;
+        op->Release(oix, &state);
+
+        if (state == PAS_FIRST) {
+            if (t->m_nextFree.Get() == nullptr) {
+                op->m_owner = G_THREAD_ID;
+                t->m_nextFree = op;
+            } else {
+                op->m_owner = -1;
+                MEMORY_BARRIER;
+                PUSH(m_nextFree, op);
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the oldest objects in the magazine of a thread to their sub-pools.
+     * @param t The thread cache.
+     * @param count The number of objects to return.
+     */
+    void FlushMagazine(ThreadAOP* t, uint32_t count)
+    {
+        ObjMagazine* mag = t->m_magazine;
+        for (uint32_t i = 0; i < count; i++) {
+            uint8_t oix = mag->m_oix[i];
+            ObjPoolPtr op = (ObjPool*)((uint8_t*)mag->m_objs[i] - sizeof(ObjPool) - oix * m_size);
+            ReleaseToPool(t, op, oix);
+        }
+        for (uint32_t i = count; i < mag->m_count; i++) {
+            mag->m_objs[i - count] = mag->m_objs[i];
+            mag->m_oix[i - count] = mag->m_oix[i];
+        }
+        mag->m_count -= count;
+        MemoryStatisticsProvider::m_provider->AddObjMagazineFlush();
+    }
 };
 
 #define SLUB_MAX_BIN 15  // up to 32KB
@@ -41,7 +41,7 @@ CompactHandler::CompactHandler(ObjAllocInterface* pool, const char* prefix)
       m_logPrefix(prefix)
 {}
 
-void CompactHandler::StartCompaction(CompactTypeT type)
+void CompactHandler::StartCompaction(CompactTypeT type, uint32_t minFreePercent)
 {
     PoolStatsSt stats;
     errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
@@ -50,7 +50,7 @@ void CompactHandler::StartCompaction(CompactTypeT type)
 
     m_ctype = type;
     m_orig->GetStats(stats);
-    m_orig->PrintStats(stats, m_logPrefix, LogLevel::LL_INFO);
+    m_orig->PrintStats(stats, m_logPrefix, GetStatsLogLevel());
 
     if (stats.m_fragmentationPercent <= 0 && stats.m_freeObjCount < stats.m_perPoolTotalCount) {
         m_compactionNeeded = false;
@@ -64,13 +64,34 @@ void CompactHandler::StartCompaction(CompactTypeT type)
         m_poolsToCompact = m_orig->m_nextFree;
     } while (!CAS(m_orig->m_nextFree, m_poolsToCompact, p));
 
+    // keep only pools that are either empty or sparse enough, give back the rest
+    ObjPoolPtr prev = nullptr;
     p = m_poolsToCompact;
     while (p.Get() != nullptr) {
         ObjPool* op = p.Get();
-        if (p->m_freeCount < p->m_totalCount)
-            m_addrMap[op] = op;
-        p = p->m_objNext;
+        ObjPoolPtr next = p->m_objNext;
+        if (p->m_freeCount < p->m_totalCount) {
+            if ((uint32_t)p->m_freeCount * 100 >= (uint32_t)p->m_totalCount * minFreePercent) {
+                m_addrMap[op] = op;
+                op->SetCompacting(true);
+            } else {
+                if (prev.Get() == nullptr) {
+                    m_poolsToCompact = next;
+                } else {
+                    prev->m_objNext = next;
+                }
+                PUSH(m_orig->m_nextFree, p);
+                p = next;
+                continue;
+            }
+        }
+        prev = p;
+        p = next;
     }
+
+    // objects of the compacted pools cached by other threads must go back to their pools, not be handed out again
+    MEMORY_BARRIER;
+    m_orig->RequestMagazineFlush();
 }
 
 void CompactHandler::EndCompaction()
@@ -112,12 +133,14 @@ void CompactHandler::EndCompaction()
         ObjPoolPtr p = m_poolsToCompact;
         while (p.Get() != nullptr) {
             ObjPoolPtr tmp = p->m_objNext;
+            p->SetCompacting(false);
             if (p->m_freeCount == p->m_totalCount) {
                 ObjPool* op = p.Get();
                 DEL_FROM_LIST(m_orig->m_listLock, m_orig->m_objList, op);
                 ObjPool::DelObjPool(op, m_orig->m_type, true);
             } else {
-                if (m_ctype != COMPACT_SIMPLE)
+                // in online compaction the relocated objects are released later by the GC
+                if (m_ctype != COMPACT_SIMPLE && m_ctype != COMPACT_ONLINE)
                     MOT_LOG_ERROR("Compaction error: pool not empty, re-inserting to free pools");
                 PUSH(m_orig->m_nextFree, p);
             }
@@ -125,7 +148,7 @@ void CompactHandler::EndCompaction()
         }
     }
 
-    m_orig->Print(m_logPrefix, LogLevel::LL_INFO);
+    m_orig->Print(m_logPrefix, GetStatsLogLevel());
 
     m_compactionNeeded = false;
 }
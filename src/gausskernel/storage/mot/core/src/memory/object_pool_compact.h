@@ -30,7 +30,7 @@
 
 namespace MOT {
 #define PTR_MASK (((uint64_t)-1) << 10)
-typedef enum : uint8_t { COMPACT_SIMPLE = 0, COMPACT_REALLOC = 1, COMPACT_DEEP = 2 } CompactTypeT;
+typedef enum : uint8_t { COMPACT_SIMPLE = 0, COMPACT_REALLOC = 1, COMPACT_DEEP = 2, COMPACT_ONLINE = 3 } CompactTypeT;
 
 struct hashing_func {
     uint64_t operator()(const ObjPool* key) const
@@ -58,8 +58,11 @@ public:
     /**
      * @brief Prepares orig for compaction, calculates fragmentation percent, initializes addrMap and set
      * comactionNeeded to true (if indeed)
+     * @param type The compaction type.
+     * @param minFreePercent Only ObjPools with at least this percentage of free objects are compacted. The rest are
+     * returned to general use right away.
      */
-    void StartCompaction(CompactTypeT type = COMPACT_REALLOC);
+    void StartCompaction(CompactTypeT type = COMPACT_REALLOC, uint32_t minFreePercent = 0);
     /** @brief Applies new ObjPools to a general use, and releases empty ObjPools.
      */
     void EndCompaction();
@@ -73,6 +76,27 @@ public:
      */
     template <typename T>
     T* CompactObj(T const* obj)
+    {
+        T* res = RelocateObj<T>(obj);
+
+        if (res != nullptr) {
+            OBJ_RELEASE_START_NOMARK(obj, m_orig->m_size);
+            PoolAllocStateT state = PAS_NONE;
+            OBJ_RELEASE_MARK(oix_ptr);
+            obj->~T();
+            op->Release(oix, &state);
+        }
+
+        return res;
+    }
+
+    /**
+     * @brief Copies the object into a compacted ObjPool if it resides in an ObjPool being compacted. The original
+     * object is left intact, and the caller is responsible to release it once no concurrent reader can access it.
+     * @return The new object, or null if the object need not move or allocation failed.
+     */
+    template <typename T>
+    T* RelocateObj(T const* obj)
     {
         T* res = nullptr;
 
@@ -88,6 +112,9 @@ public:
 
             if (m_curr == nullptr) {
                 m_curr = ObjPool::GetObjPool(m_orig->m_size, m_orig, m_orig->m_type, true);
+                if (m_curr == nullptr) {
+                    return res;
+                }
             }
 
             m_curr->Alloc(&data, &state);
@@ -98,16 +125,17 @@ public:
             }
 
             res = new (data) T(*(const T*)obj);
-
-            OBJ_RELEASE_MARK(oix_ptr);
-            state = PAS_NONE;
-            obj->~T();
-            op->Release(oix, &state);
         }
 
         return res;
     }
 
+    /** @brief Periodic online compaction reports pool statistics only in debug log level. */
+    inline LogLevel GetStatsLogLevel() const
+    {
+        return (m_ctype == COMPACT_ONLINE) ? LogLevel::LL_DEBUG : LogLevel::LL_INFO;
+    }
+
     ObjAllocInterface* m_orig;
     bool m_compactionNeeded;
     CompactTypeT m_ctype;
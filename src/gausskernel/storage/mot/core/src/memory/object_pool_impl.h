@@ -348,6 +348,10 @@ public:
     virtual void ClearThreadCache() = 0;
     virtual void ClearFreeCache() = 0;
 
+    /** @brief Asks all threads to return the objects they cache to their sub-pools. */
+    virtual void RequestMagazineFlush()
+    {}
+
     void GetStats(PoolStatsSt& stats);
     void PrintStats(PoolStatsSt& stats, const char* prefix = "", LogLevel level = LogLevel::LL_DEBUG);
     void Print(const char* prefix, LogLevel level = LogLevel::LL_DEBUG);
@@ -378,6 +382,8 @@ public:
         m_owner = -1;
         m_objNext = nullptr;
         m_next = m_prev = nullptr;
+        SetNode((int16_t)MOTCurrentNumaNodeId);
+        SetCompacting(false);
         *(uint32_t*)(&m_head.m_fill1[3]) = 0xDEADBEEF;
         *(uint32_t*)(&m_head.m_fill2[3]) = 0xDEADBEEF;
         m_overheadBytes = sizeof(ObjPool);
@@ -404,6 +410,35 @@ public:
     ~ObjPool()
     {}
 
+    /**
+     * @brief Retrieves the NUMA node on which the sub-pool was created. The node is kept in the spare header bytes
+     * so the object data stays cache-line aligned.
+     * @return The node identifier.
+     */
+    inline int16_t GetNode() const
+    {
+        return *(const int16_t*)(&m_head.m_fill1[0]);
+    }
+
+    inline void SetNode(int16_t node)
+    {
+        *(int16_t*)(&m_head.m_fill1[0]) = node;
+    }
+
+    /**
+     * @brief Specifies whether the sub-pool is being compacted (see CompactHandler). Objects of such a sub-pool are
+     * returned to it directly instead of being cached in the magazines, so it can become empty.
+     */
+    inline bool IsCompacting() const
+    {
+        return m_head.m_fill1[2] != 0;
+    }
+
+    inline void SetCompacting(bool compacting)
+    {
+        m_head.m_fill1[2] = compacting ? 1 : 0;
+    }
+
     inline void AllocNoLock(void** ret, PoolAllocStateT* state)
     {
         uint8_t ix = ++(m_head.m_nextFreeObj);
@@ -529,6 +564,12 @@ private:
     DECLARE_CLASS_LOGGER();
 };
 
+// object data must start on a cache line boundary, pools may be requested with CACHE_LINE_SIZE alignment
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winvalid-offsetof"
+static_assert(offsetof(ObjPool, m_head.m_data) % CACHE_LINE_SIZE == 0, "Object pool data is not cache-line aligned");
+#pragma GCC diagnostic pop
+
 inline void ObjPoolPtr::operator++()
 {
     Get()->m_listCounter++;
@@ -0,0 +1,438 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Primary index implementation using a lock-free split-ordered hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "hash_index.h"
+#include "mot_engine.h"
+#include "mm_global_api.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashPrimaryIndex, Storage);
+
+RC HashPrimaryIndex::IndexInitImpl(void** args)
+{
+    m_nodePool = ObjAllocInterface::GetObjPool(sizeof(HashNode) + sizeof(Key) + ALIGN8(m_keyLength), false);
+    if (m_nodePool == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash node pool");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    // bucket 0 is the head of the split-ordered list and is never removed
+    std::atomic<HashNode*>* segment = (std::atomic<HashNode*>*)MemGlobalAlloc(sizeof(std::atomic<HashNode*>));
+    HashNode* head = (HashNode*)m_nodePool->Alloc();
+    if (segment == nullptr || head == nullptr) {
+        if (segment != nullptr) {
+            MemGlobalFree(segment);
+        }
+        DestroyPools();
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to allocate hash index head bucket");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+    head->m_soKey = DummySoKey(0);
+    head->m_next.store(0, std::memory_order_relaxed);
+    head->m_sentinel = nullptr;
+    new (segment) std::atomic<HashNode*>(head);
+    m_segments[0].store(segment, std::memory_order_release);
+
+    m_bucketCount.store(INITIAL_BUCKETS, std::memory_order_relaxed);
+    m_count.store(0, std::memory_order_relaxed);
+    m_initialized = true;
+    return RC_OK;
+}
+
+void HashPrimaryIndex::DestroyPools()
+{
+    for (uint32_t i = 0; i < MAX_SEGMENTS; ++i) {
+        std::atomic<HashNode*>* segment = m_segments[i].load(std::memory_order_relaxed);
+        if (segment != nullptr) {
+            MemGlobalFree(segment);
+            m_segments[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    if (m_nodePool != nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+    }
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::FindBucket(uint64_t bucket) const
+{
+    // readers never initialize buckets: an uninitialized bucket is covered by the list segment of its parent
+    while (true) {
+        uint32_t segmentId = BucketSegment(bucket);
+        std::atomic<HashNode*>* segment = m_segments[segmentId].load(std::memory_order_acquire);
+        if (segment != nullptr) {
+            HashNode* head = segment[BucketOffset(bucket, segmentId)].load(std::memory_order_acquire);
+            if (head != nullptr) {
+                return head;
+            }
+        }
+        MOT_ASSERT(bucket != 0);
+        bucket &= ~(1ULL << (63 - __builtin_clzll(bucket)));
+    }
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::GetBucket(uint64_t bucket)
+{
+    uint32_t segmentId = BucketSegment(bucket);
+    std::atomic<HashNode*>* segment = m_segments[segmentId].load(std::memory_order_acquire);
+    if (likely(segment != nullptr)) {
+        HashNode* head = segment[BucketOffset(bucket, segmentId)].load(std::memory_order_acquire);
+        if (likely(head != nullptr)) {
+            return head;
+        }
+    }
+    return InitBucket(bucket);
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::InitBucket(uint64_t bucket)
+{
+    MOT_ASSERT(bucket != 0);
+    HashNode* parent = GetBucket(bucket & ~(1ULL << (63 - __builtin_clzll(bucket))));
+    if (parent == nullptr) {
+        return nullptr;
+    }
+
+    uint32_t segmentId = BucketSegment(bucket);
+    uint64_t segmentSize = SegmentSize(segmentId);
+    std::atomic<HashNode*>* segment = m_segments[segmentId].load(std::memory_order_acquire);
+    if (segment == nullptr) {
+        std::atomic<HashNode*>* newSegment =
+            (std::atomic<HashNode*>*)MemGlobalAlloc(segmentSize * sizeof(std::atomic<HashNode*>));
+        if (newSegment == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                "Hash Index",
+                "Failed to allocate bucket segment of %" PRIu64 " buckets for index %s",
+                segmentSize,
+                m_name.c_str());
+            return nullptr;
+        }
+        for (uint64_t i = 0; i < segmentSize; ++i) {
+            new (&newSegment[i]) std::atomic<HashNode*>(nullptr);
+        }
+        if (m_segments[segmentId].compare_exchange_strong(segment, newSegment, std::memory_order_acq_rel)) {
+            segment = newSegment;
+        } else {
+            MemGlobalFree(newSegment);  // lost the race, segment now holds the winner
+        }
+    }
+
+    HashNode* dummy = (HashNode*)m_nodePool->Alloc();
+    if (dummy == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Hash Index", "Failed to allocate bucket node for index %s", m_name.c_str());
+        return nullptr;
+    }
+    dummy->m_soKey = DummySoKey(bucket);
+    dummy->m_sentinel = nullptr;
+
+    HashNode* prev = nullptr;
+    HashNode* curr = nullptr;
+    while (true) {
+        if (ListFind(parent, dummy->m_soKey, nullptr, prev, curr)) {
+            // another thread already linked this bucket, our node was never published
+            m_nodePool->Release(dummy);
+            dummy = curr;
+            break;
+        }
+        dummy->m_next.store((uintptr_t)curr, std::memory_order_relaxed);
+        uintptr_t expected = (uintptr_t)curr;
+        if (prev->m_next.compare_exchange_strong(
+                expected, (uintptr_t)dummy, std::memory_order_release, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    segment[BucketOffset(bucket, segmentId)].store(dummy, std::memory_order_release);
+    return dummy;
+}
+
+bool HashPrimaryIndex::ListFind(HashNode* head, uint64_t soKey, const uint8_t* key, HashNode*& prev, HashNode*& curr)
+{
+retry:
+    prev = head;
+    curr = NodePtr(prev->m_next.load(std::memory_order_acquire));
+    while (curr != nullptr) {
+        uintptr_t succ = curr->m_next.load(std::memory_order_acquire);
+        if (IsMarked(succ)) {
+            // help unlinking a logically deleted node, whoever unlinks it hands it to the GC
+            uintptr_t expected = (uintptr_t)curr;
+            if (!prev->m_next.compare_exchange_strong(
+                    expected, (uintptr_t)NodePtr(succ), std::memory_order_acq_rel, std::memory_order_relaxed)) {
+                goto retry;
+            }
+            RetireNode(curr);
+            curr = NodePtr(succ);
+            continue;
+        }
+        int cmp = CompareNode(curr, soKey, key);
+        if (cmp >= 0) {
+            return (cmp == 0);
+        }
+        prev = curr;
+        curr = NodePtr(succ);
+    }
+    return false;
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::ListLookup(HashNode* head, uint64_t soKey, const uint8_t* key) const
+{
+    HashNode* curr = NodePtr(head->m_next.load(std::memory_order_acquire));
+    while (curr != nullptr) {
+        uintptr_t succ = curr->m_next.load(std::memory_order_acquire);
+        int cmp = CompareNode(curr, soKey, key);
+        if (cmp == 0) {
+            return IsMarked(succ) ? nullptr : curr;
+        }
+        if (cmp > 0) {
+            break;
+        }
+        curr = NodePtr(succ);
+    }
+    return nullptr;
+}
+
+void HashPrimaryIndex::RetireNode(HashNode* node)
+{
+    GcManager* gc = MOTEngine::GetInstance()->GetCurrentGcSession();
+    if (likely(gc != nullptr)) {
+        gc->GcRecordObject(GetIndexId(), (void*)m_nodePool, node, DeallocateFromPoolCallBack, m_nodePool->m_size);
+    } else {
+        // no session (e.g. single threaded recovery), nobody else can see the node
+        m_nodePool->Release(node);
+    }
+}
+
+HashPrimaryIndex::HashNode* HashPrimaryIndex::NextLive(HashNode* node)
+{
+    HashNode* curr = NodePtr(node->m_next.load(std::memory_order_acquire));
+    while (curr != nullptr && (curr->IsDummy() || IsMarked(curr->m_next.load(std::memory_order_acquire)))) {
+        curr = NodePtr(curr->m_next.load(std::memory_order_acquire));
+    }
+    return curr;
+}
+
+uint64_t HashPrimaryIndex::HashKey(const uint8_t* key) const
+{
+    // MurmurHash64A
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+    uint64_t h = 0x9747b28c ^ (m_keyLength * m);
+    uint32_t words = m_keyLength / sizeof(uint64_t);
+
+    for (uint32_t i = 0; i < words; ++i) {
+        uint64_t k;
+        errno_t erc = memcpy_s(&k, sizeof(k), key + i * sizeof(uint64_t), sizeof(uint64_t));
+        securec_check(erc, "\0", "\0");
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+
+    const uint8_t* tail = key + words * sizeof(uint64_t);
+    uint32_t rest = m_keyLength & (sizeof(uint64_t) - 1);
+    if (rest != 0) {
+        for (uint32_t i = rest; i > 0; --i) {
+            h ^= uint64_t(tail[i - 1]) << (8 * (i - 1));
+        }
+        h *= m;
+    }
+
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+Sentinel* HashPrimaryIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    MOT_ASSERT(key->GetKeyLength() >= m_keyLength);
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf);
+    uint64_t soKey = RegularSoKey(hash);
+
+    inserted = false;
+    HashNode* head = GetBucket(hash & (m_bucketCount.load(std::memory_order_relaxed) - 1));
+    if (head == nullptr) {
+        return nullptr;  // out of memory, error already reported
+    }
+
+    HashNode* node = nullptr;
+    HashNode* prev = nullptr;
+    HashNode* curr = nullptr;
+    while (true) {
+        if (ListFind(head, soKey, keyBuf, prev, curr)) {
+            if (node != nullptr) {
+                m_nodePool->Release(node);
+            }
+            return curr->m_sentinel;  // key mapping already exists in unique index
+        }
+        if (node == nullptr) {
+            node = (HashNode*)m_nodePool->Alloc();
+            if (node == nullptr) {
+                MOT_REPORT_ERROR(
+                    MOT_ERROR_OOM, "Hash Index Insert", "Failed to allocate node for index %s", m_name.c_str());
+                return nullptr;
+            }
+            node->m_soKey = soKey;
+            node->m_sentinel = sentinel;
+            Key* nodeKey = new (node->GetKey()) Key(m_keyLength, KeyType::PRIMARY_KEY);
+            nodeKey->CpKey(keyBuf, m_keyLength);
+        }
+        node->m_next.store((uintptr_t)curr, std::memory_order_relaxed);
+        uintptr_t expected = (uintptr_t)curr;
+        if (prev->m_next.compare_exchange_strong(
+                expected, (uintptr_t)node, std::memory_order_release, std::memory_order_relaxed)) {
+            break;
+        }
+    }
+
+    inserted = true;
+    uint64_t count = m_count.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t bucketCount = m_bucketCount.load(std::memory_order_relaxed);
+    if (count > bucketCount * MAX_LOAD_FACTOR && bucketCount < (1ULL << (MAX_SEGMENTS - 1))) {
+        // new buckets are linked lazily by the first writer that hashes into them
+        (void)m_bucketCount.compare_exchange_strong(bucketCount, bucketCount << 1, std::memory_order_relaxed);
+    }
+    return nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf);
+
+    HashNode* head = FindBucket(hash & (m_bucketCount.load(std::memory_order_relaxed) - 1));
+    HashNode* node = ListLookup(head, RegularSoKey(hash), keyBuf);
+    return (node != nullptr) ? node->m_sentinel : nullptr;
+}
+
+Sentinel* HashPrimaryIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf);
+    uint64_t soKey = RegularSoKey(hash);
+
+    HashNode* head = GetBucket(hash & (m_bucketCount.load(std::memory_order_relaxed) - 1));
+    if (head == nullptr) {
+        return nullptr;
+    }
+
+    HashNode* prev = nullptr;
+    HashNode* curr = nullptr;
+    while (true) {
+        if (!ListFind(head, soKey, keyBuf, prev, curr)) {
+            return nullptr;
+        }
+        uintptr_t succ = curr->m_next.load(std::memory_order_acquire);
+        if (IsMarked(succ)) {
+            continue;  // concurrently removed, next search unlinks it
+        }
+        // logical delete first, from here on no other remover can claim this node
+        if (!curr->m_next.compare_exchange_strong(
+                succ, succ | MARK_BIT, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+            continue;
+        }
+        break;
+    }
+
+    Sentinel* sentinel = curr->m_sentinel;
+    m_count.fetch_sub(1, std::memory_order_relaxed);
+
+    uintptr_t expected = (uintptr_t)curr;
+    if (prev->m_next.compare_exchange_strong(expected,
+            (uintptr_t)NodePtr(curr->m_next.load(std::memory_order_relaxed)),
+            std::memory_order_acq_rel,
+            std::memory_order_relaxed)) {
+        RetireNode(curr);
+    } else {
+        (void)ListFind(head, soKey, keyBuf, prev, curr);  // unlinks and retires the marked node
+    }
+    return sentinel;
+}
+
+uint64_t HashPrimaryIndex::GetIndexSize()
+{
+    PoolStatsSt stats;
+
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_keyPool->GetStats(stats);
+    uint64_t res = stats.m_poolCount * stats.m_poolGrossSize;
+    uint64_t netto = (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_sentinelPool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_nodePool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    for (uint32_t i = 0; i < MAX_SEGMENTS; ++i) {
+        if (m_segments[i].load(std::memory_order_relaxed) != nullptr) {
+            res += SegmentSize(i) * sizeof(std::atomic<HashNode*>);
+            netto += SegmentSize(i) * sizeof(std::atomic<HashNode*>);
+        }
+    }
+
+    MOT_LOG_INFO("Index %s memory size: gross: %lu, netto: %lu", m_name.c_str(), res, netto);
+    return res;
+}
+
+// Iterator API
+IndexIterator* HashPrimaryIndex::Begin(uint32_t pid, bool passive) const
+{
+    IndexIterator* itr = new (std::nothrow) HashIterator(NextLive(FindBucket(0)));
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create hash iterator");
+    }
+    return itr;
+}
+
+IndexIterator* HashPrimaryIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    const uint8_t* keyBuf = key->GetKeyBuf();
+    uint64_t hash = HashKey(keyBuf);
+
+    HashNode* head = FindBucket(hash & (m_bucketCount.load(std::memory_order_relaxed) - 1));
+    HashNode* node = ListLookup(head, RegularSoKey(hash), keyBuf);
+    found = (node != nullptr);
+
+    IndexIterator* itr = new (std::nothrow) HashIterator(node);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create hash iterator");
+    }
+    return itr;
+}
+}  // namespace MOT
@@ -0,0 +1,380 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Primary index implementation using a lock-free split-ordered hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_PRIMARY_INDEX_H
+#define HASH_PRIMARY_INDEX_H
+
+#include "index.h"
+#include "index_base.h"
+#include "utilities.h"
+#include <atomic>
+
+namespace MOT {
+/**
+ * @class HashPrimaryIndex.
+ * @brief Unordered primary index implementation using a lock-free split-ordered hash table.
+ * @detail All items live in a single lock-free linked list sorted by the bit-reversed hash of their key. Each
+ * bucket points to a dummy node inside that list, so doubling the bucket count never moves an item. Buckets are
+ * kept in a directory of lazily allocated segments, where segment i holds 2^(i-1) buckets. Removed nodes are
+ * first logically deleted by marking their next pointer, then unlinked and handed over to the GC, so concurrent
+ * readers never touch reclaimed memory. The index supports only exact key lookups; ordered scans are not
+ * available and a full scan returns the items in hash order.
+ */
+class HashPrimaryIndex : public Index {
+private:
+    /**
+     * @struct HashNode
+     * @brief A node in the split-ordered list. Regular nodes are followed by their key, so iterators can hand out
+     * a @ref Key like the tree index does.
+     */
+    struct HashNode {
+        /** @var The bit-reversed hash. Odd for regular nodes, even for bucket dummy nodes. */
+        uint64_t m_soKey;
+
+        /** @var The next node pointer. The lowest bit is set when this node is logically deleted. */
+        std::atomic<uintptr_t> m_next;
+
+        /** @var The indexed sentinel, or null for a bucket dummy node. */
+        Sentinel* m_sentinel;
+
+        inline Key* GetKey()
+        {
+            return reinterpret_cast<Key*>(this + 1);
+        }
+
+        inline bool IsDummy() const
+        {
+            return (m_soKey & 1) == 0;
+        }
+    };
+
+    /**
+     * @class HashIterator
+     * @brief A forward-only index iterator implementation for a primary hash index.
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        /**
+         * @brief Constructor.
+         * @param node The node on which the iterator is positioned, or null for an exhausted iterator.
+         */
+        explicit HashIterator(HashNode* node) : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false), m_node(node)
+        {}
+
+        /**
+         * @brief Destructor.
+         */
+        virtual ~HashIterator()
+        {
+            m_node = nullptr;
+        }
+
+        virtual bool IsValid() const
+        {
+            return m_node != nullptr;
+        }
+
+        virtual void Invalidate()
+        {
+            m_node = nullptr;
+        }
+
+        virtual const void* GetKey() const
+        {
+            return m_node->GetKey();
+        }
+
+        virtual Row* GetRow() const
+        {
+            return m_node->m_sentinel->GetData();
+        }
+
+        virtual Sentinel* GetPrimarySentinel() const
+        {
+            return m_node->m_sentinel;
+        }
+
+        /**
+         * @brief Moves the iterator to the next live item in hash order.
+         */
+        virtual void Next()
+        {
+            m_node = HashPrimaryIndex::NextLive(m_node);
+        }
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Not supported by hash index.
+         */
+        virtual void Prev()
+        {
+            MOT_ASSERT(false);
+        }
+
+        virtual bool Equals(const IndexIterator* rhs) const
+        {
+            return m_node == static_cast<const HashIterator*>(rhs)->m_node;
+        }
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         */
+        virtual void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         */
+        virtual void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff)
+        {}
+
+    private:
+        /** @var The current node. */
+        HashNode* m_node;
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HashPrimaryIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_nodePool(nullptr),
+          m_bucketCount(0),
+          m_count(0),
+          m_initialized(false)
+    {
+        for (uint32_t i = 0; i < MAX_SEGMENTS; ++i) {
+            m_segments[i] = nullptr;
+        }
+    }
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HashPrimaryIndex()
+    {
+        if (m_initialized) {
+            m_initialized = false;
+            DestroyPools();
+        }
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    virtual uint64_t GetIndexSize() override;
+
+    /**
+     * @brief Retrieves the number of rows stored in the index.
+     * @return The number of rows stored in the index.
+     */
+    virtual uint64_t GetSize() const
+    {
+        return m_count.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroy all memory pools and init index again.
+     */
+    virtual RC ReInitIndex()
+    {
+        m_initialized = false;
+        DestroyPools();
+
+        return IndexInitImpl(NULL);
+    }
+
+    // Iterator API
+    virtual IndexIterator* Begin(uint32_t pid, bool passive = false) const;
+
+    /**
+     * @brief Searches for an exact key match.
+     * @detail Hash index does not support range search. The matchKey and forward arguments are ignored and the
+     * resulting iterator is invalid if the key was not found.
+     */
+    virtual IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
+
+    /**
+     * @brief Static callback function for deallocate memory from pools.
+     * @param pool Pool to deallocate from.
+     * @param ptr Pointer to allocated memory.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateFromPoolCallBack(void* pool, void* ptr, bool dropIndex)
+    {
+        // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+        ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)pool;
+
+        if (dropIndex == false) {
+            localPoolPtr->Release(ptr);
+        }
+        return localPoolPtr->m_size;
+    }
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var Number of directory segments. Caps the table at 2^(MAX_SEGMENTS-1) buckets. */
+    static constexpr uint32_t MAX_SEGMENTS = 28;
+
+    /** @var Initial number of buckets (must be a power of two). */
+    static constexpr uint64_t INITIAL_BUCKETS = 16;
+
+    /** @var Average bucket chain length that triggers doubling the bucket count. */
+    static constexpr uint64_t MAX_LOAD_FACTOR = 2;
+
+    /** @var Mark bit of a logically deleted node. */
+    static constexpr uintptr_t MARK_BIT = 1;
+
+    /** @var Memory pool for list nodes (both regular and dummy). */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var Bucket directory. Segment i holds 1 bucket for i == 0, otherwise 2^(i-1) buckets. */
+    std::atomic<std::atomic<HashNode*>*> m_segments[MAX_SEGMENTS];
+
+    /** @var Current number of buckets (power of two). */
+    std::atomic<uint64_t> m_bucketCount;
+
+    /** @var Number of items in the index. */
+    std::atomic<uint64_t> m_count;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    void DestroyPools();
+
+    /**
+     * @brief Retrieves the dummy node of a bucket for reading. Falls back to the closest initialized parent
+     * bucket, so readers never modify the list.
+     */
+    HashNode* FindBucket(uint64_t bucket) const;
+
+    /**
+     * @brief Retrieves the dummy node of a bucket, linking it into the list first if needed.
+     * @return The bucket dummy node, or null if out of memory.
+     */
+    HashNode* GetBucket(uint64_t bucket);
+
+    HashNode* InitBucket(uint64_t bucket);
+
+    /**
+     * @brief Locates the position of a node in the list starting at the given head, unlinking any logically
+     * deleted nodes on the way.
+     * @param head The bucket dummy node from which to start.
+     * @param soKey The split-order key to look for.
+     * @param key The key bytes, or null when looking for a dummy node.
+     * @param[out] prev The last node ordered before the searched one.
+     * @param[out] curr The first node ordered at or after the searched one.
+     * @return True if curr matches the searched node exactly.
+     */
+    bool ListFind(HashNode* head, uint64_t soKey, const uint8_t* key, HashNode*& prev, HashNode*& curr);
+
+    /**
+     * @brief Read-only variant of @ref ListFind() that skips deleted nodes without unlinking them.
+     */
+    HashNode* ListLookup(HashNode* head, uint64_t soKey, const uint8_t* key) const;
+
+    void RetireNode(HashNode* node);
+
+    inline int CompareNode(HashNode* node, uint64_t soKey, const uint8_t* key) const
+    {
+        if (node->m_soKey != soKey) {
+            return (node->m_soKey < soKey) ? -1 : 1;
+        }
+        if (key == nullptr) {
+            return 0;
+        }
+        return memcmp(node->GetKey()->GetKeyBuf(), key, m_keyLength);
+    }
+
+    uint64_t HashKey(const uint8_t* key) const;
+
+    static HashNode* NextLive(HashNode* node);
+
+    static inline HashNode* NodePtr(uintptr_t next)
+    {
+        return reinterpret_cast<HashNode*>(next & ~MARK_BIT);
+    }
+
+    static inline bool IsMarked(uintptr_t next)
+    {
+        return (next & MARK_BIT) != 0;
+    }
+
+    static inline uint64_t ReverseBits(uint64_t value)
+    {
+        value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+        value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+        value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        return __builtin_bswap64(value);
+    }
+
+    static inline uint64_t RegularSoKey(uint64_t hash)
+    {
+        return ReverseBits(hash | 0x8000000000000000ULL);
+    }
+
+    static inline uint64_t DummySoKey(uint64_t bucket)
+    {
+        return ReverseBits(bucket);
+    }
+
+    static inline uint32_t BucketSegment(uint64_t bucket)
+    {
+        return (bucket == 0) ? 0 : (64 - __builtin_clzll(bucket));
+    }
+
+    static inline uint64_t SegmentSize(uint32_t segment)
+    {
+        return (segment == 0) ? 1 : (1ULL << (segment - 1));
+    }
+
+    static inline uint64_t BucketOffset(uint64_t bucket, uint32_t segment)
+    {
+        return (segment == 0) ? 0 : (bucket - (1ULL << (segment - 1)));
+    }
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_PRIMARY_INDEX_H */
@@ -204,6 +204,15 @@ public:
         return m_indexingMethod;
     }
 
+    /**
+     * @brief Queries whether the index keeps its keys ordered, i.e. supports range scans and ordered iteration.
+     * @return False for hash indexes, which support exact key lookups only.
+     */
+    inline bool IsOrdered() const
+    {
+        return m_indexingMethod == IndexingMethod::INDEXING_METHOD_TREE;
+    }
+
     /**
      * @brief Retrieves the number of rows stored in the index. This may be an estimation.
      * @return The number of rows stored in the index.
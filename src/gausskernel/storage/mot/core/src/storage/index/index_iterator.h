@@ -139,6 +139,33 @@ public:
      */
     virtual Sentinel* GetPrimarySentinel() const = 0;
 
+    /**
+     * @brief Retrieves the sentinels of a batch of items, starting with the currently iterated item, and moves the
+     * iterator past them.
+     * @detail The retrieved sentinels are those returned by @ref GetPrimarySentinel(). Implementations may prefetch
+     * the index nodes holding the next batch while retrieving the current one.
+     * @param[out] sentinels Receives the sentinels.
+     * @param maxCount The maximum number of sentinels to retrieve.
+     * @param endKey Optional key bounding the scan. The iterator stops on the first item beyond it, without
+     * retrieving it.
+     * @param endKeyLength The number of key bytes to compare with the end key.
+     * @param forward Specifies whether items beyond the end key are greater (forward scan) or smaller than it.
+     * @return The number of retrieved sentinels.
+     */
+    virtual uint32_t NextBatch(
+        Sentinel** sentinels, uint32_t maxCount, const Key* endKey, uint32_t endKeyLength, bool forward)
+    {
+        uint32_t count = 0;
+        while (count < maxCount && IsValid()) {
+            if (endKey != nullptr && IsBeyondEndKey((const Key*)GetKey(), endKey, endKeyLength, forward)) {
+                break;
+            }
+            sentinels[count++] = GetPrimarySentinel();
+            Next();
+        }
+        return count;
+    }
+
 protected:
     /**
      * @brief Constructs a builtin end or pre-begin iterator.
@@ -157,6 +184,18 @@ protected:
     IndexIterator(IndexIterator&& other) : m_type(other.m_type), m_bid(other.m_bid), m_valid(other.m_valid)
     {}
 
+    /**
+     * @brief Queries whether a key lies beyond the end key of a scan.
+     */
+    static inline bool IsBeyondEndKey(const Key* key, const Key* endKey, uint32_t endKeyLength, bool forward)
+    {
+        if (key == nullptr) {
+            return false;
+        }
+        int cmpRes = memcmp(key->GetKeyBuf(), endKey->GetKeyBuf(), endKeyLength);
+        return forward ? (cmpRes > 0) : (cmpRes < 0);
+    }
+
     /** @var The iterator type. */
     IteratorType m_type;
 
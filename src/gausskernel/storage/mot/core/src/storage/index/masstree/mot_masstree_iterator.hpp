@@ -223,6 +223,20 @@ private:
         return m_state;
     }
 
+    /**
+     * @brief Prefetches the leaf the scan visits after the given one.
+     * @param n The leaf the scan is currently visiting.
+     */
+    static inline void PrefetchSiblingLeaf(const leaf<P>* n)
+    {
+        const leaf<P>* sibling = FORWARD ? n->safe_next() : n->prev_;
+        if (sibling != nullptr) {
+            for (size_t offset = 0; offset < sizeof(leaf<P>); offset += CACHE_LINE_SIZE) {
+                MOT::Prefetch((const char*)sibling + offset);
+            }
+        }
+    }
+
 public:
     /**
      * @brief Default constructor.
@@ -293,6 +307,35 @@ public:
         delete this;
     }
 
+    /**
+     * @brief Retrieves the values of a batch of keys, starting with the current one, and moves the iterator past
+     * them.
+     * @detail Whenever the scan enters a new leaf, the leaf after it is prefetched, so it is already cached when the
+     * scan gets there.
+     * @param[out] values Receives the values.
+     * @param maxCount The maximum number of values to retrieve.
+     * @param isBeyondEnd Predicate receiving the current search key. Returns true if the scan should stop before it.
+     * @return The number of retrieved values.
+     */
+    template <typename F>
+    uint32_t NextBatch(void** values, uint32_t maxCount, const F& isBeyondEnd)
+    {
+        uint32_t count = 0;
+        const leaf<P>* currLeaf = nullptr;
+        while (count < maxCount && !m_done) {
+            if (isBeyondEnd(static_cast<const MOT::Key*>(m_searchKey))) {
+                break;
+            }
+            if (m_stack.n_ != currLeaf) {
+                currLeaf = m_stack.n_;
+                PrefetchSiblingLeaf(currLeaf);
+            }
+            values[count++] = reinterpret_cast<void*>(m_entry.value());
+            ++(*this);
+        }
+        return count;
+    }
+
     /** @brief Getter for searchKey pointer
      *  @return SearchKey (if valid) or null if not.
      */
@@ -157,6 +157,24 @@ private:
             ++(*m_itr);
         }
 
+        /**
+         * @brief Retrieves the sentinels of a batch of items, prefetching the next leaf of the tree on the way.
+         * @param[out] sentinels Receives the sentinels.
+         * @param maxCount The maximum number of sentinels to retrieve.
+         * @param endKey Optional key bounding the scan.
+         * @param endKeyLength The number of key bytes to compare with the end key.
+         * @param forward Specifies whether items beyond the end key are greater or smaller than it.
+         * @return The number of retrieved sentinels.
+         */
+        virtual uint32_t NextBatch(
+            Sentinel** sentinels, uint32_t maxCount, const Key* endKey, uint32_t endKeyLength, bool forward)
+        {
+            return m_itr->NextBatch(
+                reinterpret_cast<void**>(sentinels), maxCount, [endKey, endKeyLength, forward](const Key* key) {
+                    return endKey != nullptr && IsBeyondEndKey(key, endKey, endKeyLength, forward);
+                });
+        }
+
         /**
          * @brief Moves backwards the iterator to the previous item.
          * @detail Does not supported yet.
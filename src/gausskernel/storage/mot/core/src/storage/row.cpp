@@ -67,6 +67,34 @@ RC Row::GetRow(AccessType type, TxnAccess* txn, Row* row, TransactionId& lastTid
     return this->m_rowHeader.GetLocalCopy(txn, type, row, this, lastTid);
 }
 
+RC Row::GetSnapshotRow(uint64_t snapshotCsn, Row* row, uint32_t& chainLength) const
+{
+    Row* version = nullptr;
+    row->m_table = GetTable();
+    chainLength = 0;
+    uint64_t v = m_rowHeader.GetSnapshotCopy(snapshotCsn, row, this, version);
+    if ((v & CSN_BITS) <= snapshotCsn) {
+        return ((v & ABSENT_BIT) == 0) ? RC_OK : RC_LOCAL_ROW_NOT_FOUND;
+    }
+
+    // Older versions are immutable, and each one that a snapshot might need was retired to the GC only after the
+    // snapshot was taken, so no locking is required here
+    while (version != nullptr) {
+        chainLength++;
+        if (version->GetCommitSequenceNumber() <= snapshotCsn) {
+            if (version->IsAbsentRow()) {
+                return RC_LOCAL_ROW_NOT_FOUND;
+            }
+            row->Copy(version);
+            return RC_OK;
+        }
+        version = version->m_prevVersion;
+    }
+
+    // The row was created after the snapshot
+    return RC_LOCAL_ROW_NOT_FOUND;
+}
+
 Row* Row::CreateCopy()
 {
     Row* row = m_table->CreateNewRow();
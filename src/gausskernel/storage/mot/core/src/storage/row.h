@@ -41,6 +41,7 @@ namespace MOT {
 class OccTransactionManager;
 class CheckpointWorkerPool;
 class RecoveryOps;
+class CompactionManager;
 
 /**
  * @class Row
@@ -268,6 +269,27 @@ public:
      */
     RC GetRow(AccessType type, TxnAccess* txn, Row* row, TransactionId& lastTid) const;
 
+    /**
+     * @brief Reads the version of the row that was committed at the given snapshot.
+     * @detail Walks the chain of older versions kept for snapshot reads until a version with a commit sequence
+     * number not greater than the snapshot is found.
+     * @param snapshotCsn The commit sequence number of the snapshot.
+     * @param[out] row Receives a copy of the visible version.
+     * @param[out] chainLength Receives the number of older versions visited.
+     * @return Return code denoting the execution result. RC_LOCAL_ROW_NOT_FOUND is returned when the row was not
+     * visible to the snapshot.
+     */
+    RC GetSnapshotRow(uint64_t snapshotCsn, Row* row, uint32_t& chainLength) const;
+
+    /**
+     * @brief Retrieves the previous version of the row kept for snapshot reads.
+     * @return The previous row version, or null if there is none.
+     */
+    inline Row* GetPrevVersion() const
+    {
+        return m_prevVersion;
+    }
+
     /**
      * @brief Class specific in-place new operator.
      * @param size Object size in bytes.
@@ -586,6 +608,9 @@ protected:
     /** @var A flag to identify if row is in recover mode state. */
     bool m_twoPhaseRecoverMode = false;
 
+    /** @var The previous committed version of the row, kept for snapshot reads and reclaimed by the GC. */
+    Row* m_prevVersion = nullptr;
+
     /** @var The raw buffer holding the row data. Starts at the end of the class
      * Must be last member */
     uint8_t m_data[0];
@@ -610,6 +635,7 @@ protected:
     friend Index;
     friend RecoveryOps;
     friend Table;
+    friend CompactionManager;
 
     DECLARE_CLASS_LOGGER()
 };
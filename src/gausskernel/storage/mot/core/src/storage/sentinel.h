@@ -64,7 +64,12 @@ public:
         S_STATUS_MASK = ~S_STATUS_BITS
     };
 
-    enum StableRowFlags : uint64_t { STABLE_BIT = 1UL << 63, PRE_ALLOC_BIT = 1UL << 62 };
+    enum StableRowFlags : uint64_t {
+        STABLE_BIT = 1UL << 63,
+        PRE_ALLOC_BIT = 1UL << 62,
+        DELTA_BIT = 1UL << 61,
+        DELTA_NA_BIT = 1UL << 60
+    };
 
     inline bool IsCommited() const
     {
@@ -322,6 +327,27 @@ public:
         }
     }
 
+    /**
+     * @brief Retrieves the delta checkpoint status of the row.
+     * @param naBit The NotAvailable bit of the checkpoint the change belongs to.
+     * @return True if the row changed since it was last written by a checkpoint.
+     */
+    inline bool GetDeltaStatus(bool naBit) const
+    {
+        uint64_t bit = naBit ? DELTA_NA_BIT : DELTA_BIT;
+        return (m_stable & bit) == bit;
+    }
+
+    inline void SetDeltaStatus(bool naBit, bool val)
+    {
+        uint64_t bit = naBit ? DELTA_NA_BIT : DELTA_BIT;
+        if (val == true) {
+            m_stable |= bit;
+        } else {
+            m_stable &= ~bit;
+        }
+    }
+
     void SetLockOwner(uint64_t tid)
     {
         MOT_ASSERT(m_status & S_LOCK_BIT);
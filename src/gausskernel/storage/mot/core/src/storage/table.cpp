@@ -596,6 +596,73 @@ Row* Table::RemoveKeyFromIndex(Row* row, Sentinel* sentinel, uint64_t tid, GcMan
     return OutputRow;
 }
 
+void Table::AddDeletedKey(bool naBit, const Key* key)
+{
+    std::lock_guard<spin_lock> lock(m_deletedKeysLock);
+    std::vector<uint8_t>& keys = m_deletedKeys[naBit];
+    keys.insert(keys.end(), key->GetKeyBuf(), key->GetKeyBuf() + key->GetKeyLength());
+}
+
+void Table::TakeDeletedKeys(bool naBit, std::vector<uint8_t>& keys)
+{
+    keys.clear();
+    std::lock_guard<spin_lock> lock(m_deletedKeysLock);
+    keys.swap(m_deletedKeys[naBit]);
+}
+
+void Table::DeferKeyRemoval(Sentinel* sentinel, Row* row, GcEpochType epoch, uint64_t csn)
+{
+    std::lock_guard<spin_lock> lock(m_deferredKeysLock);
+    m_deferredKeys.push_back({sentinel, row, epoch, csn});
+}
+
+RC Table::GetDeferredKeySnapshotRow(const Sentinel* sentinel, uint64_t snapshotCsn, Row* row)
+{
+    uint32_t chainLength = 0;
+    std::lock_guard<spin_lock> lock(m_deferredKeysLock);
+    // Keys are queued in the order of their deletes, so the first row deleted after the snapshot held the key
+    for (const DeferredKey& deferred : m_deferredKeys) {
+        if (deferred.m_sentinel == sentinel && deferred.m_csn > snapshotCsn &&
+            deferred.m_row->GetSnapshotRow(snapshotCsn, row, chainLength) == RC_OK) {
+            return RC_OK;
+        }
+    }
+    return RC_LOCAL_ROW_NOT_FOUND;
+}
+
+void Table::RemoveDeferredKeys(GcManager* gc, uint64_t tid, bool force)
+{
+    DeferredKey deferred;
+    while (true) {
+        {
+            std::lock_guard<spin_lock> lock(m_deferredKeysLock);
+            if (m_deferredKeys.empty()) {
+                return;
+            }
+            deferred = m_deferredKeys.front();
+            // Transactions that started after the delete also took their snapshot after it
+            if (!force && deferred.m_epoch >= g_gcActiveEpoch) {
+                break;
+            }
+            m_deferredKeys.pop_front();
+        }
+
+        // The row is shared by all the keys of a delete, and the primary key is queued last
+        bool ownsRow = (deferred.m_sentinel == nullptr || deferred.m_sentinel->IsPrimaryIndex());
+        if (deferred.m_sentinel != nullptr) {
+            // The sentinel stays pinned by the reference count of the delete until now
+            (void)RemoveKeyFromIndex(deferred.m_row, deferred.m_sentinel, tid, gc);
+        }
+        if (ownsRow) {
+            gc->GcRecordObject(
+                GetPrimaryIndex()->GetIndexId(), deferred.m_row, nullptr, Row::RowDtor, ROW_SIZE_FROM_POOL(this));
+        }
+    }
+
+    // The global epoch is advanced only under GC memory pressure, so a delete-only workload must move it on
+    gc->SetGlobalEpoch(GetGlobalEpoch() + 1);
+}
+
 Row* Table::CreateNewRow()
 {
     Row* row = m_rowPool->Alloc<Row>(this);
@@ -26,11 +26,13 @@
 #define MOT_TABLE_H
 
 #include <atomic>
+#include <deque>
 #include <map>
 #include <string>
 #include <iostream>
 #include <memory>
 #include <pthread.h>
+#include <vector>
 #include "global.h"
 #include "sentinel.h"
 #include "surrogate_key_generator.h"
@@ -41,6 +43,7 @@
 #include "serializable.h"
 #include "object_pool.h"
 #include "mm_gc_manager.h"
+#include "spin_lock.h"
 
 namespace MOT {
 class Row;
@@ -48,6 +51,7 @@ class TxnManager;
 class TxnInsertAction;
 class RecoveryManager;
 class TxnDDLAccess;
+class CompactionManager;
 
 /**
  * @class Table
@@ -67,6 +71,7 @@ class alignas(CL_SIZE) Table : public Serializable {
     friend MOT::MOTIndexArr;
     friend RecoveryManager;
     friend TxnDDLAccess;
+    friend CompactionManager;
 
 public:
     static void deleteTablePtr(Table* t)
@@ -775,6 +780,61 @@ public:
         return m_rowCount;
     }
 
+    /**
+     * @brief Records the primary key of a deleted row for the next delta checkpoint.
+     * @param naBit The NotAvailable bit of the checkpoint the delete belongs to.
+     * @param key The primary key of the deleted row.
+     */
+    void AddDeletedKey(bool naBit, const Key* key);
+
+    /**
+     * @brief Retrieves and clears the primary keys of the rows deleted for a checkpoint.
+     * @param naBit The NotAvailable bit of the checkpoint.
+     * @param[out] keys The deleted keys, one after the other, each of the primary index key length.
+     */
+    void TakeDeletedKeys(bool naBit, std::vector<uint8_t>& keys);
+
+    /**
+     * @brief Defers the removal of a deleted key from its index, while snapshot readers may still need it.
+     * @param sentinel The index sentinel of the deleted key, or null to only release the row.
+     * @param row A copy of the deleted row used to build the key, owned by the table from now on.
+     * @param epoch The GC epoch of the delete. The key is removed once no active transaction is older.
+     * @param csn The commit sequence number of the delete.
+     */
+    void DeferKeyRemoval(Sentinel* sentinel, Row* row, GcEpochType epoch, uint64_t csn);
+
+    /**
+     * @brief Removes the deferred deleted keys that no snapshot reader needs anymore.
+     * @param gc The GC session used for the removal.
+     * @param tid The identifier of the removing thread.
+     * @param force Specifies whether to remove all the deferred keys regardless of their epoch. Used only when
+     * no transaction can access the table concurrently.
+     */
+    void RemoveDeferredKeys(GcManager* gc, uint64_t tid, bool force);
+
+    /**
+     * @brief Reads the version of a row that held a deleted unique secondary key at a snapshot, after another row
+     * took the key over.
+     * @param sentinel The unique secondary index sentinel of the key.
+     * @param snapshotCsn The commit sequence number of the snapshot.
+     * @param row Receives a copy of the visible version.
+     * @return RC_OK if a deleted row held the key at the snapshot, otherwise RC_LOCAL_ROW_NOT_FOUND.
+     */
+    RC GetDeferredKeySnapshotRow(const Sentinel* sentinel, uint64_t snapshotCsn, Row* row);
+
+    /**
+     * @brief Forces the next checkpoint to write a full image of the table, after its whole content changed.
+     */
+    inline void SetFullCheckpointRequired(bool val)
+    {
+        m_fullCheckpointRequired = val;
+    }
+
+    inline bool IsFullCheckpointRequired() const
+    {
+        return m_fullCheckpointRequired;
+    }
+
     /**
      * @brief Returns table size in memory
      */
@@ -932,6 +992,29 @@ private:
 
     uint32_t m_rowCount = 0;
 
+    /** @var Keys of rows deleted since the last checkpoint, per checkpoint NotAvailable bit. */
+    std::vector<uint8_t> m_deletedKeys[2];
+
+    /** @var Guards the deleted keys. */
+    spin_lock m_deletedKeysLock;
+
+    /** @struct A deleted key kept in its index for snapshot readers. */
+    struct DeferredKey {
+        Sentinel* m_sentinel;
+        Row* m_row;
+        GcEpochType m_epoch;
+        uint64_t m_csn;
+    };
+
+    /** @var Deleted keys waiting for removal, in the order of their deletes. */
+    std::deque<DeferredKey> m_deferredKeys;
+
+    /** @var Guards the deferred keys. */
+    spin_lock m_deferredKeysLock;
+
+    /** @var Specifies whether the next checkpoint must write a full image of the table. */
+    volatile bool m_fullCheckpointRequired = false;
+
     DECLARE_CLASS_LOGGER();
 
 public:
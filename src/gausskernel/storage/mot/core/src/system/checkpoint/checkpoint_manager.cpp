@@ -48,6 +48,9 @@ CheckpointManager::CheckpointManager()
       m_numCpTasks(0),
       m_numThreads(GetGlobalConfiguration().m_checkpointWorkers),
       m_cpSegThreshold(GetGlobalConfiguration().m_checkpointSegThreshold),
+      m_enableDeltaCheckpoint(GetGlobalConfiguration().m_enableDeltaCheckpoint),
+      m_consolidationInterval(GetGlobalConfiguration().m_checkpointConsolidationInterval),
+      m_deltaCheckpoint(false),
       m_stopFlag(false),
       m_checkpointEnded(false),
       m_checkpointError(0),
@@ -181,6 +184,12 @@ bool CheckpointManager::BeginCheckpoint()
     UnlockAndClearTables(m_tasksList);
     m_numCpTasks = 0;
 
+    // The changes written by a failed checkpoint are no longer tracked, so the next one must be a full one
+    if (m_errorSet) {
+        m_tableImages.clear();
+    }
+    m_newTableImages.clear();
+
     // Ensure that there are no transactions that started in Checkpoint CAPTURE
     // phase that are not yet completed before moving to REST phase
     WaitPrevPhaseCommittedTxnComplete();
@@ -219,6 +228,9 @@ bool CheckpointManager::Abort()
         UnlockAndClearTables(m_finishedTasks);
         m_numCpTasks = 0;
 
+        // The bits are swapped anyway, so the changes tracked for this checkpoint are lost
+        m_tableImages.clear();
+
         // Move to rest
         m_lock.WrLock();
         MoveToNextPhase();
@@ -435,6 +447,22 @@ void CheckpointManager::ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType
             MOT_LOG_ERROR("Unknown transaction start phase: %s", CheckpointManager::PhaseToString(startPhase));
             MOT_ASSERT(false);
     }
+
+    if (m_enableDeltaCheckpoint && type != RD_FOR_UPDATE) {
+        // Changes committed from the CAPTURE phase on belong to the next checkpoint
+        bool naBit = (startPhase == CAPTURE || startPhase == COMPLETE) ? !txnMan->m_checkpointNABit
+                                                                        : txnMan->m_checkpointNABit;
+        if (type == DEL) {
+            MaxKey key;
+            Table* table = origRow->GetTable();
+            Index* index = table->GetPrimaryIndex();
+            key.InitKey(index->GetKeyLength());
+            index->BuildKey(table, origRow, &key);
+            table->AddDeletedKey(naBit, &key);
+        } else {
+            s->SetDeltaStatus(naBit, true);
+        }
+    }
 }
 
 void CheckpointManager::FillTasksQueue()
@@ -447,6 +475,25 @@ void CheckpointManager::FillTasksQueue()
     GetTableManager()->AddTablesToList(m_tasksList);
     m_numCpTasks = m_tasksList.size();
     m_mapfileInfo.clear();
+
+    // Changes replayed during recovery are not tracked, so deltas are written only once recovery is over
+    m_deltaCheckpoint = m_enableDeltaCheckpoint && !MOTEngine::GetInstance()->IsRecovering();
+    if (!m_deltaCheckpoint) {
+        m_tableImages.clear();
+    }
+    m_newTableImages.clear();
+
+    if (m_enableDeltaCheckpoint) {
+        std::vector<uint8_t> staleKeys;
+        for (Table* table : m_tasksList) {
+            // Keys left from an aborted checkpoint, the table is written in full anyway
+            table->TakeDeletedKeys(m_availableBit, staleKeys);
+            if (table->IsFullCheckpointRequired()) {
+                table->SetFullCheckpointRequired(false);
+                (void)m_tableImages.erase(table->GetTableId());
+            }
+        }
+    }
     MOT_LOG_DEBUG("CheckpointManager::fillTasksQueue:: got %d tasks", m_tasksList.size());
 }
 
@@ -462,7 +509,34 @@ void CheckpointManager::UnlockAndClearTables(std::list<Table*>& tables)
     tables.clear();
 }
 
-void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
+bool CheckpointManager::GetTableImage(Table* table, CheckpointTableImage& image)
+{
+    if (!m_deltaCheckpoint) {
+        return false;
+    }
+
+    // m_tableImages is not modified while the checkpoint workers are running
+    auto it = m_tableImages.find(table->GetTableId());
+    if (it == m_tableImages.end()) {
+        return false;
+    }
+
+    const CheckpointTableImage& prevImage = it->second;
+    if (prevImage.m_exId != table->GetTableExId() || prevImage.m_tupleSize != table->GetTupleSize() ||
+        prevImage.m_fieldCount != table->GetFieldCount()) {
+        return false;
+    }
+
+    // Consolidate the deltas into a new full image once recovering them costs more than the image itself
+    if (prevImage.m_deltaMaxSegIds.size() >= m_consolidationInterval || prevImage.m_deltaOps >= prevImage.m_baseOps) {
+        return false;
+    }
+
+    image = prevImage;
+    return true;
+}
+
+void CheckpointManager::TaskDone(Table* table, const CheckpointTableImage& image, bool success)
 {
     MOT_ASSERT(table);
     if (success) { /* only successful tasks are added to the map file */
@@ -473,11 +547,18 @@ void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
         MapFileEntry* entry = new (std::nothrow) MapFileEntry();
         if (entry != nullptr) {
             entry->m_tableId = table->GetTableId();
-            entry->m_maxSegId = numSegs;
-            MOT_LOG_DEBUG("TaskDone %lu: %u %u segs", m_inProgressId, entry->m_tableId, numSegs);
+            entry->m_maxSegId = image.m_maxSegId;
+            MOT_LOG_DEBUG("TaskDone %lu: %u %u segs, %u deltas",
+                m_inProgressId,
+                entry->m_tableId,
+                image.m_maxSegId,
+                (uint32_t)image.m_deltaMaxSegIds.size());
             std::lock_guard<std::mutex> guard(m_tasksMutex);
             m_mapfileInfo.push_back(entry);
             m_finishedTasks.push_back(table);
+            if (m_deltaCheckpoint) {
+                m_newTableImages[entry->m_tableId] = image;
+            }
         } else {
             OnError(CheckpointWorkerPool::ErrCodes::MEMORY, "Failed to allocate map file entry");
             return;
@@ -507,6 +588,11 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    if (m_deltaCheckpoint && !CreateDeltaMap()) {
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create delta map file");
+        return;
+    }
+
     if (!CreateTpcRecoveryFile()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create 2pc recovery file");
         return;
@@ -540,6 +626,9 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    // The next checkpoint writes its deltas on top of this one
+    m_tableImages.swap(m_newTableImages);
+
     RemoveOldCheckpoints(m_inProgressId);
     MOT_LOG_INFO("Checkpoint [%lu] completed", m_inProgressId);
 }
@@ -716,6 +805,81 @@ bool CheckpointManager::CreateCheckpointMap()
     return ret;
 }
 
+bool CheckpointManager::CreateDeltaMap()
+{
+    int fd = -1;
+    std::string fileName;
+    std::string workingDir;
+    bool ret = false;
+
+    do {
+        if (!CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+            break;
+        }
+
+        uint64_t numEntries = 0;
+        for (auto& image : m_newTableImages) {
+            numEntries += image.second.m_deltaMaxSegIds.size();
+        }
+
+        // No delta map file means there are only full images
+        if (numEntries == 0) {
+            ret = true;
+            break;
+        }
+
+        CheckpointUtils::MakeDeltaMapFilename(fileName, workingDir, m_inProgressId);
+        if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+            MOT_LOG_ERROR(
+                "CreateDeltaMap: failed to create file '%s' - %d - %s", fileName.c_str(), errno, gs_strerror(errno));
+            break;
+        }
+
+        CheckpointUtils::MapFileHeader mapFileHeader{CP_MGR_MAGIC, numEntries};
+        size_t wrStat = CheckpointUtils::WriteFile(fd, (char*)&mapFileHeader, sizeof(CheckpointUtils::MapFileHeader));
+        if (wrStat != sizeof(CheckpointUtils::MapFileHeader)) {
+            MOT_LOG_ERROR("CreateDeltaMap: failed to write delta map file's header (%d) %d %s",
+                wrStat,
+                errno,
+                gs_strerror(errno));
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        bool entriesWritten = true;
+        for (auto it = m_newTableImages.begin(); entriesWritten && it != m_newTableImages.end(); ++it) {
+            const CheckpointTableImage& image = it->second;
+            for (uint32_t i = 0; i < image.m_deltaMaxSegIds.size(); i++) {
+                DeltaMapFileEntry entry{it->first, i + 1, image.m_deltaMaxSegIds[i]};
+                if (CheckpointUtils::WriteFile(fd, (char*)&entry, sizeof(DeltaMapFileEntry)) !=
+                    sizeof(DeltaMapFileEntry)) {
+                    MOT_LOG_ERROR("CreateDeltaMap: failed to write delta map file entry");
+                    entriesWritten = false;
+                    break;
+                }
+            }
+        }
+
+        if (!entriesWritten) {
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaMap: failed to flush delta map file");
+            break;
+        }
+
+        if (CheckpointUtils::CloseFile(fd)) {
+            MOT_LOG_ERROR("CreateDeltaMap: failed to close delta map file");
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    return ret;
+}
+
 void CheckpointManager::OnError(int errCode, const char* errMsg, const char* optionalMsg)
 {
     m_stopFlag = true;
@@ -33,6 +33,7 @@
 #include "txn.h"
 #include "txn_access.h"
 #include <queue>
+#include <map>
 #include "checkpoint_worker.h"
 #include "checkpoint_ctrlfile.h"
 #include "spin_lock.h"
@@ -111,12 +112,24 @@ public:
 
     /**
      * @brief Checkpoint task completion callback
-     * @param checkpointId The checkpoint's id.
      * @param table The table's pointer.
-     * @param numSegs number of segments written.
+     * @param image The table's files in this checkpoint.
      * @param success Indicates a success or a failure.
      */
-    virtual void TaskDone(Table* table, uint32_t numSegs, bool success);
+    virtual void TaskDone(Table* table, const CheckpointTableImage& image, bool success);
+
+    /**
+     * @brief Retrieves the table's files in the previous checkpoint, to write a delta on top of them.
+     * @param table The table's pointer.
+     * @param image The returned table's files.
+     * @return False if a full image of the table should be written.
+     */
+    virtual bool GetTableImage(Table* table, CheckpointTableImage& image);
+
+    bool IsDeltaCheckpointEnabled() const
+    {
+        return m_enableDeltaCheckpoint;
+    }
 
     virtual bool ShouldStop() const
     {
@@ -199,6 +212,12 @@ public:
         uint32_t m_maxSegId;
     };
 
+    struct DeltaMapFileEntry {
+        uint32_t m_tableId;
+        uint32_t m_deltaId;
+        uint32_t m_maxSegId;
+    };
+
 private:
     RwLock m_lock;
 
@@ -235,6 +254,21 @@ private:
     // Checkpoint segments size threshold
     uint32_t m_cpSegThreshold;
 
+    // Write only the rows changed since the previous checkpoint when possible
+    bool m_enableDeltaCheckpoint;
+
+    // Maximum number of deltas on top of a full table image
+    uint32_t m_consolidationInterval;
+
+    // Indicates the current checkpoint may write deltas
+    bool m_deltaCheckpoint;
+
+    // Table files of the last completed checkpoint, by table id
+    std::map<uint32_t, CheckpointTableImage> m_tableImages;
+
+    // Table files of the current checkpoint, by table id
+    std::map<uint32_t, CheckpointTableImage> m_newTableImages;
+
     // Signal working threads to exit
     volatile bool m_stopFlag;
 
@@ -372,6 +406,13 @@ private:
      */
     bool CreateCheckpointMap();
 
+    /**
+     * @brief Creates the checkpoint's delta map file - where the
+     * deltas of each table are listed
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateDeltaMap();
+
     /**
      * @brief Saves the in-process transaction data for 2pc recovery
      * purposes during the checkpoint.
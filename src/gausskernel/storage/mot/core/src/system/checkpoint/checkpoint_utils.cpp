@@ -92,6 +92,16 @@ bool OpenFileRead(std::string fileName, int& fd)
     return (fd != -1);
 }
 
+bool LinkFile(std::string srcName, std::string dstName)
+{
+    if (link(srcName.c_str(), dstName.c_str()) != 0) {
+        MOT_LOG_WARN(
+            "Failed to link file %s to %s (%d:%s)", srcName.c_str(), dstName.c_str(), errno, gs_strerror(errno));
+        return false;
+    }
+    return true;
+}
+
 int CloseFile(int fd)
 {
     int rc = close(fd);
@@ -84,6 +84,14 @@ bool OpenFileWrite(std::string fileName, int& fd);
  */
 bool OpenFileRead(std::string fileName, int& fd);
 
+/**
+ * @brief A wrapper function that creates a hard link to a file.
+ * @param srcName The existing file name.
+ * @param dstName The new file name.
+ * @return Boolean value denoting success or failure.
+ */
+bool LinkFile(std::string srcName, std::string dstName);
+
 /**
  * @brief a wrapper function that closes a file fd.
  * @param fd The file descriptor to close
@@ -174,6 +182,9 @@ static const char* mdFileSuffix = ".md";
 // Map file suffix
 static const char* mapFileSuffix = ".map";
 
+// Delta map file suffix
+static const char* deltaMapFileSuffix = ".dmap";
+
 // TPC file suffix
 static const char* tpcFileSuffix = ".tpc";
 
@@ -261,6 +272,40 @@ inline void MakeCpFilename(uint64_t tableId, std::string& fileName, std::string&
     fileName.append(cpFileSuffix);
 }
 
+/**
+ * @brief Creates a delta checkpoint seg filename
+ * @param tableId The tabled id that this file contains.
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param deltaId The delta number, starting from 1.
+ * @param seg The segment number. Segment 0 holds the deleted keys.
+ */
+inline void MakeDeltaFilename(
+    uint64_t tableId, std::string& fileName, std::string& workingDir, uint32_t deltaId, int seg = 0)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append("tab_");
+    fileName.append(std::to_string(tableId));
+    fileName.append("_d");
+    fileName.append(std::to_string(deltaId));
+    fileName.append("_");
+    fileName.append(std::to_string(seg));
+    fileName.append(cpFileSuffix);
+}
+
+/**
+ * @brief Creates a delta map filename according to the checkpoint id
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param cpId The checkpoint id.
+ */
+inline void MakeDeltaMapFilename(std::string& fileName, std::string& workingDir, uint64_t cpId)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append(std::to_string(cpId));
+    fileName.append(deltaMapFileSuffix);
+}
+
 /**
  * @brief Creates a checkpoint table metadata filename
  * @param tableId The tabled id that this file contains.
@@ -27,6 +27,7 @@
 #include <sys/types.h>
 #include <sys/time.h>
 #include <time.h>
+#include <unistd.h>
 #include "checkpoint_utils.h"
 #include "checkpoint_worker.h"
 #include "checkpoint_manager.h"
@@ -124,7 +125,8 @@ bool CheckpointWorkerPool::Write(Buffer* buffer, Row* row, int fd)
     return true;
 }
 
-int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted)
+int CheckpointWorkerPool::Checkpoint(
+    Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, bool delta)
 {
     Row* mainRow = sentinel->GetData();
     Row* stableRow = nullptr;
@@ -157,6 +159,10 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
     bool statusBit = sentinel->GetStableStatus();
     bool deleted = !sentinel->IsCommited(); /* this currently indicates if the row is deleted or not */
 
+    /* rows that did not change since the previous checkpoint are already in its files */
+    bool changed = !delta || sentinel->GetDeltaStatus(m_na);
+    sentinel->SetDeltaStatus(m_na, false);
+
     MOT_ASSERT(sentinel->GetStablePreAllocStatus() == false);
 
     do {
@@ -165,14 +171,14 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                 break;
             }
 
-            if (!Write(buffer, stableRow, fd)) {
+            if (changed && !Write(buffer, stableRow, fd)) {
                 wrote = -1;
             } else {
                 if (isDeleted == false) {
                     CheckpointUtils::DestroyStableRow(stableRow);
                     sentinel->SetStable(nullptr);
                 }
-                wrote = 1;
+                wrote = changed ? 1 : 0;
             }
             break;
         } else { /* no stable version */
@@ -182,7 +188,9 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                     break;
                 }
                 sentinel->SetStableStatus(!m_na);
-                if (!Write(buffer, mainRow, fd)) {
+                if (!changed) {
+                    wrote = 0;
+                } else if (!Write(buffer, mainRow, fd)) {
                     wrote = -1;  // we failed to write, set error
                 } else {
                     wrote = 1;
@@ -225,7 +233,17 @@ void CheckpointWorkerPool::ExecuteMicroGcTransaction(
     if (deletedCounter == limit) {
         gcSession->GcStartTxn();
         for (uint16_t i = 0; i < limit; i++) {
-            Row* out = table->RemoveKeyFromIndex(deletedList[i]->GetData(), deletedList[i], 0, gcSession);
+            Row* row = deletedList[i]->GetData();
+            if (GetGlobalConfiguration().m_enableSnapshotRead) {
+                // Snapshot readers may still need the key, let them remove it when they are done
+                Row* keyRow = table->CreateNewRow();
+                if (keyRow != nullptr) {
+                    keyRow->DeepCopy(row);
+                    table->DeferKeyRemoval(deletedList[i], keyRow, GetGlobalEpoch(), row->GetCommitSequenceNumber());
+                    continue;
+                }
+            }
+            Row* out = table->RemoveKeyFromIndex(row, deletedList[i], 0, gcSession);
         }
         gcSession->GcCheckPointClean();
         deletedCounter = 0;
@@ -284,6 +302,7 @@ void CheckpointWorkerPool::WorkerFunc()
 
         Table* table = GetTask();
         if (table != nullptr) {
+            CheckpointTableImage image;
             do {
                 tableId = table->GetTableId();
                 exId = table->GetTableExId();
@@ -299,9 +318,34 @@ void CheckpointWorkerPool::WorkerFunc()
 
                 struct timespec start, end;
                 uint64_t numOps = 0;
+                uint64_t numDeleted = 0;
+                uint32_t deltaId = 0;
                 clock_gettime(CLOCK_MONOTONIC, &start);
 
-                errCode = WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, maxSegId, numOps);
+                bool delta = m_cpManager.GetTableImage(table, image);
+                if (delta && !LinkTableImage(tableId, image)) {
+                    MOT_LOG_WARN("CheckpointWorkerPool::WorkerFunc: writing a full image of table %u", tableId);
+                    image = CheckpointTableImage();
+                    delta = false;
+                }
+
+                // keys deleted since the previous checkpoint are not needed on top of a full image
+                std::vector<uint8_t> deletedKeys;
+                table->TakeDeletedKeys(m_na, deletedKeys);
+                if (delta) {
+                    deltaId = image.m_deltaMaxSegIds.size() + 1;
+                    errCode = WriteDeletedKeysFile(table, &buffer, deletedKeys, deltaId, numDeleted);
+                    if (errCode != ErrCodes::SUCCESS) {
+                        MOT_LOG_ERROR(
+                            "CheckpointWorkerPool::WorkerFunc: failed to write deleted keys file for table %u", tableId);
+                        m_cpManager.OnError(
+                            errCode, "Failed to write deleted keys file for table - ", std::to_string(tableId).c_str());
+                        break;
+                    }
+                }
+
+                errCode =
+                    WriteTableDataFile(table, &buffer, deletedList, gcSession, threadId, deltaId, maxSegId, numOps);
                 if (errCode != ErrCodes::SUCCESS) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WorkerFunc: failed to write table data file for table %u", tableId);
@@ -310,6 +354,20 @@ void CheckpointWorkerPool::WorkerFunc()
                     break;
                 }
 
+                if (!delta) {
+                    image.m_exId = exId;
+                    image.m_tupleSize = table->GetTupleSize();
+                    image.m_fieldCount = table->GetFieldCount();
+                    image.m_maxSegId = maxSegId;
+                    image.m_baseOps = numOps;
+                } else if (numOps + numDeleted == 0) {
+                    RemoveDeltaFiles(tableId, deltaId, maxSegId);
+                } else {
+                    image.m_deltaMaxSegIds.push_back(maxSegId);
+                    image.m_deltaOps += numOps + numDeleted;
+                }
+                image.m_checkpointId = m_checkpointId;
+
                 taskSucceeded = true;
                 clock_gettime(CLOCK_MONOTONIC, &end);
                 /*
@@ -324,7 +382,7 @@ void CheckpointWorkerPool::WorkerFunc()
                     numOps);
             } while (0);
 
-            m_cpManager.TaskDone(table, maxSegId, taskSucceeded);
+            m_cpManager.TaskDone(table, image, taskSucceeded);
 
             if (!taskSucceeded) {
                 break;
@@ -339,10 +397,14 @@ void CheckpointWorkerPool::WorkerFunc()
     MOT_LOG_DEBUG("thread exiting");
 }
 
-bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId)
+bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId, uint32_t deltaId)
 {
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    if (deltaId > 0) {
+        CheckpointUtils::MakeDeltaFilename(tableId, fileName, m_workingDir, deltaId, seg);
+    } else {
+        CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    }
     if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
         MOT_LOG_ERROR("CheckpointWorkerPool::BeginFile: failed to create file: %s", fileName.c_str());
         return false;
@@ -467,7 +529,8 @@ bool CheckpointWorkerPool::FlushBuffer(int fd, Buffer* buffer)
 }
 
 CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* table, Buffer* buffer,
-    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps)
+    Sentinel** deletedList, GcManager* gcSession, uint16_t threadId, uint32_t deltaId, uint32_t& maxSegId,
+    uint64_t& numOps)
 {
     uint32_t tableId = table->GetTableId();
     uint64_t exId = table->GetTableExId();
@@ -476,7 +539,8 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
     uint64_t currFileOps = 0;
     uint32_t curSegLen = 0;
 
-    maxSegId = 0;
+    // segment 0 of a delta holds the deleted keys
+    maxSegId = (deltaId > 0) ? 1 : 0;
     numOps = 0;
     Index* index = table->GetPrimaryIndex();
     if (index == nullptr) {
@@ -491,7 +555,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
         return ErrCodes::INDEX;
     }
 
-    if (!BeginFile(fd, tableId, maxSegId, exId)) {
+    if (!BeginFile(fd, tableId, maxSegId, exId, deltaId)) {
         MOT_LOG_ERROR(
             "CheckpointWorkerPool::WriteTableDataFile: failed to create data file %u for table %u", maxSegId, tableId);
         delete it;
@@ -508,7 +572,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             it->Next();
             continue;
         }
-        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted);
+        int ckptStatus = Checkpoint(buffer, sentinel, fd, threadId, isDeleted, deltaId > 0);
         if (isDeleted) {
             deletedList[deletedListLocation++] = sentinel;
             ExecuteMicroGcTransaction(deletedList, gcSession, table, deletedListLocation, DELETE_LIST_SIZE);
@@ -540,7 +604,7 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
                 maxSegId++;
                 numOps += currFileOps;
 
-                if (!BeginFile(fd, tableId, maxSegId, exId)) {
+                if (!BeginFile(fd, tableId, maxSegId, exId, deltaId)) {
                     MOT_LOG_ERROR(
                         "CheckpointWorkerPool::WriteTableDataFile: failed to create data file %u for table %u",
                         maxSegId,
@@ -567,6 +631,13 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
             deletedListLocation);
         ExecuteMicroGcTransaction(deletedList, gcSession, table, deletedListLocation, deletedListLocation);
     }
+
+    if (GetGlobalConfiguration().m_enableSnapshotRead) {
+        // Deleted keys are otherwise removed only by later deletes and snapshot readers of the table
+        gcSession->GcStartTxn();
+        table->RemoveDeferredKeys(gcSession, 0, false);
+        gcSession->GcCheckPointClean();
+    }
     table->ClearThreadMemoryCache();
 
     if (errCode != ErrCodes::SUCCESS) {
@@ -598,4 +669,98 @@ CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteTableDataFile(Table* t
     numOps += currFileOps;
     return ErrCodes::SUCCESS;
 }
+
+CheckpointWorkerPool::ErrCodes CheckpointWorkerPool::WriteDeletedKeysFile(
+    Table* table, Buffer* buffer, const std::vector<uint8_t>& keys, uint32_t deltaId, uint64_t& numOps)
+{
+    uint32_t tableId = table->GetTableId();
+    uint64_t exId = table->GetTableExId();
+    uint16_t keyLen = table->GetPrimaryIndex()->GetKeyLength();
+    int fd = -1;
+
+    numOps = 0;
+    if (!BeginFile(fd, tableId, 0, exId, deltaId)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteDeletedKeysFile: failed to create delta %u for table %u",
+            deltaId,
+            tableId);
+        return ErrCodes::FILE_IO;
+    }
+
+    CheckpointUtils::EntryHeader entryHeader{0, 0, 0, keyLen};
+    for (size_t offset = 0; offset + keyLen <= keys.size(); offset += keyLen) {
+        if (buffer->Size() + keyLen + sizeof(CheckpointUtils::EntryHeader) > buffer->MaxSize() &&
+            !FlushBuffer(fd, buffer)) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteDeletedKeysFile: failed to write delta %u for table %u",
+                deltaId,
+                tableId);
+            (void)CheckpointUtils::CloseFile(fd);
+            return ErrCodes::FILE_IO;
+        }
+        if (!buffer->Append(&entryHeader, sizeof(CheckpointUtils::EntryHeader)) ||
+            !buffer->Append(&keys[offset], keyLen)) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteDeletedKeysFile: Failed to write entry to buffer");
+            (void)CheckpointUtils::CloseFile(fd);
+            return ErrCodes::MEMORY;
+        }
+        numOps++;
+    }
+
+    if (!FlushBuffer(fd, buffer) || !FinishFile(fd, tableId, numOps, exId)) {
+        MOT_LOG_ERROR(
+            "CheckpointWorkerPool::WriteDeletedKeysFile: failed to close delta %u for table %u", deltaId, tableId);
+        if (fd != -1) {
+            (void)CheckpointUtils::CloseFile(fd);
+        }
+        return ErrCodes::FILE_IO;
+    }
+    return ErrCodes::SUCCESS;
+}
+
+bool CheckpointWorkerPool::LinkTableImage(uint32_t tableId, const CheckpointTableImage& image)
+{
+    std::string prevDir;
+    if (!CheckpointUtils::SetWorkingDir(prevDir, image.m_checkpointId)) {
+        return false;
+    }
+
+    std::vector<std::string> linked;
+    std::string srcName;
+    std::string dstName;
+    bool ret = true;
+    for (uint32_t seg = 0; ret && seg <= image.m_maxSegId; seg++) {
+        CheckpointUtils::MakeCpFilename(tableId, srcName, prevDir, seg);
+        CheckpointUtils::MakeCpFilename(tableId, dstName, m_workingDir, seg);
+        ret = CheckpointUtils::LinkFile(srcName, dstName);
+        if (ret) {
+            linked.push_back(dstName);
+        }
+    }
+
+    for (uint32_t deltaId = 1; ret && deltaId <= image.m_deltaMaxSegIds.size(); deltaId++) {
+        for (uint32_t seg = 0; ret && seg <= image.m_deltaMaxSegIds[deltaId - 1]; seg++) {
+            CheckpointUtils::MakeDeltaFilename(tableId, srcName, prevDir, deltaId, seg);
+            CheckpointUtils::MakeDeltaFilename(tableId, dstName, m_workingDir, deltaId, seg);
+            ret = CheckpointUtils::LinkFile(srcName, dstName);
+            if (ret) {
+                linked.push_back(dstName);
+            }
+        }
+    }
+
+    if (!ret) {
+        for (std::string& fileName : linked) {
+            (void)unlink(fileName.c_str());
+        }
+    }
+    return ret;
+}
+
+void CheckpointWorkerPool::RemoveDeltaFiles(uint32_t tableId, uint32_t deltaId, uint32_t maxSegId)
+{
+    std::string fileName;
+    for (uint32_t seg = 0; seg <= maxSegId; seg++) {
+        CheckpointUtils::MakeDeltaFilename(tableId, fileName, m_workingDir, deltaId, seg);
+        (void)unlink(fileName.c_str());
+    }
+}
 }  // namespace MOT
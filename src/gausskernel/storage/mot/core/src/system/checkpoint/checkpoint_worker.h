@@ -38,6 +38,37 @@
 namespace MOT {
 const int CHECKPOINT_BUFFER_SIZE = 4096 * 1000;
 
+/**
+ * @struct CheckpointTableImage
+ * @brief Describes the data files of a table in a checkpoint: a full image, optionally followed by deltas that
+ * hold the rows changed and the keys deleted since the previous checkpoint.
+ */
+struct CheckpointTableImage {
+    /** @var The id of the checkpoint holding the files. */
+    uint64_t m_checkpointId = 0;
+
+    /** @var The table's external id when the full image was written. */
+    uint64_t m_exId = 0;
+
+    /** @var The table's tuple size when the full image was written. */
+    uint32_t m_tupleSize = 0;
+
+    /** @var The table's field count when the full image was written. */
+    uint64_t m_fieldCount = 0;
+
+    /** @var The maximum segment id of the full image. */
+    uint32_t m_maxSegId = 0;
+
+    /** @var The number of rows in the full image. */
+    uint64_t m_baseOps = 0;
+
+    /** @var The number of rows and deleted keys in all deltas. */
+    uint64_t m_deltaOps = 0;
+
+    /** @var The maximum segment id of each delta, delta k is at position k - 1. */
+    std::vector<uint32_t> m_deltaMaxSegIds;
+};
+
 /**
  * @class CheckpointManagerCallbacks
  * @brief This class describes the interface for callback methods
@@ -47,12 +78,19 @@ class CheckpointManagerCallbacks {
 public:
     /**
      * @brief Checkpoint task completion callback
-     * @param checkpointId The checkpoint's id.
      * @param table The table's pointer.
-     * @param numSegs number of segments written.
+     * @param image The table's files in this checkpoint.
      * @param success Indicates a success or a failure.
      */
-    virtual void TaskDone(Table* table, uint32_t numSegs, bool success) = 0;
+    virtual void TaskDone(Table* table, const CheckpointTableImage& image, bool success) = 0;
+
+    /**
+     * @brief Retrieves the table's files in the previous checkpoint, to write a delta on top of them.
+     * @param table The table's pointer.
+     * @param image The returned table's files.
+     * @return False if a full image of the table should be written.
+     */
+    virtual bool GetTableImage(Table* table, CheckpointTableImage& image) = 0;
 
     /**
      * @brief Checks if the thread should terminate it work
@@ -114,9 +152,10 @@ private:
      * @param fd The file descriptor to write to.
      * @param threadId The thread id.
      * @param isDeleted The row delete status.
+     * @param delta Specifies whether only rows changed since the previous checkpoint should be written.
      * @return -1 on error, 0 if nothing was written and 1 if the row was written.
      */
-    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted);
+    int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, uint16_t threadId, bool& isDeleted, bool delta);
 
     /**
      * @brief Pops a task (table pointer) from the tasks queue.
@@ -136,9 +175,10 @@ private:
      * @param tableId The table id that is checkpointed.
      * @param seg The table's segment number
      * @param exId The table's external table id
+     * @param deltaId The delta number, or 0 for the full image.
      * @return Boolean value denoting success or failure.
      */
-    bool BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId);
+    bool BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId, uint32_t deltaId = 0);
 
     /**
      * @brief Updates the file's header flushes and closes it.
@@ -167,12 +207,42 @@ private:
      * @param deletedList Array to collect the sentinels deleted rows to be cleaned.
      * @param gcSession GC manager object.
      * @param threadId The thread id.
+     * @param deltaId The delta number, or 0 for a full image.
      * @param maxSegId The maximum segment ID of the table.
      * @param numOps The number of rows written.
      * @return Returns the error code of type ErrCodes.
      */
     ErrCodes WriteTableDataFile(Table* table, Buffer* buffer, Sentinel** deletedList, GcManager* gcSession,
-        uint16_t threadId, uint32_t& maxSegId, uint64_t& numOps);
+        uint16_t threadId, uint32_t deltaId, uint32_t& maxSegId, uint64_t& numOps);
+
+    /**
+     * @brief Writes the primary keys deleted since the previous checkpoint to segment 0 of a delta.
+     * @param table The table's pointer.
+     * @param buffer The buffer to fill.
+     * @param keys The deleted keys, laid out back to back.
+     * @param deltaId The delta number.
+     * @param numOps The number of keys written.
+     * @return Returns the error code of type ErrCodes.
+     */
+    ErrCodes WriteDeletedKeysFile(
+        Table* table, Buffer* buffer, const std::vector<uint8_t>& keys, uint32_t deltaId, uint64_t& numOps);
+
+    /**
+     * @brief Hard links the table's files of the previous checkpoint into this checkpoint directory, so that each
+     * checkpoint directory stays self contained.
+     * @param tableId The table id.
+     * @param image The table's files in the previous checkpoint.
+     * @return Boolean value denoting success or failure. On failure nothing is left linked.
+     */
+    bool LinkTableImage(uint32_t tableId, const CheckpointTableImage& image);
+
+    /**
+     * @brief Removes the files of a delta that turned out to be empty.
+     * @param tableId The table id.
+     * @param deltaId The delta number.
+     * @param maxSegId The maximum segment ID of the delta.
+     */
+    void RemoveDeltaFiles(uint32_t tableId, uint32_t deltaId, uint32_t maxSegId);
 
     bool FlushBuffer(int fd, Buffer* buffer);
 
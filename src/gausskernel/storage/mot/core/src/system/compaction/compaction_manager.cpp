@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * compaction_manager.cpp
+ *    Background online compaction of table row memory.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/compaction/compaction_manager.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <sys/time.h>
+#include <vector>
+#include "compaction_manager.h"
+#include "mot_engine.h"
+#include "checkpoint_manager.h"
+#include "memory_statistics.h"
+#include "table.h"
+#include "row.h"
+#include "sentinel.h"
+#include "index.h"
+#include "mm_gc_manager.h"
+
+namespace MOT {
+DECLARE_LOGGER(CompactionManager, Memory)
+
+static uint64_t GetRowPoolSize(ObjAllocInterface* pool)
+{
+    PoolStatsSt stats;
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+
+    pool->GetStats(stats);
+    return stats.m_poolCount * stats.m_poolGrossSize;
+}
+
+CompactionManager::CompactionManager()
+    : m_periodSeconds(GetGlobalConfiguration().m_onlineCompactionPeriodSeconds),
+      m_rowsPerSecond(GetGlobalConfiguration().m_onlineCompactionRate),
+      m_thresholdPercent(GetGlobalConfiguration().m_onlineCompactionThreshold),
+      m_thread(0),
+      m_running(false),
+      m_relocatedRows(0),
+      m_releasedBytes(0)
+{
+    (void)pthread_mutex_init(&m_lock, nullptr);
+    (void)pthread_cond_init(&m_cond, nullptr);
+}
+
+CompactionManager::~CompactionManager()
+{
+    Stop();
+    (void)pthread_cond_destroy(&m_cond);
+    (void)pthread_mutex_destroy(&m_lock);
+}
+
+bool CompactionManager::Start()
+{
+    if (!m_running) {
+        m_running = true;
+        int rc = pthread_create(&m_thread, nullptr, CompactionThreadStatic, this);
+        if (rc != 0) {
+            MOT_REPORT_SYSTEM_ERROR_CODE(
+                rc, pthread_create, "Online Compaction Initialization", "Failed to create online compaction thread");
+            m_running = false;
+        }
+    }
+    return m_running;
+}
+
+void CompactionManager::Stop()
+{
+    // signal done flag and wake up compaction thread
+    if (m_running) {
+        pthread_mutex_lock(&m_lock);
+        m_running = false;
+        pthread_cond_signal(&m_cond);
+        pthread_mutex_unlock(&m_lock);
+
+        // wait for compaction thread to finish
+        pthread_join(m_thread, nullptr);
+    }
+}
+
+void* CompactionManager::CompactionThreadStatic(void* param)
+{
+    auto pThis = reinterpret_cast<CompactionManager*>(param);
+    pThis->CompactionThread();
+    return nullptr;
+}
+
+void CompactionManager::CompactionThread()
+{
+    MOT_DECLARE_NON_KERNEL_THREAD();
+    MOT_LOG_INFO("Online compaction thread started");
+
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        MOT_LOG_ERROR("Failed to initialize session context, online compaction is disabled");
+        MOTEngine::GetInstance()->OnCurrentThreadEnding();
+        return;
+    }
+
+    TxnManager* txn = sessionContext->GetTxnManager();
+    while (WaitNextPass(m_periodSeconds * 1000)) {
+        // rows are still being loaded, they are compact anyway
+        if (MOTEngine::GetInstance()->IsRecovering()) {
+            continue;
+        }
+        CompactTables(txn);
+    }
+
+    GetSessionManager()->DestroySessionContext(sessionContext);
+    MOTEngine::GetInstance()->OnCurrentThreadEnding();
+    MOT_LOG_INFO("Online compaction thread stopped");
+}
+
+bool CompactionManager::WaitNextPass(uint64_t millis)
+{
+    struct timeval now;
+    gettimeofday(&now, nullptr);
+    uint64_t nanos = (uint64_t)now.tv_usec * 1000UL + (millis % 1000) * 1000000UL;
+    struct timespec ts = {(time_t)(now.tv_sec + millis / 1000 + nanos / 1000000000UL), (long)(nanos % 1000000000UL)};
+
+    pthread_mutex_lock(&m_lock);
+    while (m_running) {
+        if (pthread_cond_timedwait(&m_cond, &m_lock, &ts) == ETIMEDOUT) {
+            break;
+        }
+    }
+    bool running = m_running;
+    pthread_mutex_unlock(&m_lock);
+    return running;
+}
+
+void CompactionManager::CompactTables(TxnManager* txn)
+{
+    // collect table identifiers and release the tables right away, each table is locked only while it is compacted
+    std::list<Table*> tables;
+    std::vector<ExternalTableId> tableIds;
+    (void)GetTableManager()->AddTablesToList(tables);
+    for (Table* table : tables) {
+        tableIds.push_back(table->GetTableExId());
+        table->Unlock();
+    }
+
+    m_relocatedRows = 0;
+    m_releasedBytes = 0;
+    for (ExternalTableId tableId : tableIds) {
+        if (!m_running) {
+            break;
+        }
+        CompactTable(tableId, txn);
+    }
+
+    if (m_relocatedRows > 0 || m_releasedBytes > 0) {
+        MOT_LOG_INFO("Online compaction moved %" PRIu64 " rows and released %" PRIu64 " KB of row memory",
+            m_relocatedRows,
+            m_releasedBytes / KILO_BYTE);
+    }
+}
+
+void CompactionManager::CompactTable(ExternalTableId tableId, TxnManager* txn)
+{
+    // the resume key is kept outside the index, which may go away while the table is not locked
+    MaxKey resumeKey;
+    bool resume = false;
+    bool more = true;
+    uint32_t internalId = 0;
+    ObjAllocInterface* rowPool = nullptr;
+    uint64_t sizeBefore = 0;
+    uint64_t batchesPerSlice = ((uint64_t)m_rowsPerSecond * LOCK_SLICE_MILLIS) / (1000UL * BATCH_SIZE);
+    if (batchesPerSlice == 0) {
+        batchesPerSlice = 1;
+    }
+    uint64_t sliceMillis = (batchesPerSlice * BATCH_SIZE * 1000) / m_rowsPerSecond;
+
+    // the table is locked for one slice of batches at a time, so DDL is not held back while we sleep
+    do {
+        Table* table = GetTableManager()->GetTableSafeByExId(tableId);
+        if (table == nullptr) {
+            // dropped in the meantime
+            return;
+        }
+
+        Index* index = table->GetPrimaryIndex();
+        if (rowPool == nullptr) {
+            // hash index can not resume a scan from a key
+            if (index == nullptr || index->GetIndexingMethod() != IndexingMethod::INDEXING_METHOD_TREE) {
+                table->Unlock();
+                return;
+            }
+            internalId = table->GetTableId();
+            rowPool = table->GetRowPool();
+            sizeBefore = GetRowPoolSize(rowPool);
+            resumeKey.InitKey(index->GetKeyLength(), KeyType::PRIMARY_KEY);
+        } else if (table->GetTableId() != internalId || table->GetRowPool() != rowPool) {
+            // re-created or truncated in the meantime, the resume key means nothing anymore
+            table->Unlock();
+            return;
+        }
+
+        more = CompactSlice(table, txn, &resumeKey, resume, batchesPerSlice);
+        if (!more) {
+            // reclaim the old row copies and give back sub-pools that became empty, the rest is freed in the next pass
+            txn->GetGcSession()->GcCheckPointClean();
+            table->ClearThreadMemoryCache();
+            table->ClearRowCache();
+
+            uint64_t sizeAfter = GetRowPoolSize(rowPool);
+            if (sizeAfter < sizeBefore) {
+                m_releasedBytes += sizeBefore - sizeAfter;
+                MemoryStatisticsProvider::m_provider->AddCompactionReleasedBytes(sizeBefore - sizeAfter);
+            }
+        }
+        table->Unlock();
+    } while (more && WaitNextPass(sliceMillis));
+}
+
+bool CompactionManager::CompactSlice(
+    Table* table, TxnManager* txn, Key* resumeKey, bool& resume, uint64_t batchCount)
+{
+    char prefix[256];
+    errno_t erc =
+        snprintf_s(prefix, sizeof(prefix), sizeof(prefix) - 1, "%s(row pool)", table->GetTableName().c_str());
+    securec_check_ss(erc, "\0", "\0");
+    prefix[erc] = 0;
+
+    CompactHandler ch(table->GetRowPool(), prefix);
+    ch.StartCompaction(CompactTypeT::COMPACT_ONLINE, m_thresholdPercent);
+    if (!ch.IsCompactionNeeded()) {
+        return false;
+    }
+
+    bool more = true;
+    for (uint64_t i = 0; i < batchCount && more; ++i) {
+        more = RelocateRows(table, ch, txn, resumeKey, resume);
+    }
+    ch.EndCompaction();
+    return more;
+}
+
+bool CompactionManager::RelocateRows(Table* table, CompactHandler& ch, TxnManager* txn, Key* resumeKey, bool& resume)
+{
+    Index* index = table->GetPrimaryIndex();
+    GcManager* gc = txn->GetGcSession();
+    uint64_t pid = txn->GetThdId();
+    bool checkpointEnabled = GetGlobalConfiguration().m_enableCheckpoint;
+    bool found = false;
+    bool more = false;
+
+    // a checkpoint cannot get past its prepare phase while we are registered as a committer
+    if (checkpointEnabled) {
+        GetCheckpointManager()->BeginCommit(txn);
+        if (txn->GetCheckpointPhase() != CheckpointPhase::REST) {
+            GetCheckpointManager()->EndCommit(txn);
+            return false;
+        }
+    }
+
+    gc->GcStartTxn();
+    IndexIterator* it = resume ? index->Search(resumeKey, true, true, pid, found) : index->Begin(pid);
+    if (it == nullptr) {
+        MOT_LOG_WARN("Failed to begin iterating over table %s for online compaction", table->GetTableName().c_str());
+    } else {
+        uint32_t visited = 0;
+        while (it->IsValid()) {
+            if (visited == BATCH_SIZE) {
+                resumeKey->CpKey(*reinterpret_cast<const Key*>(it->GetKey()));
+                resume = true;
+                more = true;
+                break;
+            }
+            ++visited;
+
+            // rows being written are skipped, and inserted rows are still owned by their transaction
+            Sentinel* sentinel = it->GetPrimarySentinel();
+            if (!sentinel->IsDirty() && sentinel->TryLock(pid)) {
+                Row* row = sentinel->GetData();
+                if (row != nullptr && !sentinel->IsDirty()) {
+                    Row* newRow = ch.RelocateObj<Row>(row);
+                    if (newRow != nullptr) {
+                        // readers holding the old copy keep reading it until the GC reclaims it
+                        newRow->m_prevVersion = row->m_prevVersion;
+                        COMPILER_BARRIER
+                        sentinel->SetNextPtr(newRow);
+                        gc->GcRecordObject(index->GetIndexId(), row, nullptr, Row::RowDtor, ROW_SIZE_FROM_POOL(table));
+                        MemoryStatisticsProvider::m_provider->AddCompactionRelocatedRow();
+                        ++m_relocatedRows;
+                    }
+                }
+                sentinel->Release();
+            }
+            it->Next();
+        }
+        it->Destroy();
+        delete it;
+    }
+    gc->GcEndTxn();
+
+    if (checkpointEnabled) {
+        GetCheckpointManager()->EndCommit(txn);
+    }
+    return more;
+}
+}  // namespace MOT
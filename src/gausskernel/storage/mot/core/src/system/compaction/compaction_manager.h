@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * compaction_manager.h
+ *    Background online compaction of table row memory.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/compaction/compaction_manager.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef COMPACTION_MANAGER_H
+#define COMPACTION_MANAGER_H
+
+#include <pthread.h>
+#include "global.h"
+#include "object_pool_compact.h"
+
+namespace MOT {
+class Table;
+class Key;
+class TxnManager;
+
+/**
+ * @class CompactionManager
+ * @brief Periodically moves rows out of sparsely used row pool chunks, so the chunks can be given back to the
+ * memory allocator while the database keeps serving transactions.
+ * @detail Each pass visits all tables. Rows residing in sub-pools that have at least the configured percentage of
+ * free objects are copied into fresh sub-pools under the lock of their primary sentinel, and the old copy is retired
+ * to the GC, so concurrent readers never see it disappear. Rows are moved in small batches, with a pause between
+ * batches to keep the configured rate, and the table is unlocked during the pauses. Sub-pools that end up empty are
+ * released at the end of the table visit, or in the next pass if the GC did not reclaim all old copies by then.
+ */
+class CompactionManager {
+public:
+    CompactionManager();
+    CompactionManager(const CompactionManager& orig) = delete;
+    CompactionManager& operator=(const CompactionManager& orig) = delete;
+    ~CompactionManager();
+
+    /** @brief Starts the compaction thread. */
+    bool Start();
+
+    /** @brief Stops the compaction thread. */
+    void Stop();
+
+private:
+    /** @var Number of rows visited in one batch. */
+    static constexpr uint32_t BATCH_SIZE = 256;
+
+    /** @var Approximate time between two table locks of a table visit, see CompactTable(). */
+    static constexpr uint64_t LOCK_SLICE_MILLIS = 100;
+
+    /** @var Compaction period in seconds. */
+    uint64_t m_periodSeconds;
+
+    /** @var Maximum number of rows visited per second. */
+    uint32_t m_rowsPerSecond;
+
+    /** @var Minimum percentage of free objects in a sub-pool that is worth compacting. */
+    uint32_t m_thresholdPercent;
+
+    /** @var The compaction thread handle. */
+    pthread_t m_thread;
+
+    /** @var Compaction period lock. */
+    pthread_mutex_t m_lock;
+
+    /** @var Compaction period condition variable. */
+    pthread_cond_t m_cond;
+
+    /** @var Specifies whether the compaction thread is running. */
+    volatile bool m_running;
+
+    /** @var Rows moved in the current pass. */
+    uint64_t m_relocatedRows;
+
+    /** @var Memory given back in the current pass. */
+    uint64_t m_releasedBytes;
+
+    static void* CompactionThreadStatic(void* param);
+
+    void CompactionThread();
+
+    /**
+     * @brief Waits for the next compaction pass.
+     * @return False if the compaction thread should stop.
+     */
+    bool WaitNextPass(uint64_t millis);
+
+    /**
+     * @brief Performs a single compaction pass over all tables.
+     * @param txn The transaction manager of the compaction thread session.
+     */
+    void CompactTables(TxnManager* txn);
+
+    /**
+     * @brief Compacts the row memory of a single table. The table is read-locked for one slice of batches at a time
+     * and the visit resumes from the key of the next row after each pause, so the pauses do not hold back DDL.
+     * @param tableId The external identifier of the table to compact.
+     * @param txn The transaction manager of the compaction thread session.
+     */
+    void CompactTable(uint64_t tableId, TxnManager* txn);
+
+    /**
+     * @brief Compacts the row pool of a table for a bounded number of batches.
+     * @param table The table to compact. Must be read-locked by the caller.
+     * @param txn The transaction manager of the compaction thread session.
+     * @param resumeKey The key of the first row to visit. On return it holds the key of the next row to visit.
+     * @param[in,out] resume Specifies whether to start from the resume key or from the beginning of the table.
+     * @param batchCount The maximum number of batches to visit.
+     * @return True if there are more rows to visit.
+     */
+    bool CompactSlice(Table* table, TxnManager* txn, Key* resumeKey, bool& resume, uint64_t batchCount);
+
+    /**
+     * @brief Moves a batch of rows out of the compacted sub-pools.
+     * @param table The table to compact.
+     * @param ch The compaction handler of the table row pool.
+     * @param txn The transaction manager of the compaction thread session.
+     * @param resumeKey The key of the first row to visit. On return it holds the key of the next row to visit.
+     * @param[in,out] resume Specifies whether to start from the resume key or from the beginning of the table.
+     * @return True if there are more rows to visit.
+     */
+    bool RelocateRows(Table* table, CompactHandler& ch, TxnManager* txn, Key* resumeKey, bool& resume);
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* COMPACTION_MANAGER_H */
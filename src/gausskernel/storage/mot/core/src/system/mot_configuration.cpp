@@ -58,6 +58,7 @@ constexpr const char* MOTConfiguration::DEFAULT_GROUP_COMMIT_TIMEOUT;
 constexpr uint64_t MOTConfiguration::DEFAULT_GROUP_COMMIT_TIMEOUT_USEC;
 constexpr uint64_t MOTConfiguration::MIN_GROUP_COMMIT_TIMEOUT_USEC;
 constexpr uint64_t MOTConfiguration::MAX_GROUP_COMMIT_TIMEOUT_USEC;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_PIPELINED_COMMIT;
 // checkpoint configuration members
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_CHECKPOINT;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_INCREMENTAL_CHECKPOINT;
@@ -69,10 +70,17 @@ constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_WORKERS;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_DELTA_CHECKPOINT;
+constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_CONSOLIDATION_INTERVAL;
+constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_CONSOLIDATION_INTERVAL;
+constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_CONSOLIDATION_INTERVAL;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_PARALLEL_REDO_WORKERS;
+constexpr uint32_t MOTConfiguration::MIN_PARALLEL_REDO_WORKERS;
+constexpr uint32_t MOTConfiguration::MAX_PARALLEL_REDO_WORKERS;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_LOG_RECOVERY_STATS;
 // machine configuration members
 constexpr uint16_t MOTConfiguration::DEFAULT_NUMA_NODES;
@@ -169,6 +177,18 @@ constexpr const char* MOTConfiguration::DEFAULT_GC_HIGH_RECLAIM_THRESHOLD;
 constexpr uint64_t MOTConfiguration::DEFAULT_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
 constexpr uint64_t MOTConfiguration::MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
 constexpr uint64_t MOTConfiguration::MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_SNAPSHOT_READ;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_ONLINE_COMPACTION;
+constexpr const char* MOTConfiguration::DEFAULT_ONLINE_COMPACTION_PERIOD;
+constexpr uint64_t MOTConfiguration::DEFAULT_ONLINE_COMPACTION_PERIOD_SECONDS;
+constexpr uint64_t MOTConfiguration::MIN_ONLINE_COMPACTION_PERIOD_SECONDS;
+constexpr uint64_t MOTConfiguration::MAX_ONLINE_COMPACTION_PERIOD_SECONDS;
+constexpr uint32_t MOTConfiguration::DEFAULT_ONLINE_COMPACTION_RATE;
+constexpr uint32_t MOTConfiguration::MIN_ONLINE_COMPACTION_RATE;
+constexpr uint32_t MOTConfiguration::MAX_ONLINE_COMPACTION_RATE;
+constexpr uint32_t MOTConfiguration::DEFAULT_ONLINE_COMPACTION_THRESHOLD;
+constexpr uint32_t MOTConfiguration::MIN_ONLINE_COMPACTION_THRESHOLD;
+constexpr uint32_t MOTConfiguration::MAX_ONLINE_COMPACTION_THRESHOLD;
 // JIT configuration members
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_MOT_CODEGEN;
 constexpr bool MOTConfiguration::DEFAULT_FORCE_MOT_PSEUDO_CODEGEN;
@@ -176,6 +196,10 @@ constexpr bool MOTConfiguration::DEFAULT_ENABLE_MOT_CODEGEN_PRINT;
 constexpr uint32_t MOTConfiguration::DEFAULT_MOT_CODEGEN_LIMIT;
 constexpr uint32_t MOTConfiguration::MIN_MOT_CODEGEN_LIMIT;
 constexpr uint32_t MOTConfiguration::MAX_MOT_CODEGEN_LIMIT;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_VECTORIZED_SCAN;
+constexpr uint32_t MOTConfiguration::DEFAULT_VECTORIZED_SCAN_MIN_ROWS;
+constexpr uint32_t MOTConfiguration::MIN_VECTORIZED_SCAN_MIN_ROWS;
+constexpr uint32_t MOTConfiguration::MAX_VECTORIZED_SCAN_MIN_ROWS;
 // storage configuration
 constexpr bool MOTConfiguration::DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN;
 constexpr IndexTreeFlavor MOTConfiguration::DEFAULT_INDEX_TREE_FLAVOR;
@@ -446,12 +470,16 @@ MOTConfiguration::MOTConfiguration()
       m_enableGroupCommit(DEFAULT_ENABLE_GROUP_COMMIT),
       m_groupCommitSize(DEFAULT_GROUP_COMMIT_SIZE),
       m_groupCommitTimeoutUSec(DEFAULT_GROUP_COMMIT_TIMEOUT_USEC),
+      m_enablePipelinedCommit(DEFAULT_ENABLE_PIPELINED_COMMIT),
       m_enableCheckpoint(DEFAULT_ENABLE_CHECKPOINT),
       m_enableIncrementalCheckpoint(DEFAULT_ENABLE_INCREMENTAL_CHECKPOINT),
       m_checkpointDir(DEFAULT_CHECKPOINT_DIR),
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
+      m_enableDeltaCheckpoint(DEFAULT_ENABLE_DELTA_CHECKPOINT),
+      m_checkpointConsolidationInterval(DEFAULT_CHECKPOINT_CONSOLIDATION_INTERVAL),
       m_checkpointRecoveryWorkers(DEFAULT_CHECKPOINT_RECOVERY_WORKERS),
+      m_parallelRedoWorkers(DEFAULT_PARALLEL_REDO_WORKERS),
       m_abortBufferEnable(true),
       m_preAbort(true),
       m_validationLock(TxnValidation::TXN_VALIDATION_NO_WAIT),
@@ -499,10 +527,17 @@ MOTConfiguration::MOTConfiguration()
       m_gcReclaimThresholdBytes(DEFAULT_GC_RECLAIM_THRESHOLD_BYTES),
       m_gcReclaimBatchSize(DEFAULT_GC_RECLAIM_BATCH_SIZE),
       m_gcHighReclaimThresholdBytes(DEFAULT_GC_HIGH_RECLAIM_THRESHOLD_BYTES),
+      m_enableSnapshotRead(DEFAULT_ENABLE_SNAPSHOT_READ),
+      m_enableOnlineCompaction(DEFAULT_ENABLE_ONLINE_COMPACTION),
+      m_onlineCompactionPeriodSeconds(DEFAULT_ONLINE_COMPACTION_PERIOD_SECONDS),
+      m_onlineCompactionRate(DEFAULT_ONLINE_COMPACTION_RATE),
+      m_onlineCompactionThreshold(DEFAULT_ONLINE_COMPACTION_THRESHOLD),
       m_enableCodegen(DEFAULT_ENABLE_MOT_CODEGEN),
       m_forcePseudoCodegen(DEFAULT_FORCE_MOT_PSEUDO_CODEGEN),
       m_enableCodegenPrint(DEFAULT_ENABLE_MOT_CODEGEN_PRINT),
       m_codegenLimit(DEFAULT_MOT_CODEGEN_LIMIT),
+      m_enableVectorizedScan(DEFAULT_ENABLE_VECTORIZED_SCAN),
+      m_vectorizedScanMinRows(DEFAULT_VECTORIZED_SCAN_MIN_ROWS),
       m_allowIndexOnNullableColumn(DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN),
       m_indexTreeFlavor(DEFAULT_INDEX_TREE_FLAVOR),
       m_configMonitorPeriodSeconds(DEFAULT_CFG_MONITOR_PERIOD_SECONDS),
@@ -551,12 +586,16 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseBool(name, "enable_group_commit", value, &m_enableGroupCommit)) {
     } else if (ParseUint64(name, "group_commit_size", value, &m_groupCommitSize)) {
     } else if (ParseUint64(name, "group_commit_timeout_usec", value, &m_groupCommitTimeoutUSec)) {
+    } else if (ParseBool(name, "enable_pipelined_commit", value, &m_enablePipelinedCommit)) {
     } else if (ParseBool(name, "enable_checkpoint", value, &m_enableCheckpoint)) {
     } else if (ParseBool(name, "enable_incremental_checkpoint", value, &m_enableIncrementalCheckpoint)) {
     } else if (ParseString(name, "checkpoint_dir", value, &m_checkpointDir)) {
     } else if (ParseUint64(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
+    } else if (ParseBool(name, "enable_delta_checkpoint", value, &m_enableDeltaCheckpoint)) {
+    } else if (ParseUint32(name, "checkpoint_consolidation_interval", value, &m_checkpointConsolidationInterval)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
+    } else if (ParseUint32(name, "parallel_redo_workers", value, &m_parallelRedoWorkers)) {
     } else if (ParseBool(name, "abort_buffer_enable", value, &m_abortBufferEnable)) {
     } else if (ParseBool(name, "pre_abort", value, &m_preAbort)) {
     } else if (ParseValidation(name, "validation_lock", value, &m_validationLock)) {
@@ -602,6 +641,8 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseBool(name, "force_mot_pseudo_codegen", value, &m_forcePseudoCodegen)) {
     } else if (ParseBool(name, "enable_mot_codegen_print", value, &m_enableCodegenPrint)) {
     } else if (ParseUint32(name, "mot_codegen_limit", value, &m_codegenLimit)) {
+    } else if (ParseBool(name, "enable_vectorized_scan", value, &m_enableVectorizedScan)) {
+    } else if (ParseUint32(name, "vectorized_scan_min_rows", value, &m_vectorizedScanMinRows)) {
     } else if (ParseBool(name, "allow_index_on_nullable_column", value, &m_allowIndexOnNullableColumn)) {
     } else if (ParseIndexTreeFlavor(name, "index_tree_flavor", value, &m_indexTreeFlavor)) {
     } else if (ParseUint64(name, "config_monitor_period_seconds", value, &m_configMonitorPeriodSeconds)) {
@@ -911,6 +952,7 @@ void MOTConfiguration::LoadConfig()
         SCALE_MICROS,
         MIN_GROUP_COMMIT_TIMEOUT_USEC,
         MAX_GROUP_COMMIT_TIMEOUT_USEC);
+    UPDATE_BOOL_CFG(m_enablePipelinedCommit, "enable_pipelined_commit", DEFAULT_ENABLE_PIPELINED_COMMIT);
 
     // Checkpoint configuration
     if (m_loadExtraParams) {
@@ -936,6 +978,12 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_WORKERS,
         MIN_CHECKPOINT_WORKERS,
         MAX_CHECKPOINT_WORKERS);
+    UPDATE_BOOL_CFG(m_enableDeltaCheckpoint, "enable_delta_checkpoint", DEFAULT_ENABLE_DELTA_CHECKPOINT);
+    UPDATE_INT_CFG(m_checkpointConsolidationInterval,
+        "checkpoint_consolidation_interval",
+        DEFAULT_CHECKPOINT_CONSOLIDATION_INTERVAL,
+        MIN_CHECKPOINT_CONSOLIDATION_INTERVAL,
+        MAX_CHECKPOINT_CONSOLIDATION_INTERVAL);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers,
@@ -943,6 +991,11 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_RECOVERY_WORKERS,
         MIN_CHECKPOINT_RECOVERY_WORKERS,
         MAX_CHECKPOINT_RECOVERY_WORKERS);
+    UPDATE_INT_CFG(m_parallelRedoWorkers,
+        "parallel_redo_workers",
+        DEFAULT_PARALLEL_REDO_WORKERS,
+        MIN_PARALLEL_REDO_WORKERS,
+        MAX_PARALLEL_REDO_WORKERS);
 
     // Tx configuration - not configurable yet
     if (m_loadExtraParams) {
@@ -1007,6 +1060,24 @@ void MOTConfiguration::LoadConfig()
         SCALE_BYTES,
         MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES,
         MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES);
+    UPDATE_BOOL_CFG(m_enableSnapshotRead, "enable_snapshot_read", DEFAULT_ENABLE_SNAPSHOT_READ);
+    UPDATE_BOOL_CFG(m_enableOnlineCompaction, "enable_online_compaction", DEFAULT_ENABLE_ONLINE_COMPACTION);
+    UPDATE_TIME_CFG(m_onlineCompactionPeriodSeconds,
+        "online_compaction_period",
+        DEFAULT_ONLINE_COMPACTION_PERIOD,
+        SCALE_SECONDS,
+        MIN_ONLINE_COMPACTION_PERIOD_SECONDS,
+        MAX_ONLINE_COMPACTION_PERIOD_SECONDS);
+    UPDATE_INT_CFG(m_onlineCompactionRate,
+        "online_compaction_rate",
+        DEFAULT_ONLINE_COMPACTION_RATE,
+        MIN_ONLINE_COMPACTION_RATE,
+        MAX_ONLINE_COMPACTION_RATE);
+    UPDATE_INT_CFG(m_onlineCompactionThreshold,
+        "online_compaction_threshold",
+        DEFAULT_ONLINE_COMPACTION_THRESHOLD,
+        MIN_ONLINE_COMPACTION_THRESHOLD,
+        MAX_ONLINE_COMPACTION_THRESHOLD);
 
     // JIT configuration
     UPDATE_BOOL_CFG(m_enableCodegen, "enable_mot_codegen", DEFAULT_ENABLE_MOT_CODEGEN);
@@ -1015,6 +1086,14 @@ void MOTConfiguration::LoadConfig()
     UPDATE_INT_CFG(
         m_codegenLimit, "mot_codegen_limit", DEFAULT_MOT_CODEGEN_LIMIT, MIN_MOT_CODEGEN_LIMIT, MAX_MOT_CODEGEN_LIMIT);
 
+    // vectorized scan configuration
+    UPDATE_BOOL_CFG(m_enableVectorizedScan, "enable_vectorized_scan", DEFAULT_ENABLE_VECTORIZED_SCAN);
+    UPDATE_INT_CFG(m_vectorizedScanMinRows,
+        "vectorized_scan_min_rows",
+        DEFAULT_VECTORIZED_SCAN_MIN_ROWS,
+        MIN_VECTORIZED_SCAN_MIN_ROWS,
+        MAX_VECTORIZED_SCAN_MIN_ROWS);
+
     // storage configuration
     if (m_loadExtraParams) {
         UPDATE_BOOL_CFG(
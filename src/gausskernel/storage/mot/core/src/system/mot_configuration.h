@@ -160,6 +160,9 @@ public:
     /** @var Timeout in micro-seconds of timed group commit flush policies. */
     uint64_t m_groupCommitTimeoutUSec;
 
+    /** @var Enables pipelined commit (relevant only if envelope has synchronous_commit not set to off). */
+    bool m_enablePipelinedCommit;
+
     /**********************************************************************/
     // Checkpoint configuration
     /**********************************************************************/
@@ -178,6 +181,12 @@ public:
     /** @var number of worker threads to spawn to perform checkpoint. */
     uint32_t m_checkpointWorkers;
 
+    /** @var Enable delta checkpoint (write only rows changed since the previous checkpoint). */
+    bool m_enableDeltaCheckpoint;
+
+    /** @var Maximum number of deltas kept on top of a full table image. */
+    uint32_t m_checkpointConsolidationInterval;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -185,6 +194,9 @@ public:
     /** @var Specifies the number of workers used to recover from checkpoint. */
     uint32_t m_checkpointRecoveryWorkers;
 
+    /** @var Specifies the number of workers used to replay redo log records (one means serial replay). */
+    uint32_t m_parallelRedoWorkers;
+
     /**********************************************************************/
     // Transaction management variables (not configurable)
     /**********************************************************************/
@@ -340,6 +352,21 @@ public:
     /** @var The high threshold in bytes for reclamation to be triggered (per-thread). */
     uint64_t m_gcHighReclaimThresholdBytes;
 
+    /** @var Enable/disable snapshot reads for read-only transactions (keeps older row versions until reclaimed). */
+    bool m_enableSnapshotRead;
+
+    /** @var Enable/disable the background online compaction of row memory. */
+    bool m_enableOnlineCompaction;
+
+    /** @var The period in seconds between online compaction passes. */
+    uint64_t m_onlineCompactionPeriodSeconds;
+
+    /** @var The maximum number of rows relocated per second by online compaction. */
+    uint32_t m_onlineCompactionRate;
+
+    /** @var The percentage of free objects above which a row sub-pool is considered sparse and compacted. */
+    uint32_t m_onlineCompactionThreshold;
+
     /**********************************************************************/
     // JIT configuration
     /**********************************************************************/
@@ -355,6 +382,15 @@ public:
     /** @var Limits the amount of JIT queries allowed per user session. */
     uint32_t m_codegenLimit;
 
+    /**********************************************************************/
+    // Vectorized scan configuration
+    /**********************************************************************/
+    /** @var Specifies whether large read-only scans may produce vector batches for the vectorized executor. */
+    bool m_enableVectorizedScan;
+
+    /** @var The minimum estimated number of rows returned by a scan for it to be vectorized. */
+    uint32_t m_vectorizedScanMinRows;
+
     /**********************************************************************/
     // Storage configuration
     /**********************************************************************/
@@ -444,6 +480,9 @@ public:
     static constexpr uint64_t MIN_GROUP_COMMIT_TIMEOUT_USEC = 100;
     static constexpr uint64_t MAX_GROUP_COMMIT_TIMEOUT_USEC = 200000;  // 200 ms
 
+    /** @var Default enable pipelined commit. */
+    static constexpr bool DEFAULT_ENABLE_PIPELINED_COMMIT = false;
+
     /** ------------------ Default Checkpoint Configuration ------------ */
     /** @var Default enable checkpoint. */
     static constexpr bool DEFAULT_ENABLE_CHECKPOINT = true;
@@ -465,12 +504,25 @@ public:
     static constexpr uint32_t MIN_CHECKPOINT_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_WORKERS = 1024;
 
+    /** @var Default enable delta checkpoint. */
+    static constexpr bool DEFAULT_ENABLE_DELTA_CHECKPOINT = false;
+
+    /** @var Default maximum number of deltas kept on top of a full table image. */
+    static constexpr uint32_t DEFAULT_CHECKPOINT_CONSOLIDATION_INTERVAL = 8;
+    static constexpr uint32_t MIN_CHECKPOINT_CONSOLIDATION_INTERVAL = 1;
+    static constexpr uint32_t MAX_CHECKPOINT_CONSOLIDATION_INTERVAL = 1024;
+
     /** ------------------ Default Recovery Configuration ------------ */
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
     static constexpr uint32_t MIN_CHECKPOINT_RECOVERY_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_RECOVERY_WORKERS = 1024;
 
+    /** @var Default number of workers used to replay redo log records. */
+    static constexpr uint32_t DEFAULT_PARALLEL_REDO_WORKERS = 1;
+    static constexpr uint32_t MIN_PARALLEL_REDO_WORKERS = 1;
+    static constexpr uint32_t MAX_PARALLEL_REDO_WORKERS = 64;
+
     /** @var Default enable log recovery statistics. */
     static constexpr bool DEFAULT_ENABLE_LOG_RECOVERY_STATS = false;
 
@@ -656,6 +708,28 @@ public:
     static constexpr uint64_t MIN_GC_HIGH_RECLAIM_THRESHOLD_BYTES = 1 * MEGA_BYTE;      // 1 MB
     static constexpr uint64_t MAX_GC_HIGH_RECLAIM_THRESHOLD_BYTES = 64 * MEGA_BYTE;     // 64 MB
 
+    /** @var Default enable snapshot reads for read-only transactions. */
+    static constexpr bool DEFAULT_ENABLE_SNAPSHOT_READ = false;
+
+    /** @var Default enable online compaction. */
+    static constexpr bool DEFAULT_ENABLE_ONLINE_COMPACTION = false;
+
+    /** @var Default period between online compaction passes. */
+    static constexpr const char* DEFAULT_ONLINE_COMPACTION_PERIOD = "5 minutes";
+    static constexpr uint64_t DEFAULT_ONLINE_COMPACTION_PERIOD_SECONDS = 300;
+    static constexpr uint64_t MIN_ONLINE_COMPACTION_PERIOD_SECONDS = 1;
+    static constexpr uint64_t MAX_ONLINE_COMPACTION_PERIOD_SECONDS = 86400;  // 1 day
+
+    /** @var Default maximum number of rows relocated per second by online compaction. */
+    static constexpr uint32_t DEFAULT_ONLINE_COMPACTION_RATE = 100000;
+    static constexpr uint32_t MIN_ONLINE_COMPACTION_RATE = 100;
+    static constexpr uint32_t MAX_ONLINE_COMPACTION_RATE = 100000000;
+
+    /** @var Default percentage of free objects above which a row sub-pool is compacted. */
+    static constexpr uint32_t DEFAULT_ONLINE_COMPACTION_THRESHOLD = 50;
+    static constexpr uint32_t MIN_ONLINE_COMPACTION_THRESHOLD = 1;
+    static constexpr uint32_t MAX_ONLINE_COMPACTION_THRESHOLD = 99;
+
     /** ------------------ Default JIT Configuration ------------ */
     /** @var Default enable JIT compilation and execution. */
     static constexpr bool DEFAULT_ENABLE_MOT_CODEGEN = true;
@@ -671,6 +745,15 @@ public:
     static constexpr uint32_t MIN_MOT_CODEGEN_LIMIT = 1;
     static constexpr uint32_t MAX_MOT_CODEGEN_LIMIT = 1000;
 
+    /** ------------------ Default Vectorized Scan Configuration ------------ */
+    /** @var Default enable vectorized scans. */
+    static constexpr bool DEFAULT_ENABLE_VECTORIZED_SCAN = true;
+
+    /** @var Default minimum estimated number of rows returned by a vectorized scan. */
+    static constexpr uint32_t DEFAULT_VECTORIZED_SCAN_MIN_ROWS = 10000;
+    static constexpr uint32_t MIN_VECTORIZED_SCAN_MIN_ROWS = 0;
+    static constexpr uint32_t MAX_VECTORIZED_SCAN_MIN_ROWS = UINT32_MAX;
+
     /** ------------------ Default Storage Configuration ------------ */
     /** @var The default allow index on null-able column. */
     static constexpr bool DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN = false;
@@ -45,6 +45,7 @@
 #include "cycles.h"
 #include "debug_utils.h"
 #include "recovery_manager_factory.h"
+#include "compaction_manager.h"
 
 // For mtSessionThreadInfo thread local
 #include "kvthread.hh"
@@ -84,7 +85,8 @@ MOTEngine::MOTEngine()
       m_surrogateKeyManager(nullptr),
       m_recoveryManager(nullptr),
       m_redoLogHandler(nullptr),
-      m_checkpointManager(nullptr)
+      m_checkpointManager(nullptr),
+      m_compactionManager(nullptr)
 {}
 
 MOTEngine::~MOTEngine()
@@ -428,6 +430,19 @@ bool MOTEngine::StartBackgroundTasks()
             MOT_LOG_INFO("Startup: Statistics reporter started");
             m_startBgStack.push(START_STAT_PRINT_PHASE);
         }
+
+        if (GetGlobalConfiguration().m_enableOnlineCompaction) {
+            m_compactionManager = new (std::nothrow) CompactionManager();
+            if (m_compactionManager == nullptr) {
+                MOT_REPORT_ERROR(MOT_ERROR_OOM, "MOT Engine Startup", "Failed to allocate online compaction manager");
+                result = false;
+                break;
+            }
+            m_startBgStack.push(START_ONLINE_COMPACTION_PHASE);
+            result = m_compactionManager->Start();
+            CHECK_INIT_STATUS(result, "Failed to start the online compaction task");
+            MOT_LOG_INFO("Startup: Online compaction started");
+        }
     } while (0);
 
     if (result) {
@@ -537,6 +552,14 @@ void MOTEngine::StopBackgroundTasks()
 
     while (!m_startBgStack.empty()) {
         switch (m_startBgStack.top()) {
+            case START_ONLINE_COMPACTION_PHASE:
+                if (m_compactionManager != nullptr) {
+                    m_compactionManager->Stop();
+                    delete m_compactionManager;
+                    m_compactionManager = nullptr;
+                }
+                break;
+
             case START_STAT_PRINT_PHASE:
                 if (GetGlobalConfiguration().m_enableStats) {
                     StatisticsManager::GetInstance().Stop();
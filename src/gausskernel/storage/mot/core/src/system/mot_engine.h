@@ -49,6 +49,7 @@
 namespace MOT {
 class ConfigLoader;
 class RedoLogHandler;
+class CompactionManager;
 
 /** @typedef CpSigFunc Callback for notifying envelope that engine finished checkpoint. */
 typedef void (*CpSigFunc)(void);
@@ -538,6 +539,9 @@ private:
     /** @var The checkpoint manager. */
     CheckpointManager* m_checkpointManager;
 
+    /** @var The online compaction manager. */
+    CompactionManager* m_compactionManager;
+
     /** @var The In-ProcessTransactions container. */
     InProcessTransactions m_inProcessTransactions;
 
@@ -576,7 +580,7 @@ private:
     };
     stack<InitAppPhase> m_initAppStack;
 
-    enum StartBgTaskPhase { START_STAT_PRINT_PHASE, START_BG_TASK_DONE };
+    enum StartBgTaskPhase { START_STAT_PRINT_PHASE, START_ONLINE_COMPACTION_PHASE, START_BG_TASK_DONE };
     stack<StartBgTaskPhase> m_startBgStack;
 
     /**
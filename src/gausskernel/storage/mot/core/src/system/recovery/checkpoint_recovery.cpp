@@ -41,6 +41,8 @@ bool CheckpointRecovery::Recover()
     }
 
     m_tasksList.clear();
+    m_deltaStages.clear();
+    m_deltaTableIds.clear();
     if (CheckpointControlFile::GetCtrlFile() == nullptr) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM, "Checkpoint Recovery Initialization", "Failed to allocate ctrlfile object");
         return false;
@@ -86,6 +88,11 @@ bool CheckpointRecovery::Recover()
         return true;
     }
 
+    if (!FillTasksFromDeltaMapFile()) {
+        MOT_LOG_ERROR("CheckpointRecovery:: failed to read delta map file");
+        return false;
+    }
+
     if (m_tasksList.size() > 0) {
         if (GetGlobalConfiguration().m_enableIncrementalCheckpoint) {
             MOT_LOG_ERROR(
@@ -120,6 +127,7 @@ bool CheckpointRecovery::Recover()
         m_checkpointId);
 
     m_tableIds.clear();
+    m_deltaTableIds.clear();
     MOTEngine::GetInstance()->GetCheckpointManager()->RemoveOldCheckpoints(m_checkpointId);
     return true;
 }
@@ -137,6 +145,43 @@ bool CheckpointRecovery::PerformRecovery()
         }
     }
 
+    // rows from deltas overwrite each other, so secondary indexes are built only once all deltas were applied
+    if (!m_deltaTableIds.empty()) {
+        m_deltaStages.emplace_back();
+        for (uint32_t tableId : m_deltaTableIds) {
+            Table* table = GetTableManager()->GetTable(tableId);
+            for (uint16_t ix = 1; table != nullptr && ix < table->GetNumIndexes(); ix++) {
+                Task* recoveryTask = new (std::nothrow) Task(tableId, ix, 0, SECONDARY_INDEX);
+                if (recoveryTask == nullptr) {
+                    MOT_LOG_ERROR("CheckpointRecovery: failed to allocate task object");
+                    return false;
+                }
+                m_deltaStages.back().push_back(recoveryTask);
+            }
+        }
+    }
+
+    RunWorkers();
+
+    // deltas are applied one after the other on top of the full images
+    for (auto& stage : m_deltaStages) {
+        if (m_errorSet) {
+            for (Task* task : stage) {
+                delete task;
+            }
+            stage.clear();
+            continue;
+        }
+        m_tasksList.swap(stage);
+        RunWorkers();
+    }
+    m_deltaStages.clear();
+
+    return true;
+}
+
+void CheckpointRecovery::RunWorkers()
+{
     std::vector<std::thread> threadPool;
     for (uint32_t i = 0; i < m_numWorkers; ++i) {
         threadPool.push_back(std::thread(CheckpointRecoveryWorker, this));
@@ -153,8 +198,6 @@ bool CheckpointRecovery::PerformRecovery()
             worker.join();
         }
     }
-
-    return true;
 }
 
 int CheckpointRecovery::FillTasksFromMapFile()
@@ -212,6 +255,69 @@ int CheckpointRecovery::FillTasksFromMapFile()
     return 1;
 }
 
+bool CheckpointRecovery::FillTasksFromDeltaMapFile()
+{
+    std::string mapFile;
+    CheckpointUtils::MakeDeltaMapFilename(mapFile, m_workingDir, m_checkpointId);
+    if (!CheckpointUtils::IsFileExists(mapFile)) {
+        return true;  // only full images
+    }
+
+    int fd = -1;
+    if (!CheckpointUtils::OpenFileRead(mapFile, fd)) {
+        MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromDeltaMapFile: failed to open file '%s'", mapFile.c_str());
+        return false;
+    }
+
+    CheckpointUtils::MapFileHeader mapFileHeader;
+    if (CheckpointUtils::ReadFile(fd, (char*)&mapFileHeader, sizeof(CheckpointUtils::MapFileHeader)) !=
+            sizeof(CheckpointUtils::MapFileHeader) ||
+        mapFileHeader.m_magic != CP_MGR_MAGIC) {
+        MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromDeltaMapFile: failed to verify file '%s'", mapFile.c_str());
+        CheckpointUtils::CloseFile(fd);
+        return false;
+    }
+
+    CheckpointManager::DeltaMapFileEntry entry;
+    for (uint64_t i = 0; i < mapFileHeader.m_numEntries; i++) {
+        if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointManager::DeltaMapFileEntry)) !=
+            sizeof(CheckpointManager::DeltaMapFileEntry)) {
+            MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromDeltaMapFile: failed to read file '%s' entry: %lu",
+                mapFile.c_str(),
+                i);
+            CheckpointUtils::CloseFile(fd);
+            return false;
+        }
+
+        if (m_tableIds.find(entry.m_tableId) == m_tableIds.end() || entry.m_deltaId == 0) {
+            MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromDeltaMapFile: invalid entry for table %u delta %u",
+                entry.m_tableId,
+                entry.m_deltaId);
+            CheckpointUtils::CloseFile(fd);
+            return false;
+        }
+
+        // delta k is recovered in stages 2k - 2 (deleted keys) and 2k - 1 (rows)
+        if (m_deltaStages.size() < (size_t)entry.m_deltaId * 2) {
+            m_deltaStages.resize((size_t)entry.m_deltaId * 2);
+        }
+        m_deltaTableIds.insert(entry.m_tableId);
+        for (uint32_t seg = 0; seg <= entry.m_maxSegId; seg++) {
+            Task* recoveryTask = new (std::nothrow)
+                Task(entry.m_tableId, seg, entry.m_deltaId, (seg == 0) ? DELETED_KEYS : ROWS);
+            if (recoveryTask == nullptr) {
+                CheckpointUtils::CloseFile(fd);
+                MOT_LOG_ERROR("CheckpointRecovery::FillTasksFromDeltaMapFile: failed to allocate task object");
+                return false;
+            }
+            m_deltaStages[entry.m_deltaId * 2 - ((seg == 0) ? 2 : 1)].push_back(recoveryTask);
+        }
+    }
+    CheckpointUtils::CloseFile(fd);
+    MOT_LOG_INFO("CheckpointRecovery::FillTasksFromDeltaMapFile: %lu tables have deltas", m_deltaTableIds.size());
+    return true;
+}
+
 bool CheckpointRecovery::RecoverTableMetadata(uint32_t tableId)
 {
     int fd = -1;
@@ -365,7 +471,10 @@ void CheckpointRecovery::CheckpointRecoveryWorker(CheckpointRecovery* checkpoint
         CheckpointRecovery::Task* task = checkpointRecovery->GetTask();
         if (task != nullptr) {
             bool hadError = false;
-            if (!checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status)) {
+            bool recovered = (task->m_type == SECONDARY_INDEX)
+                                 ? checkpointRecovery->RecoverSecondaryIndex(task, status)
+                                 : checkpointRecovery->RecoverTableRows(task, keyData, entryData, maxCsn, sState, status);
+            if (!recovered) {
                 MOT_LOG_ERROR("CheckpointRecovery::WorkerFunc recovery of table %lu's data failed", task->m_tableId);
                 checkpointRecovery->OnError(status,
                     "CheckpointRecovery::WorkerFunc failed to recover table: ",
@@ -418,7 +527,11 @@ bool CheckpointRecovery::RecoverTableRows(
     }
 
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    if (task->m_deltaId > 0) {
+        CheckpointUtils::MakeDeltaFilename(tableId, fileName, m_workingDir, task->m_deltaId, seg);
+    } else {
+        CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    }
     if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
         MOT_LOG_ERROR("CheckpointRecovery::RecoverTableRows: failed to open file: %s", fileName.c_str());
         return false;
@@ -450,6 +563,7 @@ bool CheckpointRecovery::RecoverTableRows(
         return false;
     }
 
+    bool skipSecIndex = (m_deltaTableIds.find(tableId) != m_deltaTableIds.end());
     CheckpointUtils::EntryHeader entry;
     for (uint64_t i = 0; i < fileHeader.m_numOps; i++) {
         reader = CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointUtils::EntryHeader));
@@ -496,16 +610,33 @@ bool CheckpointRecovery::RecoverTableRows(
             break;
         }
 
-        InsertRow(table,
-            keyData,
-            entry.m_keyLen,
-            entryData,
-            entry.m_dataLen,
-            entry.m_csn,
-            MOTCurrThreadId,
-            sState,
-            status,
-            entry.m_rowId);
+        if (task->m_type == DELETED_KEYS) {
+            RemoveRow(table, keyData, entry.m_keyLen, MOTCurrThreadId);
+            continue;
+        } else if (task->m_deltaId > 0) {
+            UpsertRow(table,
+                keyData,
+                entry.m_keyLen,
+                entryData,
+                entry.m_dataLen,
+                entry.m_csn,
+                MOTCurrThreadId,
+                sState,
+                status,
+                entry.m_rowId);
+        } else {
+            InsertRow(table,
+                keyData,
+                entry.m_keyLen,
+                entryData,
+                entry.m_dataLen,
+                entry.m_csn,
+                MOTCurrThreadId,
+                sState,
+                status,
+                entry.m_rowId,
+                skipSecIndex);
+        }
 
         if (status != RC_OK) {
             MOT_LOG_ERROR(
@@ -518,15 +649,40 @@ bool CheckpointRecovery::RecoverTableRows(
     }
     CheckpointUtils::CloseFile(fd);
 
-    MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u, %lu rows recovered (%s)",
+    MOT_LOG_DEBUG("[%u] CheckpointRecovery::RecoverTableRows table %u:%u:%u, %lu rows recovered (%s)",
         MOTCurrThreadId,
         tableId,
+        task->m_deltaId,
         seg,
         fileHeader.m_numOps,
         (status == RC_OK) ? "OK" : "Error");
     return (status == RC_OK);
 }
 
+bool CheckpointRecovery::RecoverSecondaryIndex(Task* task, RC& status)
+{
+    Table* table = GetTableManager()->GetTable(task->m_tableId);
+    if (table == nullptr || task->m_segId >= table->GetNumIndexes()) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL,
+            "CheckpointRecovery::RecoverSecondaryIndex",
+            "Index %u of table %u does not exist",
+            task->m_segId,
+            task->m_tableId);
+        status = RC_ERROR;
+        return false;
+    }
+
+    if (!table->CreateSecondaryIndexDataNonTransactional(table->GetSecondaryIndex(task->m_segId), MOTCurrThreadId)) {
+        MOT_LOG_ERROR("CheckpointRecovery::RecoverSecondaryIndex: failed to build index %u of table %u",
+            task->m_segId,
+            task->m_tableId);
+        status = RC_ERROR;
+        return false;
+    }
+    status = RC_OK;
+    return true;
+}
+
 CheckpointRecovery::Task* CheckpointRecovery::GetTask()
 {
     Task* task = nullptr;
@@ -567,7 +723,7 @@ bool CheckpointRecovery::IsMemoryLimitReached(uint32_t numThreads, uint32_t need
 }
 
 void CheckpointRecovery::InsertRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen,
-    uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId)
+    uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId, bool skipSecIndex)
 {
     MaxKey key;
     Row* row = table->CreateNewRow();
@@ -586,13 +742,50 @@ void CheckpointRecovery::InsertRow(Table* table, char* keyData, uint16_t keyLen,
         sState.UpdateMaxKey(rowId);
     }
     key.CpKey((const uint8_t*)keyData, keyLen);
-    status = table->InsertRowNonTransactional(row, tid, &key);
+    status = table->InsertRowNonTransactional(row, tid, &key, skipSecIndex);
     if (status != RC_OK) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM, "Recovery Manager Insert Row", "failed to insert row");
         table->DestroyRow(row);
     }
 }
 
+void CheckpointRecovery::UpsertRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen,
+    uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId)
+{
+    MaxKey key;
+    key.CpKey((const uint8_t*)keyData, keyLen);
+    Row* row = table->GetPrimaryIndex()->IndexRead(&key, tid);
+    if (row == nullptr) {
+        InsertRow(table, keyData, keyLen, rowData, rowLen, csn, tid, sState, status, rowId, true);
+        return;
+    }
+
+    // secondary indexes are not built yet, so the row can be overwritten in place
+    row->CopyData((const uint8_t*)rowData, rowLen);
+    row->SetCommitSequenceNumber(csn);
+    row->SetRowId(rowId);
+    status = RC_OK;
+}
+
+void CheckpointRecovery::RemoveRow(Table* table, char* keyData, uint16_t keyLen, uint32_t tid)
+{
+    MaxKey key;
+    key.CpKey((const uint8_t*)keyData, keyLen);
+    Index* ix = table->GetPrimaryIndex();
+    if (ix->IndexReadSentinel(&key, tid) == nullptr) {
+        // the row was inserted and deleted between two checkpoints
+        return;
+    }
+
+    // there are no concurrent readers during recovery, so the row is released right away
+    Sentinel* sentinel = ix->IndexRemove(&key, tid);
+    Row* row = sentinel->GetData();
+    if (row != nullptr) {
+        table->DestroyRow(row);
+    }
+    (void)Index::SentinelDtor(sentinel, nullptr, false);
+}
+
 bool CheckpointRecovery::RecoverInProcessTxns()
 {
     int fd = -1;
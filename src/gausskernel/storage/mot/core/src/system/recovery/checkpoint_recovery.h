@@ -27,6 +27,7 @@
 
 #include <set>
 #include <list>
+#include <vector>
 #include <mutex>
 #include "global.h"
 #include "spin_lock.h"
@@ -66,17 +67,31 @@ public:
         return m_stopWorkers;
     }
 
+    /**
+     * @brief The type of a checkpoint recovery task: rows of a full image or a delta,
+     * keys deleted in a delta or building a secondary index once all deltas were applied.
+     */
+    enum TaskType { ROWS = 0, DELETED_KEYS = 1, SECONDARY_INDEX = 2 };
+
     /**
      * @struct Task
      * @brief Describes a checkpoint recovery task by its table id and
      * segment file number.
      */
     struct Task {
-        explicit Task(uint32_t tableId = 0, uint32_t segId = 0) : m_tableId(tableId), m_segId(segId)
+        explicit Task(uint32_t tableId = 0, uint32_t segId = 0, uint32_t deltaId = 0, TaskType type = ROWS)
+            : m_tableId(tableId), m_segId(segId), m_deltaId(deltaId), m_type(type)
         {}
 
         uint32_t m_tableId;
+
+        // the segment file number, or the index number of a secondary index task
         uint32_t m_segId;
+
+        // the delta number, 0 for the full image
+        uint32_t m_deltaId;
+
+        TaskType m_type;
     };
 
     /**
@@ -99,6 +114,14 @@ public:
     bool RecoverTableRows(
         Task* task, char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState, RC& status);
 
+    /**
+     * @brief Builds a secondary index of a table that was recovered from deltas.
+     * @param task The task (tableid / index number) to recover.
+     * @param status RC returned from the index build.
+     * @return Boolean value denoting success or failure.
+     */
+    bool RecoverSecondaryIndex(Task* task, RC& status);
+
     uint64_t GetLsn() const
     {
         return m_lsn;
@@ -127,6 +150,18 @@ private:
      */
     int FillTasksFromMapFile();
 
+    /**
+     * @brief Reads the checkpoint delta map file, if any, and fills the
+     * delta recovery stages with the relevant information.
+     * @return Boolean value denoting success or failure.
+     */
+    bool FillTasksFromDeltaMapFile();
+
+    /**
+     * @brief Runs the recovery workers until the tasks queue is drained.
+     */
+    void RunWorkers();
+
     /**
      * @brief Checks if there are any more tasks left in the queue
      * @return Int value where 0 means failure and 1 success
@@ -161,10 +196,27 @@ private:
      * @param sState the returned surrogate state.
      * @param status the returned status of the operation
      * @param rowId the row's internal id
+     * @param skipSecIndex determines if secondaries should be skipped
      */
     void InsertRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen, uint64_t csn,
+        uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId, bool skipSecIndex = false);
+
+    /**
+     * @brief Inserts a row from a delta, or overwrites the row with the same key.
+     * The parameters are the same as in InsertRow.
+     */
+    void UpsertRow(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen, uint64_t csn,
         uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId);
 
+    /**
+     * @brief Removes a row deleted in a delta from the primary index, if it exists.
+     * @param table the table's object pointer.
+     * @param keyData key's data buffer.
+     * @param keyLen key's data buffer len.
+     * @param tid the thread id of the recovering thread.
+     */
+    void RemoveRow(Table* table, char* keyData, uint16_t keyLen, uint32_t tid);
+
     /**
      * @brief performs table creation.
      * @param data the table's data
@@ -213,6 +265,13 @@ private:
     std::set<uint32_t> m_tableIds;
 
     std::list<Task*> m_tasksList;
+
+    // Tasks recovering the deltas, run in order after the full images: deleted keys
+    // and rows of each delta, followed by the secondary indexes build
+    std::vector<std::list<Task*>> m_deltaStages;
+
+    // Tables that have deltas, their secondary indexes are built at the end
+    std::set<uint32_t> m_deltaTableIds;
 };
 }  // namespace MOT
 
@@ -76,4 +76,18 @@ bool InProcessTransactions::FindTransactionId(uint64_t externalId, uint64_t& int
     }
     return false;
 }
+
+RedoLogTransactionSegments* InProcessTransactions::DetachTransaction(uint64_t internalId, uint64_t externalId)
+{
+    RedoLogTransactionSegments* segments = nullptr;
+    const std::lock_guard<std::mutex> lock(m_lock);
+    auto it = m_map.find(internalId);
+    if (it != m_map.end()) {
+        segments = it->second;
+        m_map.erase(it);
+        m_extToInt.erase(externalId);
+        m_numEntries--;
+    }
+    return segments;
+}
 }  // namespace MOT
@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * parallel_redo.cpp
+ *    Replays committed redo log transactions on several worker threads.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/recovery/parallel_redo.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <algorithm>
+#include "parallel_redo.h"
+#include "recovery_manager.h"
+#include "recovery_ops.h"
+#include "mot_engine.h"
+#include "bitmapset.h"
+#include "column.h"
+
+namespace MOT {
+DECLARE_LOGGER(ParallelRedo, Recovery);
+
+static inline uint64_t HashBytes(uint64_t hash, const uint8_t* data, uint32_t len)
+{
+    // FNV-1a
+    constexpr uint64_t prime = 1099511628211ULL;
+    for (uint32_t i = 0; i < len; ++i) {
+        hash ^= data[i];
+        hash *= prime;
+    }
+    return hash;
+}
+
+static inline uint64_t HashRow(uint64_t exId, const uint8_t* keyData, uint16_t keyLength)
+{
+    constexpr uint64_t offsetBasis = 14695981039346656037ULL;
+    uint64_t hash = HashBytes(offsetBasis, (const uint8_t*)&exId, sizeof(exId));
+    if (keyData != nullptr) {
+        hash = HashBytes(hash, keyData, keyLength);
+    }
+    return hash;
+}
+
+ParallelRedo::ParallelRedo(RecoveryManager* recoveryManager, uint32_t numWorkers)
+    : m_recoveryManager(recoveryManager),
+      m_numWorkers(numWorkers),
+      m_workers(nullptr),
+      m_dispatchedSeq(0),
+      m_committedSeq(0),
+      m_running(false),
+      m_stop(false),
+      m_errorSet(false)
+{
+    for (uint32_t i = 0; i < NUM_BUCKETS; ++i) {
+        m_bucketOwners[i].m_seq = 0;
+        m_bucketOwners[i].m_worker = 0;
+    }
+}
+
+ParallelRedo::~ParallelRedo()
+{
+    (void)Stop();
+    if (m_workers != nullptr) {
+        delete[] m_workers;
+        m_workers = nullptr;
+    }
+}
+
+bool ParallelRedo::Start()
+{
+    if (m_workers == nullptr) {
+        m_workers = new (std::nothrow) RedoWorker[m_numWorkers];
+        if (m_workers == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Parallel Redo", "Failed to allocate %u redo workers", m_numWorkers);
+            return false;
+        }
+    }
+
+    m_stop = false;
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        m_workers[i].m_thread = std::thread(RedoWorkerFunc, this, i);
+    }
+    m_running = true;
+    MOT_LOG_INFO("Started %u parallel redo workers", m_numWorkers);
+    return true;
+}
+
+bool ParallelRedo::Stop()
+{
+    std::lock_guard<std::mutex> dispatchLock(m_dispatchLock);
+    if (m_running) {
+        WaitIdle();
+        {
+            std::lock_guard<std::mutex> lock(m_lock);
+            m_stop = true;
+        }
+        m_cond.notify_all();
+
+        for (uint32_t i = 0; i < m_numWorkers; ++i) {
+            if (m_workers[i].m_thread.joinable()) {
+                m_workers[i].m_thread.join();
+            }
+            // left behind by a failure
+            for (RedoTask& task : m_workers[i].m_queue) {
+                delete task.m_segments;
+            }
+            m_workers[i].m_queue.clear();
+        }
+        m_running = false;
+        MOT_LOG_INFO("Stopped parallel redo workers after %" PRIu64 " transactions", m_committedSeq);
+    }
+
+    // the next run (e.g. after switchover) starts over
+    bool success = !m_errorSet;
+    m_dispatchedSeq = 0;
+    m_committedSeq = 0;
+    m_errorSet = false;
+    for (uint32_t i = 0; i < NUM_BUCKETS; ++i) {
+        m_bucketOwners[i].m_seq = 0;
+    }
+    return success;
+}
+
+bool ParallelRedo::Dispatch(RedoLogTransactionSegments* segments, SurrogateState& sState)
+{
+    std::lock_guard<std::mutex> dispatchLock(m_dispatchLock);
+    if (m_errorSet) {
+        delete segments;
+        return false;
+    }
+
+    if (!CollectBuckets(segments) || (!m_running && !Start())) {
+        return RedoInline(segments, sState);
+    }
+
+    // the worker is chosen by the first modified row, so single-row transactions never wait for each other
+    uint32_t workerId = m_buckets.front() % m_numWorkers;
+    std::sort(m_buckets.begin(), m_buckets.end());
+    m_buckets.erase(std::unique(m_buckets.begin(), m_buckets.end()), m_buckets.end());
+
+    RedoTask task;
+    task.m_segments = segments;
+    task.m_dependency = 0;
+    for (uint32_t bucket : m_buckets) {
+        // earlier transactions of the same worker are replayed before this one anyway
+        const BucketOwner& owner = m_bucketOwners[bucket];
+        if (owner.m_worker != workerId && owner.m_seq > task.m_dependency) {
+            task.m_dependency = owner.m_seq;
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_cond.wait(lock, [this, workerId] {
+        return m_workers[workerId].m_queue.size() < MAX_QUEUE_DEPTH || m_errorSet;
+    });
+    if (m_errorSet) {
+        lock.unlock();
+        delete segments;
+        return false;
+    }
+    task.m_seq = ++m_dispatchedSeq;
+    m_workers[workerId].m_queue.push_back(task);
+    lock.unlock();
+    m_cond.notify_all();
+
+    for (uint32_t bucket : m_buckets) {
+        m_bucketOwners[bucket].m_seq = task.m_seq;
+        m_bucketOwners[bucket].m_worker = workerId;
+    }
+    return true;
+}
+
+bool ParallelRedo::RedoInline(RedoLogTransactionSegments* segments, SurrogateState& sState)
+{
+    WaitIdle();
+
+    RC status = RC_ERROR;
+    if (!m_errorSet) {
+        status = m_recoveryManager->RedoTransaction(segments, segments->GetTransactionId(), sState);
+    }
+    delete segments;
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    // all workers are idle, so the transaction committed right after the last queued one
+    m_committedSeq = ++m_dispatchedSeq;
+    return (status == RC_OK);
+}
+
+void ParallelRedo::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_cond.wait(lock, [this] { return m_committedSeq == m_dispatchedSeq || m_errorSet; });
+}
+
+bool ParallelRedo::CollectBuckets(RedoLogTransactionSegments* segments)
+{
+    m_buckets.clear();
+    for (uint32_t i = 0; i < segments->GetCount(); ++i) {
+        LogSegment* segment = segments->GetSegment(i);
+        uint8_t* data = (uint8_t*)segment->m_data;
+        uint8_t* endPosition = data + segment->m_len;
+        while (data < endPosition) {
+            uint8_t* opData = data;
+            OperationCode opCode = *(OperationCode*)data;
+            data += sizeof(OperationCode);
+            switch (opCode) {
+                case CREATE_ROW:
+                case UPDATE_ROW:
+                case OVERWRITE_ROW:
+                case REMOVE_ROW:
+                    if (!CollectRowBucket(opCode, data)) {
+                        return false;
+                    }
+                    break;
+                case COMMIT_TX:
+                case PARTIAL_REDO_TX:
+                    data = opData + sizeof(EndSegmentBlock);
+                    break;
+                default:
+                    // DDL and two-phase commit operations
+                    return false;
+            }
+        }
+    }
+    return !m_buckets.empty();
+}
+
+bool ParallelRedo::CollectRowBucket(OperationCode opCode, uint8_t*& data)
+{
+    uint64_t tableId = 0;
+    uint64_t exId = 0;
+    uint64_t rowId = 0;
+    uint64_t rowLength = 0;
+    uint16_t keyLength = 0;
+
+    RecoveryOps::Extract(data, tableId);
+    RecoveryOps::Extract(data, exId);
+    if (opCode == CREATE_ROW) {
+        RecoveryOps::Extract(data, rowId);
+    }
+    RecoveryOps::Extract(data, keyLength);
+    uint8_t* keyData = RecoveryOps::ExtractPtr(data, keyLength);
+
+    // tables are created and dropped only while all workers are idle
+    Table* table = GetTableManager()->GetTableByExternal(exId);
+    if (table == nullptr) {
+        // let the serial replay report it
+        return false;
+    }
+
+    switch (opCode) {
+        case CREATE_ROW:
+        case OVERWRITE_ROW:
+            RecoveryOps::Extract(data, rowLength);
+            (void)RecoveryOps::ExtractPtr(data, rowLength);
+            break;
+        case UPDATE_ROW: {
+            uint16_t numColumns = table->GetFieldCount() - 1;
+            BitmapSet updatedColumns(RecoveryOps::ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+            BitmapSet validColumns(RecoveryOps::ExtractPtr(data, BitmapSet::GetLength(numColumns)), numColumns);
+            BitmapSet::BitmapSetIterator updatedIt(updatedColumns);
+            BitmapSet::BitmapSetIterator validIt(validColumns);
+            while (!updatedIt.End()) {
+                if (updatedIt.IsSet() && validIt.IsSet()) {
+                    data += table->GetField(updatedIt.GetPosition() + 1)->m_size;
+                }
+                validIt.Next();
+                updatedIt.Next();
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    // a unique secondary key may move between rows, so such tables are replayed by a single worker at a time
+    uint64_t hash = HasUniqueSecondaryIndex(table) ? HashRow(exId, nullptr, 0) : HashRow(exId, keyData, keyLength);
+    m_buckets.push_back((uint32_t)(hash % NUM_BUCKETS));
+    return true;
+}
+
+bool ParallelRedo::HasUniqueSecondaryIndex(Table* table)
+{
+    for (uint16_t i = 1; i < table->GetNumIndexes(); ++i) {
+        if (table->GetSecondaryIndex(i)->GetUnique()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ParallelRedo::GetTask(uint32_t workerId, RedoTask& task)
+{
+    std::deque<RedoTask>& queue = m_workers[workerId].m_queue;
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_cond.wait(lock, [this, &queue] { return !queue.empty() || m_stop || m_errorSet; });
+    if (queue.empty() || m_errorSet) {
+        return false;
+    }
+
+    uint64_t dependency = queue.front().m_dependency;
+    m_cond.wait(lock, [this, dependency] { return m_committedSeq >= dependency || m_errorSet; });
+    if (m_errorSet) {
+        return false;
+    }
+
+    task = queue.front();
+    queue.pop_front();
+    lock.unlock();
+    m_cond.notify_all();
+    return true;
+}
+
+void ParallelRedo::WaitCommitTurn(uint64_t commitSeq)
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_cond.wait(lock, [this, commitSeq] { return m_committedSeq + 1 >= commitSeq || m_errorSet; });
+}
+
+void ParallelRedo::EndCommitTurn(uint64_t commitSeq)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (m_committedSeq < commitSeq) {
+            m_committedSeq = commitSeq;
+        }
+    }
+    m_cond.notify_all();
+}
+
+void ParallelRedo::OnError(RC status, uint64_t transactionId)
+{
+    MOT_LOG_ERROR("Parallel redo of transaction %" PRIu64 " failed: %s (error code: %d)",
+        transactionId,
+        RcToString(status),
+        (int)status);
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_errorSet = true;
+    }
+    m_cond.notify_all();
+}
+
+void ParallelRedo::RedoWorkerFunc(ParallelRedo* parallelRedo, uint32_t workerId)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    MOTEngine* engine = MOTEngine::GetInstance();
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        parallelRedo->OnError(RC_MEMORY_ALLOCATION_ERROR, 0);
+        engine->OnCurrentThreadEnding();
+        return;
+    }
+
+    // in a thread-pooled envelope the affinity could be disabled, so we use task affinity here
+    if (GetGlobalConfiguration().m_enableNuma && !GetTaskAffinity().SetAffinity(MOTCurrThreadId)) {
+        MOT_LOG_WARN("Failed to set affinity of parallel redo worker, redo replay performance may be affected");
+    }
+
+    SurrogateState sState;
+    if (!sState.IsValid()) {
+        parallelRedo->OnError(RC_MEMORY_ALLOCATION_ERROR, 0);
+    } else {
+        RedoTask task;
+        while (parallelRedo->GetTask(workerId, task)) {
+            uint64_t transactionId = task.m_segments->GetTransactionId();
+            RC status =
+                parallelRedo->m_recoveryManager->RedoTransaction(task.m_segments, transactionId, sState, task.m_seq);
+            delete task.m_segments;
+            if (status != RC_OK) {
+                parallelRedo->OnError(status, transactionId);
+                break;
+            }
+            // in case the transaction had no commit record
+            parallelRedo->WaitCommitTurn(task.m_seq);
+            parallelRedo->EndCommitTurn(task.m_seq);
+        }
+        if (!sState.IsEmpty()) {
+            GetRecoveryManager()->AddSurrogateArrayToList(sState);
+        }
+    }
+
+    GetSessionManager()->DestroySessionContext(sessionContext);
+    engine->OnCurrentThreadEnding();
+    MOT_LOG_DEBUG("Parallel redo worker %u stopped", workerId);
+}
+}  // namespace MOT
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * parallel_redo.h
+ *    Replays committed redo log transactions on several worker threads.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/recovery/parallel_redo.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef PARALLEL_REDO_H
+#define PARALLEL_REDO_H
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "global.h"
+#include "redo_log_transaction_segments.h"
+#include "surrogate_state.h"
+
+namespace MOT {
+class RecoveryManager;
+class Table;
+
+/**
+ * @class ParallelRedo
+ * @brief Replays committed redo log transactions on several worker threads.
+ * @detail Each transaction is queued to a worker chosen by the hash of the first row it modifies. A transaction that
+ * also modifies rows last modified by a transaction queued to another worker waits for that transaction to commit
+ * before it starts, so changes to the same row are always replayed in log order. Transactions commit in the order
+ * they were dispatched, so a checkpoint taken on a standby, as well as a snapshot reader, never sees a transaction
+ * without all the transactions logged before it. Transactions with DDL or two-phase commit operations are replayed
+ * by the dispatching thread once all workers are idle.
+ */
+class ParallelRedo {
+public:
+    ParallelRedo(RecoveryManager* recoveryManager, uint32_t numWorkers);
+    ParallelRedo(const ParallelRedo& orig) = delete;
+    ParallelRedo& operator=(const ParallelRedo& orig) = delete;
+    ~ParallelRedo();
+
+    /**
+     * @brief Queues a committed transaction for replay, or replays it right away if it cannot be replayed in
+     * parallel.
+     * @param segments The transaction log segments. Ownership is passed to the callee.
+     * @param sState The surrogate state of the calling thread, used when the transaction is replayed inline.
+     * @return False if the transaction or a previously queued one failed.
+     */
+    bool Dispatch(RedoLogTransactionSegments* segments, SurrogateState& sState);
+
+    /**
+     * @brief Waits for all queued transactions to be replayed and stops the worker threads.
+     * @return False if any of the replayed transactions failed.
+     */
+    bool Stop();
+
+    /**
+     * @brief Waits until all transactions dispatched before the given one are committed.
+     * @param commitSeq The dispatch sequence number of the committing transaction.
+     */
+    void WaitCommitTurn(uint64_t commitSeq);
+
+    /**
+     * @brief Marks a transaction as committed, allowing the next one to commit.
+     * @param commitSeq The dispatch sequence number of the committed transaction.
+     */
+    void EndCommitTurn(uint64_t commitSeq);
+
+private:
+    /** @var Number of row hash buckets used to track the last transaction modifying a row. */
+    static constexpr uint32_t NUM_BUCKETS = 4096;
+
+    /** @var Maximum number of transactions queued to a single worker. */
+    static constexpr size_t MAX_QUEUE_DEPTH = 256;
+
+    /** @struct RedoTask A committed transaction queued for replay. */
+    struct RedoTask {
+        /** @var The transaction log segments. */
+        RedoLogTransactionSegments* m_segments;
+
+        /** @var Dispatch sequence number of the transaction. */
+        uint64_t m_seq;
+
+        /** @var Dispatch sequence number of the last transaction queued to another worker that this one depends on. */
+        uint64_t m_dependency;
+    };
+
+    /** @struct BucketOwner The last transaction modifying rows of a single hash bucket. */
+    struct BucketOwner {
+        uint64_t m_seq;
+
+        uint32_t m_worker;
+    };
+
+    /** @struct RedoWorker A single redo worker. */
+    struct RedoWorker {
+        std::thread m_thread;
+
+        std::deque<RedoTask> m_queue;
+    };
+
+    RecoveryManager* m_recoveryManager;
+
+    uint32_t m_numWorkers;
+
+    RedoWorker* m_workers;
+
+    /** @var Serializes dispatching threads. Protects the bucket owners and the dispatch buffer. */
+    std::mutex m_dispatchLock;
+
+    /** @var Protects the worker queues and the sequence numbers below. */
+    std::mutex m_lock;
+
+    std::condition_variable m_cond;
+
+    /** @var Sequence number of the last dispatched transaction. */
+    uint64_t m_dispatchedSeq;
+
+    /** @var Sequence number of the last committed transaction. All transactions before it are committed as well. */
+    uint64_t m_committedSeq;
+
+    BucketOwner m_bucketOwners[NUM_BUCKETS];
+
+    /** @var The buckets of the transaction being dispatched. */
+    std::vector<uint32_t> m_buckets;
+
+    bool m_running;
+
+    bool m_stop;
+
+    bool m_errorSet;
+
+    bool Start();
+
+    /**
+     * @brief Replays a transaction on the calling thread, after all queued transactions are replayed.
+     */
+    bool RedoInline(RedoLogTransactionSegments* segments, SurrogateState& sState);
+
+    /** @brief Waits for all queued transactions to be replayed. Caller must hold the dispatch lock. */
+    void WaitIdle();
+
+    /**
+     * @brief Collects the hash buckets of all rows modified by a transaction.
+     * @return False if the transaction contains operations that can not be replayed in parallel.
+     */
+    bool CollectBuckets(RedoLogTransactionSegments* segments);
+
+    /**
+     * @brief Collects the hash bucket of a single row operation.
+     * @param opCode The operation code.
+     * @param[in,out] data The operation data past the operation code. On return, points to the next operation.
+     * @return False if the operation can not be replayed in parallel.
+     */
+    bool CollectRowBucket(OperationCode opCode, uint8_t*& data);
+
+    static bool HasUniqueSecondaryIndex(Table* table);
+
+    /**
+     * @brief Retrieves the next transaction to replay by a worker, waiting for its dependency to commit.
+     * @return False if the worker should stop.
+     */
+    bool GetTask(uint32_t workerId, RedoTask& task);
+
+    void OnError(RC status, uint64_t transactionId);
+
+    static void RedoWorkerFunc(ParallelRedo* parallelRedo, uint32_t workerId);
+};
+}  // namespace MOT
+
+#endif /* PARALLEL_REDO_H */
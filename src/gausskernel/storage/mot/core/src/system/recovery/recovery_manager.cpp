@@ -62,6 +62,15 @@ bool RecoveryManager::Initialize()
         return false;
     }
 
+    if (m_numRedoWorkers > 1) {
+        m_parallelRedo = new (std::nothrow) ParallelRedo(this, m_numRedoWorkers);
+        if (m_parallelRedo == nullptr) {
+            MOT_REPORT_ERROR(
+                MOT_ERROR_OOM, "Recovery Manager Initialization", "Failed to allocate parallel redo object");
+            return false;
+        }
+    }
+
     m_initialized = true;
     return m_initialized;
 }
@@ -95,6 +104,12 @@ bool RecoveryManager::RecoverDbStart()
 
 bool RecoveryManager::RecoverDbEnd()
 {
+    // wait for the transactions still being replayed, the workers are started again on the next redo
+    if (m_parallelRedo != nullptr && !m_parallelRedo->Stop()) {
+        MOT_LOG_ERROR("MOT recovery: parallel redo failed");
+        m_errorSet = true;
+    }
+
     if (MOTEngine::GetInstance()->GetInProcessTransactions().GetNumTxns() != 0) {
         MOT_LOG_ERROR("MOT recovery: There are uncommitted or incomplete transactions, "
             "ignoring and clearing those log segments.");
@@ -128,6 +143,11 @@ void RecoveryManager::CleanUp()
         return;
     }
 
+    if (m_parallelRedo != nullptr) {
+        delete m_parallelRedo;
+        m_parallelRedo = nullptr;
+    }
+
     if (m_logStats != nullptr) {
         delete m_logStats;
         m_logStats = nullptr;
@@ -224,20 +244,19 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
     uint64_t internalTransactionId, uint64_t externalTransactionId, RecoveryOps::RecoveryOpState rState)
 {
     RC status = RC_OK;
+    if (rState != RecoveryOps::RecoveryOpState::ABORT && m_parallelRedo != nullptr) {
+        RedoLogTransactionSegments* segments = MOTEngine::GetInstance()->GetInProcessTransactions().DetachTransaction(
+            internalTransactionId, externalTransactionId);
+        if (segments == nullptr || !m_parallelRedo->Dispatch(segments, m_sState)) {
+            MOT_LOG_ERROR("OperateOnRecoveredTransaction: parallel wal recovery failed");
+            return false;
+        }
+        return true;
+    }
+
     if (rState != RecoveryOps::RecoveryOpState::ABORT) {
         auto operateLambda = [this](RedoLogTransactionSegments* segments, uint64_t id) -> RC {
-            RC redoStatus = RC_OK;
-            LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
-            uint64_t csn = segment->m_controlBlock.m_csn;
-            for (uint32_t i = 0; i < segments->GetCount(); i++) {
-                segment = segments->GetSegment(i);
-                redoStatus = RedoSegment(segment, csn, id, RecoveryOps::RecoveryOpState::COMMIT);
-                if (redoStatus != RC_OK) {
-                    MOT_LOG_ERROR("OperateOnRecoveredTransaction failed with rc %d", redoStatus);
-                    return redoStatus;
-                }
-            }
-            return redoStatus;
+            return RedoTransaction(segments, id, m_sState);
         };
 
         status = MOTEngine::GetInstance()->GetInProcessTransactions().ForUniqueTransaction(
@@ -250,8 +269,25 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
     return true;
 }
 
-RC RecoveryManager::RedoSegment(
-    LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState)
+RC RecoveryManager::RedoTransaction(
+    RedoLogTransactionSegments* segments, uint64_t transactionId, SurrogateState& sState, uint64_t commitSeq)
+{
+    RC redoStatus = RC_OK;
+    LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
+    uint64_t csn = segment->m_controlBlock.m_csn;
+    for (uint32_t i = 0; i < segments->GetCount(); i++) {
+        segment = segments->GetSegment(i);
+        redoStatus = RedoSegment(segment, csn, transactionId, RecoveryOps::RecoveryOpState::COMMIT, sState, commitSeq);
+        if (redoStatus != RC_OK) {
+            MOT_LOG_ERROR("OperateOnRecoveredTransaction failed with rc %d", redoStatus);
+            return redoStatus;
+        }
+    }
+    return redoStatus;
+}
+
+RC RecoveryManager::RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId,
+    RecoveryOps::RecoveryOpState rState, SurrogateState& sState, uint64_t commitSeq)
 {
     RC status = RC_OK;
     uint8_t* endPosition = (uint8_t*)(segment->m_data + segment->m_len);
@@ -260,8 +296,7 @@ RC RecoveryManager::RedoSegment(
     bool wasCommit = false;
 
     while (operationData < endPosition) {
-        // redo log recovery - single threaded
-        if (IsRecoveryMemoryLimitReached(NUM_REDO_RECOVERY_THREADS)) {
+        if (IsRecoveryMemoryLimitReached(m_numRedoWorkers)) {
             status = RC_ERROR;
             MOT_LOG_ERROR("Memory hard limit reached. Cannot recover datanode");
             break;
@@ -278,8 +313,14 @@ RC RecoveryManager::RedoSegment(
             txnStarted = true;
         }
 
+        // parallel redo commits in log order, so a checkpoint never misses a transaction logged before a captured one
+        bool isCommit = IsCommitOp(*(OperationCode*)operationData);
+        if (isCommit && commitSeq != 0) {
+            m_parallelRedo->WaitCommitTurn(commitSeq);
+        }
+
         operationData += RecoveryOps::RecoverLogOperation(
-            MOTCurrTxn, operationData, csn, transactionId, MOTCurrThreadId, m_sState, status, wasCommit);
+            MOTCurrTxn, operationData, csn, transactionId, MOTCurrThreadId, sState, status, wasCommit);
 
         // check operation result status
         if (status != RC_OK) {
@@ -290,13 +331,14 @@ RC RecoveryManager::RedoSegment(
         // update transactional state
         if (wasCommit) {
             txnStarted = false;
+            PublishCsn(csn);
+            if (commitSeq != 0) {
+                m_parallelRedo->EndCommitTurn(commitSeq);
+            }
         }
     }
 
-    // single threaded, no need for locking or CAS
-    if (csn > m_maxRecoveredCsn) {
-        m_maxRecoveredCsn = csn;
-    }
+    SetCsn(csn);
     if (status != RC_OK) {
         MOT_LOG_ERROR("RecoveryManager::redoSegment: got error %u on tid %lu", status, transactionId);
     }
@@ -345,6 +387,14 @@ void RecoveryManager::SetCsn(uint64_t csn)
     }
 }
 
+void RecoveryManager::PublishCsn(uint64_t csn)
+{
+    // commits are replayed one at a time in log order, so all transactions up to this csn are visible now
+    if (MOTEngine::GetInstance()->IsRecovering() && csn > GetCSNManager().GetCurrentCSN()) {
+        (void)GetCSNManager().SetCSN(csn);
+    }
+}
+
 void RecoveryManager::AddSurrogateArrayToList(SurrogateState& surrogate)
 {
     m_surrogateListLock.lock();
@@ -36,6 +36,7 @@
 #include "surrogate_state.h"
 #include "checkpoint_recovery.h"
 #include "recovery_ops.h"
+#include "parallel_redo.h"
 
 namespace MOT {
 /**
@@ -57,7 +58,9 @@ public:
           m_errorSet(false),
           m_clogCallback(nullptr),
           m_threadId(AllocThreadId()),
-          m_maxConnections(GetGlobalConfiguration().m_maxConnections)
+          m_maxConnections(GetGlobalConfiguration().m_maxConnections),
+          m_numRedoWorkers(GetGlobalConfiguration().m_parallelRedoWorkers),
+          m_parallelRedo(nullptr)
     {}
 
     ~RecoveryManager() override
@@ -114,6 +117,18 @@ public:
      */
     bool CommitRecoveredTransaction(uint64_t externalTransactionId) override;
 
+    /**
+     * @brief performs a redo on all the segments of a committed transaction.
+     * @param segments the transaction segments.
+     * @param transactionId the internal transaction id.
+     * @param sState the surrogate state of the calling thread.
+     * @param commitSeq the parallel redo dispatch sequence number of the
+     * transaction, or zero when it is replayed serially.
+     * @return RC value denoting the operation's status
+     */
+    RC RedoTransaction(RedoLogTransactionSegments* segments, uint64_t transactionId, SurrogateState& sState,
+        uint64_t commitSeq = 0);
+
     void SetCsn(uint64_t csn) override;
 
     /**
@@ -244,8 +259,6 @@ public:
     std::map<uint64_t, RecoveryOps::TableInfo*> m_preCommitedTables;
 
 private:
-    static constexpr uint32_t NUM_REDO_RECOVERY_THREADS = 1;
-
     /**
      * @brief performs a redo on a segment, which is either a recovery op
      * or a segment that belongs to a 2pc recovered transaction.
@@ -253,9 +266,20 @@ private:
      * @param csn the segment's csn
      * @param transactionId the transaction id of the segment
      * @param rState the operation to perform on the segment.
+     * @param sState the surrogate state of the calling thread.
+     * @param commitSeq the parallel redo dispatch sequence number of the
+     * transaction, or zero when it is replayed serially.
      * @return RC value denoting the operation's status
      */
-    RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState);
+    RC RedoSegment(LogSegment* segment, uint64_t csn, uint64_t transactionId, RecoveryOps::RecoveryOpState rState,
+        SurrogateState& sState, uint64_t commitSeq);
+
+    /**
+     * @brief makes all transactions replayed so far visible to snapshot
+     * readers on a standby.
+     * @param csn the csn of the last committed transaction.
+     */
+    void PublishCsn(uint64_t csn);
 
     /**
      * @brief inserts a segment in to the in-process transactions map
@@ -339,6 +363,10 @@ private:
     uint16_t m_maxConnections;
 
     CheckpointRecovery m_checkpointRecovery;
+
+    uint32_t m_numRedoWorkers;
+
+    ParallelRedo* m_parallelRedo;
 };
 }  // namespace MOT
 
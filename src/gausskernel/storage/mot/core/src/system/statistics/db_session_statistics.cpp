@@ -41,7 +41,10 @@ DbSessionThreadStatistics::DbSessionThreadStatistics(uint64_t threadId, void* in
       m_commitTxnCount(MakeName("commit-txn", threadId).c_str()),
       m_rollbackTxnCount(MakeName("rollback-txn", threadId).c_str()),
       m_commitPreparedTxnCount(MakeName("commit-prepared-txn", threadId).c_str()),
-      m_rollbackPreparedTxnCount(MakeName("rollback-prepared-txn", threadId).c_str())
+      m_rollbackPreparedTxnCount(MakeName("rollback-prepared-txn", threadId).c_str()),
+      m_rowVersionCount(MakeName("row-version", threadId).c_str()),
+      m_versionChainLength(MakeName("version-chain-length", threadId).c_str()),
+      m_gcEpochLag(MakeName("gc-epoch-lag", threadId).c_str())
 {
     RegisterStatistics(&m_txnCount);
     RegisterStatistics(&m_rowPerTxnCount);
@@ -52,6 +55,9 @@ DbSessionThreadStatistics::DbSessionThreadStatistics(uint64_t threadId, void* in
     RegisterStatistics(&m_rollbackTxnCount);
     RegisterStatistics(&m_commitPreparedTxnCount);
     RegisterStatistics(&m_rollbackPreparedTxnCount);
+    RegisterStatistics(&m_rowVersionCount);
+    RegisterStatistics(&m_versionChainLength);
+    RegisterStatistics(&m_gcEpochLag);
 }
 
 TypedStatisticsGenerator<DbSessionThreadStatistics, EmptyGlobalStatistics> DbSessionStatisticsProvider::m_generator;
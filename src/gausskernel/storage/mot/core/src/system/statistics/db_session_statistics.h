@@ -103,6 +103,24 @@ public:
         m_rollbackPreparedTxnCount.AddSample();
     }
 
+    /** @brief Updates the snapshot-read row version count statistics. */
+    inline void AddRowVersionCount()
+    {
+        m_rowVersionCount.AddSample();
+    }
+
+    /** @brief Updates the version-chain-length statistics. */
+    inline void AddVersionChainLength(uint64_t length)
+    {
+        m_versionChainLength.AddSample(length);
+    }
+
+    /** @brief Updates the GC epoch lag statistics. */
+    inline void AddGcEpochLag(uint64_t lag)
+    {
+        m_gcEpochLag.AddSample(lag);
+    }
+
 private:
     /** @var The transaction count statistic variable. */
     FrequencyStatisticVariable m_txnCount;
@@ -130,6 +148,15 @@ private:
 
     /** @var The rolled-back-prepared-transaction count statistic variable. */
     FrequencyStatisticVariable m_rollbackPreparedTxnCount;
+
+    /** @var The created row version count statistic variable. */
+    FrequencyStatisticVariable m_rowVersionCount;
+
+    /** @var The number of older row versions visited by a snapshot read. */
+    NumericStatisticVariable m_versionChainLength;
+
+    /** @var The distance between the global GC epoch and the oldest active epoch at snapshot transaction end. */
+    NumericStatisticVariable m_gcEpochLag;
 };
 
 /**
@@ -235,6 +262,33 @@ public:
         }
     }
 
+    /** @brief Records a row-version event. */
+    inline void AddRowVersion()
+    {
+        DbSessionThreadStatistics* dbts = GetCurrentThreadStatistics<DbSessionThreadStatistics>();
+        if (dbts != nullptr) {
+            dbts->AddRowVersionCount();
+        }
+    }
+
+    /** @brief Records the number of older row versions visited by a snapshot read. */
+    inline void AddVersionChainLength(uint64_t length)
+    {
+        DbSessionThreadStatistics* dbts = GetCurrentThreadStatistics<DbSessionThreadStatistics>();
+        if (dbts != nullptr) {
+            dbts->AddVersionChainLength(length);
+        }
+    }
+
+    /** @brief Records the GC epoch lag seen by a snapshot transaction. */
+    inline void AddGcEpochLag(uint64_t lag)
+    {
+        DbSessionThreadStatistics* dbts = GetCurrentThreadStatistics<DbSessionThreadStatistics>();
+        if (dbts != nullptr) {
+            dbts->AddGcEpochLag(lag);
+        }
+    }
+
     /**
      * @brief Derives classes should react to a notification that configuration changed. New
      * configuration is accessible via the ConfigManager.
@@ -47,6 +47,7 @@ public:
     {
         m_localInsertRow = nullptr;
         m_auxRow = nullptr;
+        m_versionRow = nullptr;
         m_origSentinel = nullptr;
         m_stmtCount = 0;
         m_params.AssignParams(0);
@@ -80,6 +81,9 @@ public:
     /** @var The auxiliary row */
     Row* m_auxRow = nullptr;
 
+    /** @var Pre-allocated copy of the global row, kept as its previous version for snapshot reads. */
+    Row* m_versionRow = nullptr;
+
     /** @var The original row header */
     Sentinel* m_origSentinel = nullptr;
 
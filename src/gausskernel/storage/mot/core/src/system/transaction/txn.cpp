@@ -94,6 +94,11 @@ Row* TxnManager::RowLookup(const AccessType type, Sentinel* const& originalSenti
     // if txn not started, tag as started and take global epoch
     GcSessionStart();
 
+    if (type == AccessType::RD && IsSnapshotRead()) {
+        TrackSnapshotTable(originalSentinel->GetIndex()->GetTable());
+        return m_accessMgr->GetSnapshotRow(originalSentinel, m_snapshotCsn, rc);
+    }
+
     RC res = AccessLookup(type, originalSentinel, local_row);
 
     switch (res) {
@@ -197,6 +202,7 @@ void TxnManager::RollbackInternal(bool isPrepared)
     } else {
         m_occManager.ReleaseLocks(this);
     }
+    m_occManager.FreeRowVersions(this);
 
     // We have to undo changes to secondary indexes and ddls
     m_occManager.RollbackInserts(this);
@@ -217,7 +223,7 @@ void TxnManager::CleanTxn()
 RC TxnManager::Prepare()
 {
     // Run only first validation phase
-    RC rc = m_occManager.ValidateOcc(this);
+    RC rc = ValidateCommit();
     if (rc == RC_OK) {
         m_redoLog.Prepare();
     }
@@ -247,6 +253,9 @@ void TxnManager::CommitInternal()
         GetCheckpointManager()->EndCommit(this);
     }
 
+    // a pipelined redo log writes in the background of the above, the envelope commit record must follow it
+    m_redoLog.WaitCommitTicket();
+
     if (!GetGlobalConfiguration().m_enableRedoLog) {
         m_occManager.ReleaseLocks(this);
     }
@@ -254,9 +263,25 @@ void TxnManager::CommitInternal()
 
 RC TxnManager::ValidateCommit()
 {
+    if (m_snapshotRead) {
+        // Snapshot reads are not recorded in the read set, and the deleted keys they need are kept for them
+        return RC_OK;
+    }
     return m_occManager.ValidateOcc(this);
 }
 
+bool TxnManager::IsSnapshotRead()
+{
+    if (!m_snapshotRead && m_readOnly && m_isolationLevel > READ_COMMITED && m_accessMgr->m_rowCnt == 0 &&
+        m_txnDdlAccess->Size() == 0) {
+        // Versions needed by the snapshot are retired only after it is taken, so the GC epoch must be taken first
+        GcSessionStart();
+        m_snapshotCsn = GetCSNManager().GetCurrentCSN();
+        m_snapshotRead = true;
+    }
+    return m_snapshotRead;
+}
+
 void TxnManager::RecordCommit()
 {
     CommitInternal();
@@ -298,6 +323,8 @@ void TxnManager::CommitPrepared()
         GetCheckpointManager()->EndCommit(this);
     }
 
+    m_redoLog.WaitCommitTicket();
+
     if (!GetGlobalConfiguration().m_enableRedoLog) {
         m_occManager.ReleaseLocks(this);
     }
@@ -327,10 +354,12 @@ void TxnManager::EndTransaction()
 void TxnManager::RedoWriteAction(bool isCommit)
 {
     m_redoLog.SetForceWrite();
-    if (isCommit)
+    if (isCommit) {
         m_redoLog.Commit();
-    else
+        m_redoLog.WaitCommitTicket();
+    } else {
         m_redoLog.Rollback();
+    }
 }
 
 void TxnManager::Cleanup()
@@ -338,6 +367,17 @@ void TxnManager::Cleanup()
     if (m_isLightSession == false) {
         m_accessMgr->ClearSet();
     }
+    if (m_snapshotRead) {
+        MOT::DbSessionStatisticsProvider::GetInstance().AddGcEpochLag(g_gcGlobalEpoch - g_gcActiveEpoch);
+        for (Table* table : m_snapshotTables) {
+            table->RemoveDeferredKeys(GetGcSession(), GetThdId(), false);
+        }
+        m_snapshotRead = false;
+        m_snapshotCsn = CSNManager::INVALID_CSN;
+        m_lastSnapshotTable = nullptr;
+        m_snapshotTables.clear();
+    }
+    m_readOnly = false;
     m_txnDdlAccess->Reset();
     m_checkpointPhase = CheckpointPhase::NONE;
     m_csn = CSNManager::INVALID_CSN;
@@ -495,6 +535,8 @@ void TxnManager::RollbackDDLs()
                     }
                 }
                 table->ReplaceRowPool(indexArr->GetRowPool());
+                // a checkpoint might have written the table while it was empty
+                table->SetFullCheckpointRequired(true);
                 table->Unlock();
                 delete indexArr;
                 break;
@@ -612,6 +654,9 @@ Row* TxnManager::RowLookupByKey(Table* const& table, const AccessType type, Key*
     RC rc = RC_OK;
     Row* originalRow = nullptr;
     Sentinel* pSentinel = nullptr;
+    if (type == AccessType::RD) {
+        TrackSnapshotTable(table);
+    }
     table->FindRow(currentKey, pSentinel, GetThdId());
     if (pSentinel == nullptr) {
         MOT_LOG_DEBUG("Cannot find key:%" PRIu64 " from table:%s", m_key, table->GetLongTableName().c_str());
@@ -639,6 +684,10 @@ TxnManager::TxnManager(SessionContext* session_context)
       m_internalTransactionId(((uint64_t)m_sessionContext->GetSessionId()) << SESSION_ID_BITS),
       m_internalStmtCount(0),
       m_isolationLevel(READ_COMMITED),
+      m_readOnly(false),
+      m_snapshotRead(false),
+      m_snapshotCsn(CSNManager::INVALID_CSN),
+      m_lastSnapshotTable(nullptr),
       m_isLightSession(false),
       m_errIx(nullptr),
       m_err(RC_OK)
@@ -741,6 +790,11 @@ void TxnManager::SetTxnIsoLevel(int envelopeIsoLevel)
     m_isolationLevel = envelopeIsoLevel;
 }
 
+void TxnManager::SetTxnReadOnly(bool envelopeReadOnly)
+{
+    m_readOnly = envelopeReadOnly && !m_isLightSession && GetGlobalConfiguration().m_enableSnapshotRead;
+}
+
 void TxnManager::GcSessionRecordRcu(
     uint32_t index_id, void* object_ptr, void* object_pool, DestroyValueCbFunc cb, uint32_t obj_size)
 {
@@ -1070,6 +1124,10 @@ RC TxnManager::TruncateTable(Table* table)
         }
     }
 
+    // no snapshot reader can access the table now, remove the deleted keys kept for them
+    GcSessionStart();
+    table->RemoveDeferredKeys(GetGcSession(), GetThdId(), true);
+
     // clean all GC elements for the table, this call should actually release
     // all elements into an appropriate object pool
     for (uint16_t i = 0; i < table->GetNumIndexes(); i++) {
@@ -1135,6 +1193,8 @@ RC TxnManager::TruncateTable(Table* table)
             else  // is primary
                 table->m_primaryIndex = index_copy;
         }
+        // the rows of the table are gone, deltas on top of its last checkpoint image are meaningless
+        table->SetFullCheckpointRequired(true);
         m_txnDdlAccess->Add(ddl_access);
     }
 
@@ -1233,6 +1293,10 @@ RC TxnManager::DropIndex(MOT::Index* index)
         }
     }
 
+    // no snapshot reader can access the table now, remove the deleted keys kept for them
+    GcSessionStart();
+    table->RemoveDeferredKeys(GetGcSession(), GetThdId(), true);
+
     table->RemoveSecondaryIndexFromMetaData(index);
     m_txnDdlAccess->Add(new_ddl_access);
     return res;
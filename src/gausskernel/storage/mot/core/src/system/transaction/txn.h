@@ -31,6 +31,7 @@
 #include <cstring>
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "global.h"
 #include "redo_log.h"
@@ -111,6 +112,12 @@ public:
         return m_connectionId;
     }
 
+    /** @brief Retrieves the checkpoint phase in which the current commit started. */
+    inline CheckpointPhase GetCheckpointPhase() const
+    {
+        return m_checkpointPhase;
+    }
+
     inline uint64_t GetCommitSequenceNumber() const
     {
         return m_csn;
@@ -371,6 +378,25 @@ public:
      */
     void SetTxnIsoLevel(int envelopeIsoLevel);
 
+    /**
+     * @brief Sets whether the envelope transaction is read-only. Read-only transactions use snapshot reads when
+     * these are enabled.
+     */
+    void SetTxnReadOnly(bool envelopeReadOnly);
+
+    /**
+     * @brief Records a table scanned by a snapshot read transaction, so the deleted keys kept in its indexes
+     * for the transaction are removed after it ends.
+     * @param table The scanned table.
+     */
+    inline void TrackSnapshotTable(Table* table)
+    {
+        if (table != m_lastSnapshotTable && IsSnapshotRead()) {
+            m_lastSnapshotTable = table;
+            (void)m_snapshotTables.insert(table);
+        }
+    }
+
     inline void IncStmtCount()
     {
         m_internalStmtCount++;
@@ -470,6 +496,12 @@ private:
 
     void RollbackInternal(bool isPrepared);
 
+    /**
+     * @brief Queries whether the transaction reads from a snapshot. The snapshot is taken on first call, if the
+     * transaction is read-only and did not access any row yet.
+     */
+    bool IsSnapshotRead();
+
     // Disable class level new operator
     /** @cond EXCLUDE_DOC */
     void* operator new(std::size_t size) = delete;
@@ -551,6 +583,21 @@ private:
 
     int m_isolationLevel;
 
+    /** @var Whether the envelope transaction is read-only and snapshot reads are enabled. */
+    bool m_readOnly;
+
+    /** @var Whether the transaction reads from a snapshot. */
+    bool m_snapshotRead;
+
+    /** @var The CSN of the snapshot used by snapshot reads. */
+    uint64_t m_snapshotCsn;
+
+    /** @var The last table recorded by snapshot reads. */
+    Table* m_lastSnapshotTable;
+
+    /** @var The tables scanned by snapshot reads. */
+    std::unordered_set<Table*> m_snapshotTables;
+
 public:
     /** @var Transaction cache (OCC optimization). */
     MemSessionPtr<TxnAccess> m_accessMgr;
@@ -29,6 +29,8 @@
 #include "txn.h"
 #include "txn_access.h"
 #include "txn_insert_action.h"
+#include "cycles.h"
+#include "db_session_statistics.h"
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(TxnInsertAction, TxMan);
@@ -699,6 +701,74 @@ Row* TxnAccess::GetReadCommitedRow(Sentinel* sentinel)
     } else
         return nullptr;
 }
+static void WaitForCommitter(const Sentinel* sentinel)
+{
+    uint64_t sleepTime = 1;
+    while (sentinel->IsLocked()) {
+        if (sleepTime > LOCK_TIME_OUT) {
+            sleepTime = LOCK_TIME_OUT;
+            struct timespec ts = {0, 5000};
+            (void)nanosleep(&ts, NULL);
+        } else {
+            CpuCyclesLevelTime::Sleep(1);
+            sleepTime = sleepTime << 1;
+        }
+    }
+}
+
+Row* TxnAccess::GetSnapshotRow(Sentinel* sentinel, uint64_t snapshotCsn, RC& rc)
+{
+    // Committers lock their sentinels before they take a CSN, so a committer that might be older than the
+    // snapshot is holding the lock until it is done writing
+    WaitForCommitter(sentinel);
+    Sentinel* primarySentinel = sentinel;
+    Index* uniqueIndex = nullptr;
+    if (!sentinel->IsPrimaryIndex()) {
+        if (sentinel->GetIndex()->GetUnique()) {
+            uniqueIndex = sentinel->GetIndex();
+        }
+        primarySentinel = reinterpret_cast<Sentinel*>(sentinel->GetPrimarySentinel());
+        if (primarySentinel == nullptr) {
+            return nullptr;
+        }
+        WaitForCommitter(primarySentinel);
+    }
+
+    // Not yet committed insert
+    Row* row = primarySentinel->GetData();
+    if (row == nullptr) {
+        rc = RC_LOCAL_ROW_NOT_FOUND;
+    } else {
+        uint32_t chainLength = 0;
+        rc = row->GetSnapshotRow(snapshotCsn, m_rowZero, chainLength);
+        MOT::DbSessionStatisticsProvider::GetInstance().AddVersionChainLength(chainLength);
+    }
+
+    if (uniqueIndex != nullptr && (rc == RC_OK || rc == RC_LOCAL_ROW_NOT_FOUND)) {
+        // A deleted unique key can be taken over by another row after the snapshot, so the version must still
+        // carry the key, otherwise the row that held it is kept with the deleted key
+        if (rc == RC_OK) {
+            MaxKey key;
+            key.InitKey(uniqueIndex->GetKeyLength());
+            uniqueIndex->BuildKey(uniqueIndex->GetTable(), m_rowZero, &key);
+            if (uniqueIndex->IndexReadHeader(&key, m_txnManager->GetThdId()) != sentinel) {
+                rc = RC_LOCAL_ROW_NOT_FOUND;
+            }
+        }
+        if (rc == RC_LOCAL_ROW_NOT_FOUND) {
+            rc = uniqueIndex->GetTable()->GetDeferredKeySnapshotRow(sentinel, snapshotCsn, m_rowZero);
+        }
+    }
+
+    if (rc == RC_OK) {
+        return m_rowZero;
+    }
+    if (rc == RC_LOCAL_ROW_NOT_FOUND) {
+        rc = RC_OK;
+    }
+    return nullptr;
+}
+
 RC TxnAccess::GenerateDeletes(Access* element)
 {
     RC rc = RC_OK;
@@ -187,6 +187,15 @@ public:
      */
     Row* GetReadCommitedRow(Sentinel* sentinel);
 
+    /**
+     * @brief For snapshot reads we return a copy of the row version committed at the snapshot
+     * @param sentinel The row-header
+     * @param snapshotCsn The commit sequence number of the snapshot
+     * @param[out] rc Return code denoting success or failure
+     * @return row zero with the visible version, or null if the row is not visible
+     */
+    Row* GetSnapshotRow(Sentinel* sentinel, uint64_t snapshotCsn, RC& rc);
+
     /**
      * @brief Undo insert operation if possible after delete
      * @param element Current row to be deleted
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * pipelined_redo_log_handler.cpp
+ *    Implements a pipelined redo log with per-NUMA commit queues.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/transaction_logger/
+ *        pipelined_redo_log/pipelined_redo_log_handler.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <sched.h>
+#include "pipelined_redo_log_handler.h"
+#include "utilities.h"
+#include "mot_configuration.h"
+#include "session_context.h"
+
+namespace MOT {
+DECLARE_LOGGER(PipelinedRedoLogHandler, RedoLog);
+
+PipelinedRedoLogHandler::PipelinedRedoLogHandler()
+    : m_numaNodes(GetGlobalConfiguration().m_numaNodes), m_queues(nullptr)
+{}
+
+PipelinedRedoLogHandler::~PipelinedRedoLogHandler()
+{
+    if (m_queues != nullptr) {
+        delete[] m_queues;
+        m_queues = nullptr;
+    }
+}
+
+bool PipelinedRedoLogHandler::Init()
+{
+    m_queues = new (std::nothrow) CommitQueue[m_numaNodes];
+    if (m_queues == nullptr) {
+        MOT_LOG_ERROR("Error allocating pipelined redo log commit queues");
+        return false;
+    }
+
+    for (unsigned int i = 0; i < m_numaNodes; i++) {
+        CommitQueue* queue = &m_queues[i];
+        queue->m_tail.store(0, std::memory_order_relaxed);
+        queue->m_head.store(0, std::memory_order_relaxed);
+        queue->m_written.store(0, std::memory_order_relaxed);
+        queue->m_draining.store(false, std::memory_order_relaxed);
+        for (uint64_t pos = 0; pos < QUEUE_SIZE; pos++) {
+            queue->m_slots[pos].m_seq.store(pos, std::memory_order_relaxed);
+            queue->m_slots[pos].m_buffer = nullptr;
+        }
+    }
+    return true;
+}
+
+RedoLogBuffer* PipelinedRedoLogHandler::CreateBuffer()
+{
+    RedoLogBuffer* buffer = new (std::nothrow) RedoLogBuffer();
+    if (buffer != nullptr) {
+        if (!buffer->Initialize()) {
+            delete buffer;
+            buffer = nullptr;
+        }
+    }
+    return buffer;
+}
+
+void PipelinedRedoLogHandler::DestroyBuffer(RedoLogBuffer* buffer)
+{
+    if (buffer != nullptr) {
+        delete buffer;
+    }
+}
+
+RedoLogBuffer* PipelinedRedoLogHandler::WriteToLog(RedoLogBuffer* buffer)
+{
+    m_logger->AddToLog(buffer);
+    m_logger->FlushLog();
+    return buffer;
+}
+
+inline PipelinedRedoLogHandler::CommitQueue* PipelinedRedoLogHandler::GetCurrentQueue() const
+{
+    int node = MOTCurrentNumaNodeId;
+    if (node < 0 || (unsigned int)node >= m_numaNodes) {
+        node = 0;
+    }
+    return &m_queues[node];
+}
+
+bool PipelinedRedoLogHandler::EnqueueToLog(RedoLogBuffer* buffer, uint64_t& ticket)
+{
+    CommitQueue* queue = GetCurrentQueue();
+    uint64_t pos = queue->m_tail.load(std::memory_order_relaxed);
+    for (;;) {
+        QueueSlot* slot = &queue->m_slots[pos & (QUEUE_SIZE - 1)];
+        uint64_t seq = slot->m_seq.load(std::memory_order_acquire);
+        int64_t diff = (int64_t)seq - (int64_t)pos;
+        if (diff == 0) {
+            if (queue->m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot->m_buffer = buffer;
+                slot->m_seq.store(pos + 1, std::memory_order_release);
+                break;
+            }
+        } else if (diff < 0) {
+            // queue is full, write out what is already there and retry
+            (void)DrainQueue(queue, true);
+            pos = queue->m_tail.load(std::memory_order_relaxed);
+        } else {
+            pos = queue->m_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    ticket = ((uint64_t)(queue - m_queues) << TICKET_NODE_SHIFT) | (pos + 1);
+    return true;
+}
+
+void PipelinedRedoLogHandler::WaitForTicket(uint64_t ticket)
+{
+    CommitQueue* queue = &m_queues[ticket >> TICKET_NODE_SHIFT];
+    uint64_t target = ticket & TICKET_POS_MASK;
+    while (queue->m_written.load(std::memory_order_acquire) < target) {
+        if (!DrainQueue(queue, false)) {
+            // the queue has a flusher already, sleep until it wrote our buffer or gave up the queue
+            std::unique_lock<std::mutex> lock(queue->m_writtenMutex);
+            queue->m_writtenCV.wait(lock, [queue, target] {
+                return queue->m_written.load(std::memory_order_acquire) >= target ||
+                       !queue->m_draining.load(std::memory_order_acquire);
+            });
+        }
+    }
+}
+
+bool PipelinedRedoLogHandler::DrainQueue(CommitQueue* queue, bool wait)
+{
+    bool expected = false;
+    while (!queue->m_draining.compare_exchange_weak(expected, true, std::memory_order_acquire)) {
+        if (!wait) {
+            return false;
+        }
+        expected = false;
+        (void)sched_yield();
+    }
+
+    RedoLogBuffer* batch[MAX_BATCH_SIZE];
+    uint64_t head = queue->m_head.load(std::memory_order_relaxed);
+    for (;;) {
+        uint32_t count = 0;
+        while (count < MAX_BATCH_SIZE) {
+            QueueSlot* slot = &queue->m_slots[head & (QUEUE_SIZE - 1)];
+            if (slot->m_seq.load(std::memory_order_acquire) != head + 1) {
+                // either empty, or the producer did not finish publishing yet
+                break;
+            }
+            batch[count++] = slot->m_buffer;
+            slot->m_buffer = nullptr;
+            slot->m_seq.store(head + QUEUE_SIZE, std::memory_order_release);
+            ++head;
+        }
+        if (count == 0) {
+            break;
+        }
+
+        // buffers are owned by their waiting transactions, so they must not be touched after m_written moves
+        m_logger->AddToLog(batch, count);
+        m_logger->FlushLog();
+        queue->m_head.store(head, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(queue->m_writtenMutex);
+            queue->m_written.store(head, std::memory_order_release);
+        }
+        queue->m_writtenCV.notify_all();
+    }
+
+    // waiters queued after the last batch find the queue free and flush it themselves
+    {
+        std::lock_guard<std::mutex> lock(queue->m_writtenMutex);
+        queue->m_draining.store(false, std::memory_order_release);
+    }
+    queue->m_writtenCV.notify_all();
+    return true;
+}
+
+void PipelinedRedoLogHandler::Flush()
+{
+    for (unsigned int i = 0; i < m_numaNodes; i++) {
+        (void)DrainQueue(&m_queues[i], true);
+    }
+}
+}  // namespace MOT
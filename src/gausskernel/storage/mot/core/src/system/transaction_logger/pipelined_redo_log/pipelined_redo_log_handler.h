@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * pipelined_redo_log_handler.h
+ *    Implements a pipelined redo log with per-NUMA commit queues.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/transaction_logger/
+ *        pipelined_redo_log/pipelined_redo_log_handler.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef PIPELINED_REDO_LOG_HANDLER_H
+#define PIPELINED_REDO_LOG_HANDLER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include "global.h"
+#include "redo_log_handler.h"
+
+namespace MOT {
+/**
+ * @class PipelinedRedoLogHandler
+ * @brief Implements a pipelined redo log.
+ * @detail Committing transactions push their redo buffer into a bounded lock-free queue of their NUMA node and get
+ * back a commit ticket, then go on writing their changes and ending the checkpoint commit. The ticket is waited for
+ * at the end of the MOT commit, that is before the envelope writes its commit record, so the envelope never commits
+ * a transaction whose redo data is not in its log yet. Redo data is inserted into the envelope log, which can only be
+ * done from envelope threads, so the first committer that waits on a queue becomes its flusher: it writes everything
+ * queued so far in batches until the queue is empty, while the other waiters sleep until their buffer is written.
+ */
+class PipelinedRedoLogHandler : public RedoLogHandler {
+public:
+    PipelinedRedoLogHandler();
+    PipelinedRedoLogHandler(const PipelinedRedoLogHandler& orig) = delete;
+    PipelinedRedoLogHandler& operator=(const PipelinedRedoLogHandler& orig) = delete;
+    virtual ~PipelinedRedoLogHandler();
+
+    bool Init();
+
+    /**
+     * @brief creates a new Buffer object
+     * @return a Buffer
+     */
+    RedoLogBuffer* CreateBuffer();
+
+    /**
+     * @brief destroys a Buffer object
+     * @param buffer pointer to be destroyed and de-allocated
+     */
+    void DestroyBuffer(RedoLogBuffer* buffer);
+
+    /**
+     * @brief Synchronously writes a buffer to the log, bypassing the commit queue.
+     * @param buffer The buffer to write to the log.
+     * @return The next buffer to write to, or null in case of failure.
+     */
+    RedoLogBuffer* WriteToLog(RedoLogBuffer* buffer);
+
+    /**
+     * @brief Queues a buffer for writing to the log.
+     * @param buffer The buffer to write. It must not be touched until the ticket is reached.
+     * @param[out] ticket The commit ticket to wait for.
+     * @return Always true.
+     */
+    bool EnqueueToLog(RedoLogBuffer* buffer, uint64_t& ticket);
+
+    /**
+     * @brief Waits until the buffer of the given ticket is written to the log, writing the queue if it has no flusher.
+     * @param ticket The ticket returned by @ref EnqueueToLog().
+     */
+    void WaitForTicket(uint64_t ticket);
+
+    bool IsPipelined() const
+    {
+        return true;
+    }
+
+    /**
+     * @brief Writes all queued buffers to the log.
+     */
+    void Flush();
+
+private:
+    /** @var Number of slots in each commit queue (must be a power of two). */
+    static constexpr uint64_t QUEUE_SIZE = 1024;
+
+    /** @var Maximum number of buffers written to the log in one batch. */
+    static constexpr uint32_t MAX_BATCH_SIZE = 64;
+
+    /** @var Bit position of the NUMA node identifier within a ticket. */
+    static constexpr uint32_t TICKET_NODE_SHIFT = 56;
+
+    /** @var Mask of the queue position within a ticket. */
+    static constexpr uint64_t TICKET_POS_MASK = (1ULL << TICKET_NODE_SHIFT) - 1;
+
+    /** @struct QueueSlot A single commit queue slot. */
+    struct QueueSlot {
+        /** @var Position the slot is ready for. Equals to the enqueue position when free, plus one when full. */
+        std::atomic<uint64_t> m_seq;
+
+        /** @var The queued buffer. */
+        RedoLogBuffer* m_buffer;
+    };
+
+    /** @struct CommitQueue The commit queue of a single NUMA node. */
+    struct alignas(CACHE_LINE_SIZE) CommitQueue {
+        /** @var Next enqueue position. */
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_tail;
+
+        /** @var Next dequeue position. Changed only by the thread holding the drain flag. */
+        alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> m_head;
+
+        /** @var All queue positions below this one are already written to the log. */
+        std::atomic<uint64_t> m_written;
+
+        /** @var Set while a thread is draining the queue. */
+        std::atomic<bool> m_draining;
+
+        /** @var Protects waking up waiters when m_written or m_draining changes. */
+        std::mutex m_writtenMutex;
+
+        /** @var Waiters sleep here until their buffer is written or the queue has no flusher. */
+        std::condition_variable m_writtenCV;
+
+        /** @var Queue slots. */
+        alignas(CACHE_LINE_SIZE) QueueSlot m_slots[QUEUE_SIZE];
+    };
+
+    /** @var Number of NUMA nodes. */
+    const unsigned int m_numaNodes;
+
+    /** @var Per-NUMA commit queues. */
+    CommitQueue* m_queues;
+
+    /**
+     * @brief Writes all buffers queued in a single commit queue to the log.
+     * @param queue The queue to drain.
+     * @param wait Specifies whether to wait for another thread already draining the queue.
+     * @return True if the queue was drained by the caller.
+     */
+    bool DrainQueue(CommitQueue* queue, bool wait);
+
+    inline CommitQueue* GetCurrentQueue() const;
+};
+}  // namespace MOT
+
+#endif /* PIPELINED_REDO_LOG_HANDLER_H */
@@ -35,6 +35,8 @@ DECLARE_LOGGER(RedoLog, RedoLog);
 RedoLog::RedoLog(TxnManager* txn)
     : m_redoLogHandler(nullptr),
       m_redoBuffer(nullptr),
+      m_pendingBuffer(nullptr),
+      m_commitTicket(0),
       m_configuration(GetGlobalConfiguration()),
       m_txn(txn),
       m_flushed(false),
@@ -43,8 +45,11 @@ RedoLog::RedoLog(TxnManager* txn)
 
 RedoLog::~RedoLog()
 {
+    WaitCommitTicket();
     if (m_redoBuffer != nullptr)
         m_redoLogHandler->DestroyBuffer(m_redoBuffer);
+    if (m_pendingBuffer != nullptr)
+        m_redoLogHandler->DestroyBuffer(m_pendingBuffer);
 }
 
 bool RedoLog::Init()
@@ -53,6 +58,13 @@ bool RedoLog::Init()
         m_redoLogHandler = MOTEngine::GetInstance()->GetRedoLogHandler();
         if (m_redoLogHandler != nullptr) {
             m_redoBuffer = m_redoLogHandler->CreateBuffer();
+            if (m_redoBuffer != nullptr && m_redoLogHandler->IsPipelined()) {
+                m_pendingBuffer = m_redoLogHandler->CreateBuffer();
+                if (m_pendingBuffer == nullptr) {
+                    m_redoLogHandler->DestroyBuffer(m_redoBuffer);
+                    m_redoBuffer = nullptr;
+                }
+            }
         }
         if (m_redoBuffer == nullptr)
             return false;
@@ -63,6 +75,7 @@ bool RedoLog::Init()
 
 void RedoLog::Reset()
 {
+    WaitCommitTicket();
     ResetBuffer();
     m_flushed = false;
 }
@@ -76,7 +89,7 @@ RC RedoLog::Commit()
         status = SerializeTransaction();
         if (status == RC_OK && (m_flushed || !m_redoBuffer->Empty() || m_forceWrite)) {
             RedoLogWriter::AppendCommit(*m_redoBuffer, m_txn);
-            WriteToLog();
+            WriteToLog(true);
         }
     }
     return status;
@@ -123,7 +136,7 @@ void RedoLog::CommitPrepared()
         !MOTEngine::GetInstance()->IsRecovering()) {
         // write commit op to transaction wal buffer
         RedoLogWriter::AppendCommitPrepared(*m_redoBuffer, m_txn);
-        WriteToLog();
+        WriteToLog(true);
     }
 }
 
@@ -269,17 +282,34 @@ void RedoLog::WritePartial()
     WriteToLog();
 }
 
-void RedoLog::WriteToLog()
+void RedoLog::WriteToLog(bool deferred)
 {
     if (!m_redoBuffer->Empty() || m_forceWrite) {
+        // keep the log order of this transaction's buffers
+        WaitCommitTicket();
         m_redoLogHandler->RdLock();
-        m_redoBuffer = m_redoLogHandler->WriteToLog(m_redoBuffer);
+        if (deferred && m_pendingBuffer != nullptr && m_redoLogHandler->EnqueueToLog(m_redoBuffer, m_commitTicket)) {
+            // the queued buffer belongs to the handler until the ticket is reached, continue with the spare one
+            RedoLogBuffer* queuedBuffer = m_redoBuffer;
+            m_redoBuffer = m_pendingBuffer;
+            m_pendingBuffer = queuedBuffer;
+        } else {
+            m_redoBuffer = m_redoLogHandler->WriteToLog(m_redoBuffer);
+        }
         m_redoLogHandler->RdUnlock();
         ResetBuffer();
         m_flushed = true;
     }
 }
 
+void RedoLog::WaitCommitTicket()
+{
+    if (m_commitTicket != 0) {
+        m_redoLogHandler->WaitForTicket(m_commitTicket);
+        m_commitTicket = 0;
+    }
+}
+
 RC RedoLog::SerializeDropIndex(TxnDDLAccess::DDLAccess* ddlAccess, bool hasDML, IdxDDLAccessMap& idxDDLMap)
 {
     RC status = RC_ERROR;
@@ -162,8 +162,15 @@ public:
 
     /**
      * @brief Writes buffer data to the logger
+     * @param deferred Specifies whether the write may be queued in a pipelined handler. The caller must then call
+     * @ref WaitCommitTicket() before the transaction is considered committed.
      */
-    void WriteToLog();
+    void WriteToLog(bool deferred = false);
+
+    /**
+     * @brief Waits until a buffer queued by a deferred write is written to the log.
+     */
+    void WaitCommitTicket();
 
     inline RedoLogBuffer& GetBuffer()
     {
@@ -202,6 +209,12 @@ private:
     /* Member variables */
     RedoLogHandler* m_redoLogHandler;
     RedoLogBuffer* m_redoBuffer;
+
+    /** @var The buffer in flight in a pipelined handler when a ticket is held, otherwise a spare buffer. */
+    RedoLogBuffer* m_pendingBuffer;
+
+    /** @var The commit ticket of the pending buffer, or zero if none. */
+    uint64_t m_commitTicket;
     MOTConfiguration& m_configuration;
     TxnManager* m_txn;
     bool m_flushed;
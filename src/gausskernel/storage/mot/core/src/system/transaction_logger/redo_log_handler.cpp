@@ -31,6 +31,7 @@
 #include "logger_type.h"
 #include "synchronous_redo_log_handler.h"
 #include "segmented_group_synchronous_redo_log_handler.h"
+#include "pipelined_redo_log_handler.h"
 #include "mot_error.h"
 
 namespace MOT {
@@ -57,6 +58,9 @@ RedoLogHandler* RedoLogHandlerFactory::CreateRedoLogHandler()
         case RedoLogHandlerType::SEGMENTED_GROUP_SYNC_REDO_LOG_HANDLER:
             handler = new (std::nothrow) SegmentedGroupSyncRedoLogHandler();
             break;
+        case RedoLogHandlerType::PIPELINED_REDO_LOG_HANDLER:
+            handler = new (std::nothrow) PipelinedRedoLogHandler();
+            break;
         default:
             MOT_REPORT_PANIC(MOT_ERROR_INTERNAL,
                 "Redo Log Handler Initialization",
@@ -68,6 +68,33 @@ public:
      */
     virtual RedoLogBuffer* WriteToLog(RedoLogBuffer* buffer) = 0;
 
+    /**
+     * @brief Queues a buffer to be written to the log later. Handlers that do not support pipelining refuse and
+     * the caller falls back to @ref WriteToLog().
+     * @param buffer The buffer to write to the log.
+     * @param[out] ticket The commit ticket to pass to @ref WaitForTicket().
+     * @return True if the buffer was queued.
+     */
+    virtual bool EnqueueToLog(RedoLogBuffer* buffer, uint64_t& ticket)
+    {
+        return false;
+    }
+
+    /**
+     * @brief Waits until a buffer queued with @ref EnqueueToLog() is written to the log.
+     * @param ticket The commit ticket of the buffer.
+     */
+    virtual void WaitForTicket(uint64_t ticket)
+    {}
+
+    /**
+     * @brief Queries whether the handler supports @ref EnqueueToLog().
+     */
+    virtual bool IsPipelined() const
+    {
+        return false;
+    }
+
     /**
      * @brief flush all buffers (if exist) to log
      */
@@ -39,6 +39,9 @@ enum class RedoLogHandlerType : uint32_t {
     /** @var Denotes SegmentedGroupSyncRedoLogHandler. */
     SEGMENTED_GROUP_SYNC_REDO_LOG_HANDLER,
 
+    /** @var Denotes PipelinedRedoLogHandler. */
+    PIPELINED_REDO_LOG_HANDLER,
+
     /** @var Denotes invalid handler type. */
     INVALID_REDO_LOG_HANDLER
 };
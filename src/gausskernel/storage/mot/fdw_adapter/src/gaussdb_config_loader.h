@@ -148,6 +148,10 @@ private:
             MOT_LOG_INFO("Configuring asynchronous redo-log handler due to synchronous_commit=off");
             result = AddExtTypedConfigItem<MOT::RedoLogHandlerType>(
                 "", "redo_log_handler_type", MOT::RedoLogHandlerType::SYNC_REDO_LOG_HANDLER);
+        } else if (MOT::GetGlobalConfiguration().m_enablePipelinedCommit) {
+            MOT_LOG_INFO("Configuring pipelined redo-log handler");
+            result = AddExtTypedConfigItem<MOT::RedoLogHandlerType>(
+                "", "redo_log_handler_type", MOT::RedoLogHandlerType::PIPELINED_REDO_LOG_HANDLER);
         } else if (MOT::GetGlobalConfiguration().m_enableGroupCommit) {
             MOT_LOG_INFO("Configuring segmented-group redo-log handler");
             result = AddExtTypedConfigItem<MOT::RedoLogHandlerType>(
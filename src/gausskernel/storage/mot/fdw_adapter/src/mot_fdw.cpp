@@ -70,6 +70,7 @@
 #include "postmaster/bgwriter.h"
 #include "storage/lmgr.h"
 #include "storage/ipc.h"
+#include "vecexecutor/vecnodes.h"
 
 #include "mot_internal.h"
 #include "storage/mot/jit_exec.h"
@@ -108,6 +109,7 @@ static const struct MOTFdwOption valid_options[] = {
     {"null", ForeignTableRelationId},
     {"encoding", ForeignTableRelationId},
     {"force_not_null", AttributeRelationId},
+    {"primary_index", ForeignTableRelationId},
 
     /* Sentinel */
     {NULL, InvalidOid}};
@@ -131,6 +133,7 @@ static ForeignScan* MOTGetForeignPlan(PlannerInfo* root, RelOptInfo* baserel, Oi
 static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es);
 static void MOTBeginForeignScan(ForeignScanState* node, int eflags);
 static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node);
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node);
 static void MOTReScanForeignScan(ForeignScanState* node);
 static void MOTEndForeignScan(ForeignScanState* node);
 static void MOTAddForeignUpdateTargets(Query* parsetree, RangeTblEntry* targetRte, Relation targetRelation);
@@ -296,6 +299,7 @@ Datum mot_fdw_handler(PG_FUNCTION_ARGS)
     fdwroutine->ExplainForeignScan = MOTExplainForeignScan;
     fdwroutine->BeginForeignScan = MOTBeginForeignScan;
     fdwroutine->IterateForeignScan = MOTIterateForeignScan;
+    fdwroutine->VecIterateForeignScan = MOTVecIterateForeignScan;
     fdwroutine->ReScanForeignScan = MOTReScanForeignScan;
     fdwroutine->EndForeignScan = MOTEndForeignScan;
     fdwroutine->AnalyzeForeignTable = MOTAnalyzeForeignTable;
@@ -377,6 +381,16 @@ Datum mot_fdw_validator(PG_FUNCTION_ARGS)
                     buf.len > 0 ? errhint("Valid options in this context are: %s", buf.data)
                                 : errhint("There are no valid options in this context.")));
         }
+
+        if (strcmp(def->defname, "primary_index") == 0) {
+            char* method = defGetString(def);
+            if (strcmp(method, "btree") != 0 && strcmp(method, "hash") != 0) {
+                ereport(ERROR,
+                    (errcode(ERRCODE_INVALID_PARAMETER_VALUE),
+                        errmsg("invalid value \"%s\" for option \"primary_index\"", method),
+                        errhint("Valid values are: btree, hash")));
+            }
+        }
     }
 
     /*
@@ -487,6 +501,10 @@ static bool IsOrderingApplicable(PathKey* pathKey, RelOptInfo* rel, MOT::Index*
 {
     bool res = false;
 
+    // hash index returns rows in hash order
+    if (!ix->IsOrdered())
+        return res;
+
     if (ord->m_order == SORTDIR_ENUM::SORTDIR_NONE)
         ord->m_order = SORT_STRATEGY(pathKey->pk_strategy);
     else if (ord->m_order != SORT_STRATEGY(pathKey->pk_strategy))
@@ -721,6 +739,43 @@ static void MOTGetForeignPaths(PlannerInfo* root, RelOptInfo* baserel, Oid forei
 /*
  *
  */
+/*
+ * Large read-only scans can produce vector batches, so analytic queries run in the vectorized executor without
+ * converting each row. Point queries, short range scans and scans of rows about to be modified stay row based.
+ */
+static bool IsVectorizedScanApplicable(
+    PlannerInfo* root, RelOptInfo* baserel, MOTFdwStateSt* planstate, ForeignPath* bestPath, List* tlist)
+{
+    MOT::MOTConfiguration& cfg = MOT::GetGlobalConfiguration();
+    if (!cfg.m_enableVectorizedScan || root->parse->commandType != CMD_SELECT || root->parse->hasForUpdate ||
+        root->parse->rowMarks != NIL) {
+        return false;
+    }
+
+    if (bestPath->path.rows < cfg.m_vectorizedScanMinRows) {
+        return false;
+    }
+
+    if (planstate->m_bestIx != nullptr && planstate->m_bestIx->m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT &&
+        planstate->m_bestIx->m_ix->GetUnique()) {
+        return false;
+    }
+
+    // vector batches carry user columns only, so system columns and whole row references cannot be vectorized
+    Bitmapset* attrs = nullptr;
+    pull_varattnos((Node*)tlist, baserel->relid, &attrs);
+    pull_varattnos((Node*)planstate->m_localConds, baserel->relid, &attrs);
+    bool result = true;
+    for (int attno = FirstLowInvalidHeapAttributeNumber + 1; attno <= 0; attno++) {
+        if (bms_is_member(attno - FirstLowInvalidHeapAttributeNumber, attrs)) {
+            result = false;
+            break;
+        }
+    }
+    bms_free(attrs);
+    return result;
+}
+
 static ForeignScan* MOTGetForeignPlan(
     PlannerInfo* root, RelOptInfo* baserel, Oid foreigntableid, ForeignPath* best_path, List* tlist, List* scan_clauses)
 {
@@ -785,7 +840,8 @@ static ForeignScan* MOTGetForeignPlan(
         list_free(tmpLocal);
 
     List* quals = planstate->m_localConds;
-    return make_foreignscan(tlist,
+    bool vecOutput = IsVectorizedScanApplicable(root, baserel, planstate, best_path, tlist);
+    ForeignScan* scan = make_foreignscan(tlist,
         quals,
         scanRelid,
         remote, /* no expressions to evaluate */
@@ -797,6 +853,10 @@ static ForeignScan* MOTGetForeignPlan(
         nullptr
 #endif
     );
+
+    // the planner turns the scan into a vectorized one only if the rest of the plan can be vectorized as well
+    ((Plan*)scan)->vec_output = vecOutput;
+    return scan;
 }
 
 /*
@@ -869,15 +929,31 @@ static void MOTBeginForeignScan(ForeignScanState* node, int eflags)
     MOTAdaptor::GetCmdOper(festate);
     festate->m_txnId = GetCurrentTransactionIdIfAny();
     festate->m_currTxn = GetSafeTxn(__FUNCTION__);
+    festate->m_table = festate->m_currTxn->GetTableByExternalId(RelationGetRelid(node->ss.ss_currentRelation));
+    bool selfModify = (node->ss.ps.state->es_result_relation_info &&
+                       RelationGetRelid(node->ss.ps.state->es_result_relation_info->ri_RelationDesc) ==
+                           RelationGetRelid(node->ss.ss_currentRelation));
+
+    // a full scan of a hash primary index has no end to bound it, so it would also visit the rows being inserted
+    if (selfModify && (eflags & EXEC_FLAG_EXPLAIN_ONLY) == 0 && festate->m_bestIx == nullptr &&
+        node->ss.ps.state->es_plannedstmt->commandType == CMD_INSERT &&
+        !festate->m_table->GetPrimaryIndex()->IsOrdered()) {
+        ereport(ERROR,
+            (errcode(ERRCODE_FDW_OPERATION_NOT_SUPPORTED),
+                errmodule(MOD_MOT),
+                errmsg("Cannot insert into memory table \"%s\" rows selected from the table itself",
+                    RelationGetRelationName(node->ss.ss_currentRelation)),
+                errdetail("The table has a hash primary index, which cannot bound a full scan.")));
+    }
+
     festate->m_currTxn->IncStmtCount();
     festate->m_currTxn->m_queryState[(uint64_t)festate] = (uint64_t)festate;
-    festate->m_table = festate->m_currTxn->GetTableByExternalId(RelationGetRelid(node->ss.ss_currentRelation));
     node->fdw_state = festate;
-    if (node->ss.ps.state->es_result_relation_info &&
-        RelationGetRelid(node->ss.ps.state->es_result_relation_info->ri_RelationDesc) ==
-            RelationGetRelid(node->ss.ss_currentRelation))
+    if (selfModify)
         node->ss.ps.state->es_result_relation_info->ri_FdwState = festate;
     festate->m_currTxn->SetTxnIsoLevel(u_sess->utils_cxt.XactIsoLevel);
+    festate->m_currTxn->SetTxnReadOnly(u_sess->attr.attr_common.XactReadOnly);
+    festate->m_currTxn->TrackSnapshotTable(festate->m_table);
 
     foreach (t, node->ss.ps.plan->targetlist) {
         TargetEntry* tle = (TargetEntry*)lfirst(t);
@@ -987,6 +1063,32 @@ static TupleTableSlot* IterateForeignScanStopAtFirst(
     return nullptr;
 }
 
+static void OpenScanCursor(ForeignScanState* node, MOTFdwStateSt* festate)
+{
+    if (!festate->m_cursorOpened) {
+        ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
+        festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
+        festate->m_econtext = node->ss.ps.ps_ExprContext;
+        CleanCursors(festate);
+        MOTAdaptor::OpenCursor(node->ss.ss_currentRelation, festate);
+
+        festate->m_cursorOpened = true;
+    }
+}
+
+static void ReportRowLookupError(MOTFdwStateSt* festate, MOT::RC rc)
+{
+    if (MOT_IS_SEVERE()) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTIterateForeignScan", "Failed to lookup row");
+        MOT_LOG_ERROR_STACK("Failed to lookup row");
+    }
+
+    CleanQueryStatesOnError(festate->m_currTxn);
+    report_pg_error(rc,
+        (void*)(festate->m_currTxn->m_errIx != NULL ? festate->m_currTxn->m_errIx->GetName().c_str() : "unknown"),
+        (void*)festate->m_currTxn->m_errMsgBuf);
+}
+
 /*
  *
  */
@@ -1010,15 +1112,7 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
         return IterateForeignScanStopAtFirst(node, festate, slot);
     }
 
-    if (!festate->m_cursorOpened) {
-        ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
-        festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
-        festate->m_econtext = node->ss.ps.ps_ExprContext;
-        CleanCursors(festate);
-        MOTAdaptor::OpenCursor(node->ss.ss_currentRelation, festate);
-
-        festate->m_cursorOpened = true;
-    }
+    OpenScanCursor(node, festate);
     /*
      * The protocol for loading a virtual tuple into a slot is first
      * ExecClearTuple, then fill the values/isnull arrays, then
@@ -1031,46 +1125,31 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
      * We can also pass tupleOid = NULL because we don't allow oids for
      * foreign tables.
      */
-    // festate->cursor[1] might be NULL (in case it is not in use)
-    if (festate->m_cursor[0] == nullptr || !festate->m_cursor[0]->IsValid() ||
-        (festate->m_cursor[1] != nullptr && !festate->m_cursor[1]->IsValid())) {
-        return nullptr;
-    }
-
+    // sentinels are fetched from the cursor in batches, the end of a range search is checked while fetching them
     do {
-        MOT::Sentinel* Sentinel = festate->m_cursor[0]->GetPrimarySentinel();
+        bool scanEnd = false;
+        MOT::Sentinel* Sentinel = MOTAdaptor::NextScanSentinel(festate, scanEnd);
+        if (Sentinel == nullptr) {
+            if (scanEnd) {
+                festate->m_cursor[0]->Invalidate();
+                node->ss.is_scan_end = true;
+            }
+            break;
+        }
+
         currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, Sentinel, rc);
         if (currRow == NULL) {
             if (rc != MOT::RC_OK) {
-                if (MOT_IS_SEVERE()) {
-                    MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTIterateForeignScan", "Failed to lookup row");
-                    MOT_LOG_ERROR_STACK("Failed to lookup row");
-                }
-
-                CleanQueryStatesOnError(festate->m_currTxn);
-                report_pg_error(rc,
-                    (void*)(festate->m_currTxn->m_errIx != NULL ? festate->m_currTxn->m_errIx->GetName().c_str()
-                                                                : "unknown"),
-                    (void*)festate->m_currTxn->m_errMsgBuf);
+                ReportRowLookupError(festate, rc);
                 return NULL;
             }
-            festate->m_cursor[0]->Next();
             continue;
         }
 
-        // check end condition for range search
-        if (MOTAdaptor::IsScanEnd(festate)) {
-            festate->m_cursor[0]->Invalidate();
-            node->ss.is_scan_end = true;
-            break;
-        }
-
         MOTAdaptor::UnpackRow(slot, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
         found = true;
-
-        festate->m_cursor[0]->Next();
         break;
-    } while (festate->m_cursor[0]->IsValid());
+    } while (true);
 
     if (found) {
         ExecStoreVirtualTuple(slot);
@@ -1091,6 +1170,60 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
     }
 }
 
+/*
+ * Fills the scan batch of a vectorized scan. Each row is decoded straight into the batch vectors, and the local
+ * quals are evaluated by the executor on the whole batch.
+ */
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node)
+{
+    MOT::RC rc = MOT::RC_OK;
+    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
+    VectorBatch* batch = node->m_pScanBatch;
+    int numRows = 0;
+
+    batch->Reset(true);
+    if (node->ss.is_scan_end) {
+        return batch;
+    }
+
+    OpenScanCursor(node, festate);
+
+    // values decoded into temporary datums (e.g. numeric) are copied by the vectors, they live for one batch only
+    MemoryContextReset(node->m_scanCxt);
+    MemoryContext oldCxt = MemoryContextSwitchTo(node->m_scanCxt);
+    while (numRows < BatchMaxSize) {
+        bool scanEnd = false;
+        MOT::Sentinel* sentinel = MOTAdaptor::NextScanSentinel(festate, scanEnd);
+        if (sentinel == nullptr) {
+            if (scanEnd) {
+                festate->m_cursor[0]->Invalidate();
+            }
+            node->ss.is_scan_end = true;
+            break;
+        }
+
+        MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, sentinel, rc);
+        if (currRow == nullptr) {
+            if (rc != MOT::RC_OK) {
+                (void)MemoryContextSwitchTo(oldCxt);
+                ReportRowLookupError(festate, rc);
+                return nullptr;
+            }
+            continue;
+        }
+
+        // the looked up row may be a per-transaction copy that is overwritten by the next lookup
+        MOTAdaptor::UnpackBatchRow(
+            batch, numRows, festate->m_table, festate->m_attrsUsed, const_cast<uint8_t*>(currRow->GetData()));
+        ++numRows;
+    }
+    (void)MemoryContextSwitchTo(oldCxt);
+
+    batch->FixRowCount(numRows);
+    festate->m_rowsFound += numRows;
+    return batch;
+}
+
 /*
  *
  */
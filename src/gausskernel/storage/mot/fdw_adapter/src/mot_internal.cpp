@@ -40,7 +40,10 @@
 #include "executor/executor.h"
 #include "storage/ipc.h"
 #include "commands/dbcommands.h"
+#include "commands/defrem.h"
+#include "foreign/foreign.h"
 #include "knl/knl_session.h"
+#include "vecexecutor/vectorbatch.h"
 
 #include "mot_internal.h"
 #include "row.h"
@@ -804,6 +807,15 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
             MOT::Index* ix = festate->m_table->GetPrimaryIndex();
             uint16_t keyLength = ix->GetKeyLength();
 
+            if (!ix->IsOrdered()) {
+                // hash index has no key range to bound the scan, items are visited once in hash order, and
+                // inserting rows selected from the same table is refused in MOTBeginForeignScan()
+                festate->m_forwardDirectionScan = true;
+                festate->m_cursor[0] = festate->m_table->Begin(festate->m_currTxn->GetThdId());
+                festate->m_cursor[1] = nullptr;
+                break;
+            }
+
             if (festate->m_order == SORTDIR_ENUM::SORTDIR_ASC) {
                 fIx = 0;
                 bIx = 1;
@@ -1029,6 +1041,30 @@ static MOT::RC TableFieldType(
     return res;
 }
 
+/*
+ * An index is hashed when created with USING hash, or when it is the primary key of a table created with the
+ * primary_index 'hash' option (constraint indexes always come with the default btree access method).
+ */
+static MOT::IndexingMethod GetIndexingMethod(IndexStmt* stmt)
+{
+    if (strcmp(stmt->accessMethod, "hash") == 0) {
+        return MOT::IndexingMethod::INDEXING_METHOD_HASH;
+    }
+
+    if (stmt->primary) {
+        ForeignTable* ftable = GetForeignTable(stmt->relation->foreignOid);
+        ListCell* lc = nullptr;
+        foreach (lc, ftable->options) {
+            DefElem* def = (DefElem*)lfirst(lc);
+            if (strcmp(def->defname, "primary_index") == 0 && strcmp(defGetString(def), "hash") == 0) {
+                return MOT::IndexingMethod::INDEXING_METHOD_HASH;
+            }
+        }
+    }
+
+    return MOT::IndexingMethod::INDEXING_METHOD_TREE;
+}
+
 void MOTAdaptor::ValidateCreateIndex(IndexStmt* stmt, MOT::Table* table, MOT::TxnManager* txn)
 {
     if (stmt->primary) {
@@ -1048,8 +1084,17 @@ void MOTAdaptor::ValidateCreateIndex(IndexStmt* stmt, MOT::Table* table, MOT::Tx
         return;
     }
 
-    if (strcmp(stmt->accessMethod, "btree") != 0) {
-        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE only (btree or btree_art)")));
+    if (strcmp(stmt->accessMethod, "btree") != 0 && strcmp(stmt->accessMethod, "hash") != 0) {
+        ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE or HASH only")));
+        return;
+    }
+
+    if (GetIndexingMethod(stmt) == MOT::IndexingMethod::INDEXING_METHOD_HASH && !stmt->unique) {
+        ereport(ERROR,
+            (errmodule(MOD_MOT),
+                errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                errmsg("Can't create index"),
+                errdetail("MOT supports unique HASH indexes only")));
         return;
     }
 
@@ -1093,7 +1138,7 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* stmt, ::TransactionId tid)
     MOT::IndexOrder index_order = MOT::IndexOrder::INDEX_ORDER_SECONDARY;
 
     // Use the default index tree flavor from configuration file
-    MOT::IndexingMethod indexing_method = MOT::IndexingMethod::INDEXING_METHOD_TREE;
+    MOT::IndexingMethod indexing_method = GetIndexingMethod(stmt);
     MOT::IndexTreeFlavor flavor = MOT::GetGlobalConfiguration().m_indexTreeFlavor;
 
     // check if we have primary and delete previous definition
@@ -1745,40 +1790,51 @@ void MOTAdaptor::CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start
     festate->m_bestIx->m_ix->AdjustKey(&festate->m_stateKey[start], pattern);
 }
 
-bool MOTAdaptor::IsScanEnd(MOTFdwStateSt* festate)
+MOT::Sentinel* MOTAdaptor::NextScanSentinel(MOTFdwStateSt* festate, bool& scanEnd)
 {
-    bool res = false;
     EnsureSafeThreadAccessInline();
+    scanEnd = false;
 
-    // festate->cursor[1] (end iterator) might be NULL (in case it is not in use). If this is the case, return false
-    // (which means we have not reached the end yet)
-    if (festate->m_cursor[1] == nullptr) {
-        return false;
-    }
+    if (festate->m_scanBatchPos == festate->m_scanBatchCount) {
+        festate->m_scanBatchPos = 0;
+        festate->m_scanBatchCount = 0;
+        if (festate->m_cursor[0] == nullptr || !festate->m_cursor[0]->IsValid()) {
+            return nullptr;
+        }
 
-    if (!festate->m_cursor[1]->IsValid()) {
-        return true;
-    } else {
-        const MOT::Key* startKey = nullptr;
+        // festate->cursor[1] (end iterator) might be NULL (in case it is not in use)
         const MOT::Key* endKey = nullptr;
-        MOT::Index* ix = (festate->m_bestIx != nullptr ? festate->m_bestIx->m_ix : festate->m_table->GetPrimaryIndex());
+        uint32_t endKeyLength = 0;
+        if (festate->m_cursor[1] != nullptr) {
+            if (!festate->m_cursor[1]->IsValid()) {
+                scanEnd = true;
+                return nullptr;
+            }
+            MOT::Index* ix =
+                (festate->m_bestIx != nullptr ? festate->m_bestIx->m_ix : festate->m_table->GetPrimaryIndex());
+            endKey = reinterpret_cast<const MOT::Key*>(festate->m_cursor[1]->GetKey());
+            endKeyLength = ix->GetKeySizeNoSuffix();
+        }
 
-        startKey = reinterpret_cast<const MOT::Key*>(festate->m_cursor[0]->GetKey());
-        endKey = reinterpret_cast<const MOT::Key*>(festate->m_cursor[1]->GetKey());
-        if (startKey != nullptr && endKey != nullptr) {
-            int cmpRes = memcmp(startKey->GetKeyBuf(), endKey->GetKeyBuf(), ix->GetKeySizeNoSuffix());
+        festate->m_scanBatchCount = festate->m_cursor[0]->NextBatch(
+            festate->m_scanBatch, MOT_SCAN_BATCH_SIZE, endKey, endKeyLength, festate->m_forwardDirectionScan);
+        if (festate->m_scanBatchCount == 0) {
+            // the cursor stopped on the first key beyond the end key
+            scanEnd = festate->m_cursor[0]->IsValid();
+            return nullptr;
+        }
 
-            if (festate->m_forwardDirectionScan) {
-                if (cmpRes > 0)
-                    res = true;
-            } else {
-                if (cmpRes < 0)
-                    res = true;
-            }
+        for (uint32_t i = 0; i < MOT_SCAN_PREFETCH_DISTANCE && i < festate->m_scanBatchCount; i++) {
+            MOT::Prefetch(festate->m_scanBatch[i]->GetData());
         }
     }
 
-    return res;
+    // the row data is needed only a few rows from now, by then it is hopefully cached
+    uint32_t ahead = festate->m_scanBatchPos + MOT_SCAN_PREFETCH_DISTANCE;
+    if (ahead < festate->m_scanBatchCount) {
+        MOT::Prefetch(festate->m_scanBatch[ahead]->GetData());
+    }
+    return festate->m_scanBatch[festate->m_scanBatchPos++];
 }
 
 void MOTAdaptor::PackRow(TupleTableSlot* slot, MOT::Table* table, uint8_t* attrs_used, uint8_t* destRow)
@@ -1861,6 +1917,58 @@ void MOTAdaptor::UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_
     }
 }
 
+void MOTAdaptor::UnpackBatchRow(
+    VectorBatch* batch, int rowIndex, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow)
+{
+    EnsureSafeThreadAccessInline();
+
+    // column count includes null bits field
+    int cols = (int)table->GetFieldCount() - 1;
+    if (cols > batch->m_cols) {
+        cols = batch->m_cols;
+    }
+
+    for (int i = 0; i < cols; i++) {
+        ScalarVector* vec = &(batch->m_arr[i]);
+        if (!BITMAP_GET(attrs_used, i) || !BITMAP_GET(srcRow, i)) {
+            vec->SetNull(rowIndex);
+            continue;
+        }
+
+        MOT::Column* col = table->GetField(i + 1);
+        size_t len = 0;
+        switch (vec->m_desc.typeId) {
+            case VARCHAROID:
+            case BPCHAROID:
+            case TEXTOID:
+            case CLOBOID:
+            case BYTEAOID: {
+                uintptr_t tmp;
+                col->Unpack(srcRow, &tmp, len);
+                (void)vec->AddVarCharWithoutHeader((const char*)tmp, (int)len, rowIndex);
+                break;
+            }
+            case NUMERICOID: {
+                MOT::DecimalSt* d = nullptr;
+                col->Unpack(srcRow, (uintptr_t*)&d, len);
+                (void)vec->AddVar(NumericGetDatum(MOTNumericToPG(d)), rowIndex);
+                break;
+            }
+            default: {
+                Datum value = 0;
+                col->Unpack(srcRow, &value, len);
+                if (vec->m_desc.encoded) {
+                    // fixed size types passed by reference point into the row, so they are copied
+                    (void)vec->AddVar(value, rowIndex);
+                } else {
+                    vec->m_vals[rowIndex] = value;
+                }
+                break;
+            }
+        }
+    }
+}
+
 // useful functions for data conversion: utils/fmgr/gmgr.cpp
 void MOTAdaptor::MOTToDatum(MOT::Table* table, const Form_pg_attribute attr, uint8_t* data, Datum* value, bool* is_null)
 {
@@ -90,6 +90,8 @@ class Column;
 class MOTEngine;
 }  // namespace MOT
 
+class VectorBatch;
+
 #ifndef MOTFdwStateSt
 typedef struct MOTFdwState_St MOTFdwStateSt;
 #endif
@@ -113,6 +115,12 @@ typedef struct Order_St {
 
 #define MOT_REC_TID_NAME "ctid"
 
+/* number of index items fetched from a scan cursor at once */
+#define MOT_SCAN_BATCH_SIZE 64
+
+/* number of rows ahead of the returned one whose data is prefetched */
+#define MOT_SCAN_PREFETCH_DISTANCE 4
+
 typedef struct MOTRecConvert {
     union {
         uint64_t m_ptr;
@@ -156,6 +164,11 @@ struct MOTFdwState_St {
     MOT::MaxKey m_stateKey[2];
     bool m_forwardDirectionScan;
     MOT::AccessType m_internalCmdOper;
+
+    // sentinels already fetched from m_cursor[0] and not returned yet
+    MOT::Sentinel* m_scanBatch[MOT_SCAN_BATCH_SIZE];
+    uint32_t m_scanBatchCount;
+    uint32_t m_scanBatchPos;
 };
 
 class MOTAdaptor {
@@ -268,10 +281,12 @@ public:
     static void PackRow(TupleTableSlot* slot, MOT::Table* table, uint8_t* attrs_used, uint8_t* destRow);
     static void PackUpdateRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* destRow);
     static void UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow);
+    static void UnpackBatchRow(
+        VectorBatch* batch, int rowIndex, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow);
 
     // scan helpers
     static void OpenCursor(Relation rel, MOTFdwStateSt* festate);
-    static bool IsScanEnd(MOTFdwStateSt* festate);
+    static MOT::Sentinel* NextScanSentinel(MOTFdwStateSt* festate, bool& scanEnd);
     static void CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start);
 
     // planning helpers
@@ -375,6 +390,8 @@ inline void CleanCursors(MOTFdwStateSt* state)
             state->m_cursor[i] = NULL;
         }
     }
+    state->m_scanBatchCount = 0;
+    state->m_scanBatchPos = 0;
 }
 
 inline void CleanQueryStatesOnError(MOT::TxnManager* txn)
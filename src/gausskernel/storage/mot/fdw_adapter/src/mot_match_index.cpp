@@ -377,6 +377,11 @@ double MatchIndex::GetCost(int numClauses)
         return INT_MAX;
     }
 
+    // hash index serves exact lookups of the full key only
+    if (!m_ix->IsOrdered() && !(m_end == -1 && m_ixOpers[0] == KEY_OPER::READ_KEY_EXACT)) {
+        return INT_MAX;
+    }
+
     return m_cost;
 }
 
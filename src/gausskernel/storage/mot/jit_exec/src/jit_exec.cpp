@@ -354,6 +354,21 @@ extern void JitResetScan(JitContext* jitContext)
     jitContext->m_iterCount = 0;
 }
 
+/**
+ * @brief Materializes parameters that are fetched lazily through a hook (as PL/pgSQL does), since jitted code reads
+ * parameter values directly from the parameter list.
+ */
+static void FetchLazyParams(ParamListInfo params)
+{
+    if ((params != nullptr) && (params->paramFetch != nullptr)) {
+        for (int i = 0; i < params->numParams; ++i) {
+            if (!OidIsValid(params->params[i].ptype)) {
+                (*params->paramFetch)(params, i + 1);
+            }
+        }
+    }
+}
+
 extern int JitExecQuery(
     JitContext* jitContext, ParamListInfo params, TupleTableSlot* slot, uint64_t* tuplesProcessed, int* scanEnded)
 {
@@ -431,6 +446,10 @@ extern int JitExecQuery(
     }
     ++jitContext->m_iterCount;
 
+    if (newScan) {
+        FetchLazyParams(params);
+    }
+
     // invoke the jitted function
     if (jitContext->m_llvmFunction != nullptr) {
 #ifdef MOT_JIT_DEBUG
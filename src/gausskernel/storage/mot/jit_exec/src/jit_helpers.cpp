@@ -747,6 +747,7 @@ MOT::IndexIterator* searchIterator(MOT::Index* index, MOT::Key* key, int forward
         MOT::HexStr(key->GetKeyBuf(), key->GetKeyLength()).c_str());
     MOT::TxnManager* curr_txn = u_sess->mot_cxt.jit_txn;
     MOT_LOG_DEBUG("searchIterator: Current txn is: %p", curr_txn);
+    curr_txn->TrackSnapshotTable(index->GetTable());
 
     itr = index->Search(key, matchKey, forwardDirection, curr_txn->GetThdId(), found);
     if (!found) {
@@ -760,6 +761,7 @@ MOT::IndexIterator* searchIterator(MOT::Index* index, MOT::Key* key, int forward
 
 MOT::IndexIterator* beginIterator(MOT::Index* index)
 {
+    u_sess->mot_cxt.jit_txn->TrackSnapshotTable(index->GetTable());
     return index->Begin(MOTCurrThreadId);
 }
 
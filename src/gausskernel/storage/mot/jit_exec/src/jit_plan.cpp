@@ -958,6 +958,10 @@ static JitRangeScanPlan* JitPrepareRangeScanPlan(Query* query, MOT::Table* table
         table->GetTableName().c_str(),
         index_id,
         index->GetName().c_str());
+    if (!index->IsOrdered()) {
+        MOT_LOG_TRACE("Range scan is not supported by unordered index %s", index->GetName().c_str());
+        return nullptr;
+    }
     JitRangeScanPlan* plan = (JitRangeScanPlan*)MOT::MemSessionAlloc(alloc_size);
     if (plan == nullptr) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM,
@@ -169,6 +169,7 @@ static MdfdVec *_mdfd_openseg(SMgrRelation reln, ForkNumber forkno, BlockNumber
 static MdfdVec *_mdfd_getseg(SMgrRelation reln, ForkNumber forkno, BlockNumber blkno, bool skipFsync,
                              ExtensionBehavior behavior);
 static BlockNumber _mdnblocks(SMgrRelation reln, ForkNumber forknum, const MdfdVec *seg);
+static BlockNumber _mdnblocks_all(SMgrRelation reln, ForkNumber forknum);
 static MdfdVec *_mdcreate(ForkNumber forkNum, bool isRedo, const RelFileNodeBackend &rnode);
 static void _mdcreatebucket(SMgrRelation reln, ForkNumber forkNum, bool isRedo);
 
@@ -279,6 +280,7 @@ void mdcreate(SMgrRelation reln, ForkNumber forkNum, bool isRedo)
 
     Assert(reln->md_fd[forkNum] == NULL);
     reln->md_fd[forkNum] = _mdcreate(forkNum, isRedo, reln->smgr_rnode);
+    RelSizeCacheForget(reln->smgr_rnode, forkNum);
 }
 /*
  *	mdcreate() -- Create a new relation on magnetic disk.
@@ -373,6 +375,8 @@ void mdunlink(const RelFileNodeBackend &rnode, ForkNumber forkNum, bool isRedo)
     } else {
         mdunlinkfork(rnode, forkNum, isRedo);
     }
+
+    RelSizeCacheForget(rnode, forkNum);
 }
 
 static void _mdunlinkfork_bucket_dir(const RelFileNodeBackend &rnode, bool isRedo)
@@ -532,6 +536,90 @@ void mdextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const
         register_dirty_segment(reln, forknum, v);
     }
     Assert(_mdnblocks(reln, forknum, v) <= ((BlockNumber)RELSEG_SIZE));
+
+    RelSizeCacheExtend(reln, forknum, blocknum + 1);
+}
+
+/*
+ *  mdextendbatch() -- Add nblocks zeroed blocks to the specified relation,
+ *      starting at blocknum.
+ *
+ *      This is for bulk pre-extension: each segment touched is extended with
+ *      a single fallocate() when enable_fast_allocate is on, so no zero pages
+ *      are written at all, or else with large zero-filled writes instead of
+ *      one write per block.
+ */
+void mdextendbatch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks, bool skipFsync)
+{
+    const BlockNumber zero_blocks = 64;
+    char *zerobuf = NULL;
+
+    Assert(reln->smgr_rnode.node.bucketNode != DIR_BUCKET_ID);
+
+    if (nblocks == 0) {
+        return;
+    }
+    if (blocknum >= InvalidBlockNumber - nblocks) {
+        ereport(ERROR, (errcode(ERRCODE_PROGRAM_LIMIT_EXCEEDED),
+                        errmsg("cannot extend file \"%s\" beyond %u blocks", relpath(reln->smgr_rnode, forknum),
+                               InvalidBlockNumber)));
+    }
+
+    while (nblocks > 0) {
+        BlockNumber segblocks = nblocks;
+        off_t seekpos;
+        MdfdVec *v = NULL;
+
+        /* split at segment boundaries, since those are separate files */
+        if (blocknum / RELSEG_SIZE != (blocknum + nblocks - 1) / RELSEG_SIZE) {
+            segblocks = RELSEG_SIZE - (blocknum % ((BlockNumber)RELSEG_SIZE));
+        }
+
+        v = _mdfd_getseg(reln, forknum, blocknum, skipFsync, EXTENSION_CREATE);
+        seekpos = (off_t)BLCKSZ * (blocknum % ((BlockNumber)RELSEG_SIZE));
+
+        if (u_sess->attr.attr_sql.enable_fast_allocate) {
+            FileFastExtendFile(v->mdfd_vfd, (uint32)seekpos, (uint32)(segblocks * BLCKSZ), false);
+        } else {
+            BlockNumber done = 0;
+
+            if (zerobuf == NULL) {
+                zerobuf = (char *)palloc0(zero_blocks * BLCKSZ);
+            }
+            while (done < segblocks) {
+                int amount = (int)(Min(segblocks - done, zero_blocks) * BLCKSZ);
+                int nbytes = FilePWrite(v->mdfd_vfd, zerobuf, amount, seekpos + (off_t)done * BLCKSZ,
+                                        WAIT_EVENT_DATA_FILE_EXTEND);
+
+                if (nbytes != amount) {
+                    if (nbytes < 0) {
+                        ereport(ERROR, (errcode_for_file_access(),
+                                        errmsg("could not extend file \"%s\": %m", FilePathName(v->mdfd_vfd)),
+                                        errhint("Check free disk space.")));
+                    }
+                    ereport(ERROR, (errcode(ERRCODE_DISK_FULL),
+                                    errmsg("could not extend file \"%s\": wrote only %d of %d bytes at block %u",
+                                           FilePathName(v->mdfd_vfd), nbytes, amount, blocknum + done),
+                                    errhint("Check free disk space.")));
+                }
+                done += (BlockNumber)(amount / BLCKSZ);
+            }
+        }
+
+        if (!skipFsync && !SmgrIsTemp(reln)) {
+            register_dirty_segment(reln, forknum, v);
+        }
+        Assert(_mdnblocks(reln, forknum, v) <= ((BlockNumber)RELSEG_SIZE));
+
+        nblocks -= segblocks;
+        blocknum += segblocks;
+    }
+
+    RelSizeCacheExtend(reln, forknum, blocknum);
+
+    if (zerobuf != NULL) {
+        pfree(zerobuf);
+    }
 }
 
 /*
@@ -1217,12 +1305,29 @@ void mdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const
 /*
  *  mdnblocks() -- Get the number of blocks stored in a relation.
  *
+ *      The size comes from the shared relation size cache when it is known
+ *      there; otherwise the segments are measured and the result cached.
+ *      Callers that need all active segments opened use _mdnblocks_all.
+ */
+BlockNumber mdnblocks(SMgrRelation reln, ForkNumber forknum)
+{
+    BlockNumber nblocks = RelSizeCacheGet(reln, forknum);
+
+    if (nblocks != InvalidBlockNumber) {
+        return nblocks;
+    }
+    return RelSizeCacheLoad(reln, forknum, _mdnblocks_all);
+}
+
+/*
+ *  _mdnblocks_all() -- Measure the number of blocks stored in a relation.
+ *
  *      Important side effect: all active segments of the relation are opened
  *      and added to the mdfd_chain list.  If this routine has not been
  *      called, then only segments up to the last one actually touched
  *      are present in the chain.
  */
-BlockNumber mdnblocks(SMgrRelation reln, ForkNumber forknum)
+static BlockNumber _mdnblocks_all(SMgrRelation reln, ForkNumber forknum)
 {
     MdfdVec *v = mdopen(reln, forknum, EXTENSION_FAIL);
     BlockNumber nblocks;
@@ -1292,10 +1397,10 @@ void mdtruncate(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks)
     Assert(reln->smgr_rnode.node.bucketNode != DIR_BUCKET_ID);
 
     /*
-     * NOTE: mdnblocks makes sure we have opened all active segments, so that
+     * NOTE: _mdnblocks_all makes sure we have opened all active segments, so that
      * truncation loop will get them all!
      */
-    curnblk = mdnblocks(reln, forknum);
+    curnblk = _mdnblocks_all(reln, forknum);
     if (nblocks > curnblk) {
         /* Bogus request ... but no complaint if InRecovery */
         if (t_thrd.xlog_cxt.InRecovery) {
@@ -1364,6 +1469,8 @@ void mdtruncate(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks)
         }
         prior_blocks += RELSEG_SIZE;
     }
+
+    RelSizeCacheForget(reln->smgr_rnode, forknum);
 }
 
 /*
@@ -1380,10 +1487,10 @@ void mdimmedsync(SMgrRelation reln, ForkNumber forknum)
     Assert(reln->smgr_rnode.node.bucketNode != DIR_BUCKET_ID);
 
     /*
-     * NOTE: mdnblocks makes sure we have opened all active segments, so that
+     * NOTE: _mdnblocks_all makes sure we have opened all active segments, so that
      * fsync loop will get them all!
      */
-    (void)mdnblocks(reln, forknum);
+    (void)_mdnblocks_all(reln, forknum);
 
     v = mdopen(reln, forknum, EXTENSION_FAIL);
 
@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ *  relsize.cpp
+ *        Shared relation size cache, so that mdnblocks does not seek to the end of
+ *        every segment each time the size of a relation fork is asked for.
+ *
+ *        The cache is an array of slots, relsize_cache_entries of them, and a
+ *        partitioned shared hash table mapping RelFileNode + fork to a slot. Each
+ *        slot holds one 64-bit word: a generation number in the high half and the
+ *        number of blocks in the low half. An SMgrRelation remembers the slot and
+ *        generation it found for each fork, so a repeated size check is a single
+ *        atomic read without any lock. Whenever a slot is dropped or recycled its
+ *        generation is advanced, which makes every remembered copy miss.
+ *
+ *        The size is kept up to date by md.c: extensions raise it with a
+ *        compare-and-swap that also checks the generation, truncation and unlink
+ *        drop the entry, and so does dropping or moving a database. Redo goes
+ *        through the same md.c routines, so the cache stays right in recovery too.
+ *        An entry is only loaded while holding its partition lock exclusively,
+ *        and extenders that have not found the slot yet take the same lock in
+ *        shared mode after writing, so a load can never publish a size older
+ *        than an extension it raced with.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/smgr/relsize.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "storage/barrier.h"
+#include "storage/lock/lwlock.h"
+#include "storage/shmem.h"
+#include "storage/smgr.h"
+#include "utils/atomic.h"
+#include "utils/hsearch.h"
+
+typedef struct RelSizeTag {
+    RelFileNode rnode;
+    ForkNumber forknum;
+} RelSizeTag;
+
+/* entry of the lookup hashtable */
+typedef struct RelSizeEnt {
+    RelSizeTag tag;
+    int slot;
+} RelSizeEnt;
+
+typedef struct RelSizeSlot {
+    RelSizeTag tag;         /* changed only while claimed, under the partition lock of the tag */
+    pg_atomic_uint64 state; /* generation << 32 | nblocks */
+} RelSizeSlot;
+
+typedef struct RelSizeCacheCtl {
+    pg_atomic_uint32 clock_hand; /* next slot to consider for recycling */
+    int nslots;
+    RelSizeSlot slots[FLEXIBLE_ARRAY_MEMBER];
+} RelSizeCacheCtl;
+
+/* nblocks half of the state of a slot not mapped by the hashtable */
+#define RELSIZE_FREE ((uint32)0xFFFFFFFF)
+/* nblocks half of the state of a slot being mapped */
+#define RELSIZE_CLAIMED ((uint32)0xFFFFFFFE)
+
+#define RELSIZE_STATE(gen, nblocks) (((uint64)(gen) << 32) | (uint64)(nblocks))
+#define RELSIZE_GEN(state) ((uint32)((state) >> 32))
+#define RELSIZE_NBLOCKS(state) ((uint32)(state))
+#define RELSIZE_MAPPED(state) (RELSIZE_NBLOCKS(state) < RELSIZE_CLAIMED)
+
+/* slots looked at for recycling before giving up caching one fork */
+#define RELSIZE_RECYCLE_TRIES 16
+
+#define RelSizeCachePartitionLock(hashcode) \
+    GetMainLWLockByIndex(FirstRelSizeCacheLock + (int)((hashcode) % NUM_RELSIZE_CACHE_PARTITIONS))
+
+static inline bool RelSizeCacheable(SMgrRelation reln, ForkNumber forknum)
+{
+    return t_thrd.shemem_ptr_cxt.relsize_cache != NULL && forknum >= 0 && forknum <= MAX_FORKNUM &&
+           !SmgrIsTemp(reln) && reln->smgr_rnode.node.bucketNode != DIR_BUCKET_ID;
+}
+
+static inline void RelSizeTagFill(RelSizeTag *tag, const RelFileNode &rnode, ForkNumber forknum)
+{
+    errno_t rc = memset_s(tag, sizeof(RelSizeTag), 0, sizeof(RelSizeTag));
+    securec_check(rc, "", "");
+    tag->rnode = rnode;
+    tag->forknum = forknum;
+}
+
+Size RelSizeCacheShmemSize(void)
+{
+    int nslots = g_instance.attr.attr_storage.relsize_cache_entries;
+    Size size;
+
+    if (nslots <= 0) {
+        return 0;
+    }
+    size = add_size(offsetof(RelSizeCacheCtl, slots), mul_size(nslots, sizeof(RelSizeSlot)));
+    return add_size(size, hash_estimate_size(nslots, sizeof(RelSizeEnt)));
+}
+
+void RelSizeCacheShmemInit(void)
+{
+    int nslots = g_instance.attr.attr_storage.relsize_cache_entries;
+    RelSizeCacheCtl *ctl = NULL;
+    HASHCTL info;
+    bool found = false;
+    errno_t rc;
+
+    if (nslots <= 0) {
+        t_thrd.shemem_ptr_cxt.relsize_cache = NULL;
+        t_thrd.shemem_ptr_cxt.relsize_hash = NULL;
+        return;
+    }
+
+    rc = memset_s(&info, sizeof(info), 0, sizeof(info));
+    securec_check(rc, "", "");
+    info.keysize = sizeof(RelSizeTag);
+    info.entrysize = sizeof(RelSizeEnt);
+    info.hash = tag_hash;
+    info.num_partitions = NUM_RELSIZE_CACHE_PARTITIONS;
+    t_thrd.shemem_ptr_cxt.relsize_hash = ShmemInitHash("Relation Size Cache Lookup Table", nslots, nslots, &info,
+                                                       HASH_ELEM | HASH_FUNCTION | HASH_PARTITION);
+
+    ctl = (RelSizeCacheCtl *)ShmemInitStruct("Relation Size Cache",
+                                             offsetof(RelSizeCacheCtl, slots) + nslots * sizeof(RelSizeSlot), &found);
+    if (!found) {
+        pg_atomic_init_u32(&ctl->clock_hand, 0);
+        ctl->nslots = nslots;
+        for (int i = 0; i < nslots; i++) {
+            ctl->slots[i].tag.forknum = InvalidForkNumber;
+            pg_atomic_init_u64(&ctl->slots[i].state, RELSIZE_STATE(0, RELSIZE_FREE));
+        }
+    }
+    t_thrd.shemem_ptr_cxt.relsize_cache = ctl;
+}
+
+/*
+ * Raise the size kept in a slot to nblocks, as long as the slot still has generation gen.
+ * Returns false if the slot was dropped or recycled meanwhile.
+ */
+static bool RelSizeSlotRaise(RelSizeSlot *slot, uint32 gen, BlockNumber nblocks)
+{
+    uint64 state = pg_atomic_read_u64(&slot->state);
+
+    for (;;) {
+        if (RELSIZE_GEN(state) != gen || !RELSIZE_MAPPED(state)) {
+            return false;
+        }
+        if (RELSIZE_NBLOCKS(state) >= nblocks) {
+            return true;
+        }
+        if (pg_atomic_compare_exchange_u64(&slot->state, &state, RELSIZE_STATE(gen, nblocks))) {
+            return true;
+        }
+    }
+}
+
+/*
+ * Unmap a slot whose hashtable entry was just removed, the partition lock of its tag is held
+ * exclusively. The new generation invalidates all remembered copies, and concurrent raises fail.
+ */
+static void RelSizeSlotRelease(RelSizeSlot *slot, uint32 nblocks)
+{
+    uint64 state = pg_atomic_read_u64(&slot->state);
+
+    while (!pg_atomic_compare_exchange_u64(&slot->state, &state, RELSIZE_STATE(RELSIZE_GEN(state) + 1, nblocks))) {
+    }
+}
+
+/*
+ * Read the tag of a mapped slot without its partition lock. Returns false if the slot is not
+ * mapped, or was remapped while reading.
+ */
+static bool RelSizeSlotReadTag(RelSizeSlot *slot, RelSizeTag *tag, uint64 *state)
+{
+    uint64 before = pg_atomic_read_u64(&slot->state);
+
+    if (!RELSIZE_MAPPED(before)) {
+        return false;
+    }
+    pg_read_barrier();
+    *tag = slot->tag;
+    pg_read_barrier();
+    *state = pg_atomic_read_u64(&slot->state);
+    return RELSIZE_GEN(*state) == RELSIZE_GEN(before) && RELSIZE_MAPPED(*state);
+}
+
+/*
+ * Drop the mapping of tag, the partition lock of tag is held exclusively.
+ */
+static void RelSizeCacheRemove(const RelSizeTag *tag, uint32 hashcode, uint32 nblocks)
+{
+    RelSizeCacheCtl *ctl = t_thrd.shemem_ptr_cxt.relsize_cache;
+    RelSizeEnt *ent = NULL;
+
+    ent = (RelSizeEnt *)hash_search_with_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)tag, hashcode,
+                                                    HASH_REMOVE, NULL);
+    if (ent != NULL) {
+        RelSizeSlotRelease(&ctl->slots[ent->slot], nblocks);
+    }
+}
+
+/*
+ * Get a slot for a new mapping, the caller holds the partition lock of hashcode exclusively.
+ * Free slots are taken as they are; mapped ones are recycled in clock order, taking the
+ * partition lock of the victim only conditionally so that no two partition locks are ever
+ * waited for together. Returns -1 if no slot could be had quickly, then the fork is simply
+ * not cached this time.
+ */
+static int RelSizeSlotClaim(uint32 hashcode)
+{
+    RelSizeCacheCtl *ctl = t_thrd.shemem_ptr_cxt.relsize_cache;
+    LWLock *mylock = RelSizeCachePartitionLock(hashcode);
+
+    for (int tries = 0; tries < RELSIZE_RECYCLE_TRIES; tries++) {
+        int victim = (int)(pg_atomic_fetch_add_u32(&ctl->clock_hand, 1) % (uint32)ctl->nslots);
+        RelSizeSlot *slot = &ctl->slots[victim];
+        uint64 state = pg_atomic_read_u64(&slot->state);
+        RelSizeTag tag;
+        uint32 victimhash;
+        LWLock *victimlock = NULL;
+        RelSizeEnt *ent = NULL;
+
+        if (RELSIZE_NBLOCKS(state) == RELSIZE_FREE) {
+            if (pg_atomic_compare_exchange_u64(&slot->state, &state,
+                                               RELSIZE_STATE(RELSIZE_GEN(state) + 1, RELSIZE_CLAIMED))) {
+                return victim;
+            }
+            continue;
+        }
+        if (!RelSizeSlotReadTag(slot, &tag, &state)) {
+            continue;
+        }
+
+        victimhash = get_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag);
+        victimlock = RelSizeCachePartitionLock(victimhash);
+        if (victimlock != mylock && !LWLockConditionalAcquire(victimlock, LW_EXCLUSIVE)) {
+            continue;
+        }
+
+        /* the mapping can't change under the lock, check it is still this slot */
+        ent = (RelSizeEnt *)hash_search_with_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag,
+                                                        victimhash, HASH_FIND, NULL);
+        if (ent != NULL && ent->slot == victim) {
+            RelSizeCacheRemove(&tag, victimhash, RELSIZE_CLAIMED);
+            if (victimlock != mylock) {
+                LWLockRelease(victimlock);
+            }
+            return victim;
+        }
+        if (victimlock != mylock) {
+            LWLockRelease(victimlock);
+        }
+    }
+    return -1;
+}
+
+/*
+ *  RelSizeCacheGet() -- Cached number of blocks of a relation fork, or InvalidBlockNumber
+ *      if it is not in the cache.
+ */
+BlockNumber RelSizeCacheGet(SMgrRelation reln, ForkNumber forknum)
+{
+    RelSizeCacheCtl *ctl = t_thrd.shemem_ptr_cxt.relsize_cache;
+    RelSizeTag tag;
+    RelSizeEnt *ent = NULL;
+    uint32 hashcode;
+    LWLock *partlock = NULL;
+    BlockNumber nblocks = InvalidBlockNumber;
+
+    if (!RelSizeCacheable(reln, forknum)) {
+        return InvalidBlockNumber;
+    }
+
+    /* fast path: the slot found before still has the same generation */
+    if (reln->smgr_relsize_slot[forknum] >= 0) {
+        uint64 state = pg_atomic_read_u64(&ctl->slots[reln->smgr_relsize_slot[forknum]].state);
+
+        if (RELSIZE_GEN(state) == reln->smgr_relsize_gen[forknum] && RELSIZE_MAPPED(state)) {
+            return RELSIZE_NBLOCKS(state);
+        }
+        reln->smgr_relsize_slot[forknum] = -1;
+    }
+
+    RelSizeTagFill(&tag, reln->smgr_rnode.node, forknum);
+    hashcode = get_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag);
+    partlock = RelSizeCachePartitionLock(hashcode);
+
+    (void)LWLockAcquire(partlock, LW_SHARED);
+    ent = (RelSizeEnt *)hash_search_with_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag, hashcode,
+                                                    HASH_FIND, NULL);
+    if (ent != NULL) {
+        uint64 state = pg_atomic_read_u64(&ctl->slots[ent->slot].state);
+
+        Assert(RELSIZE_MAPPED(state));
+        reln->smgr_relsize_slot[forknum] = ent->slot;
+        reln->smgr_relsize_gen[forknum] = RELSIZE_GEN(state);
+        nblocks = RELSIZE_NBLOCKS(state);
+    }
+    LWLockRelease(partlock);
+
+    return nblocks;
+}
+
+/*
+ *  RelSizeCacheLoad() -- Compute the number of blocks of a relation fork with nblocksfn and
+ *      cache it.
+ *
+ *      nblocksfn runs under the exclusive partition lock, see the file header.
+ */
+BlockNumber RelSizeCacheLoad(SMgrRelation reln, ForkNumber forknum, BlockNumber (*nblocksfn)(SMgrRelation, ForkNumber))
+{
+    RelSizeCacheCtl *ctl = t_thrd.shemem_ptr_cxt.relsize_cache;
+    RelSizeTag tag;
+    RelSizeEnt *ent = NULL;
+    uint32 hashcode;
+    LWLock *partlock = NULL;
+    BlockNumber nblocks;
+    bool found = false;
+    int slot;
+
+    if (!RelSizeCacheable(reln, forknum)) {
+        return nblocksfn(reln, forknum);
+    }
+
+    RelSizeTagFill(&tag, reln->smgr_rnode.node, forknum);
+    hashcode = get_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag);
+    partlock = RelSizeCachePartitionLock(hashcode);
+
+    (void)LWLockAcquire(partlock, LW_EXCLUSIVE);
+    ent = (RelSizeEnt *)hash_search_with_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag, hashcode,
+                                                    HASH_FIND, NULL);
+    if (ent != NULL) {
+        /* loaded by someone else meanwhile */
+        uint64 state = pg_atomic_read_u64(&ctl->slots[ent->slot].state);
+
+        reln->smgr_relsize_slot[forknum] = ent->slot;
+        reln->smgr_relsize_gen[forknum] = RELSIZE_GEN(state);
+        LWLockRelease(partlock);
+        return RELSIZE_NBLOCKS(state);
+    }
+
+    nblocks = nblocksfn(reln, forknum);
+    if (nblocks >= RELSIZE_CLAIMED) {
+        LWLockRelease(partlock);
+        return nblocks;
+    }
+
+    slot = RelSizeSlotClaim(hashcode);
+    if (slot < 0) {
+        LWLockRelease(partlock);
+        return nblocks;
+    }
+
+    ent = (RelSizeEnt *)hash_search_with_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag, hashcode,
+                                                    HASH_ENTER_NULL, &found);
+    if (ent == NULL) {
+        RelSizeSlotRelease(&ctl->slots[slot], RELSIZE_FREE);
+    } else {
+        RelSizeSlot *s = &ctl->slots[slot];
+        uint32 gen = RELSIZE_GEN(pg_atomic_read_u64(&s->state));
+
+        Assert(!found);
+        ent->slot = slot;
+        s->tag = tag;
+        pg_write_barrier();
+        pg_atomic_write_u64(&s->state, RELSIZE_STATE(gen, nblocks));
+        reln->smgr_relsize_slot[forknum] = slot;
+        reln->smgr_relsize_gen[forknum] = gen;
+    }
+    LWLockRelease(partlock);
+
+    return nblocks;
+}
+
+/*
+ *  RelSizeCacheExtend() -- The relation fork now has at least nblocks blocks.
+ *
+ *      Called after the file was written, so a load that doesn't see this update
+ *      has seen the new file size.
+ */
+void RelSizeCacheExtend(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks)
+{
+    RelSizeCacheCtl *ctl = t_thrd.shemem_ptr_cxt.relsize_cache;
+    RelSizeTag tag;
+    RelSizeEnt *ent = NULL;
+    uint32 hashcode;
+    LWLock *partlock = NULL;
+
+    if (!RelSizeCacheable(reln, forknum) || nblocks >= RELSIZE_CLAIMED) {
+        return;
+    }
+
+    if (reln->smgr_relsize_slot[forknum] >= 0) {
+        if (RelSizeSlotRaise(&ctl->slots[reln->smgr_relsize_slot[forknum]], reln->smgr_relsize_gen[forknum],
+                             nblocks)) {
+            return;
+        }
+        reln->smgr_relsize_slot[forknum] = -1;
+    }
+
+    RelSizeTagFill(&tag, reln->smgr_rnode.node, forknum);
+    hashcode = get_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag);
+    partlock = RelSizeCachePartitionLock(hashcode);
+
+    (void)LWLockAcquire(partlock, LW_SHARED);
+    ent = (RelSizeEnt *)hash_search_with_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag, hashcode,
+                                                    HASH_FIND, NULL);
+    if (ent != NULL) {
+        /* the slot can't be recycled while we hold the lock */
+        uint32 gen = RELSIZE_GEN(pg_atomic_read_u64(&ctl->slots[ent->slot].state));
+
+        (void)RelSizeSlotRaise(&ctl->slots[ent->slot], gen, nblocks);
+        reln->smgr_relsize_slot[forknum] = ent->slot;
+        reln->smgr_relsize_gen[forknum] = gen;
+    }
+    LWLockRelease(partlock);
+}
+
+/*
+ * Drop the cached size of every fork matching rnode (all buckets when rnode is a bucket dir),
+ * or of every fork of database dbid when rnode is NULL.
+ */
+static void RelSizeCacheForgetMatching(const RelFileNode *rnode, Oid dbid)
+{
+    RelSizeCacheCtl *ctl = t_thrd.shemem_ptr_cxt.relsize_cache;
+
+    for (int i = 0; i < ctl->nslots; i++) {
+        RelSizeTag tag;
+        uint64 state;
+        uint32 hashcode;
+        LWLock *partlock = NULL;
+        RelSizeEnt *ent = NULL;
+
+        if (!RelSizeSlotReadTag(&ctl->slots[i], &tag, &state)) {
+            continue;
+        }
+        if (rnode != NULL) {
+            if (tag.rnode.relNode != rnode->relNode || tag.rnode.dbNode != rnode->dbNode ||
+                tag.rnode.spcNode != rnode->spcNode) {
+                continue;
+            }
+        } else if (tag.rnode.dbNode != dbid) {
+            continue;
+        }
+
+        hashcode = get_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag);
+        partlock = RelSizeCachePartitionLock(hashcode);
+        (void)LWLockAcquire(partlock, LW_EXCLUSIVE);
+        ent = (RelSizeEnt *)hash_search_with_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag,
+                                                        hashcode, HASH_FIND, NULL);
+        if (ent != NULL && ent->slot == i) {
+            RelSizeCacheRemove(&tag, hashcode, RELSIZE_FREE);
+        }
+        LWLockRelease(partlock);
+    }
+}
+
+/*
+ *  RelSizeCacheForget() -- Drop the cached size of a relation fork, or of all its forks
+ *      when forknum is InvalidForkNumber.
+ *
+ *      Called after the file was truncated or unlinked.
+ */
+void RelSizeCacheForget(const RelFileNodeBackend &rnode, ForkNumber forknum)
+{
+    RelSizeTag tag;
+    uint32 hashcode;
+    LWLock *partlock = NULL;
+
+    if (t_thrd.shemem_ptr_cxt.relsize_cache == NULL || RelFileNodeBackendIsTemp(rnode)) {
+        return;
+    }
+
+    if (rnode.node.bucketNode == DIR_BUCKET_ID) {
+        RelSizeCacheForgetMatching(&rnode.node, InvalidOid);
+        return;
+    }
+
+    for (int fork = 0; fork <= MAX_FORKNUM; fork++) {
+        if (forknum != InvalidForkNumber && fork != forknum) {
+            continue;
+        }
+        RelSizeTagFill(&tag, rnode.node, (ForkNumber)fork);
+        hashcode = get_hash_value(t_thrd.shemem_ptr_cxt.relsize_hash, (const void *)&tag);
+        partlock = RelSizeCachePartitionLock(hashcode);
+        (void)LWLockAcquire(partlock, LW_EXCLUSIVE);
+        RelSizeCacheRemove(&tag, hashcode, RELSIZE_FREE);
+        LWLockRelease(partlock);
+    }
+}
+
+/*
+ *  RelSizeCacheForgetDatabase() -- Drop the cached sizes of all relations of a database,
+ *      whose files are about to be removed or moved wholesale.
+ */
+void RelSizeCacheForgetDatabase(Oid dbid)
+{
+    if (t_thrd.shemem_ptr_cxt.relsize_cache == NULL) {
+        return;
+    }
+    RelSizeCacheForgetMatching(NULL, dbid);
+}
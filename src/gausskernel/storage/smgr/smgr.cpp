@@ -49,6 +49,8 @@ typedef struct f_smgr {
     void (*smgr_unlink)(const RelFileNodeBackend &rnode, ForkNumber forknum, bool isRedo);
     void (*smgr_extend)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char *buffer,
                         bool skipFsync);
+    void (*smgr_extend_batch)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks,
+                              bool skipFsync);
     void (*smgr_prefetch)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum);
     void (*smgr_read)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer);
     void (*smgr_write)(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char *buffer, bool skipFsync);
@@ -72,6 +74,7 @@ static const f_smgr smgrsw[] = {
       mdexists,
       mdunlink,
       mdextend,
+      mdextendbatch,
       mdprefetch,
       mdread,
       mdwrite,
@@ -148,8 +151,13 @@ static void _smgr_init(SMgrRelation reln, int col = 0)
     /* hash_search already filled in the lookup key */
     reln->smgr_owner = NULL;
     reln->smgr_targblock = InvalidBlockNumber;
+    reln->smgr_bulk_next = InvalidBlockNumber;
+    reln->smgr_bulk_end = InvalidBlockNumber;
     reln->smgr_fsm_nblocks = InvalidBlockNumber;
     reln->smgr_vm_nblocks = InvalidBlockNumber;
+    for (int forknum = 0; forknum <= MAX_FORKNUM; forknum++) {
+        reln->smgr_relsize_slot[forknum] = -1;
+    }
 
     reln->smgr_which = 0; /* we only have md.c at present */
 
@@ -736,6 +744,18 @@ void smgrextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, con
     (*(smgrsw[reln->smgr_which].smgr_extend))(reln, forknum, blocknum, buffer, skipFsync);
 }
 
+/*
+ *	smgrextendbatch() -- Add nblocks zeroed blocks to the file, starting
+ *						 at blocknum.
+ *
+ *		The blocks are not read into shared buffers; callers read them with
+ *		RBM_ZERO_AND_LOCK.
+ */
+void smgrextendbatch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks, bool skipFsync)
+{
+    (*(smgrsw[reln->smgr_which].smgr_extend_batch))(reln, forknum, blocknum, nblocks, skipFsync);
+}
+
 /*
  *	smgrprefetch() -- Initiate asynchronous read of the specified block of a relation.
  */
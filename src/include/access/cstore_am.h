@@ -240,6 +240,7 @@ public:  // public vars
 private:  // private methods.
     // CStore scan : pass vector to VE.
     void CStoreScan(CStoreScanState *state, VectorBatch *vecBatchOut);
+    static bool IsBulkReadRelation(Relation rel);
     void CStoreMinMaxScan(CStoreScanState *state, VectorBatch *vecBatchOut);
 
     // The number of holding CUDesc is  max_loaded_cudesc
@@ -322,6 +323,9 @@ private:
     int m_prefetch_threshold;
     bool m_load_finish;
 
+    // CUs are loaded by a large sequential scan, see CacheMgr::TouchCacheBlock_Locked
+    bool m_bulkRead;
+
     // Current scan position inside CU
     // 
     int *m_scanPosInCU;
@@ -292,6 +292,14 @@ typedef struct ReaderState {
     /* The size of the current file, this is 0 for foreign table. */
     int64_t currentFileSize;
 
+    /*
+     * A large file is scanned by all the SMP workers together, each of them reads
+     * the stripes (row groups for parquet) whose index modulo stripeSplitDop is
+     * stripeSplitId. stripeSplitDop is 1 when this worker reads the whole file.
+     */
+    int stripeSplitDop;
+    int stripeSplitId;
+
     /* The memory context to store the persist state when reading the file. */
     MemoryContext persistCtx;
 
@@ -326,6 +334,22 @@ typedef struct ReaderState {
     instr_time obsScanTime;
 } ReaderState;
 
+/* The files at least this large are split among the SMP workers at stripe/row group level. */
+#define DFS_SMP_SHARED_SPLIT_SIZE (256 * 1024 * 1024L)
+
+/*
+ * @Description: Check whether a stripe (row group for parquet) of the current
+ *     file is read by another SMP worker sharing the file.
+ * @IN readerState: the reader state of the scan.
+ * @IN stripeIdx: the index of the stripe in the file.
+ * @Return: true if the stripe must be skipped by this worker.
+ */
+static inline bool StripeOfOtherSmpWorker(const ReaderState *readerState, uint64_t stripeIdx)
+{
+    return readerState->stripeSplitDop > 1 &&
+           (int)(stripeIdx % (uint64_t)readerState->stripeSplitDop) != readerState->stripeSplitId;
+}
+
 /*
  * @Description: The factory function to create a reader for ORC file.
  * @IN readerState: the state information for reading
@@ -175,4 +175,86 @@
     }                                   \
 } while (0)
 
+/* Number of slots of the string datum cache, must be a power of 2 */
+#define DFS_STRING_DATUM_CACHE_SIZE 256
+
+/*
+ * Dictionary encoded string columns come back from the orc and parquet decoders
+ * as pointers into the dictionary, so all the rows sharing a dictionary entry
+ * share its address.  DfsStringDatumCache remembers the datum materialized for
+ * an address while one batch is filled, the following rows of the entry reuse
+ * the datum instead of being copied and encoding-checked again.
+ *
+ * All the values of a batch are alive while it is filled, so within a batch an
+ * address always holds the same string.  NextBatch() forgets the previous batch
+ * and must be called before each batch is filled.
+ */
+class DfsStringDatumCache : public BaseObject {
+public:
+    DfsStringDatumCache() : m_generation(0), m_pending(NULL)
+    {
+        errno_t rc = memset_s(m_entries, sizeof(m_entries), 0, sizeof(m_entries));
+        securec_check(rc, "\0", "\0");
+    }
+
+    inline void NextBatch()
+    {
+        if (++m_generation == 0) {
+            errno_t rc = memset_s(m_entries, sizeof(m_entries), 0, sizeof(m_entries));
+            securec_check(rc, "\0", "\0");
+            m_generation = 1;
+        }
+        m_pending = NULL;
+    }
+
+    /*
+     * Look up the datum of a string.  On a miss the slot is claimed for the string
+     * and Remember() must be called once the datum is materialized.
+     * @_in param ptr, len: the string returned by the decoder.
+     * @_out param value: the datum of an earlier row with the same string.
+     * @_out param meetError: whether the string failed the encoding check.
+     * @return true if the string was already materialized in this batch.
+     */
+    inline bool Lookup(const char *ptr, int64 len, Datum &value, bool &meetError)
+    {
+        uint32 slot = (uint32)(((uintptr_t)ptr * 0x9E3779B1U) >> 8) & (DFS_STRING_DATUM_CACHE_SIZE - 1);
+        Entry *entry = &m_entries[slot];
+
+        if (entry->generation == m_generation && entry->ptr == ptr && entry->len == len) {
+            value = entry->value;
+            meetError = entry->meetError;
+            return true;
+        }
+
+        /* not valid until Remember() */
+        entry->ptr = ptr;
+        entry->len = len;
+        entry->generation = 0;
+        m_pending = entry;
+        return false;
+    }
+
+    inline void Remember(Datum value, bool meetError)
+    {
+        Assert(m_pending != NULL);
+        m_pending->value = value;
+        m_pending->meetError = meetError;
+        m_pending->generation = m_generation;
+        m_pending = NULL;
+    }
+
+private:
+    typedef struct Entry {
+        const char *ptr;
+        int64 len;
+        uint32 generation;
+        bool meetError;
+        Datum value;
+    } Entry;
+
+    uint32 m_generation;
+    Entry *m_pending;
+    Entry m_entries[DFS_STRING_DATUM_CACHE_SIZE];
+};
+
 #endif
@@ -231,13 +231,26 @@ void dw_bootstrap();
 void dw_init(bool shutdown);
 
 /**
- * double write only work when incremental checkpoint enabled and double write enabled
+ * double write only work when incremental checkpoint enabled and double write enabled,
+ * and torn pages are not left to full page writes
  * @return true if both enabled
  */
 inline bool dw_enabled()
 {
-    return (
-        g_instance.attr.attr_storage.enableIncrementalCheckpoint && g_instance.attr.attr_storage.enable_double_write);
+    return (g_instance.attr.attr_storage.enableIncrementalCheckpoint &&
+            g_instance.attr.attr_storage.enable_double_write &&
+            g_instance.dw_batch_cxt.torn_page_mode == TORN_PAGE_DOUBLE_WRITE);
+}
+
+/**
+ * incremental checkpoint normally turns full page writes off, except when they are
+ * the torn page protection chosen by dw_init
+ * @return true if full page images must be written to WAL under incremental checkpoint
+ */
+inline bool dw_full_page_writes()
+{
+    return (g_instance.attr.attr_storage.enableIncrementalCheckpoint &&
+            g_instance.dw_batch_cxt.torn_page_mode == TORN_PAGE_FULL_PAGE_WRITE);
 }
 
 /**
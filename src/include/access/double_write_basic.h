@@ -102,6 +102,14 @@ const static uint32 DW_VIEW_COL_NAME_LEN = 32;
 #define DW_LOG_LEVEL DEBUG1
 #endif
 
+/*
+ * torn page protection of the data pages flushed by incremental checkpoint (torn_page_protection)
+ */
+typedef enum {
+    TORN_PAGE_DOUBLE_WRITE = 0, /* pages go through the double write files first */
+    TORN_PAGE_FULL_PAGE_WRITE   /* full page image in WAL on the first change after a checkpoint */
+} TornPageProtection;
+
 typedef Datum (*dw_view_get_data_func)();
 
 typedef struct st_dw_view_col {
@@ -68,7 +68,7 @@ extern TableScanDesc scan_handler_tbl_begin_tidscan(Relation relation, ScanState
 extern void scan_handler_tbl_end_tidscan(TableScanDesc scan);
 extern void scan_handler_tbl_markpos(TableScanDesc scan);
 extern void scan_handler_tbl_restrpos(TableScanDesc scan);
-extern void scan_handler_tbl_init_parallel_seqscan(TableScanDesc scan, int32 dop, ScanDirection dir);
+extern void scan_handler_tbl_init_parallel_seqscan(TableScanDesc scan, int32 dop, ScanDirection dir, int plan_node_id);
 extern TableScanDesc scan_handler_tbl_beginscan_bm(Relation relation, Snapshot snapshot, int nkeys, ScanKey key, ScanState* sstate);
 extern TableScanDesc scan_handler_tbl_beginscan_sampling(Relation relation, Snapshot snapshot, int nkeys, ScanKey key, bool allow_strat, bool allow_sync, ScanState* sstate);
 extern Tuple scan_handler_tbl_getnext(TableScanDesc scan, ScanDirection direction, Relation rel);
@@ -215,7 +215,7 @@ extern void heap_rescan(TableScanDesc sscan, ScanKey key);
 extern void heap_endscan(TableScanDesc scan);
 extern HeapTuple heap_getnext(TableScanDesc scan, ScanDirection direction);
 
-extern void heap_init_parallel_seqscan(TableScanDesc sscan, int32 dop, ScanDirection dir);
+extern void heap_init_parallel_seqscan(TableScanDesc sscan, int32 dop, ScanDirection dir, int plan_node_id);
 
 extern HeapTuple heapGetNextForVerify(TableScanDesc scan, ScanDirection direction, bool& isValidRelationPage);
 extern bool heap_fetch(Relation relation, Snapshot snapshot, HeapTuple tuple, Buffer *userbuf, bool keep_buf, Relation stats_relation);
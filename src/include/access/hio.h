@@ -38,5 +38,6 @@ extern Buffer RelationGetBufferForTuple(Relation relation, Size len, Buffer othe
     BulkInsertState bistate, Buffer* vmbuffer, Buffer* vmbuffer_other, BlockNumber end_rel_block);
 extern Buffer RelationGetNewBufferForBulkInsert(Relation relation, Size len, Size dictSize, BulkInsertState bistate);
 extern void RelationAddExtraBlocks(Relation relation, BulkInsertState bistate);
+extern void RelationReleaseBulkExtendBlocks(Relation relation, BlockNumber nblocks);
 
 #endif /* HIO_H */
@@ -118,6 +118,12 @@ typedef struct BTMetaPageData {
 #define BTREE_SPLIT_UPGRADE_FLAG 0x01
 #define BTREE_DELETE_UPGRADE_FLAG 0x02
 
+/* Upgrade support for suffix truncation of leaf high keys, see _bt_truncate(). */
+#define BTREE_SUFFIX_TRUNCATION_VERSION 92299
+
+/* Upgrade support for posting list tuples on leaf pages, see nbtdedup.cpp. */
+#define BTREE_DEDUP_VERSION 92300
+
 /*
  * Maximum size of a btree index entry, including its tuple header.
  *
@@ -129,6 +135,15 @@ typedef struct BTMetaPageData {
                       MAXALIGN(sizeof(BTPageOpaqueData))) /                                          \
                   3)
 
+/*
+ * MaxBTreeTIDsPerPage is an upper bound on the number of heap TIDs that may
+ * be stored on a btree leaf page, counting every TID of posting list tuples.
+ * It is used to size the per-page arrays of index scans.  Per-tuple overhead
+ * is ignored, which keeps the bound simple and safe.
+ */
+#define MaxBTreeTIDsPerPage \
+    (int)((BLCKSZ - SizeOfPageHeaderData - sizeof(BTPageOpaqueDataInternal)) / sizeof(ItemPointerData))
+
 /*
  * The leaf-page fillfactor defaults to 90% but is user-adjustable.
  * For pages above the leaf level, we use a fixed 70% fillfactor.
@@ -235,6 +250,7 @@ typedef struct BTMetaPageData {
 #define XLOG_BTREE_REUSE_PAGE                   \
     0xD0 /* old page is about to be reused from \
           * FSM */
+#define XLOG_BTREE_DEDUP 0xE0 /* merge equal leaf tuples into posting lists */
 
 
 enum {
@@ -258,6 +274,10 @@ enum {
     BTREE_DELETE_ORIG_BLOCK_NUM = 0,
 };
 
+enum {
+    BTREE_DEDUP_ORIG_BLOCK_NUM = 0,
+};
+
 enum {
     BTREE_HALF_DEAD_LEAF_PAGE_NUM = 0,
     BTREE_HALF_DEAD_PARENT_PAGE_NUM,
@@ -395,10 +415,50 @@ typedef struct xl_btree_reuse_page {
 typedef struct xl_btree_vacuum {
     BlockNumber lastBlockVacuumed;
 
-    /* TARGET OFFSET NUMBERS FOLLOW */
+    /*
+     * The counts are only logged when some posting list tuples lose part of
+     * their heap TIDs, see SizeOfBtreeVacuumPosting.  Without them, the block
+     * data is just the array of deleted offsets.
+     */
+    uint16 ndeleted;
+    uint16 nupdated;
+
+    /* DELETED TARGET OFFSET NUMBERS FOLLOW */
+    /* UPDATED TARGET OFFSET NUMBERS FOLLOW */
+    /* UPDATED TUPLES METADATA (xl_btree_update) ARRAY FOLLOWS */
 } xl_btree_vacuum;
 
 #define SizeOfBtreeVacuum (offsetof(xl_btree_vacuum, lastBlockVacuumed) + sizeof(BlockNumber))
+#define SizeOfBtreeVacuumPosting (offsetof(xl_btree_vacuum, nupdated) + sizeof(uint16))
+
+/*
+ * Each updated posting list tuple of a vacuum record is described by one of
+ * these, followed by the ndeletedtids posting list indexes (uint16) of the
+ * heap TIDs that were removed from it.
+ */
+typedef struct xl_btree_update {
+    uint16 ndeletedtids;
+
+    /* POSTING LIST uint16 OFFSETS TO A DELETED TID FOLLOW */
+} xl_btree_update;
+
+#define SizeOfBtreeUpdate (offsetof(xl_btree_update, ndeletedtids) + sizeof(uint16))
+
+/*
+ * This is what we need to know about a deduplication pass on a leaf page.
+ * Each interval of the block data names a run of equal tuples, which replay
+ * merges into a single posting list tuple, just like _bt_dedup_one_page()
+ * did.
+ *
+ * Backup Blk 0: leaf page
+ */
+typedef struct xl_btree_dedup {
+    uint16 nintervals;
+
+    /* DEDUPLICATION INTERVALS (BTDedupInterval) FOLLOW */
+} xl_btree_dedup;
+
+#define SizeOfBtreeDedup (offsetof(xl_btree_dedup, nintervals) + sizeof(uint16))
 
 /*
  * This is what we need to know about deletion of a btree page.  The target
@@ -503,7 +563,11 @@ typedef struct xl_btree_newroot {
  * present in leaf index tuples whose item pointers actually point to heap
  * tuples.  All other types of index tuples (collectively, "pivot" tuples)
  * only have key attributes, since pivot tuples only ever need to represent
- * how the key space is separated.  In general, any B-Tree index that has
+ * how the key space is separated.  Leaf high keys (and so the downlinks
+ * copied from them) may even lack trailing key attributes, when the leading
+ * ones are enough to separate the last item on the left page from the first
+ * one on the right page; the missing attributes are treated as "minus
+ * infinity" by _bt_compare().  In general, any B-Tree index that has
  * more than one level (i.e. any index that does not just consist of a
  * metapage and a single leaf root page) must have some number of pivot
  * tuples, since pivot tuples are used for traversing the tree.
@@ -515,19 +579,25 @@ typedef struct xl_btree_newroot {
  * bit is set (we never assume that pivot tuples must explicitly store the
  * number of attributes, and currently do not bother storing the number of
  * attributes unless indnkeyatts actually differs from indnatts).
- * INDEX_ALT_TID_MASK is only used for pivot tuples at present, though it's
- * possible that it will be used within non-pivot tuples in the future.  Do
- * not assume that a tuple with INDEX_ALT_TID_MASK set must be a pivot
- * tuple.
  *
  * The 12 least significant offset bits are used to represent the number of
  * attributes in INDEX_ALT_TID_MASK tuples, leaving 4 bits that are reserved
- * for future use (BT_RESERVED_OFFSET_MASK bits). BT_N_KEYS_OFFSET_MASK should
+ * for other uses (BT_RESERVED_OFFSET_MASK bits). BT_N_KEYS_OFFSET_MASK should
  * be large enough to store any number <= INDEX_MAX_KEYS.
+ *
+ * Posting list tuples are non-pivot leaf tuples that stand for a run of
+ * equal leaf tuples, see nbtdedup.cpp.  They have INDEX_ALT_TID_MASK set too,
+ * together with the BT_IS_POSTING reserved offset bit.  Their 12 least
+ * significant offset bits hold the number of heap TIDs instead, and the block
+ * number field holds the byte offset of the posting list, an array of heap
+ * TIDs in ascending order that follows the key attributes.  So a tuple with
+ * INDEX_ALT_TID_MASK set is not necessarily a pivot tuple.  Posting list
+ * tuples never appear in unique indexes, on internal pages or as high keys.
  */
 #define INDEX_ALT_TID_MASK INDEX_AM_RESERVED_BIT
 #define BT_RESERVED_OFFSET_MASK 0xF000
 #define BT_N_KEYS_OFFSET_MASK 0x0FFF
+#define BT_IS_POSTING 0x2000
 
 /* Get/set downlink block number */
 #define BTreeInnerTupleGetDownLink(itup) ItemPointerGetBlockNumberNoCheck(&((itup)->t_tid))
@@ -546,16 +616,28 @@ typedef struct xl_btree_newroot {
         BTreeTupleSetNAtts((itup), 0);                        \
     } while (0)
 
+/* Tell pivot and posting list tuples apart, see above */
+#define BTreeTupleIsPivot(itup)                       \
+    (((itup)->t_info & INDEX_ALT_TID_MASK) != 0 &&    \
+        (ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_IS_POSTING) == 0)
+#define BTreeTupleIsPosting(itup)                     \
+    (((itup)->t_info & INDEX_ALT_TID_MASK) != 0 &&    \
+        (ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_IS_POSTING) != 0)
+
 /*
- * Get/set number of attributes within B-tree index tuple. Asserts should be
- * removed when BT_RESERVED_OFFSET_MASK bits will be used.
+ * Get/set number of attributes within B-tree index tuple.  Posting list
+ * tuples have all of them, like any other non-pivot tuple.
  */
 #define BTreeTupleGetNAtts(itup, rel)                                                                           \
-    ((itup)->t_info & INDEX_ALT_TID_MASK                                                                        \
+    (BTreeTupleIsPivot(itup)                                                                                    \
             ? (AssertMacro((ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_RESERVED_OFFSET_MASK) == 0), \
                   ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_N_KEYS_OFFSET_MASK)                    \
             : IndexRelationGetNumberOfAttributes(rel))
 
+/* Number of key attributes of a pivot tuple, which may be suffix truncated */
+#define BTreeTupleGetNKeyAtts(itup, rel) \
+    Min(BTreeTupleGetNAtts(itup, rel), IndexRelationGetNumberOfKeyAttributes(rel))
+
 #define BTreeTupleSetNAtts(itup, n)                                                 \
     do {                                                                            \
         (itup)->t_info |= INDEX_ALT_TID_MASK;                                       \
@@ -563,6 +645,30 @@ typedef struct xl_btree_newroot {
         ItemPointerSetOffsetNumber(&(itup)->t_tid, (n) & BT_N_KEYS_OFFSET_MASK);    \
     } while (0)
 
+/*
+ * Access the posting list of a posting list tuple.  The key attributes end
+ * at the posting list offset, which is where the plain tuple that was the
+ * base of the posting list ended.
+ */
+#define BTreeTupleGetNPosting(itup) \
+    (AssertMacro(BTreeTupleIsPosting(itup)), (int)(ItemPointerGetOffsetNumberNoCheck(&(itup)->t_tid) & BT_N_KEYS_OFFSET_MASK))
+#define BTreeTupleGetPostingOffset(itup) \
+    (AssertMacro(BTreeTupleIsPosting(itup)), (Size)ItemPointerGetBlockNumberNoCheck(&(itup)->t_tid))
+#define BTreeTupleGetPosting(itup) ((ItemPointer)((char*)(itup) + BTreeTupleGetPostingOffset(itup)))
+#define BTreeTupleGetPostingN(itup, n) (BTreeTupleGetPosting(itup) + (n))
+
+/* Number of heap TIDs a non-pivot tuple stands for */
+#define BTreeTupleGetNHeapTIDs(itup) (BTreeTupleIsPosting(itup) ? BTreeTupleGetNPosting(itup) : 1)
+
+#define BTreeTupleSetPosting(itup, nhtids, postingoffset)                            \
+    do {                                                                             \
+        Assert((nhtids) > 1 && ((nhtids) & BT_N_KEYS_OFFSET_MASK) == (nhtids));     \
+        Assert((postingoffset) == MAXALIGN(postingoffset));                          \
+        (itup)->t_info |= INDEX_ALT_TID_MASK;                                        \
+        ItemPointerSetOffsetNumber(&(itup)->t_tid, (nhtids) | BT_IS_POSTING);        \
+        ItemPointerSetBlockNumber(&(itup)->t_tid, (postingoffset));                  \
+    } while (0)
+
 /*
  *	Operator strategy numbers for B-tree have been moved to access/skey.h,
  *	because many places need to use them in ScanKeyInit() calls.
@@ -614,6 +720,44 @@ typedef struct BTStackData {
 
 typedef BTStackData* BTStack;
 
+/*
+ * BTDedupStateData is the working state of deduplication: the run of equal
+ * tuples that is going to be merged into a single posting list tuple.
+ */
+typedef struct BTDedupStateData {
+    Size maxpostingsize;  /* limit on the size of the final tuple */
+    IndexTuple base;      /* first tuple of the pending run */
+    OffsetNumber baseoff; /* page offset of base, if any */
+    Size basetupsize;     /* size of base without its posting list */
+    ItemPointer htids;    /* heap TIDs of the pending run */
+    int nhtids;           /* number of heap TIDs in htids */
+    int nitems;           /* number of tuples in the pending run */
+} BTDedupStateData;
+
+typedef BTDedupStateData* BTDedupState;
+
+/*
+ * A run of nitems tuples starting at baseoff, merged into one posting list
+ * tuple by a deduplication pass.  This is what XLOG_BTREE_DEDUP records carry.
+ */
+typedef struct BTDedupInterval {
+    OffsetNumber baseoff;
+    uint16 nitems;
+} BTDedupInterval;
+
+/*
+ * A posting list tuple that VACUUM removes some but not all heap TIDs from.
+ * deletetids holds the posting list indexes of the removed TIDs.
+ */
+typedef struct BTVacuumPostingData {
+    IndexTuple itup;           /* the posting list tuple on the page */
+    OffsetNumber updatedoffset;
+    uint16 ndeletedtids;
+    uint16 deletetids[FLEXIBLE_ARRAY_MEMBER];
+} BTVacuumPostingData;
+
+typedef BTVacuumPostingData* BTVacuumPosting;
+
 /*
  * BTScanOpaqueData is the btree-private state needed for an indexscan.
  * This consists of preprocessed scan keys (see _bt_preprocess_keys() for
@@ -638,6 +782,10 @@ typedef BTStackData* BTStack;
  * matched item, otherwise only its heap TID and offset.  The IndexTuples go
  * into a separate workspace array; each BTScanPosItem stores its tuple's
  * offset within that array.
+ *
+ * A posting list tuple gives one BTScanPosItem per heap TID.  They all have
+ * the same indexOffset, and in an index-only scan they share one copy of the
+ * tuple, saved without its posting list.
  */
 
 typedef struct BTScanPosItem { /* what we remember about each match */
@@ -669,7 +817,8 @@ typedef struct BTScanPosData {
 
     /*
      * The items array is always ordered in index order (ie, increasing
-     * indexoffset).  When scanning backwards it is convenient to fill the
+     * indexoffset, then increasing heap TID within a posting list tuple).
+     * When scanning backwards it is convenient to fill the
      * array back-to-front, so we start at the last slot and fill downwards.
      * Hence we need both a first-valid-entry and a last-valid-entry counter.
      * itemIndex is a cursor showing which entry was last returned to caller.
@@ -678,7 +827,7 @@ typedef struct BTScanPosData {
     int lastItem;  /* last valid index in items[] */
     int itemIndex; /* current index in items[] */
 
-    BTScanPosItem items[MaxIndexTuplesPerPage]; /* MUST BE LAST */
+    BTScanPosItem items[MaxBTreeTIDsPerPage]; /* MUST BE LAST */
 } BTScanPosData;
 
 typedef BTScanPosData* BTScanPos;
@@ -728,6 +877,18 @@ typedef struct BTScanOpaqueData {
      */
     int markItemIndex; /* itemIndex, or -1 if not valid */
 
+    /*
+     * Heap prefetching of a plain index scan keeps up to target_prefetch_pages
+     * heap blocks of currPos requested ahead of currPos.itemIndex.
+     * prefetchItem is the next item of currPos whose block is not requested
+     * yet, or -1 if we don't prefetch on this page; prefetchBlock is the
+     * block of the item before it, and prefetchDistance the number of blocks
+     * requested ahead of the item being returned.
+     */
+    int prefetchItem;
+    int prefetchDistance;
+    BlockNumber prefetchBlock;
+
     /* keep these last in struct for efficiency */
     BTScanPosData currPos; /* current position data */
     BTScanPosData markPos; /* marked position, if any */
@@ -819,7 +980,21 @@ extern bool _bt_doinsert(Relation rel, IndexTuple itup, IndexUniqueCheck checkUn
 extern Buffer _bt_getstackbuf(Relation rel, BTStack stack);
 extern void _bt_insert_parent(Relation rel, Buffer buf, Buffer rbuf, BTStack stack, bool is_root, bool is_only);
 extern void _bt_finish_split(Relation rel, Buffer bbuf, BTStack stack);
-extern IndexTuple _bt_nonkey_truncate(Relation idxrel, IndexTuple olditup);
+extern IndexTuple _bt_truncate(Relation idxrel, IndexTuple lastleft, IndexTuple firstright);
+
+/*
+ * prototypes for functions in nbtdedup.c
+ */
+extern bool _bt_dedup_enabled(Relation rel);
+extern bool _bt_dedup_page_has_duplicates(Page page);
+extern bool _bt_dedup_one_page(Relation rel, Buffer buf);
+extern void _bt_dedup_start_pending(BTDedupState state, IndexTuple base, OffsetNumber baseoff);
+extern bool _bt_dedup_save_htid(BTDedupState state, IndexTuple itup);
+extern bool _bt_dedup_equal(IndexTuple itup1, IndexTuple itup2);
+extern Page _bt_dedup_build_page(Page page, const BTDedupInterval* intervals, int nintervals);
+extern IndexTuple _bt_form_posting(IndexTuple base, const ItemPointerData* htids, int nhtids);
+extern IndexTuple _bt_update_posting(IndexTuple origtuple, const uint16* deletetids, int ndeletedtids);
+extern void _bt_replace_item(Page page, OffsetNumber offnum, IndexTuple itup);
 
 /*
  * prototypes for functions in nbtpage.c
@@ -834,8 +1009,8 @@ extern void _bt_relbuf(Relation rel, Buffer buf);
 extern void _bt_pageinit(Page page, Size size);
 extern bool _bt_page_recyclable(Page page);
 extern void _bt_delitems_delete(Relation rel, Buffer buf, OffsetNumber* itemnos, int nitems, Relation heapRel);
-extern void _bt_delitems_vacuum(
-    Relation rel, Buffer buf, OffsetNumber* itemnos, int nitems, BlockNumber lastBlockVacuumed);
+extern void _bt_delitems_vacuum(Relation rel, Buffer buf, OffsetNumber* itemnos, int nitems,
+    BTVacuumPosting* updatable, int nupdatable, BlockNumber lastBlockVacuumed);
 extern int _bt_pagedel(Relation rel, Buffer buf, BTStack stack);
 extern void _bt_page_localupgrade(Page page);
 /*
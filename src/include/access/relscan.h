@@ -19,8 +19,30 @@
 #include "access/heapam.h"
 #include "access/itup.h"
 #include "access/tupdesc.h"
+#include "utils/atomic.h"
 
 #define PARALLEL_SCAN_GAP 100
+/* chunks shrink once fewer than dop * PARALLEL_SCAN_RAMPDOWN of them remain */
+#define PARALLEL_SCAN_RAMPDOWN 4
+
+/*
+ * Block allocator shared by the SMP workers of one parallel seqscan. Workers
+ * claim chunks of at most PARALLEL_SCAN_GAP blocks from nallocated, so a
+ * worker slowed down by expensive pages does not hold up the others. The
+ * allocator lives in the stream node group and is found by plan node id and
+ * relfilenode; see StreamNodeGroup::AttachParallelScan().
+ */
+typedef struct ParallelBlockAllocData {
+    int plan_node_id;               /* SeqScan node owning the allocator */
+    RelFileNode rnode;              /* relation (or partition, bucket) scanned */
+    uint64 attached;                /* bitmask of smp ids that joined */
+    BlockNumber nblocks;            /* fixed by the first worker to join */
+    BlockNumber startblock;         /* syncscan start point, 0 if none */
+    pg_atomic_uint32 nallocated;    /* blocks handed out so far */
+    struct ParallelBlockAllocData* next;
+} ParallelBlockAllocData;
+
+typedef struct ParallelBlockAllocData* ParallelBlockAlloc;
 
 /* ----------------------------------------------------------------
  *				 Scan State Information
@@ -42,6 +64,8 @@ typedef struct HeapScanDescData {
     /* these fields only used in page-at-a-time mode and for bitmap scans */
     int rs_mindex;                                   /* marked tuple's saved index */
     int dop;                                         /* scan parallel degree */
+    ParallelBlockAlloc rs_parallel;                  /* shared block allocator, NULL if static striping */
+    BlockNumber rs_chunkend;                         /* end (exclusive) of the chunk being scanned */
     /* put decompressed tuple data into rs_ctbuf be careful  , when malloc memory  should give extra mem for
      *xs_ctbuf_hdr. t_bits which is varlength arr
      */
@@ -89,6 +113,7 @@ typedef struct IndexScanDescData {
     ScanKey orderByData;    /* array of ordering op descriptors */
     bool xs_want_itup;      /* caller requests index tuples */
     bool xs_want_ext_oid;    /* global partition index need partition oid */
+    bool xs_heap_prefetch;   /* AM may prefetch the heap pages of its matches */
 
     /* signaling to index AM about killing index tuples */
     bool kill_prior_tuple;      /* last-returned tuple is dead */
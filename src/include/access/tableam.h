@@ -354,7 +354,7 @@ typedef struct TableAmRoutine
     /*
      * init parallel seq scan
      */
-    void (*scan_init_parallel_seqscan) (TableScanDesc sscan, int32 dop, ScanDirection dir);
+    void (*scan_init_parallel_seqscan) (TableScanDesc sscan, int32 dop, ScanDirection dir, int plan_node_id);
 
     /*
      * Get next tuple
@@ -741,9 +741,10 @@ static inline void tableam_scan_markpos(TableScanDesc sscan)
     return g_tableam_routines[sscan->rs_rd->rd_tam_type]->scan_markpos(sscan);
 }
 
-static inline void tableam_scan_init_parallel_seqscan(TableScanDesc sscan, int32 dop, ScanDirection dir)
+static inline void tableam_scan_init_parallel_seqscan(TableScanDesc sscan, int32 dop, ScanDirection dir,
+    int plan_node_id)
 {    
-    return g_tableam_routines[sscan->rs_rd->rd_tam_type]->scan_init_parallel_seqscan(sscan, dop, dir);
+    return g_tableam_routines[sscan->rs_rd->rd_tam_type]->scan_init_parallel_seqscan(sscan, dop, dir, plan_node_id);
 }
 
 static inline double tableam_index_build_scan(Relation heapRelation, Relation indexRelation, 
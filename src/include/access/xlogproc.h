@@ -734,7 +734,9 @@ void BtreeXlogSplitOperatorRightpage(
 void BtreeXlogSplitOperatorNextpage(RedoBufferInfo* buffer, BlockNumber rightsib);
 void BtreeXlogSplitOperatorLeftpage(
     RedoBufferInfo* lbuf, void* recorddata, BlockNumber rightsib, bool onleft, void* blkdata, Size datalen);
-void BtreeXlogVacuumOperatorPage(RedoBufferInfo* redobuffer, void* recorddata, void* blkdata, Size len);
+void BtreeXlogVacuumOperatorPage(
+    RedoBufferInfo* redobuffer, void* recorddata, Size recorddatalen, void* blkdata, Size len);
+void BtreeXlogDedupOperatorPage(RedoBufferInfo* buffer, void* recorddata, void* blkdata, Size len);
 void BtreeXlogDeleteOperatorPage(RedoBufferInfo* buffer, void* recorddata, Size recorddatalen);
 void btreeXlogDeletePageOperatorRightpage(RedoBufferInfo* buffer, void* recorddata);
 
@@ -62,6 +62,7 @@ struct StreamState;
 class StreamObj;
 class StreamNodeGroup;
 struct SyncController;
+struct ParallelBlockAllocData;
 
 typedef bool (*scanStreamFun)(StreamState* node);
 typedef bool (*deserializeStreamFun)(StreamState* node);
@@ -377,6 +378,9 @@ public:
     /* Controller list for recursive */
     List* m_syncControllers;
 
+    /* Block allocators of parallel seqscans, linked through next */
+    ParallelBlockAllocData* m_parallelScans;
+
     MemoryContext m_streamRuntimeContext;
 
     /* Save the first error data of producer thread */
@@ -401,6 +405,10 @@ public:
     SyncController* GetSyncController(int controller_plannodeid);
     void MarkSyncControllerStopFlagAll();
 
+    /* Join the shared block allocator of a parallel seqscan. */
+    static ParallelBlockAllocData* AttachParallelScan(
+        int planNodeId, const RelFileNode* rnode, int smpId, BlockNumber nblocks, BlockNumber startblock);
+
     inline pthread_mutex_t* GetStreamMutext()
     {
         return &m_mutex;
@@ -111,6 +111,7 @@ typedef enum knl_thread_role {
     COMM_POOLER_CLEAN,
     CSNMIN_SYNC,
     BARRIER_CREATOR,
+    AIO_COMPLETER,
     TS_COMPACTION,
     TS_COMPACTION_CONSUMER,
     TS_COMPACTION_AUXILIAY,
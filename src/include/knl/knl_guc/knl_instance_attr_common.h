@@ -51,6 +51,7 @@ typedef struct knl_instance_attr_common {
     bool enable_thread_pool;
     bool enable_ffic_log;
     bool enable_global_plancache;
+    bool enable_global_syscache;
     int max_files_per_process;
     int pgstat_track_activity_query_size;
     int GtmHostPortArray[MAX_GTM_HOST_NUM];
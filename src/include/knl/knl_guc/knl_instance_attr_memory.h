@@ -46,6 +46,7 @@ typedef struct knl_instance_attr_memory {
     int memorypool_size;
     int max_process_memory;
     int local_syscache_threshold;
+    int global_syscache_threshold;
 } knl_instance_attr_memory;
 
 #endif /* SRC_INCLUDE_KNL_KNL_INSTANCE_ATTR_MEMORY_H_ */
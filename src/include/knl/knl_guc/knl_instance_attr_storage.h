@@ -57,9 +57,14 @@ typedef struct knl_instance_attr_storage {
     int DataQueueBufSize;
     int NBuffers;
     int cstore_buffers;
+    int cstore_cache_policy;
+    int adio_io_engine;
+    int torn_page_protection;
     int MaxSendSize;
     int max_prepared_xacts;
     int max_locks_per_xact;
+    int relsize_cache_entries;
+    int fsm_target_cache_entries;
     int max_predicate_locks_per_xact;
     int64 xlog_idle_flushes_before_sleep;
     int num_xloginsert_locks;
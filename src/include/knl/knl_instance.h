@@ -109,6 +109,7 @@ typedef struct knl_g_cache_context
 {
     MemoryContext global_cache_mem;
     MemoryContext global_plancache_mem[MAX_GLOBAL_CACHEMEM_NUM];
+    struct GlobalCatCacheHeader* global_catcache;
 } knl_g_cache_context;
 
 typedef struct knl_g_cost_context {
@@ -155,6 +156,7 @@ typedef struct knl_g_pid_context {
     ThreadId CBMWriterPID;
     ThreadId RemoteServicePID;
     ThreadId AioCompleterStarted;
+    ThreadId AioUringCompltrPID;
     ThreadId HeartbeatPID;
     ThreadId CsnminSyncPID;
     ThreadId BarrierCreatorPID;
@@ -450,6 +452,7 @@ typedef struct knl_g_dw_context {
     char* buf;
     dw_file_head_t* file_head;
     bool contain_hashbucket;
+    int torn_page_mode; /* torn page protection in effect, resolved by dw_init, batch context only */
 
     /* single flush dw extras information */
     single_slot_pos *single_flush_pos;     /* dw single flush slot */
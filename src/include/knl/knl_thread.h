@@ -746,6 +746,11 @@ typedef struct knl_t_cbm_context {
 /* thread local pointer to the shared memory */
 typedef struct knl_t_shemem_ptr_context {
     struct ss_scan_locations_t* scan_locations;
+    /* shared relation size cache, relsize.cpp */
+    struct RelSizeCacheCtl* relsize_cache;
+    struct HTAB* relsize_hash;
+    /* shared FSM target cache, fsmcache.cpp */
+    struct FsmTargetCacheCtl* fsm_target_cache;
     struct SlruCtlData* MultiXactOffsetCtl;
     struct SlruCtlData* MultiXactMemberCtl;
     struct MultiXactStateData* MultiXactState;
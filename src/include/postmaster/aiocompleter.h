@@ -52,6 +52,11 @@ typedef enum { DefaultPri = 0, HighPri = 1, MediumPri = 2, LowPri = 3 } AioPrior
 
 typedef enum { AioRead = 0, AioWrite = 1, AioVacummFull = 2, AioUnkown } AioDescType;
 
+/*
+ * kernel interface used to dispatch and complete the requests (adio_io_engine)
+ */
+typedef enum { AioEngineLibaio = 0, AioEngineIoUring, AioEngineIoUringSqpoll } AioEngineType;
+
 /*
  * Context for Page AIO completion
  */
@@ -97,12 +102,18 @@ extern int AioCompltrSets;
 extern int AioCompltrEvents;
 
 extern void AioCompltrMain(int ac, char** av);
+extern void AioCompltrUringMain(void);
 extern void AioCompltrStop(int signal);
 extern int AioCompltrStart(void);
+extern void AioCompltrReset(void);
 extern bool AioCompltrIsReady(void);
 extern io_context_t CompltrContext(AioCompltrType reqType, int h);
 extern short CompltrPriority(AioCompltrType reqType);
 
+/* io_uring dispatch, used instead of CompltrContext() when CompltrUringActive() */
+extern bool CompltrUringActive(void);
+extern int CompltrUringSubmit(AioCompltrType reqType, struct iocb** iocbList, int count);
+
 /*
  * These Storage Manager AIO prototypes would normally
  * go in smgr.h, and that file would include this one.
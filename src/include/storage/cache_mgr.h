@@ -58,6 +58,20 @@ const int CACHE_BLOCK_NO_LIST = -2;      // Invalid index -not in any list
 // Max usage count for CLOCK cache strategy
 const uint16 CACHE_BLOCK_MAX_USAGE = 5;
 
+// Cache Block segments, only used by CACHE_POLICY_2Q
+const unsigned char CACHE_SEGMENT_PROBATION = 0x00;  // admitted once, first choice of eviction
+const unsigned char CACHE_SEGMENT_PROTECTED = 0x01;  // re-referenced, evicted only when over budget
+const unsigned char CACHE_SEGMENT_PREFETCH = 0x02;   // reserved by prefetch, not referenced yet
+
+// Percent of cache memory the protected segment may hold before it is demoted
+const int CACHE_PROTECTED_PERCENT = 75;
+
+/* eviction policy of cache manager, see cstore_cache_policy */
+typedef enum CachePolicy {
+    CACHE_POLICY_CLOCK = 0, /* plain clock sweep over all blocks */
+    CACHE_POLICY_2Q         /* segmented clock, probationary and protected segments */
+} CachePolicy;
+
 /* common buffer cache function for cu cache and orc cache */
 #define MAX_CACHE_TAG_LEN (32)
 
@@ -153,6 +167,9 @@ typedef struct CacheDesc {
     slock_t m_slot_hdr_lock;
 
     CacheFlags m_flag;
+
+    /* CACHE_SEGMENT_PROBATION, CACHE_SEGMENT_PROTECTED or CACHE_SEGMENT_PREFETCH */
+    unsigned char m_segment;
 } CacheDesc;
 
 int CacheMgrNumLocks(int64 cache_size, uint32 each_block_size);
@@ -170,10 +187,11 @@ public:
 
     /* operate cache block */
     void InitCacheBlockTag(CacheTag* cacheTag, int32 type, const void* key, int32 length) const;
-    CacheSlotId_t FindCacheBlock(CacheTag* cacheTag, bool first_enter_block);
+    CacheSlotId_t FindCacheBlock(CacheTag* cacheTag, bool first_enter_block, bool bulkRead = false);
     void InvalidateCacheBlock(CacheTag* cacheTag);
     void DeleteCacheBlock(CacheTag* cacheTag);
-    CacheSlotId_t ReserveCacheBlock(CacheTag* cacheTag, int size, bool& hasFound);
+    CacheSlotId_t ReserveCacheBlock(
+        CacheTag* cacheTag, int size, bool& hasFound, bool bulkRead = false, bool prefetch = false);
     bool ReserveCacheBlockWithSlotId(CacheSlotId_t slotId);
     bool ReserveCstoreCacheBlockWithSlotId(CacheSlotId_t slotId);
     void* GetCacheBlock(CacheSlotId_t slotId);
@@ -236,6 +254,11 @@ private:
     CacheSlotId_t EvictCacheBlock(int size, int retryNum);
     CacheSlotId_t GetFreeCacheBlock(int size);
 
+    /* eviction policy */
+    void TouchCacheBlock_Locked(CacheSlotId_t slotId, bool bulkRead);
+    void ResetCacheBlockSegment_Locked(CacheSlotId_t slotId);
+    bool SweepProtectedBlock_Locked(CacheSlotId_t slotId, int looped);
+
     /* memory operate */
     bool ReserveCacheMem(int size);
     void FreeCacheBlockMem(CacheSlotId_t slotId);
@@ -272,8 +295,14 @@ private:
     int64 m_cstoreMaxSize;
     int64 m_cstoreCurrentSize;
 
+    /* eviction policy and memory held by the protected segment */
+    CachePolicy m_policy;
+    int64 m_protectedSize;
+    int64 m_protectedMaxSize;
+
     int m_freeListHead;
     int m_freeListTail;
+    int m_freeListCount; /* slots on the free list, the others hold a block */
     slock_t m_freeList_lock;
 
     int m_csweep;
@@ -110,8 +110,9 @@ public:
     DataSlotTag InitORCSlotTag(RelFileNode* rnode, int32 fileid, uint64 offset, uint64 length);
     DataSlotTag InitOBSSlotTag(uint32 hostNameHash, uint32 bucketNameHash, uint32 fileFirstHalfHash,
         uint32 fileSecondHalfHash, uint64 offset, uint64 length) const;
-    CacheSlotId_t FindDataBlock(DataSlotTag* dataSlotTag, bool first_enter_block);
-    int ReserveDataBlock(DataSlotTag* dataSlotTag, int size, bool& hasFound);
+    CacheSlotId_t FindDataBlock(DataSlotTag* dataSlotTag, bool first_enter_block, bool bulkRead = false);
+    int ReserveDataBlock(
+        DataSlotTag* dataSlotTag, int size, bool& hasFound, bool bulkRead = false, bool prefetch = false);
     bool ReserveDataBlockWithSlotId(int slotId);
     bool ReserveCstoreDataBlockWithSlotId(int slotId);
     CU* GetCUBuf(int cuSlotId);
@@ -95,4 +95,8 @@ extern BlockNumber fsm_logical_to_physical(const FSMAddress& addr);
 extern uint8 fsm_space_avail_to_cat(Size avail);
 extern bool fsm_set_avail(Page page, int slot, uint8 value);
 
+/* in fsmcache.c */
+extern Size FsmTargetCacheShmemSize(void);
+extern void FsmTargetCacheShmemInit(void);
+
 #endif /* FREESPACE_H_ */
@@ -16,6 +16,7 @@
 
 #include "storage/buf/buf.h"
 #include "storage/buf/bufpage.h"
+#include "utils/relcache.h"
 
 /*
  * Structure of a FSM page. See src/backend/storage/freespace/README for
@@ -65,4 +66,11 @@ extern uint8 fsm_get_max_avail(Page page);
 extern bool fsm_truncate_avail(Page page, int nslots);
 extern bool fsm_rebuild_page(Page page);
 
+/* Prototypes for functions in fsmcache.c */
+extern BlockNumber fsm_target_get(Relation rel, uint8 min_cat);
+extern void fsm_target_set(Relation rel, BlockNumber blkno, uint8 cat);
+extern void fsm_target_update(Relation rel, BlockNumber blkno, uint8 cat);
+extern bool fsm_target_taken(Relation rel, BlockNumber blkno);
+extern void fsm_target_forget(Relation rel);
+
 #endif /* FSM_INTERNALS_H */
@@ -76,6 +76,12 @@ extern const char *const MainLWLockNames[];
 /* Number of partions the global plan cache hashtable */
 #define NUM_GPC_PARTITIONS 128
 
+/* Number of partions the global catalog cache hashtable */
+#define NUM_GLOBAL_CATCACHE_PARTITIONS 64
+
+/* Number of partions the shared relation size cache hashtable */
+#define NUM_RELSIZE_CACHE_PARTITIONS 128
+
 /* Number of partions normalized query hashtable */
 #define NUM_NORMALIZED_SQL_PARTITIONS 64
 
@@ -128,9 +134,14 @@ enum LWLockTrunkOffset {
 
     FirstNGroupMappingLock = FirstMPFLLock + NUM_MAX_PAGE_FLUSH_LSN_PARTITIONS,
     FirstIOStatLock = FirstNGroupMappingLock + NUM_NGROUP_INFO_PARTITIONS,
+    /* global catalog cache */
+    FirstGlobalCatCacheLock = FirstIOStatLock + NUM_IO_STAT_PARTITIONS,
+
+    /* shared relation size cache */
+    FirstRelSizeCacheLock = FirstGlobalCatCacheLock + NUM_GLOBAL_CATCACHE_PARTITIONS,
 
     /* must be last: */
-    NumFixedLWLocks = FirstIOStatLock + NUM_IO_STAT_PARTITIONS
+    NumFixedLWLocks = FirstRelSizeCacheLock + NUM_RELSIZE_CACHE_PARTITIONS
 };
 
 /*
@@ -190,6 +201,8 @@ enum BuiltinTrancheIds
     LWTRANCHE_WAL_FLUSH_WAIT,
     LWTRANCHE_WAL_BUFFER_INIT_WAIT,
     LWTRANCHE_WAL_INIT_SEGMENT,
+    LWTRANCHE_GLOBAL_CATCACHE,
+    LWTRANCHE_RELSIZE_CACHE,
     /*
      * Each trancheId above should have a corresponding item in BuiltinTrancheNames;
      */
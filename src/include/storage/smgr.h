@@ -51,13 +51,15 @@ typedef struct SMgrRelationData {
     struct SMgrRelationData** smgr_owner;
 
     /*
-     * These next three fields are not actually used or manipulated by smgr,
+     * These next fields are not actually used or manipulated by smgr,
      * except that they are reset to InvalidBlockNumber upon a cache flush
      * event (in particular, upon truncation of the relation).	Higher levels
      * store cached state here so that it will be reset when truncation
-     * happens.  In all three cases, InvalidBlockNumber means "unknown".
+     * happens.  In all cases, InvalidBlockNumber means "unknown".
      */
     BlockNumber smgr_targblock;   /* current insertion target block */
+    BlockNumber smgr_bulk_next;   /* next block pre-extended for our inserts */
+    BlockNumber smgr_bulk_end;    /* end (exclusive) of those blocks */
     BlockNumber smgr_fsm_nblocks; /* last known size of fsm fork */
     BlockNumber smgr_vm_nblocks;  /* last known size of vm fork */
 
@@ -73,6 +75,10 @@ typedef struct SMgrRelationData {
      int smgr_which; /* storage manager selector */
 
 
+    /* slot and generation in the shared relation size cache, -1 if not known */
+    int smgr_relsize_slot[MAX_FORKNUM + 1];
+    uint32 smgr_relsize_gen[MAX_FORKNUM + 1];
+
     /* for md.c; NULL for forks that are not open */
     int md_fdarray_size;
     struct _MdfdVec** md_fd;
@@ -101,6 +107,8 @@ extern void smgrcreate(SMgrRelation reln, ForkNumber forknum, bool isRedo );
 extern void smgrdounlink(SMgrRelation reln, bool isRedo);
 extern void smgrdounlinkfork(SMgrRelation reln, ForkNumber forknum, bool isRedo);
 extern void smgrextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
+extern void smgrextendbatch(
+    SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks, bool skipFsync);
 extern void smgrprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum);
 extern void smgrread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer);
 extern void smgrwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
@@ -126,6 +134,8 @@ extern void smgrcreatebuckets(SMgrRelation reln, ForkNumber forknum, bool isRedo
 extern bool mdexists(SMgrRelation reln, ForkNumber forknum);
 extern void mdunlink(const RelFileNodeBackend& rnode, ForkNumber forknum, bool isRedo);
 extern void mdextend(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
+extern void mdextendbatch(
+    SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, BlockNumber nblocks, bool skipFsync);
 extern void mdprefetch(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum);
 extern void mdread(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, char* buffer);
 extern void mdwrite(SMgrRelation reln, ForkNumber forknum, BlockNumber blocknum, const char* buffer, bool skipFsync);
@@ -138,6 +148,16 @@ extern void mdsync(void);
 extern void mdpostckpt(void);
 extern char* mdsegpath(const RelFileNode& rnode, ForkNumber forknum, BlockNumber blkno);
 
+/* in relsize.c */
+extern Size RelSizeCacheShmemSize(void);
+extern void RelSizeCacheShmemInit(void);
+extern BlockNumber RelSizeCacheGet(SMgrRelation reln, ForkNumber forknum);
+extern BlockNumber RelSizeCacheLoad(
+    SMgrRelation reln, ForkNumber forknum, BlockNumber (*nblocksfn)(SMgrRelation, ForkNumber));
+extern void RelSizeCacheExtend(SMgrRelation reln, ForkNumber forknum, BlockNumber nblocks);
+extern void RelSizeCacheForget(const RelFileNodeBackend& rnode, ForkNumber forknum);
+extern void RelSizeCacheForgetDatabase(Oid dbid);
+
 extern void SetForwardFsyncRequests(void);
 extern void RememberFsyncRequest(const RelFileNode& rnode, ForkNumber forknum, BlockNumber segno);
 extern void ForgetRelationFsyncRequests(const RelFileNode& rnode, ForkNumber forknum);
@@ -23,6 +23,7 @@
 #include "access/htup.h"
 #include "access/skey.h"
 #include "lib/dllist.h"
+#include "storage/sinval.h"
 #include "utils/relcache.h"
 
 /*
@@ -120,6 +121,13 @@ typedef struct catctup {
      */
     struct catclist* c_list; /* containing CatCList, or NULL if none */
     CatCache* my_cache;      /* link to owning catcache */
+
+    /*
+     * When the global catalog cache is enabled, tuple.t_data may point into
+     * an entry of the instance-wide cache instead of memory allocated along
+     * with the CatCTup.  The reference is dropped when the CatCTup is freed.
+     */
+    struct GlobalCatCTup* global_ct; /* shared entry holding the tuple, or NULL */
 } CatCTup;
 
 /*
@@ -198,6 +206,14 @@ extern void CatalogCacheIdInvalidate(int cacheId, uint32 hashValue);
 extern void PrepareToInvalidateCacheTuple(
     Relation relation, HeapTuple tuple, HeapTuple newtuple, void (*function)(int, uint32, Oid));
 
+/* global catalog cache shared by thread pool sessions, see enable_global_syscache */
+#define ENABLE_GLOBAL_SYSCACHE (g_instance.cache_cxt.global_catcache != NULL)
+
+extern void GlobalCatCacheInit(void);
+extern void GlobalCatCacheInvalidateMessages(const SharedInvalidationMessage* msgs, int n);
+extern void GlobalCatCacheResetAll(void);
+extern void ReleaseCatCacheGlobalRefs(void);
+
 extern void PrintCatCacheLeakWarning(HeapTuple tuple);
 extern void PrintCatCacheListLeakWarning(CatCList* list);
 extern bool RelationInvalidatesSnapshotsOnly(Oid);
@@ -299,6 +299,7 @@ typedef struct StdRdOptions {
     bool user_catalog_table;       /* use as an additional catalog relation */
     bool hashbucket;        /* enable hash bucket for this relation */
     bool primarynode;       /* enable primarynode mode for replication table */
+    bool deduplicate_items; /* btree: merge equal leaf tuples into posting lists */
     /* info for redistribution */
     Oid rel_cn_oid;
     RedisHtlAction append_mode_internal;
@@ -366,6 +367,13 @@ typedef struct StdRdOptions {
 #define RelationGetTargetPageFreeSpace(relation, defaultff) \
     (BLCKSZ * (100 - RelationGetFillFactor(relation, defaultff)) / 100)
 
+/*
+ * RelationGetDeduplicateItems
+ *		Returns whether a btree index may merge equal leaf tuples.
+ */
+#define RelationGetDeduplicateItems(relation) \
+    ((relation)->rd_options ? ((StdRdOptions*)(relation)->rd_options)->deduplicate_items : true)
+
 /*
  * RelationIsSecurityView
  *		Returns whether the relation is security view, or not
@@ -509,6 +517,27 @@ typedef struct StdRdOptions {
         (relation)->rd_smgr->smgr_targblock = (targblock); \
     } while (0)
 
+/*
+ * RelationHasBulkExtendBlock
+ *		True if blocks pre-extended for this backend's inserts are left.
+ *
+ * Like the target block, they are discarded on any smgr-level invalidation.
+ */
+#define RelationHasBulkExtendBlock(relation)                                                  \
+    ((relation)->rd_smgr != NULL && (relation)->rd_smgr->smgr_bulk_next != InvalidBlockNumber && \
+        (relation)->rd_smgr->smgr_bulk_next < (relation)->rd_smgr->smgr_bulk_end)
+
+/*
+ * RelationSetBulkExtendBlocks
+ *		Keep blocks [start, end) for this backend's future inserts.
+ */
+#define RelationSetBulkExtendBlocks(relation, start, end) \
+    do {                                                   \
+        RelationOpenSmgr(relation);                        \
+        (relation)->rd_smgr->smgr_bulk_next = (start);     \
+        (relation)->rd_smgr->smgr_bulk_end = (end);        \
+    } while (0)
+
 /*
  * RelationNeedsWAL
  *		True if relation needs WAL.
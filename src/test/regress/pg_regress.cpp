@@ -374,6 +374,7 @@ static _stringlist* extra_tests = NULL;
 static char* pcRegConfFile = NULL;
 static char* temp_install = NULL;
 static char* temp_config = NULL;
+static char* temp_mot_config = NULL;
 static char* top_builddir = NULL;
 static bool nolocale = false;
 static bool use_existing = false;
@@ -1894,6 +1895,41 @@ int get_local_ip(char* local_ip)
     return 0;
 }
 
+/*
+ * Append the contents of the --temp-mot-config file to the mot.conf of a node
+ */
+static void append_temp_mot_config(const char* data_folder)
+{
+    FILE* mot_conf = NULL;
+    FILE* extra_conf = NULL;
+    char buf[MAXPGPATH * 4];
+    char line_buf[1024];
+
+    if (temp_mot_config == NULL) {
+        return;
+    }
+
+    (void)snprintf(buf, sizeof(buf), "%s/%s/mot.conf", temp_install, data_folder);
+    mot_conf = fopen(buf, "a");
+    if (mot_conf == NULL) {
+        fprintf(stderr, _("\n%s: could not open \"%s\" for adding extra config: %s\n"), progname, buf, strerror(errno));
+        exit_nicely(2);
+    }
+    fputs("\n# Configuration added by pg_regress\n\n", mot_conf);
+
+    extra_conf = fopen(temp_mot_config, "r");
+    if (extra_conf == NULL) {
+        fprintf(stderr, _("\n%s: could not open \"%s\" to read extra config: %s\n"),
+            progname, temp_mot_config, strerror(errno));
+        exit_nicely(2);
+    }
+    while (fgets(line_buf, sizeof(line_buf), extra_conf) != NULL) {
+        fputs(line_buf, mot_conf);
+    }
+    fclose(extra_conf);
+    fclose(mot_conf);
+}
+
 static void initdb_node_config_file(bool standby)
 {
     int i;
@@ -1991,6 +2027,7 @@ static void initdb_node_config_file(bool standby)
         fputs(buf, pg_conf);
 
         fclose(pg_conf);
+        append_temp_mot_config(data_folder);
         free(data_folder);
     }
 
@@ -2107,6 +2144,7 @@ static void initdb_node_config_file(bool standby)
         fputs(buf, pg_conf);
 
         fclose(pg_conf);
+        append_temp_mot_config(data_folder);
         free(data_folder);
     }
 
@@ -2163,6 +2201,8 @@ static void initdb_node_config_file(bool standby)
         }
 
         fclose(pg_conf);
+        (void)snprintf(buf, sizeof(buf), "%s_standby", data_folder);
+        append_temp_mot_config(buf);
         free(data_folder);
     }
 }
@@ -5254,6 +5294,7 @@ static void help(void)
     printf(_("  --top-builddir=DIR        (relative) path to top level build directory\n"));
     printf(_("  --port=PORT               start postmaster on PORT\n"));
     printf(_("  --temp-config=PATH        append contents of PATH to temporary config\n"));
+    printf(_("  --temp-mot-config=PATH    append contents of PATH to temporary mot.conf\n"));
     printf(_("  --extra-install=DIR       additional directory to install (e.g., contrib\n"));
     printf(_("  --hdfshostname=IPAddress	  hdfs data IP address\n"));
     printf(_("  --hdfsstoreplus=hdfsstoreplus	  hdfs data store path plus information\n"));
@@ -6169,6 +6210,7 @@ int regression_main(int argc, char* argv[], init_function ifunc, test_function t
         {"platform", required_argument, NULL, 55},
         {"g_aiehost", required_argument, NULL, 56},
         {"g_aieport", required_argument, NULL, 57},
+        {"temp-mot-config", required_argument, NULL, 58},
         {NULL, 0, NULL, 0}
     };
 
@@ -6298,6 +6340,9 @@ int regression_main(int argc, char* argv[], init_function ifunc, test_function t
             case 19:
                 temp_config = strdup(optarg);
                 break;
+            case 58:
+                temp_mot_config = strdup(optarg);
+                break;
             case 20:
                 use_existing = true;
                 break;
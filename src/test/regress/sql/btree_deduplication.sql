@@ -0,0 +1,48 @@
+--
+-- Deduplication of equal leaf tuples into posting lists
+--
+create table bt_dedup (a int, b text);
+insert into bt_dedup select i % 10, 'v' || (i % 3) from generate_series(1, 20000) i;
+
+-- posting lists formed by an index build
+create index bt_dedup_build_idx on bt_dedup (a);
+create index bt_dedup_build_off_idx on bt_dedup (a) with (deduplicate_items = off);
+select pg_relation_size('bt_dedup_build_idx') < pg_relation_size('bt_dedup_build_off_idx') as smaller;
+drop index bt_dedup_build_off_idx;
+
+-- posting lists formed by insertion, instead of page splits
+create table bt_dedup_ins (a int, b text);
+create index bt_dedup_ins_idx on bt_dedup_ins (a, b);
+create index bt_dedup_ins_off_idx on bt_dedup_ins (a, b) with (deduplicate_items = off);
+insert into bt_dedup_ins select a, b from bt_dedup;
+select pg_relation_size('bt_dedup_ins_idx') < pg_relation_size('bt_dedup_ins_off_idx') as smaller;
+drop index bt_dedup_ins_off_idx;
+
+set enable_seqscan = off;
+set enable_bitmapscan = off;
+
+-- every heap TID of a posting list is returned
+select count(*) from bt_dedup where a = 3;
+select count(*), count(distinct b) from bt_dedup_ins where a = 3;
+select a, b, count(*) from bt_dedup_ins where a between 4 and 5 group by a, b order by a, b;
+select a, b from bt_dedup_ins where a = 7 order by a desc, b desc limit 3;
+
+-- dead heap TIDs are skipped, and killed once all of a posting list is dead
+delete from bt_dedup_ins where a = 8;
+select count(*) from bt_dedup_ins where a = 8;
+select count(*) from bt_dedup_ins where a = 8;
+
+-- VACUUM removes some heap TIDs of posting lists, and all of others
+delete from bt_dedup where a = 3 and b = 'v1';
+delete from bt_dedup where a = 5;
+vacuum bt_dedup;
+select count(*) from bt_dedup where a = 3;
+select count(*) from bt_dedup where a = 5;
+insert into bt_dedup select 3, 'v9' from generate_series(1, 500);
+select count(*) from bt_dedup where a = 3;
+select b, count(*) from bt_dedup where a = 3 group by b order by b;
+
+reset enable_seqscan;
+reset enable_bitmapscan;
+drop table bt_dedup;
+drop table bt_dedup_ins;
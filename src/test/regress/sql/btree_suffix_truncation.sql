@@ -0,0 +1,65 @@
+--
+-- Suffix truncation of leaf high keys on multi-column B-tree indexes
+--
+create table bt_trunc (a int, b int, c text);
+insert into bt_trunc select i % 50, i, 'row' || i from generate_series(1, 5000) i;
+
+-- high keys truncated by an index build
+create unique index bt_trunc_build_idx on bt_trunc (a, b);
+
+-- high keys truncated by page splits during insertion
+create table bt_trunc_ins (a int, b int, c text);
+create unique index bt_trunc_ins_idx on bt_trunc_ins (a, b, c);
+insert into bt_trunc_ins select a, b, c from bt_trunc order by b;
+
+set enable_seqscan = off;
+set enable_bitmapscan = off;
+
+-- every row is still reachable through the truncated pivots
+select count(*) from bt_trunc where a = 7;
+select count(*) from bt_trunc where a = 7 and b > 2500;
+select count(*) from bt_trunc_ins where a = 0;
+select count(*) from bt_trunc_ins where a between 10 and 19;
+select a, b, c from bt_trunc_ins where a = 49 and b between 2400 and 2600 order by a, b;
+select a, b from bt_trunc where a = 25 order by a desc, b desc limit 3;
+
+-- unique checks reach the end of pages whose high key is truncated
+do $$
+declare
+    r record;
+    dups int := 0;
+begin
+    for r in select a, b, c from bt_trunc loop
+        begin
+            insert into bt_trunc values (r.a, r.b, r.c);
+        exception when unique_violation then
+            dups := dups + 1;
+        end;
+    end loop;
+    raise notice 'bt_trunc duplicates rejected: %', dups;
+end $$;
+
+do $$
+declare
+    r record;
+    dups int := 0;
+begin
+    for r in select a, b, c from bt_trunc_ins loop
+        begin
+            insert into bt_trunc_ins values (r.a, r.b, r.c);
+        exception when unique_violation then
+            dups := dups + 1;
+        end;
+    end loop;
+    raise notice 'bt_trunc_ins duplicates rejected: %', dups;
+end $$;
+
+-- new keys between existing ones split pages again
+insert into bt_trunc_ins select a, b, c || 'x' from bt_trunc where b % 3 = 0;
+select count(*) from bt_trunc_ins where a = 3;
+select count(*) from bt_trunc_ins where a = 3 and b = 153;
+
+reset enable_seqscan;
+reset enable_bitmapscan;
+drop table bt_trunc;
+drop table bt_trunc_ins;
@@ -0,0 +1,23 @@
+--
+-- Opportunistic pruning while reading: the pruned page may be frozen and
+-- marked all-visible, but the visibility map is never created from a read
+--
+create table prune_opt (a int, b text) with (autovacuum_enabled = off);
+insert into prune_opt select i, repeat('x', 100) from generate_series(1, 2000) i;
+
+-- leave dead versions on every page, so that the scans prune them
+update prune_opt set b = repeat('y', 100);
+update prune_opt set b = repeat('z', 100);
+select count(*), sum(a) from prune_opt;
+select count(*) from prune_opt where b = repeat('z', 100);
+select pg_relation_size('prune_opt', 'vm') = 0 as no_vm;
+
+-- once VACUUM created the map, pruned pages may be marked all-visible
+vacuum prune_opt;
+select pg_relation_size('prune_opt', 'vm') > 0 as has_vm;
+update prune_opt set b = repeat('w', 100) where a % 2 = 0;
+select count(*), sum(a) from prune_opt;
+select count(*) from prune_opt where b = repeat('w', 100);
+select a, b = repeat('w', 100) as w from prune_opt where a in (1, 2, 1999, 2000) order by a;
+
+drop table prune_opt;
@@ -0,0 +1,34 @@
+--
+-- Hash indexes on MOT tables
+--
+create foreign table hash_pk (id int primary key, u int not null, v int) options (primary_index 'hash');
+insert into hash_pk select i, i + 100, i % 3 from generate_series(1, 50) i;
+select id, u, v from hash_pk where id = 7;
+select count(*), sum(id), sum(u) from hash_pk;
+
+-- rows come back in hash order, so ordering is never taken from a hash index
+select id from hash_pk order by id limit 5;
+select id from hash_pk order by id desc limit 3;
+
+update hash_pk set v = 10 where id = 7;
+delete from hash_pk where id = 8;
+select id, v from hash_pk where id in (7, 8) order by id;
+
+-- a full scan of a hash primary index cannot feed an insert into the same table
+insert into hash_pk select id + 1000, u + 1000, v from hash_pk;
+select count(*) from hash_pk;
+
+-- unique hash secondary index
+create unique index hash_pk_u on hash_pk using hash (u);
+select id, u from hash_pk where u = 120;
+select id, u from hash_pk where u = 108;
+insert into hash_pk values (108, 108, 0);
+select id, u from hash_pk where u = 108;
+
+-- hash indexes must be unique
+create index hash_pk_v on hash_pk using hash (v);
+
+-- the primary index option takes btree or hash
+create foreign table hash_bad (id int primary key) options (primary_index 'bitmap');
+
+drop foreign table hash_pk;
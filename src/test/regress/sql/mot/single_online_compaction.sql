@@ -0,0 +1,30 @@
+--
+-- Online compaction moves rows out of sparse row buffers while the table is in use
+-- (make_fastcheck_single_mot_mot.conf runs a slow pass every second)
+--
+create foreign table online_compact (id int primary key, val int not null, pad varchar(100));
+insert into online_compact select i, i % 100, repeat('p', 50) from generate_series(1, 10000) i;
+
+-- leave the row buffers sparse
+delete from online_compact where id % 10 <> 0;
+select count(*), sum(id), sum(val) from online_compact;
+
+-- DML and DDL get through between the compaction batches
+select pg_sleep(1);
+update online_compact set val = val + 1;
+create index online_compact_val on online_compact (val);
+select pg_sleep(1);
+insert into online_compact select i, i % 100, 'q' from generate_series(1, 10000) i where i % 10 = 5;
+select pg_sleep(2);
+select count(*), sum(id), sum(val), sum(length(pad)) from online_compact;
+select count(*) from online_compact where val = 11;
+
+-- a truncate in the middle of a table visit ends the visit
+delete from online_compact where id % 20 <> 0;
+select pg_sleep(1);
+truncate online_compact;
+insert into online_compact select i, i, 'r' from generate_series(1, 100) i;
+select pg_sleep(1);
+select count(*), sum(id), sum(val) from online_compact;
+
+drop foreign table online_compact;
@@ -0,0 +1,85 @@
+--
+-- Statements of PL/pgSQL functions over MOT tables are jitted one by one, their parameters come from the
+-- function variables and change on every loop iteration
+--
+create foreign table jit_loop (id int primary key, val int not null);
+
+create function jit_loop_fill(n int) returns int as $$
+begin
+    for i in 1..n loop
+        insert into jit_loop values (i, i * 10);
+    end loop;
+    return n;
+end;
+$$ language plpgsql;
+
+create function jit_loop_sum(lo int, hi int) returns bigint as $$
+declare
+    v int;
+    total bigint := 0;
+begin
+    for i in lo..hi loop
+        select val into v from jit_loop where id = i;
+        if found then
+            total := total + v;
+        end if;
+    end loop;
+    return total;
+end;
+$$ language plpgsql;
+
+create function jit_loop_bump(n int) returns int as $$
+begin
+    for i in 1..n loop
+        update jit_loop set val = val + i where id = i;
+    end loop;
+    return n;
+end;
+$$ language plpgsql;
+
+create function jit_loop_prune(n int) returns int as $$
+begin
+    for i in 1..n loop
+        if i % 3 = 0 then
+            delete from jit_loop where id = i;
+        end if;
+    end loop;
+    return n;
+end;
+$$ language plpgsql;
+
+-- one decimal digit per window of w keys
+create function jit_loop_windows(w int) returns bigint as $$
+declare
+    c bigint;
+    total bigint := 0;
+begin
+    for i in 0..(100 / w - 1) loop
+        select count(*) into c from jit_loop where id > i * w and id <= (i + 1) * w;
+        total := total * 10 + c;
+    end loop;
+    return total;
+end;
+$$ language plpgsql;
+
+-- point insert and lookup, the second calls reuse the jitted statements
+select jit_loop_fill(100);
+select jit_loop_sum(1, 100);
+select jit_loop_sum(11, 20);
+select jit_loop_sum(95, 105);
+-- point update
+select jit_loop_bump(100);
+select jit_loop_sum(1, 100);
+select val from jit_loop where id = 7;
+-- point delete and range aggregate
+select jit_loop_prune(100);
+select jit_loop_sum(1, 100);
+select jit_loop_windows(10);
+select count(*) from jit_loop;
+
+drop function jit_loop_windows;
+drop function jit_loop_prune;
+drop function jit_loop_bump;
+drop function jit_loop_sum;
+drop function jit_loop_fill;
+drop foreign table jit_loop;
@@ -0,0 +1,33 @@
+--
+-- Range scans fetch rows in batches of 64, the end key can fall inside a batch or right on its boundary
+--
+create foreign table range_batch (id int primary key, grp int not null);
+create index range_batch_grp on range_batch (grp);
+insert into range_batch select i, i / 2 from generate_series(1, 300) i;
+
+-- end key inside the second batch
+select count(*), min(id), max(id), sum(id) from range_batch where id >= 1 and id <= 100;
+-- end key on the last row of a batch, and on the first row of the next one
+select count(*), min(id), max(id), sum(id) from range_batch where id >= 1 and id <= 64;
+select count(*), min(id), max(id), sum(id) from range_batch where id >= 1 and id <= 65;
+select count(*), min(id), max(id), sum(id) from range_batch where id >= 1 and id <= 128;
+select count(*), min(id), max(id), sum(id) from range_batch where id > 10 and id < 75;
+select count(*), min(id), max(id), sum(id) from range_batch where id > 10 and id < 76;
+-- end key beyond the last row, and empty ranges
+select count(*), min(id), max(id), sum(id) from range_batch where id >= 250 and id <= 1000;
+select count(*) from range_batch where id > 64 and id < 65;
+select count(*) from range_batch where id >= 301 and id <= 400;
+-- backward scans
+select id from range_batch where id >= 60 and id <= 70 order by id desc;
+select count(*), min(id), max(id) from (select id from range_batch where id >= 1 and id <= 128 order by id desc) s;
+-- non-unique index, two rows per key
+select count(*), min(grp), max(grp), sum(id) from range_batch where grp >= 1 and grp <= 32;
+select count(*), min(grp), max(grp), sum(id) from range_batch where grp >= 10 and grp < 42;
+select id from range_batch where grp = 32 order by id;
+
+-- rows deleted inside the range are skipped
+delete from range_batch where id % 3 = 0;
+select count(*), min(id), max(id), sum(id) from range_batch where id >= 1 and id <= 96;
+select count(*), min(id), max(id), sum(id) from range_batch where id >= 1 and id <= 97;
+
+drop foreign table range_batch;
@@ -0,0 +1,22 @@
+--
+-- Row and key memory is reused after deletes (objects pass through the per-thread magazines)
+--
+create foreign table pool_churn (id int primary key, grp int not null, pad varchar(200));
+create index pool_churn_grp on pool_churn (grp);
+insert into pool_churn select i, i % 7, repeat('x', i % 200) from generate_series(1, 5000) i;
+
+-- free most of the rows
+delete from pool_churn where id % 10 <> 0;
+select count(*), sum(id) from pool_churn;
+
+-- take the freed objects again
+insert into pool_churn select i, i % 7, repeat('y', i % 150) from generate_series(1, 5000) i where i % 10 <> 0;
+select count(*), sum(id), sum(length(pad)) from pool_churn;
+
+-- empty the table completely and fill it again
+delete from pool_churn;
+select count(*) from pool_churn;
+insert into pool_churn select i, i % 7, 'z' from generate_series(1, 2000) i;
+select grp, count(*) from pool_churn group by grp order by grp;
+
+drop foreign table pool_churn;
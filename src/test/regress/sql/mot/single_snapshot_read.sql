@@ -0,0 +1,50 @@
+--
+-- Commit paths that keep row versions and deleted keys for snapshot reads (enable_snapshot_read is set in mot.conf)
+--
+create foreign table snap_tbl (id int primary key, u int not null, v int not null, note varchar(16));
+create unique index snap_tbl_u on snap_tbl (u);
+create index snap_tbl_v on snap_tbl (v);
+insert into snap_tbl select i, i + 1000, i % 10, 'row' || i from generate_series(1, 100) i;
+
+-- update, delete and insert after delete in one transaction
+start transaction;
+update snap_tbl set note = 'upd' || id where id <= 10;
+delete from snap_tbl where id between 11 and 20;
+insert into snap_tbl values (15, 1015, 5, 'again15');
+commit;
+
+-- keys deleted by an earlier transaction are taken again
+delete from snap_tbl where id between 21 and 25;
+insert into snap_tbl values (21, 1021, 1, 'again21');
+insert into snap_tbl values (122, 1022, 2, 'moved22');
+
+-- read-only transactions are never aborted
+start transaction isolation level repeatable read read only;
+select count(*), sum(id), sum(u) from snap_tbl;
+select id, u, v, note from snap_tbl where id in (5, 15, 16, 21, 22, 122) order by id;
+select id, note from snap_tbl where u in (1005, 1015, 1016, 1022) order by id;
+select count(*) from snap_tbl where v = 5;
+commit;
+
+start transaction isolation level read committed read only;
+select count(*) from snap_tbl where id between 11 and 25;
+commit;
+
+-- a unique secondary key taken over by another row
+delete from snap_tbl where id = 30;
+insert into snap_tbl values (130, 1030, 0, 'took1030');
+start transaction isolation level repeatable read read only;
+select id, u, note from snap_tbl where u = 1030;
+select id, u, note from snap_tbl where id in (30, 130) order by id;
+commit;
+
+-- deleted keys do not outlive the indexes they belong to
+drop index snap_tbl_v;
+delete from snap_tbl where id > 90;
+select count(*), max(id) from snap_tbl;
+truncate snap_tbl;
+select count(*) from snap_tbl;
+insert into snap_tbl values (1, 1001, 1, 'new1');
+select id, u, v, note from snap_tbl;
+
+drop foreign table snap_tbl;
@@ -0,0 +1,29 @@
+--
+-- Vectorized scans of MOT tables
+--
+
+CREATE FOREIGN TABLE vec_scan_tbl (id int NOT NULL PRIMARY KEY, grp int, val bigint, name varchar(32), amount numeric(10,2)) SERVER mot_server;
+
+INSERT INTO vec_scan_tbl
+    SELECT i, i % 10, i * 2, CASE WHEN i % 1000 = 0 THEN NULL ELSE 'name_' || (i % 100) END, i / 4.0
+    FROM generate_series(1, 20000) AS i;
+
+SET enable_vector_engine = on;
+
+-- every row of a batch must be decoded from its own version, not from the last row looked up
+START TRANSACTION ISOLATION LEVEL READ COMMITTED;
+SELECT count(*), count(DISTINCT id), count(name), sum(val), min(name), max(name), sum(amount) FROM vec_scan_tbl;
+SELECT grp, count(*), sum(val), count(DISTINCT name), max(amount) FROM vec_scan_tbl GROUP BY grp ORDER BY grp;
+SELECT count(*), sum(val), sum(amount) FROM vec_scan_tbl WHERE name <> 'name_7' AND amount > 100;
+COMMIT;
+
+-- same results from the row executor
+SET enable_vector_engine = off;
+START TRANSACTION ISOLATION LEVEL READ COMMITTED;
+SELECT count(*), count(DISTINCT id), count(name), sum(val), min(name), max(name), sum(amount) FROM vec_scan_tbl;
+SELECT grp, count(*), sum(val), count(DISTINCT name), max(amount) FROM vec_scan_tbl GROUP BY grp ORDER BY grp;
+SELECT count(*), sum(val), sum(amount) FROM vec_scan_tbl WHERE name <> 'name_7' AND amount > 100;
+COMMIT;
+
+RESET enable_vector_engine;
+DROP FOREIGN TABLE vec_scan_tbl;
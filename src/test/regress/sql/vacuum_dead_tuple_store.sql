@@ -0,0 +1,42 @@
+--
+-- Dead tuple store of lazy vacuum: lookups from the index pass and the
+-- one page store of tables without indexes
+--
+set maintenance_work_mem = '1MB';
+
+-- more than one radix tree leaf of dead pages, with whole pages dead
+create table vac_store (a int);
+insert into vac_store select i from generate_series(1, 300000) i;
+create index vac_store_idx on vac_store (a);
+delete from vac_store where a % 7 = 0 or a between 100001 and 120000;
+vacuum vac_store;
+
+-- reclaimed line pointers are reused, stale index entries would show up
+insert into vac_store select i from generate_series(1000001, 1100000) i;
+
+set enable_seqscan = off;
+set enable_bitmapscan = off;
+select count(*), sum(a) from vac_store where a <= 300000;
+select count(*) from vac_store where a between 100001 and 120000;
+select count(*) from vac_store where a >= 1000001;
+select count(*) from vac_store where a between 1 and 1000;
+select a from vac_store where a in (7, 8, 14, 100500, 299998, 299999) order by a;
+reset enable_seqscan;
+reset enable_bitmapscan;
+select count(*), sum(a) from vac_store where a <= 300000;
+
+-- no index: each page is vacuumed as soon as it is scanned
+create table vac_store_noidx (a int);
+insert into vac_store_noidx select i from generate_series(1, 50000) i;
+delete from vac_store_noidx where a % 5 = 0;
+vacuum vac_store_noidx;
+create table vac_store_size as select pg_relation_size('vac_store_noidx') as size;
+insert into vac_store_noidx select i from generate_series(1000001, 1005000) i;
+select count(*) from vac_store_noidx;
+select count(*) from vac_store_noidx where a <= 50000 and a % 5 = 0;
+select pg_relation_size('vac_store_noidx') = size as reused from vac_store_size;
+
+reset maintenance_work_mem;
+drop table vac_store;
+drop table vac_store_noidx;
+drop table vac_store_size;